@@ -26,10 +26,11 @@ ConstantBuffer< DescriptorHeapIndex > g_CoreMaterial         : register(b18, ROO
 
 ConstantBuffer< VoxelChunkDesc > g_VoxelChunkDesc : register(b1, space1);
 
-cbuffer DebugConstants : register(b0, ROOT_CONSTANT_SPACE)
-{
-    uint g_DebugView;
-};
+// Permutation feature; LightingNode builds one pipeline per debug view in use
+// @permutation SURFACE_DEBUG_VIEW 8
+#ifndef SURFACE_DEBUG_VIEW
+#define SURFACE_DEBUG_VIEW 0
+#endif
 
 
 static const float MIN_ROUGHNESS = 0.045;
@@ -155,20 +156,20 @@ void main(uint3 tID : SV_DispatchThreadID)
             }
         }
 
-        if (g_DebugView != 0)
+        if (SURFACE_DEBUG_VIEW != 0)
         {
             float3 dbg = float3(0.0, 0.0, 0.0);
-            if (g_DebugView == 1)
+            if (SURFACE_DEBUG_VIEW == 1)
             {
                 if (VisIsSky(v0))          dbg = float3(0.0, 0.0, 1.0);
                 else if (VisIsTerrain(v0)) dbg = float3(1.0, 0.0, 0.0);
                 else                       dbg = float3(0.0, 1.0, 0.0);
             }
-            else if (g_DebugView == 2)
+            else if (SURFACE_DEBUG_VIEW == 2)
             {
                 dbg = N * 0.5 + 0.5;
             }
-            else if (g_DebugView == 3)
+            else if (SURFACE_DEBUG_VIEW == 3)
             {
                 float3 nLive = N;
                 if (VisIsMesh(v0))
@@ -180,10 +181,10 @@ void main(uint3 tID : SV_DispatchThreadID)
                 }
                 dbg = nLive * 0.5 + 0.5;
             }
-            else if (g_DebugView == 4) dbg = albedo;
-            else if (g_DebugView == 5) dbg = float3(roughness, roughness, roughness);
-            else if (g_DebugView == 6) dbg = float3(ao, ao, ao);
-            else if (g_DebugView == 7)
+            else if (SURFACE_DEBUG_VIEW == 4) dbg = albedo;
+            else if (SURFACE_DEBUG_VIEW == 5) dbg = float3(roughness, roughness, roughness);
+            else if (SURFACE_DEBUG_VIEW == 6) dbg = float3(ao, ao, ao);
+            else if (SURFACE_DEBUG_VIEW == 7)
             {
                 float3 bcol = float3(0.0, 0.0, 0.0);
                 if (VisIsMesh(v0))
@@ -270,16 +270,21 @@ void BistroApp::ConfigureSceneObjects()
 		descriptor.bGenerateMeshlets = true;
 		descriptor.numLODs			 = 8;
 
-		srand(42);
+		// Seeded engine-side so benchmark runs place every instance the same way on any CRT.
+		// mt19937's output sequence is fixed by the standard but the distributions are not,
+		// so floats come straight from its top 24 bits
+		std::mt19937 rng(GetSceneSeed());
+		auto unit = [&rng]() { return static_cast< float >(rng() >> 8) * 0x1p-24f; };
+
 		const u32 meshCount = 100'000;
 		for (u32 i = 0; i < meshCount; ++i)
 		{
 			auto entity = m_pScene->ImportModel(MODEL_PATH.append("kitten.obj"), descriptor);
 			entity.AttachComponent< ScriptComponent >();
 
-			float3 position = { float(rand()) / RAND_MAX, float(rand()) / RAND_MAX, float(rand()) / RAND_MAX + 0.5f };
-			float3 rotation = { float(rand()) / RAND_MAX, float(rand()) / RAND_MAX, float(rand()) / RAND_MAX };
-			float  scale    = (float(rand() / RAND_MAX) + 1.0f) * 2.0f;
+			float3 position = { unit(), unit(), unit() + 0.5f };
+			float3 rotation = { unit(), unit(), unit() };
+			float  scale    = 2.0f;
 
 			auto& tc = entity.GetComponent< TransformComponent >();
 			tc.transform.position = float3(position.x * 100.0f - 50.0f, position.y * 100.0f - 50.0f, position.z * 600.0f - 300.0f);
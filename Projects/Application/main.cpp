@@ -3,17 +3,150 @@
 #include "Applications/LightingApp.h"
 #include "Applications/RayTracingApp.h"
 #include "Applications/TerrainApp.h"
+#include "BaambooCore/PerfGate.h"
 
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <string_view>
+#include <vector>
+
+namespace
+{
+
+int RunApp(baamboo::Engine& app, eRendererAPI api)
+{
+	try
+	{
+		app.Initialize(api);
+	}
+	catch (std::runtime_error& e)
+	{
+		std::cerr << e.what() << '\n';
+		return -1;
+	}
+
+	return app.Run();
+}
+
+int RunBenchmark(const std::string& configPath, u32 traceFrames, baamboo::PerfGate::ScenarioResult& outResult)
+{
+	baamboo::Benchmark::Config config;
+	if (!baamboo::Benchmark::LoadConfig(configPath, config))
+		return -1;
+
+	const eRendererAPI api     = config.api == "Vulkan" ? eRendererAPI::Vulkan : eRendererAPI::D3D12;
+	const std::string  appName = config.app;
+	auto Run = [&](baamboo::Engine& app)
+	{
+		app.ConfigureTraceCapture(traceFrames);
+		app.ConfigureBenchmark(std::move(config));
+
+		const int exitCode = RunApp(app, api);
+		if (const auto* pBenchmark = app.GetBenchmark())
+			outResult = baamboo::PerfGate::Collect(*pBenchmark);
+		return exitCode;
+	};
+
+	if (appName == "Example")
+	{
+		ExampleApp app = {};
+		return Run(app);
+	}
+	if (appName == "Bistro")
+	{
+		BistroApp app = {};
+		return Run(app);
+	}
+	if (appName == "Lighting")
+	{
+		LightingApp app = {};
+		return Run(app);
+	}
+	if (appName == "RayTracing")
+	{
+		RayTracingApp app = {};
+		return Run(app);
+	}
+	if (appName == "Terrain")
+	{
+		TerrainApp app = {};
+		return Run(app);
+	}
+
+	std::cerr << "Unknown benchmark app '" << appName << "' (Example, Bistro, Lighting, RayTracing, Terrain)\n";
+	return -1;
+}
+
+// Runs every scenario, then checks them against the baseline (or records them into it).
+// Returns the first failed run's exit code, else 2 if anything regressed or had nothing to compare against.
+int RunBenchmarks(const std::vector< std::string >& configPaths, u32 traceFrames, const std::string& baselinePath, bool bUpdateBaseline)
+{
+	baamboo::PerfGate gate;
+	if (!baselinePath.empty() && !gate.Load(baselinePath, bUpdateBaseline))
+		return -1;
+
+	int exitCode = 0;
+	std::vector< baamboo::PerfGate::Regression > regressions;
+	for (const auto& configPath : configPaths)
+	{
+		baamboo::PerfGate::ScenarioResult result;
+		const int runExitCode = RunBenchmark(configPath, traceFrames, result);
+		if (runExitCode != 0 || !result.bComplete)
+		{
+			std::cerr << "Benchmark '" << configPath << "' failed (exit code " << runExitCode << ")\n";
+			if (exitCode == 0)
+				exitCode = runExitCode != 0 ? runExitCode : 1;
+			continue;
+		}
+
+		if (baselinePath.empty())
+			continue;
+
+		if (bUpdateBaseline)
+		{
+			gate.Update(result);
+		}
+		else
+		{
+			auto scenarioRegressions = gate.Check(result);
+			regressions.insert(regressions.end(), scenarioRegressions.begin(), scenarioRegressions.end());
+		}
+	}
+
+	if (bUpdateBaseline)
+	{
+		// A failed run would leave holes in the baseline
+		if (exitCode != 0)
+			return exitCode;
+		return gate.Save(baselinePath) ? 0 : -1;
+	}
+
+	if (!regressions.empty())
+	{
+		baamboo::PerfGate::PrintRegressions(regressions);
+		if (exitCode == 0)
+			exitCode = 2;
+	}
+	else if (!baselinePath.empty() && exitCode == 0)
+	{
+		std::cout << "[PerfGate] no regressions across " << configPaths.size() << " scenario(s)\n";
+	}
+	return exitCode;
+}
+
+} // anonymous namespace
 
 int main(int argc, char** argv)
 {
 	bool bDumpAOV             = false;
 	bool bExitAfterDump       = false;
 	bool bPathTracerRequested = false;
+	u32  traceFrames          = 0;
+	bool bUpdateBaseline      = false;
 	std::string pathTracerScene;
+	std::string baselinePath;
+	std::vector< std::string > benchmarkPaths;
 	for (int i = 1; i < argc; ++i)
 	{
 		const std::string_view arg = argv[i];
@@ -47,8 +180,31 @@ int main(int argc, char** argv)
 			pathTracerScene = std::string(arg.substr(std::string_view("--pt-scene=").size()));
 			bPathTracerRequested = true;
 		}
+		else if (arg == "--benchmark" && i + 1 < argc)
+		{
+			benchmarkPaths.emplace_back(argv[++i]);
+		}
+		else if (arg == "--baseline" && i + 1 < argc)
+		{
+			baselinePath = argv[++i];
+		}
+		else if (arg == "--update-baseline")
+		{
+			bUpdateBaseline = true;
+		}
+		else if (arg == "--trace-frames" && i + 1 < argc)
+		{
+			traceFrames = static_cast< u32 >(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (arg.starts_with("--trace-frames="))
+		{
+			traceFrames = static_cast< u32 >(std::strtoul(argv[i] + std::string_view("--trace-frames=").size(), nullptr, 10));
+		}
 	}
 
+	if (!benchmarkPaths.empty())
+		return RunBenchmarks(benchmarkPaths, traceFrames, baselinePath, bUpdateBaseline);
+
 	if (bPathTracerRequested)
 	{
 		if (pathTracerScene.empty())
@@ -56,17 +212,8 @@ int main(int argc, char** argv)
 
 		RayTracingApp app = {};
 		app.ConfigurePathTracerAutomation(bDumpAOV, bExitAfterDump, pathTracerScene);
-		try
-		{
-			app.Initialize(eRendererAPI::D3D12);
-		}
-		catch (std::runtime_error& e)
-		{
-			std::cerr << e.what() << '\n';
-			return -1;
-		}
-
-		return app.Run();
+		app.ConfigureTraceCapture(traceFrames);
+		return RunApp(app, eRendererAPI::D3D12);
 	}
 
 	eRendererAPI api = eRendererAPI::D3D12;
@@ -77,15 +224,6 @@ int main(int argc, char** argv)
 	//LightingApp app = {};
 	//RayTracingApp app = {};
 	//TerrainApp app = {};
-	try
-	{
-		app.Initialize(api);
-	}
-	catch (std::runtime_error& e)
-	{
-		std::cerr << e.what() << '\n';
-		return -1;
-	}
-
-	return app.Run();
+	app.ConfigureTraceCapture(traceFrames);
+	return RunApp(app, api);
 }
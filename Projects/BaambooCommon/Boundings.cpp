@@ -2,6 +2,7 @@
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/matrix_decompose.hpp>
+#include <glm/gtc/matrix_access.hpp>
 
 //-------------------------------------------------------------------------
 // Bounding sphere
@@ -138,4 +139,80 @@ const BoundingBox BoundingBox::Union(const BoundingBox& aabb1, const BoundingBox
 	const auto min = glm::min(aabb1.m_Min, aabb2.m_Min);
 	const auto max = glm::max(aabb1.m_Max, aabb2.m_Max);
 	return BoundingBox(min, max);
-}
\ No newline at end of file
+}
+
+const BoundingBox BoundingBox::Transformed(const BoundingBox& aabb, const mat4& transform)
+{
+	const float3 center = (aabb.m_Min + aabb.m_Max) * 0.5f;
+	const float3 extent = (aabb.m_Max - aabb.m_Min) * 0.5f;
+
+	const float3 newCenter = float3(transform * float4(center, 1.0f));
+	const float3 newExtent = glm::abs(float3(transform[0])) * extent.x
+		+ glm::abs(float3(transform[1])) * extent.y
+		+ glm::abs(float3(transform[2])) * extent.z;
+
+	return BoundingBox(newCenter - newExtent, newCenter + newExtent);
+}
+
+
+//-------------------------------------------------------------------------
+// BoundingFrustum
+//-------------------------------------------------------------------------
+BoundingFrustum::BoundingFrustum(const mat4& mViewProj)
+{
+	const float4 row0 = glm::row(mViewProj, 0);
+	const float4 row1 = glm::row(mViewProj, 1);
+	const float4 row2 = glm::row(mViewProj, 2);
+	const float4 row3 = glm::row(mViewProj, 3);
+
+	m_Planes[0] = row3 + row0;
+	m_Planes[1] = row3 - row0;
+	m_Planes[2] = row3 + row1;
+	m_Planes[3] = row3 - row1;
+	m_Planes[4] = row2;        // depth >= 0
+	m_Planes[5] = row3 - row2; // depth <= w
+
+	for (auto& plane : m_Planes)
+	{
+		// An infinite reverse-Z projection maps the far plane to (0, 0, 0, zNear):
+		// no normal, nothing to clip. Keep a plane every point is inside of.
+		const float length = glm::length(float3(plane));
+		plane = length > 1e-6f ? plane / length : float4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
+
+bool BoundingFrustum::Surrounds(const BoundingBox& aabb) const
+{
+	const float3 center = (aabb.Min() + aabb.Max()) * 0.5f;
+	const float3 extent = (aabb.Max() - aabb.Min()) * 0.5f;
+	for (const auto& plane : m_Planes)
+	{
+		const float3 normal = float3(plane);
+		if (glm::dot(normal, center) + plane.w < glm::dot(glm::abs(normal), extent))
+			return false;
+	}
+	return true;
+}
+
+bool BoundingFrustum::Overlaps(const BoundingBox& aabb) const
+{
+	const float3 center = (aabb.Min() + aabb.Max()) * 0.5f;
+	const float3 extent = (aabb.Max() - aabb.Min()) * 0.5f;
+	for (const auto& plane : m_Planes)
+	{
+		const float3 normal = float3(plane);
+		if (glm::dot(normal, center) + plane.w < -glm::dot(glm::abs(normal), extent))
+			return false;
+	}
+	return true;
+}
+
+bool BoundingFrustum::Overlaps(const BoundingSphere& sphere) const
+{
+	for (const auto& plane : m_Planes)
+	{
+		if (glm::dot(float3(plane), sphere.Center()) + plane.w < -sphere.Radius())
+			return false;
+	}
+	return true;
+}
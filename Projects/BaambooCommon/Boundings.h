@@ -88,7 +88,42 @@ public:
 	[[nodiscard]]
 	static const BoundingBox Union(const BoundingBox& aabb1, const BoundingBox& aabb2);
 
+	// bounds of the box after 'transform' (still axis-aligned, hence conservative)
+	[[nodiscard]]
+	static const BoundingBox Transformed(const BoundingBox& aabb, const mat4& transform);
+
 private:
 	float3 m_Min;
 	float3 m_Max;
+};
+
+
+//-------------------------------------------------------------------------
+// BoundingFrustum
+//-------------------------------------------------------------------------
+class BAAMBOO_API BoundingFrustum
+{
+public:
+	static constexpr u32 kNumPlanes = 6; // left, right, bottom, top, depth 0, depth 1
+
+	BoundingFrustum() = default;
+	// planes of a left-handed, zero-to-one depth projection. Reverse-Z swaps the
+	// depth planes; an infinite far plane becomes one that culls nothing.
+	explicit BoundingFrustum(const mat4& mViewProj);
+
+	[[nodiscard]]
+	bool Surrounds(const BoundingBox& aabb) const;
+
+	[[nodiscard]]
+	bool Overlaps(const BoundingBox& aabb) const;
+	[[nodiscard]]
+	bool Overlaps(const BoundingSphere& sphere) const;
+
+public:
+	// xyz : inward unit normal, w : distance, so dot(n, p) + w >= 0 inside
+	[[nodiscard]]
+	const float4& Plane(u32 index) const { return m_Planes[index]; }
+
+private:
+	float4 m_Planes[kNumPlanes] = {};
 };
\ No newline at end of file
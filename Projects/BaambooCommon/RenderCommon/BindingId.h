@@ -0,0 +1,53 @@
+#pragma once
+#include "Primitives.h"
+
+#include <string>
+
+namespace render
+{
+
+// =========================================================================
+// FNV-1a (64-bit) — usable in constant expressions
+// =========================================================================
+constexpr u64 kFnv1aOffsetBasis = 0xcbf29ce484222325ull;
+constexpr u64 kFnv1aPrime       = 0x00000100000001b3ull;
+
+constexpr u64 HashBindingName(const char* str, size_t length)
+{
+    u64 hash = kFnv1aOffsetBasis;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= static_cast< u64 >(static_cast< u8 >(str[i]));
+        hash *= kFnv1aPrime;
+    }
+    return hash;
+}
+
+// =========================================================================
+// BindingId — pre-hashed shader resource name.
+//
+//   Built from a string literal the hash always folds at compile time (the
+//   constructor is consteval), so binding through a BindingId costs one flat
+//   lookup in the pipeline's slot table and never constructs a std::string.
+//   Names only known at runtime take the explicit std::string constructor.
+// =========================================================================
+struct BindingId
+{
+    u64         hash = 0;
+    const char* name = ""; // literal (or caller-owned) string, kept for diagnostics only
+
+    constexpr BindingId() = default;
+
+    template< size_t N >
+    consteval BindingId(const char (&literal)[N])
+        : hash(HashBindingName(literal, N - 1)), name(literal) {}
+
+    // runtime path for tooling / data-driven names; 'str' must outlive the call
+    explicit BindingId(const std::string& str)
+        : hash(HashBindingName(str.data(), str.size())), name(str.c_str()) {}
+
+    constexpr bool operator==(const BindingId& other) const { return hash == other.hash; }
+    constexpr bool operator!=(const BindingId& other) const { return hash != other.hash; }
+};
+
+} // namespace render
@@ -1,5 +1,6 @@
 #pragma once
 #include "RenderResources.h"
+#include "ProfileScope.h"
 
 namespace render
 {
@@ -25,13 +26,17 @@ struct GpuPipelineStats
 // =========================================================================
 struct GpuProfileEntry
 {
-    const char*      name;              // caller-owned string (string literal lifetime recommended)
+    const char*      name;              // interned, valid for the life of the process
     u32              depth;             // 0 = top-level (typically the implicit "Frame" scope)
     double           elapsedMs;         // wall-clock GPU time for this scope
     bool             bHasStats = false; // true if pipeline statistics were collected for this scope
     GpuPipelineStats stats     = {};    // zero when !bHasStats
+    double           beginMs   = 0.0;   // device timestamp at scope begin; lines up scopes of different queues
+    ProfileScopeId   scopeId   = kInvalidProfileScope;
 };
 
+constexpr u64 kNoProfileFrame = ~0ull;
+
 inline u32 GetGpuMarkerColor(const char* name)
 {
     if (!name || !name[0]) return 0xFF808080u; // gray
@@ -92,6 +97,8 @@ public:
     virtual void TransitionTextureToWrite(const Arc< Texture >& pTexture, render::ePipelineStage dstStage, u32 subresource = ALL_SUBRESOURCES, bool bFlushImmediate = false) = 0;
     virtual void TransitionBarrier(const Arc< Texture >& pTexture, eTextureLayout newState, u32 subresource = ALL_SUBRESOURCES, bool flushImmediate = false) = 0;
     virtual void UAVBarrier(const Arc< Buffer >& pBuffer, bool bFlushImmediate = false) = 0;
+    // 'pAfter' takes over memory last used by 'pBefore'; its contents become undefined
+    virtual void AliasingBarrier(const Arc< Texture >& pBefore, const Arc< Texture >& pAfter) { UNUSED(pBefore); UNUSED(pAfter); }
 
     virtual void TransitionBufferToIndirectArgs(const Arc< Buffer >& pBuffer, u64 offsetInBytes = 0, bool bFlushImmediate = true)
     {
@@ -115,29 +122,33 @@ public:
     virtual void SetComputeConstants(u32 sizeInBytes, const void* pData, u32 offsetInBytes = 0) = 0;
     virtual void SetGraphicsConstants(u32 sizeInBytes, const void* pData, u32 offsetInBytes = 0) = 0;
 
-    virtual void SetComputeDynamicUniformBuffer(const std::string& name, u32 size, const void* pData) = 0;
+    // Bindings are resolved through BindingId (pre-hashed name → pipeline slot).
+    // String literals convert at the call site, where the hash is folded at
+    // compile time; runtime names go through an explicit BindingId(std::string).
+    virtual void SetComputeDynamicUniformBuffer(const BindingId& id, u32 size, const void* pData) = 0;
+    virtual void SetGraphicsDynamicUniformBuffer(const BindingId& id, u32 size, const void* pData) = 0;
+
+    virtual void SetComputeShaderResource(const BindingId& id, Arc< Buffer > buffer) = 0;
+    virtual void SetGraphicsShaderResource(const BindingId& id, Arc< Buffer > buffer) = 0;
+    virtual void SetComputeShaderResource(const BindingId& id, Arc< Texture > texture, Arc< Sampler > samplerInCharge = nullptr) = 0;
+    virtual void SetGraphicsShaderResource(const BindingId& id, Arc< Texture > texture, Arc< Sampler > samplerInCharge = nullptr) = 0;
+
     template< typename T >
-    void SetComputeDynamicUniformBuffer(const std::string& name, const T& data)
+    void SetComputeDynamicUniformBuffer(const BindingId& id, const T& data)
     {
-        SetComputeDynamicUniformBuffer(name, sizeof(T), &data);
+        SetComputeDynamicUniformBuffer(id, sizeof(T), &data);
     }
-    virtual void SetGraphicsDynamicUniformBuffer(const std::string& name, u32 size, const void* pData) = 0;
     template< typename T >
-    void SetGraphicsDynamicUniformBuffer(const std::string& name, const T& data)
+    void SetGraphicsDynamicUniformBuffer(const BindingId& id, const T& data)
     {
-        SetGraphicsDynamicUniformBuffer(name, sizeof(T), &data);
+        SetGraphicsDynamicUniformBuffer(id, sizeof(T), &data);
     }
-    
-    virtual void SetComputeShaderResource(const std::string&, Arc< Buffer > buffer) = 0;
-    virtual void SetGraphicsShaderResource(const std::string&, Arc< Buffer > buffer) = 0;
-    virtual void SetComputeShaderResource(const std::string&, Arc< Texture > texture, Arc< Sampler > samplerInCharge = nullptr) = 0;
-    virtual void SetGraphicsShaderResource(const std::string&, Arc< Texture > texture, Arc< Sampler > samplerInCharge = nullptr) = 0;
 
     virtual void SetAccelerationStructure(const std::string& name, TopLevelAccelerationStructure& tlas) = 0;
 
-    virtual void StageDescriptor(const std::string&, Arc< Buffer > buffer, u32 offset = 0) = 0;
-    virtual void StageDescriptor(const std::string&, Arc< Texture > texture, Arc< Sampler > samplerInCharge = nullptr, u32 offset = 0) = 0;
-    virtual void StageDescriptorMip(const std::string&, Arc< Texture > texture, u32 mipLevel, Arc< Sampler > samplerInCharge = nullptr) = 0;
+    virtual void StageDescriptor(const BindingId& id, Arc< Buffer > buffer, u32 offset = 0) = 0;
+    virtual void StageDescriptor(const BindingId& id, Arc< Texture > texture, Arc< Sampler > samplerInCharge = nullptr, u32 offset = 0) = 0;
+    virtual void StageDescriptorMip(const BindingId& id, Arc< Texture > texture, u32 mipLevel, Arc< Sampler > samplerInCharge = nullptr) = 0;
 
     // === Draw Commands ===
     virtual void Draw(u32 vertexCount, u32 instanceCount = 1, u32 firstVertex = 0, u32 firstInstance = 0) = 0;
@@ -177,10 +188,12 @@ public:
     }
 
     // === GPU Profiling Markers ===
-    virtual void BeginGpuMarker(const char* name, bool bWithStats = false) = 0;
+    virtual void BeginGpuMarker(ProfileScopeId scopeId, bool bWithStats = false) = 0;
     virtual void EndGpuMarker() = 0;
 
     virtual const std::vector< GpuProfileEntry >& GetLastFrameProfile() const = 0;
+    // RenderDevice::FrameIndex() the last profile was recorded in, kNoProfileFrame before the first one
+    virtual u64 GetLastFrameProfileIndex() const = 0;
 
     virtual double GetLastFrameElapsedTime() const = 0;
     void SetRenderSequence(u64 sequence) { m_RenderSequence = sequence; }
@@ -204,7 +217,7 @@ private:
 class GpuScope
 {
 public:
-    GpuScope(CommandContext& ctx, const char* name, bool bWithStats = false) : m_Ctx(ctx) { m_Ctx.BeginGpuMarker(name, bWithStats); }
+    GpuScope(CommandContext& ctx, ProfileScopeId scopeId, bool bWithStats = false) : m_Ctx(ctx) { m_Ctx.BeginGpuMarker(scopeId, bWithStats); }
     ~GpuScope() { m_Ctx.EndGpuMarker(); }
     GpuScope(const GpuScope&) = delete;
     GpuScope& operator=(const GpuScope&) = delete;
@@ -216,5 +229,11 @@ private:
 
 #define BAAMBOO_GPU_SCOPE_CONCAT_INNER_(a, b) a##b
 #define BAAMBOO_GPU_SCOPE_CONCAT_(a, b) BAAMBOO_GPU_SCOPE_CONCAT_INNER_(a, b)
-#define BAAMBOO_GPU_SCOPE(ctx, name)       ::render::GpuScope BAAMBOO_GPU_SCOPE_CONCAT_(_gpu_scope_, __LINE__)((ctx), name, false)
-#define BAAMBOO_GPU_SCOPE_STATS(ctx, name) ::render::GpuScope BAAMBOO_GPU_SCOPE_CONCAT_(_gpu_scope_, __LINE__)((ctx), name, true)
+#define BAAMBOO_GPU_SCOPE_ID(ctx, id)       ::render::GpuScope BAAMBOO_GPU_SCOPE_CONCAT_(_gpu_scope_, __LINE__)((ctx), id, false)
+#define BAAMBOO_GPU_SCOPE_STATS_ID(ctx, id) ::render::GpuScope BAAMBOO_GPU_SCOPE_CONCAT_(_gpu_scope_, __LINE__)((ctx), id, true)
+
+// 'name' must be a string literal; it is interned once per call site
+#define BAAMBOO_GPU_SCOPE_NAME_ID_(name) \
+    static const ::render::ProfileScopeId BAAMBOO_GPU_SCOPE_CONCAT_(_gpu_scope_id_, __LINE__) = ::render::ProfileScopeRegistry::Intern("" name)
+#define BAAMBOO_GPU_SCOPE(ctx, name)       BAAMBOO_GPU_SCOPE_NAME_ID_(name); BAAMBOO_GPU_SCOPE_ID((ctx), BAAMBOO_GPU_SCOPE_CONCAT_(_gpu_scope_id_, __LINE__))
+#define BAAMBOO_GPU_SCOPE_STATS(ctx, name) BAAMBOO_GPU_SCOPE_NAME_ID_(name); BAAMBOO_GPU_SCOPE_STATS_ID((ctx), BAAMBOO_GPU_SCOPE_CONCAT_(_gpu_scope_id_, __LINE__))
@@ -1,6 +1,7 @@
 #pragma once
-#include <chrono>
-#include <string>
+#include "ProfileScope.h"
+#include "TraceRecorder.h"
+
 #include <vector>
 
 namespace render
@@ -11,13 +12,20 @@ namespace render
 // =========================================================================
 struct CpuProfileEntry
 {
-    const char* name;       // caller-owned string (string literal recommended)
-    u32         depth;      // 0 = top-level (typically the implicit "Frame" scope)
-    double      elapsedMs;  // wall-clock CPU time for this scope
+    const char*    name;                           // interned, valid for the life of the process
+    u32            depth;                          // 0 = top-level (typically the implicit "Frame" scope)
+    double         elapsedMs;                      // wall-clock CPU time for this scope
+    ProfileScopeId scopeId = kInvalidProfileScope;
 };
 
 // =========================================================================
 // CpuProfiler — per-frame, per-thread multi-scope CPU profiler.
+//
+//   Scopes are recorded by interned ID with raw tick counts; names and
+//   milliseconds are filled in once per frame when the results are
+//   published. After the first few frames the buffers stop growing, so a
+//   scope costs two tick reads and two appends, plus two events in the
+//   thread's TraceRecorder ring while tracing is on.
 // =========================================================================
 class CpuProfiler
 {
@@ -28,19 +36,35 @@ public:
         return inst;
     }
 
+    CpuProfiler()
+    {
+        m_Building.reserve(kInitialCapacity);
+        m_LastResults.reserve(kInitialCapacity);
+        m_Ticks.reserve(kInitialCapacity);
+        m_OpenStack.reserve(kInitialCapacity);
+    }
+
     void BeginFrame()
     {
+        static const ProfileScopeId s_FrameScope = ProfileScopeRegistry::Intern("Frame");
+
         if (!m_Building.empty())
         {
             // Previous frame's data becomes available as "last results".
-            m_LastResults = std::move(m_Building);
+            CpuTicks::Recalibrate();
+            for (size_t i = 0; i < m_Building.size(); ++i)
+            {
+                m_Building[i].name      = ProfileScopeRegistry::Name(m_Building[i].scopeId);
+                m_Building[i].elapsedMs = CpuTicks::ToMs(m_Ticks[i]);
+            }
+            m_LastResults.swap(m_Building); // swap, not move, so both keep their capacity
         }
         m_Building.clear();
-        m_StartTimes.clear();
+        m_Ticks.clear();
         m_OpenStack.clear();
         m_CurrentDepth = 0;
 
-        BeginMarker("Frame");
+        BeginMarker(s_FrameScope);
     }
 
     void EndFrame()
@@ -48,32 +72,28 @@ public:
         EndMarker(); // close "Frame"
     }
 
-    void BeginMarker(const char* name)
+    void BeginMarker(ProfileScopeId scopeId)
     {
-        CpuProfileEntry entry = {
-            .name      = name,
-            .depth     = m_CurrentDepth,
-            .elapsedMs = 0.0,
-        };
-        const size_t entryIdx = m_Building.size();
-        m_Building.push_back(entry);
-        m_StartTimes.push_back(std::chrono::steady_clock::now());
-        m_OpenStack.push_back(u32(entryIdx));
+        TraceRecorder::Begin(scopeId, CpuTicks::Now());
+
+        const u32 entryIdx = u32(m_Building.size());
+        m_Building.push_back({ .name = nullptr, .depth = m_CurrentDepth, .elapsedMs = 0.0, .scopeId = scopeId });
+        m_OpenStack.push_back(entryIdx);
         ++m_CurrentDepth;
+        m_Ticks.push_back(CpuTicks::Now()); // last, so the bookkeeping above isn't timed
     }
 
     void EndMarker()
     {
+        const u64 end = CpuTicks::Now();
         if (m_OpenStack.empty())
             return; // silent in release; asserts elsewhere catch mismatches
 
-        const u32  entryIdx = m_OpenStack.back();
+        const u32 entryIdx = m_OpenStack.back();
         m_OpenStack.pop_back();
 
-        const auto end   = std::chrono::steady_clock::now();
-        const auto start = m_StartTimes[entryIdx];
-        const auto delta = std::chrono::duration_cast< std::chrono::nanoseconds >(end - start).count();
-        m_Building[entryIdx].elapsedMs = double(delta) * 1e-6;
+        m_Ticks[entryIdx] = end - m_Ticks[entryIdx]; // start ticks become elapsed ticks
+        TraceRecorder::End(end);
 
         --m_CurrentDepth;
     }
@@ -81,11 +101,13 @@ public:
     const std::vector< CpuProfileEntry >& GetLastFrameProfile() const { return m_LastResults; }
 
 private:
-    std::vector< CpuProfileEntry >                         m_Building;
-    std::vector< CpuProfileEntry >                         m_LastResults;
-    std::vector< std::chrono::steady_clock::time_point >   m_StartTimes; // parallel to m_Building
-    std::vector< u32 >                                     m_OpenStack;
-    u32                                                    m_CurrentDepth = 0;
+    static constexpr size_t kInitialCapacity = 256;
+
+    std::vector< CpuProfileEntry > m_Building;
+    std::vector< CpuProfileEntry > m_LastResults;
+    std::vector< u64 >             m_Ticks;     // parallel to m_Building: start ticks while open, elapsed once closed
+    std::vector< u32 >             m_OpenStack;
+    u32                            m_CurrentDepth = 0;
 };
 
 // ================================================================================
@@ -94,7 +116,7 @@ private:
 class CpuScope
 {
 public:
-    explicit CpuScope(const char* name) { CpuProfiler::Thread().BeginMarker(name); }
+    explicit CpuScope(ProfileScopeId scopeId) { CpuProfiler::Thread().BeginMarker(scopeId); }
     ~CpuScope() { CpuProfiler::Thread().EndMarker(); }
     CpuScope(const CpuScope&) = delete;
     CpuScope& operator=(const CpuScope&) = delete;
@@ -104,12 +126,30 @@ public:
 
 #define BAAMBOO_CPU_SCOPE_CONCAT_INNER_(a, b) a##b
 #define BAAMBOO_CPU_SCOPE_CONCAT_(a, b) BAAMBOO_CPU_SCOPE_CONCAT_INNER_(a, b)
-#define BAAMBOO_CPU_SCOPE(name) ::render::CpuScope BAAMBOO_CPU_SCOPE_CONCAT_(_cpu_scope_, __LINE__)(name)
+
+// Interns a string literal once per call site ("" name rejects anything else); use the *_ID forms for runtime names
+#define BAAMBOO_PROFILE_SCOPE_ID_(name) \
+    static const ::render::ProfileScopeId BAAMBOO_CPU_SCOPE_CONCAT_(_profile_scope_id_, __LINE__) = ::render::ProfileScopeRegistry::Intern("" name)
+
+#define BAAMBOO_CPU_SCOPE_ID(id) ::render::CpuScope BAAMBOO_CPU_SCOPE_CONCAT_(_cpu_scope_, __LINE__)(id)
+#define BAAMBOO_CPU_SCOPE(name)                \
+    BAAMBOO_PROFILE_SCOPE_ID_(name);           \
+    BAAMBOO_CPU_SCOPE_ID(BAAMBOO_CPU_SCOPE_CONCAT_(_profile_scope_id_, __LINE__))
+
+// Timeline only, for threads without a CpuProfiler frame (e.g. the game thread)
+#define BAAMBOO_TRACE_SCOPE(name)              \
+    BAAMBOO_PROFILE_SCOPE_ID_(name);           \
+    ::render::TraceScope BAAMBOO_CPU_SCOPE_CONCAT_(_trace_scope_, __LINE__)(BAAMBOO_CPU_SCOPE_CONCAT_(_profile_scope_id_, __LINE__))
+
+#define BAAMBOO_PROFILE_SCOPE_ID(ctx, id) \
+    BAAMBOO_CPU_SCOPE_ID(id);             \
+    BAAMBOO_GPU_SCOPE_ID((ctx), id)
 
 #define BAAMBOO_PROFILE_SCOPE(ctx, name) \
-    BAAMBOO_CPU_SCOPE(name);             \
-    BAAMBOO_GPU_SCOPE((ctx), name)
+    BAAMBOO_PROFILE_SCOPE_ID_(name);     \
+    BAAMBOO_PROFILE_SCOPE_ID((ctx), BAAMBOO_CPU_SCOPE_CONCAT_(_profile_scope_id_, __LINE__))
 
-#define BAAMBOO_PROFILE_SCOPE_STATS(ctx, name) \
-    BAAMBOO_CPU_SCOPE(name);                   \
-    BAAMBOO_GPU_SCOPE_STATS((ctx), name)
+#define BAAMBOO_PROFILE_SCOPE_STATS(ctx, name)                                                    \
+    BAAMBOO_PROFILE_SCOPE_ID_(name);                                                              \
+    BAAMBOO_CPU_SCOPE_ID(BAAMBOO_CPU_SCOPE_CONCAT_(_profile_scope_id_, __LINE__));                \
+    BAAMBOO_GPU_SCOPE_STATS_ID((ctx), BAAMBOO_CPU_SCOPE_CONCAT_(_profile_scope_id_, __LINE__))
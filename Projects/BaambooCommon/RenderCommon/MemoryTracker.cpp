@@ -0,0 +1,162 @@
+#include "MemoryTracker.h"
+
+#include <array>
+#include <atomic>
+
+namespace render
+{
+
+namespace
+{
+
+struct TagCounters
+{
+    std::atomic< u64 > currentBytes{ 0 };
+    std::atomic< u64 > peakBytes{ 0 };
+    std::atomic< u64 > budgetBytes{ 0 };
+    std::atomic< u32 > numAllocations{ 0 };
+    std::atomic< u64 > numAllocated{ 0 };
+};
+
+// Lives in this DLL so the engine and every backend report into the same counters
+std::array< TagCounters, static_cast< size_t >(eMemoryTag::Count) >& Counters()
+{
+    static std::array< TagCounters, static_cast< size_t >(eMemoryTag::Count) > counters;
+    return counters;
+}
+
+TagCounters& CountersOf(eMemoryTag tag)
+{
+    BB_ASSERT(tag < eMemoryTag::Count, "Invalid memory tag %u", static_cast< u32 >(tag));
+    return Counters()[static_cast< size_t >(tag)];
+}
+
+// 'bMoved': allocations coming over from another tag, not new ones
+void Add(eMemoryTag tag, u64 sizeInBytes, u32 numAllocations, bool bMoved = false)
+{
+    auto& counters = CountersOf(tag);
+
+    const u64 currentBytes = counters.currentBytes.fetch_add(sizeInBytes, std::memory_order_relaxed) + sizeInBytes;
+    counters.numAllocations.fetch_add(numAllocations, std::memory_order_relaxed);
+    if (!bMoved)
+        counters.numAllocated.fetch_add(numAllocations, std::memory_order_relaxed);
+
+    u64 peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    while (currentBytes > peakBytes && !counters.peakBytes.compare_exchange_weak(peakBytes, currentBytes, std::memory_order_relaxed))
+        ;
+}
+
+void Sub(eMemoryTag tag, u64 sizeInBytes, u32 numAllocations)
+{
+    auto& counters = CountersOf(tag);
+
+    counters.currentBytes.fetch_sub(sizeInBytes, std::memory_order_relaxed);
+    counters.numAllocations.fetch_sub(numAllocations, std::memory_order_relaxed);
+}
+
+} // anonymous namespace
+
+const char* MemoryTagName(eMemoryTag tag)
+{
+    switch (tag)
+    {
+    case eMemoryTag::ModelData:       return "ModelData";
+    case eMemoryTag::AnimationClips:  return "AnimationClips";
+    case eMemoryTag::SceneRenderView: return "SceneRenderView";
+    case eMemoryTag::Textures:        return "Textures";
+    case eMemoryTag::TextureCache:    return "TextureCache";
+    case eMemoryTag::RenderTargets:   return "RenderTargets";
+    case eMemoryTag::Buffers:         return "Buffers";
+    case eMemoryTag::StaticBuffers:   return "StaticBuffers";
+    case eMemoryTag::DynamicBuffers:  return "DynamicBuffers";
+    default:                          return "Unknown";
+    }
+}
+
+void MemoryTracker::Allocate(eMemoryTag tag, u64 sizeInBytes)
+{
+    Add(tag, sizeInBytes, 1);
+}
+
+void MemoryTracker::Free(eMemoryTag tag, u64 sizeInBytes)
+{
+    Sub(tag, sizeInBytes, 1);
+}
+
+MemoryTagStats MemoryTracker::Query(eMemoryTag tag)
+{
+    const auto& counters = CountersOf(tag);
+
+    MemoryTagStats stats = {};
+    stats.currentBytes   = counters.currentBytes.load(std::memory_order_relaxed);
+    stats.peakBytes      = counters.peakBytes.load(std::memory_order_relaxed);
+    stats.budgetBytes    = counters.budgetBytes.load(std::memory_order_relaxed);
+    stats.numAllocations = counters.numAllocations.load(std::memory_order_relaxed);
+    stats.numAllocated   = counters.numAllocated.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool MemoryTracker::IsOverBudget(eMemoryTag tag)
+{
+    const auto& counters = CountersOf(tag);
+
+    const u64 budgetBytes = counters.budgetBytes.load(std::memory_order_relaxed);
+    return budgetBytes > 0 && counters.peakBytes.load(std::memory_order_relaxed) > budgetBytes;
+}
+
+void MemoryTracker::SetBudget(eMemoryTag tag, u64 budgetBytes)
+{
+    CountersOf(tag).budgetBytes.store(budgetBytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::ResetPeaks()
+{
+    for (auto& counters : Counters())
+        counters.peakBytes.store(counters.currentBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+
+//-------------------------------------------------------------------------
+// TrackedMemory
+//-------------------------------------------------------------------------
+void TrackedMemory::Add(u64 sizeInBytes)
+{
+    render::Add(m_Tag, sizeInBytes, 1);
+
+    m_SizeInBytes += sizeInBytes;
+    ++m_NumAllocations;
+}
+
+void TrackedMemory::Remove(u64 sizeInBytes)
+{
+    BB_ASSERT(m_NumAllocations > 0 && sizeInBytes <= m_SizeInBytes, "Removing more from '%s' than was added", MemoryTagName(m_Tag));
+    Sub(m_Tag, sizeInBytes, 1);
+
+    m_SizeInBytes -= sizeInBytes;
+    --m_NumAllocations;
+}
+
+void TrackedMemory::Clear()
+{
+    if (m_NumAllocations == 0)
+        return;
+
+    Sub(m_Tag, m_SizeInBytes, m_NumAllocations);
+    m_SizeInBytes    = 0;
+    m_NumAllocations = 0;
+}
+
+void TrackedMemory::Retag(eMemoryTag tag)
+{
+    if (tag == m_Tag)
+        return;
+
+    if (m_NumAllocations > 0)
+    {
+        Sub(m_Tag, m_SizeInBytes, m_NumAllocations);
+        render::Add(tag, m_SizeInBytes, m_NumAllocations, true);
+    }
+    m_Tag = tag;
+}
+
+} // namespace render
@@ -0,0 +1,103 @@
+#pragma once
+#include "Defines.h"
+#include "Primitives.h"
+
+namespace render
+{
+
+enum class eMemoryTag : u8
+{
+    // CPU
+    ModelData,       // ModelLoader meshes, materials and animation imports
+    AnimationClips,  // scene clips, raw or compressed
+    SceneRenderView, // the render view last built by the game thread
+
+    // GPU
+    Textures,        // sampled textures not owned by a scene cache (defaults, environment maps, ...)
+    TextureCache,    // material textures held by the scene resource's texture cache
+    RenderTargets,   // textures the GPU writes (attachments, storage), incl. aliased transient memory
+    Buffers,         // buffers not owned by an allocator
+    StaticBuffers,   // StaticBufferAllocator slabs
+    DynamicBuffers,  // DynamicBufferAllocator pages
+
+    Count
+};
+
+[[nodiscard]]
+BAAMBOO_API const char* MemoryTagName(eMemoryTag tag);
+[[nodiscard]]
+inline bool IsGpuMemoryTag(eMemoryTag tag) { return tag >= eMemoryTag::Textures; }
+
+struct MemoryTagStats
+{
+    u64 currentBytes   = 0;
+    u64 peakBytes      = 0;
+    u64 budgetBytes    = 0; // 0 = no budget
+    u32 numAllocations = 0; // live
+    u64 numAllocated   = 0; // since start
+};
+
+// One GPU memory heap as the driver reports it (VMA / D3D12MA budget queries)
+struct MemoryHeapBudget
+{
+    bool bDeviceLocal = false;
+    u64  usageBytes   = 0; // whole process
+    u64  budgetBytes  = 0; // how much the process can use before the OS starts evicting
+};
+
+// =========================================================================
+// MemoryTracker — bytes, peaks and allocation counts per memory tag.
+//
+//   Allocation sites report what they allocate and free, so the counters
+//   are the engine's own view of where memory goes; the driver's view of
+//   whole heaps comes from RenderDevice::QueryMemoryBudgets(). A tag can be
+//   given a budget, which the profiler UI and benchmark runs check the
+//   tag's peak against. Counters are atomics, any thread may report.
+// =========================================================================
+class BAAMBOO_API MemoryTracker
+{
+public:
+    static void Allocate(eMemoryTag tag, u64 sizeInBytes);
+    static void Free(eMemoryTag tag, u64 sizeInBytes);
+
+    [[nodiscard]]
+    static MemoryTagStats Query(eMemoryTag tag);
+    [[nodiscard]]
+    static bool IsOverBudget(eMemoryTag tag);
+
+    static void SetBudget(eMemoryTag tag, u64 budgetBytes);
+    // Restarts every tag's peak at its current bytes
+    static void ResetPeaks();
+};
+
+// ================================================================================
+// TrackedMemory — what one owner (a resource, a cache, a loader) has reported
+// under its tag; freed when the owner goes away.
+// ================================================================================
+class BAAMBOO_API TrackedMemory
+{
+public:
+    explicit TrackedMemory(eMemoryTag tag) : m_Tag(tag) {}
+    ~TrackedMemory() { Clear(); }
+
+    TrackedMemory(const TrackedMemory&) = delete;
+    TrackedMemory& operator=(const TrackedMemory&) = delete;
+
+    void Add(u64 sizeInBytes);
+    void Remove(u64 sizeInBytes);
+    void Clear();
+    // Moves what is outstanding to 'tag'
+    void Retag(eMemoryTag tag);
+
+    [[nodiscard]]
+    eMemoryTag Tag() const { return m_Tag; }
+    [[nodiscard]]
+    u64 SizeInBytes() const { return m_SizeInBytes; }
+
+private:
+    eMemoryTag m_Tag;
+    u64        m_SizeInBytes    = 0;
+    u32        m_NumAllocations = 0;
+};
+
+} // namespace render
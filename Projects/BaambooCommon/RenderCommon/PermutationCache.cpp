@@ -0,0 +1,233 @@
+#include "PermutationCache.h"
+#include "PipelineBuildQueue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace render
+{
+
+namespace
+{
+
+struct RegistryState
+{
+    std::mutex mutex;
+    bool       bLoaded = false;
+    bool       bDirty  = false;
+
+    ShaderPermutationList                   recorded;
+    std::vector< ComputePermutationCache* > caches;
+};
+
+// Lives in this DLL so every node and the engine's report share one list
+RegistryState& Registry()
+{
+    static RegistryState state;
+    return state;
+}
+
+u64 HashValues(const u32* pValues, size_t count)
+{
+    return HashBindingName(reinterpret_cast< const char* >(pValues), count * sizeof(u32));
+}
+
+std::string DescribeFeatures(const std::vector< ShaderFeature >& features)
+{
+    std::string description;
+    for (const auto& feature : features)
+    {
+        if (feature.value == 0)
+            continue;
+
+        if (!description.empty())
+            description += ' ';
+        description += feature.name + "=" + std::to_string(feature.value);
+    }
+    return description;
+}
+
+} // anonymous namespace
+
+ComputePermutationCache::ComputePermutationCache(RenderDevice& rd, const char* name, Shader::CreationInfo&& baseInfo, std::vector< Feature >&& features)
+    : m_RenderDevice(rd)
+    , m_Name(name)
+    , m_BaseInfo(std::move(baseInfo))
+    , m_Features(std::move(features))
+{
+    BB_ASSERT(m_BaseInfo.stage == eShaderStage::Compute, "ComputePermutationCache '%s' needs a compute shader", m_Name.c_str());
+    BB_ASSERT(m_BaseInfo.features.empty(), "ComputePermutationCache '%s' declares its features itself", m_Name.c_str());
+
+    std::vector< ShaderPermutationList::Entry > recorded;
+    {
+        auto& registry = Registry();
+        std::lock_guard< std::mutex > lock(registry.mutex);
+        if (!registry.bLoaded)
+        {
+            registry.recorded.Load(GetShaderPermutationListPath());
+            registry.bLoaded = true;
+        }
+
+        for (const auto& entry : registry.recorded.Entries())
+        {
+            if (entry.filename == m_BaseInfo.filename)
+                recorded.push_back(entry);
+        }
+        registry.caches.push_back(this);
+    }
+
+    // **
+    // Pre-warm the default variant and every recorded one
+    // **
+    std::lock_guard< std::mutex > lock(m_Mutex);
+
+    std::vector< ShaderFeature > defaults;
+    for (const auto& feature : m_Features)
+        defaults.push_back({ feature.name, feature.constantId, 0 });
+    Build(std::vector< ShaderFeature >(defaults), true);
+
+    for (const auto& entry : recorded)
+    {
+        std::vector< ShaderFeature > permutation = defaults;
+
+        bool bKnown = true;
+        for (const auto& listed : entry.features)
+        {
+            auto iter = std::find_if(permutation.begin(), permutation.end(),
+                [&listed](const ShaderFeature& feature) { return feature.name == listed.name; });
+            if (iter == permutation.end())
+            {
+                // The shader dropped or renamed the feature since it was recorded
+                bKnown = false;
+                break;
+            }
+            iter->value = listed.value;
+        }
+
+        if (bKnown)
+            Build(std::move(permutation), true);
+    }
+}
+
+ComputePermutationCache::~ComputePermutationCache()
+{
+    auto& registry = Registry();
+    std::lock_guard< std::mutex > lock(registry.mutex);
+    registry.caches.erase(std::remove(registry.caches.begin(), registry.caches.end(), this), registry.caches.end());
+}
+
+ComputePipeline* ComputePermutationCache::Get(std::initializer_list< u32 > values)
+{
+    BB_ASSERT(values.size() == m_Features.size(), "ComputePermutationCache '%s' expects %zu feature values", m_Name.c_str(), m_Features.size());
+
+    std::vector< ShaderFeature > added;
+    ComputePipeline*             pPipeline = nullptr;
+    {
+        std::lock_guard< std::mutex > lock(m_Mutex);
+
+        auto iter = m_Variants.find(HashValues(values.begin(), values.size()));
+        Variant* pVariant = iter != m_Variants.end() ? &iter->second : nullptr;
+        if (!pVariant)
+        {
+            std::vector< ShaderFeature > features;
+            features.reserve(m_Features.size());
+
+            const u32* pValue = values.begin();
+            for (const auto& feature : m_Features)
+            {
+                BB_ASSERT(*pValue < feature.numValues, "ComputePermutationCache '%s': %s = %u is outside its declared %u values",
+                    m_Name.c_str(), feature.name.c_str(), *pValue, feature.numValues);
+                features.push_back({ feature.name, feature.constantId, *pValue++ });
+            }
+
+            pVariant = &Build(std::move(features), false);
+            added    = pVariant->features;
+        }
+
+        ++pVariant->numUses;
+        pPipeline = pVariant->pPipeline.get();
+    }
+
+    // Recorded outside the cache lock; the report takes the registry lock first
+    if (!added.empty())
+    {
+        auto& registry = Registry();
+        std::lock_guard< std::mutex > lock(registry.mutex);
+        registry.bDirty |= registry.recorded.Add(m_BaseInfo.filename, added);
+    }
+    return pPipeline;
+}
+
+ComputePermutationCache::Variant& ComputePermutationCache::Build(std::vector< ShaderFeature >&& features, bool bPrewarm)
+{
+    std::vector< u32 > values;
+    values.reserve(features.size());
+    for (const auto& feature : features)
+        values.push_back(feature.value);
+
+    // Distinct pipeline names, so the build queue compiles variants on separate workers
+    const std::string suffix = GetPermutationSuffix(features);
+    const std::string pipelineName = m_Name + suffix;
+    const std::string shaderName   = m_BaseInfo.filename + suffix;
+
+    Shader::CreationInfo info = m_BaseInfo;
+    info.features = features;
+
+    const bool bTimed = !bPrewarm && !PipelineBuildQueue::IsRecording();
+    const auto start  = std::chrono::steady_clock::now();
+
+    auto pPipeline = ComputePipeline::Create(m_RenderDevice, pipelineName.c_str());
+    pPipeline->SetComputeShader(Shader::Create(m_RenderDevice, shaderName.c_str(), std::move(info))).Build();
+
+    Variant& variant = m_Variants[HashValues(values.data(), values.size())];
+    variant.features   = std::move(features);
+    variant.pPipeline  = std::move(pPipeline);
+    variant.bPrewarmed = bPrewarm;
+    if (bTimed)
+    {
+        variant.buildMs = std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - start).count();
+        printf("[Permutation] built '%s' on first use in %.2f ms\n", pipelineName.c_str(), variant.buildMs);
+    }
+    m_Order.push_back(&variant);
+    return variant;
+}
+
+std::vector< ComputePermutationCache::Usage > ComputePermutationCache::GetUsageReport()
+{
+    std::vector< Usage > report;
+
+    auto& registry = Registry();
+    std::lock_guard< std::mutex > registryLock(registry.mutex);
+    for (const ComputePermutationCache* pCache : registry.caches)
+    {
+        std::lock_guard< std::mutex > lock(pCache->m_Mutex);
+        for (const Variant* pVariant : pCache->m_Order)
+        {
+            Usage& usage = report.emplace_back();
+            usage.cacheName   = pCache->m_Name;
+            usage.permutation = DescribeFeatures(pVariant->features);
+            usage.numUses     = pVariant->numUses;
+            usage.buildMs     = pVariant->buildMs;
+            usage.bPrewarmed  = pVariant->bPrewarmed;
+        }
+    }
+    return report;
+}
+
+void ComputePermutationCache::SaveRecordedPermutations()
+{
+    auto& registry = Registry();
+    std::lock_guard< std::mutex > lock(registry.mutex);
+    if (!registry.bDirty)
+        return;
+
+    if (registry.recorded.Save(GetShaderPermutationListPath()))
+    {
+        registry.bDirty = false;
+        printf("[Permutation] recorded %zu permutations to '%s'\n",
+            registry.recorded.Entries().size(), GetShaderPermutationListPath().string().c_str());
+    }
+}
+
+} // namespace render
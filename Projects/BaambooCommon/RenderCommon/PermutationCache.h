@@ -0,0 +1,78 @@
+#pragma once
+#include "RenderResources.h"
+
+#include <initializer_list>
+#include <mutex>
+#include <unordered_map>
+
+namespace render
+{
+
+// =========================================================================
+// ComputePermutationCache — one compute shader, one pipeline per variant.
+//
+//   The cache declares the shader's features once; a node then asks for
+//   the variant matching this frame's feature values instead of branching
+//   on them in the shader or keeping a pipeline per combination by hand.
+//   Variants listed in the recorded permutation list are built up front
+//   (on the build queue's workers when the cache is made during scene
+//   load), anything else is built the first time it's asked for and
+//   recorded for the next run.
+// =========================================================================
+class BAAMBOO_API ComputePermutationCache
+{
+public:
+    struct Feature
+    {
+        std::string name;
+        u32         constantId = 0;
+        u32         numValues  = 2; // must match the shader's '// @permutation' declaration
+    };
+
+    struct Usage
+    {
+        std::string cacheName;
+        std::string permutation; // "" for the default one
+        u64         numUses    = 0;
+        double      buildMs    = 0.0; // lazy builds only; pre-warmed ones are timed by the build queue
+        bool        bPrewarmed = false;
+    };
+
+    ComputePermutationCache(RenderDevice& rd, const char* name, Shader::CreationInfo&& baseInfo, std::vector< Feature >&& features);
+    ~ComputePermutationCache();
+
+    // One value per declared feature, in declaration order
+    [[nodiscard]]
+    ComputePipeline* Get(std::initializer_list< u32 > values);
+
+    // Every live cache's variants, in cache creation order
+    [[nodiscard]]
+    static std::vector< Usage > GetUsageReport();
+    // Writes the permutation list if any variant was added since it was loaded
+    static void SaveRecordedPermutations();
+
+private:
+    struct Variant
+    {
+        std::vector< ShaderFeature > features;
+        Box< ComputePipeline >       pPipeline;
+
+        u64    numUses    = 0;
+        double buildMs    = 0.0;
+        bool   bPrewarmed = false;
+    };
+
+    Variant& Build(std::vector< ShaderFeature >&& features, bool bPrewarm);
+
+    RenderDevice&        m_RenderDevice;
+    std::string          m_Name;
+    Shader::CreationInfo m_BaseInfo;
+
+    std::vector< Feature > m_Features;
+
+    mutable std::mutex                 m_Mutex;
+    std::unordered_map< u64, Variant > m_Variants; // by hash of the feature values
+    std::vector< const Variant* >      m_Order;    // build order, for the report
+};
+
+} // namespace render
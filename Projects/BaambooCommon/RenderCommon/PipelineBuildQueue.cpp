@@ -0,0 +1,242 @@
+#include "PipelineBuildQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace render
+{
+
+namespace
+{
+
+struct PendingJob
+{
+    const void*             pOwner = nullptr;
+    std::string             name;
+    std::function< void() > job;
+};
+
+struct QueueState
+{
+    std::mutex              mutex;
+    std::condition_variable jobDone;
+    bool                    bRecording = false;
+    bool                    bFlushing  = false;
+
+    std::vector< PendingJob > pending;
+
+    // While a Flush() runs: owners whose jobs must no longer start, and jobs running per owner
+    std::unordered_set< const void* >      cancelled;
+    std::unordered_map< const void*, u32 > running;
+
+    std::vector< PipelineBuildQueue::Record > records;
+    PipelineBuildQueue::Stats                 stats;
+};
+
+// Lives in this DLL so the engine and every backend share one queue
+QueueState& State()
+{
+    static QueueState state;
+    return state;
+}
+
+double RunTimed(const std::function< void() >& job)
+{
+    const auto start = std::chrono::steady_clock::now();
+    job();
+    return std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - start).count();
+}
+
+// On-demand compiles keep arriving after load, so only the slowest ones are kept
+void AddRecord(QueueState& state, const std::string& name, double elapsedMs)
+{
+    auto& records = state.records;
+    if (records.size() == PipelineBuildQueue::kMaxRecords)
+    {
+        if (elapsedMs <= records.back().elapsedMs)
+            return;
+        records.pop_back();
+    }
+
+    const auto iter = std::upper_bound(records.begin(), records.end(), elapsedMs,
+        [](double elapsed, const PipelineBuildQueue::Record& record) { return elapsed > record.elapsedMs; });
+    records.insert(iter, { name, elapsedMs });
+}
+
+} // anonymous namespace
+
+void PipelineBuildQueue::Begin()
+{
+    auto& state = State();
+    std::lock_guard< std::mutex > lock(state.mutex);
+    BB_ASSERT(!state.bRecording, "PipelineBuildQueue::Begin called twice without a Flush");
+
+    state.bRecording = true;
+    state.records.clear();
+    state.stats = {};
+}
+
+void PipelineBuildQueue::Flush()
+{
+    auto& state = State();
+
+    std::vector< PendingJob > pending;
+    {
+        std::lock_guard< std::mutex > lock(state.mutex);
+        state.bRecording = false;
+        pending.swap(state.pending);
+        state.bFlushing = true;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // negative: cancelled before it started
+    std::vector< double > elapsed(pending.size(), -1.0);
+    const u32 numWorkers =
+        std::min(static_cast< u32 >(pending.size()), std::max(1u, std::thread::hardware_concurrency()));
+
+    // Driver compiles are coarse and few, so plain threads pulling from a shared cursor are enough
+    std::atomic< u32 > next{ 0 };
+    std::exception_ptr firstError;
+    std::mutex         errorMutex;
+    auto worker = [&]()
+    {
+        for (u32 i = next.fetch_add(1); i < pending.size(); i = next.fetch_add(1))
+        {
+            const void* pOwner = pending[i].pOwner;
+            {
+                std::lock_guard< std::mutex > lock(state.mutex);
+                if (state.cancelled.contains(pOwner))
+                    continue;
+                ++state.running[pOwner];
+            }
+
+            try
+            {
+                elapsed[i] = RunTimed(pending[i].job);
+            }
+            catch (...)
+            {
+                std::lock_guard< std::mutex > lock(errorMutex);
+                if (!firstError)
+                    firstError = std::current_exception();
+            }
+
+            {
+                std::lock_guard< std::mutex > lock(state.mutex);
+                if (--state.running[pOwner] == 0)
+                    state.running.erase(pOwner);
+            }
+            state.jobDone.notify_all();
+        }
+    };
+
+    std::vector< std::thread > threads;
+    if (numWorkers > 1)
+    {
+        threads.reserve(numWorkers - 1);
+        for (u32 i = 1; i < numWorkers; ++i)
+            threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+        thread.join();
+
+    const double wallMs = std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - start).count();
+
+    {
+        std::lock_guard< std::mutex > lock(state.mutex);
+        state.bFlushing = false;
+        state.cancelled.clear();
+        for (u32 i = 0; i < pending.size(); ++i)
+        {
+            if (elapsed[i] < 0.0)
+                continue;
+
+            AddRecord(state, pending[i].name, elapsed[i]);
+            ++state.stats.numPipelines;
+            state.stats.serialMs += elapsed[i];
+        }
+        state.stats.numWorkers = numWorkers;
+        state.stats.elapsedMs    = wallMs;
+
+        printf("[Pipeline] built %zu pipelines on %u workers in %.2f ms (%.2f ms serial)\n",
+            pending.size(), numWorkers, wallMs, state.stats.serialMs);
+    }
+
+    if (firstError)
+        std::rethrow_exception(firstError);
+}
+
+bool PipelineBuildQueue::IsRecording()
+{
+    auto& state = State();
+    std::lock_guard< std::mutex > lock(state.mutex);
+    return state.bRecording;
+}
+
+void PipelineBuildQueue::Submit(const void* pOwner, const std::string& name, std::function< void() >&& job)
+{
+    auto& state = State();
+    {
+        std::lock_guard< std::mutex > lock(state.mutex);
+        if (state.bRecording)
+        {
+            // a pipeline rebuilt before the flush only needs its latest compile
+            const auto iter = std::find_if(state.pending.begin(), state.pending.end(),
+                [pOwner](const PendingJob& pending) { return pending.pOwner == pOwner; });
+            if (iter != state.pending.end())
+                *iter = { pOwner, name, std::move(job) };
+            else
+                state.pending.push_back({ pOwner, name, std::move(job) });
+            return;
+        }
+    }
+
+    const double elapsedMs = RunTimed(job);
+
+    std::lock_guard< std::mutex > lock(state.mutex);
+    AddRecord(state, name, elapsedMs);
+    ++state.stats.numPipelines;
+    state.stats.serialMs += elapsedMs;
+}
+
+void PipelineBuildQueue::Cancel(const void* pOwner)
+{
+    auto& state = State();
+    std::unique_lock< std::mutex > lock(state.mutex);
+
+    // still recording: the jobs never left the queue
+    std::erase_if(state.pending, [pOwner](const PendingJob& job) { return job.pOwner == pOwner; });
+
+    // flushing: keep the rest from starting and let a running one finish with the owner alive
+    if (state.bFlushing)
+    {
+        state.cancelled.insert(pOwner);
+        state.jobDone.wait(lock, [&]() { return !state.running.contains(pOwner); });
+    }
+}
+
+std::vector< PipelineBuildQueue::Record > PipelineBuildQueue::GetRecords()
+{
+    auto& state = State();
+    std::lock_guard< std::mutex > lock(state.mutex);
+    return state.records;
+}
+
+PipelineBuildQueue::Stats PipelineBuildQueue::GetStats()
+{
+    auto& state = State();
+    std::lock_guard< std::mutex > lock(state.mutex);
+    return state.stats;
+}
+
+} // namespace render
@@ -0,0 +1,103 @@
+#pragma once
+#include "Defines.h"
+#include "Primitives.h"
+
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace render
+{
+
+// =========================================================================
+// PipelineBuildQueue — batches driver pipeline compiles at load time.
+//
+//   Between Begin() and Flush(), a backend's Build() still does its
+//   order-dependent setup (reflection, layouts, descriptor sets) on the
+//   calling thread but hands the driver compile to Submit(), which only
+//   queues it. Flush() then compiles everything queued on a pool of
+//   worker threads. Outside that window Submit() compiles immediately,
+//   so late or on-demand pipelines behave as before.
+//
+//   A job belongs to the pipeline that submitted it, which must Cancel()
+//   in its destructor: the job captures the pipeline itself. Submitting
+//   again before the flush replaces the owner's queued job.
+// =========================================================================
+class BAAMBOO_API PipelineBuildQueue
+{
+public:
+    struct Record
+    {
+        std::string name;
+        double      elapsedMs = 0.0;
+    };
+
+    struct Stats
+    {
+        u32    numPipelines = 0;
+        u32    numWorkers   = 0;
+        double serialMs     = 0.0; // sum of per-pipeline compile times
+        double elapsedMs    = 0.0; // wall time of the last Flush()
+    };
+
+    static void Begin();
+    static void Flush();
+
+    [[nodiscard]]
+    static bool IsRecording();
+
+    // Queues 'job' while recording, runs it on the calling thread otherwise
+    static void Submit(const void* pOwner, const std::string& name, std::function< void() >&& job);
+    // Drops the owner's queued jobs and waits for any of them a Flush() is running
+    static void Cancel(const void* pOwner);
+
+    // The slowest kMaxRecords compiles since the last Begin(), slowest first
+    static constexpr u32 kMaxRecords = 64;
+    [[nodiscard]]
+    static std::vector< Record > GetRecords();
+    [[nodiscard]]
+    static Stats GetStats();
+};
+
+// Records pipeline compiles for its lifetime. Flush() compiles them and rethrows a failed
+// compile; a scope left without Flush() (early return, exception) flushes on destruction
+// and only reports errors, since the destructor must not throw.
+class PipelineBuildScope
+{
+public:
+    PipelineBuildScope() { PipelineBuildQueue::Begin(); }
+    ~PipelineBuildScope()
+    {
+        if (m_bFlushed)
+            return;
+
+        try
+        {
+            PipelineBuildQueue::Flush();
+        }
+        catch (const std::exception& e)
+        {
+            printf("[Pipeline] compile failed while unwinding: %s\n", e.what());
+        }
+        catch (...)
+        {
+            printf("[Pipeline] compile failed while unwinding\n");
+        }
+    }
+
+    PipelineBuildScope(const PipelineBuildScope&) = delete;
+    PipelineBuildScope& operator=(const PipelineBuildScope&) = delete;
+
+    void Flush()
+    {
+        m_bFlushed = true;
+        PipelineBuildQueue::Flush();
+    }
+
+private:
+    bool m_bFlushed = false;
+};
+
+} // namespace render
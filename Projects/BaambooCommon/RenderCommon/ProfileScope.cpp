@@ -0,0 +1,111 @@
+#include "ProfileScope.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace render
+{
+
+namespace
+{
+
+struct RegistryState
+{
+    std::mutex mutex;
+
+    std::unordered_map< std::string, ProfileScopeId >            ids;
+    std::array< std::string, ProfileScopeRegistry::kMaxScopes > names; // written once per slot, before 'count' publishes it
+    std::atomic< u32 >                                           count{ 0 };
+};
+
+// Lives in this DLL so the engine and every backend agree on the IDs
+RegistryState& Registry()
+{
+    static RegistryState state;
+    return state;
+}
+
+struct Calibration
+{
+    using Clock = std::chrono::steady_clock;
+
+    u64               originTicks = 0;
+    Clock::time_point originTime;
+
+    std::atomic< double > msPerTick{ 0.0 };
+
+    Calibration()
+    {
+        // A first estimate good enough for the opening frames; Recalibrate() converges from here
+        originTicks = CpuTicks::Now();
+        originTime  = Clock::now();
+
+        Clock::time_point now = originTime;
+        while (now - originTime < std::chrono::milliseconds(1))
+            now = Clock::now();
+
+        const u64 ticks = CpuTicks::Now() - originTicks;
+        msPerTick.store(std::chrono::duration< double, std::milli >(now - originTime).count() / double(ticks > 0 ? ticks : 1));
+    }
+};
+
+Calibration& GetCalibration()
+{
+    static Calibration calibration;
+    return calibration;
+}
+
+} // anonymous namespace
+
+ProfileScopeId ProfileScopeRegistry::Intern(const char* name)
+{
+    auto& registry = Registry();
+    std::lock_guard< std::mutex > lock(registry.mutex);
+
+    const std::string key = name ? name : "(null)";
+    auto iter = registry.ids.find(key);
+    if (iter != registry.ids.end())
+        return iter->second;
+
+    const u32 id = registry.count.load(std::memory_order_relaxed);
+    BB_ASSERT(id < kMaxScopes, "ProfileScopeRegistry is full (%u scopes); raise kMaxScopes", kMaxScopes);
+
+    registry.names[id] = key;
+    registry.ids.emplace(key, id);
+    registry.count.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+const char* ProfileScopeRegistry::Name(ProfileScopeId id)
+{
+    auto& registry = Registry();
+    return id < registry.count.load(std::memory_order_acquire) ? registry.names[id].c_str() : "(unknown)";
+}
+
+u32 ProfileScopeRegistry::Count()
+{
+    return Registry().count.load(std::memory_order_acquire);
+}
+
+double CpuTicks::ToMs(u64 ticks)
+{
+    return double(ticks) * GetCalibration().msPerTick.load(std::memory_order_relaxed);
+}
+
+void CpuTicks::Recalibrate()
+{
+    auto& calibration = GetCalibration();
+
+    // Measured over the whole run so far, so the estimate only gets tighter
+    const double elapsedMs = std::chrono::duration< double, std::milli >(Calibration::Clock::now() - calibration.originTime).count();
+    const u64    ticks     = Now() - calibration.originTicks;
+    if (elapsedMs >= 100.0 && ticks > 0)
+        calibration.msPerTick.store(elapsedMs / double(ticks), std::memory_order_relaxed);
+}
+
+} // namespace render
@@ -0,0 +1,70 @@
+#pragma once
+#include "Defines.h"
+#include "Primitives.h"
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define BAAMBOO_HAS_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BAAMBOO_HAS_RDTSC 1
+#else
+#include <chrono>
+#define BAAMBOO_HAS_RDTSC 0
+#endif
+
+namespace render
+{
+
+using ProfileScopeId = u32;
+constexpr ProfileScopeId kInvalidProfileScope = ~0u;
+
+// =========================================================================
+// ProfileScopeRegistry — profiler scope names interned to dense IDs.
+//
+//   A scope's name is looked up once (the profile macros keep the ID in a
+//   function-local static, render nodes keep theirs as a member); from then
+//   on profilers record and aggregate by ID, and stats live in flat arrays
+//   indexed by it. Interned names are never freed, so the pointer returned
+//   by Name() stays valid for the life of the process.
+// =========================================================================
+class BAAMBOO_API ProfileScopeRegistry
+{
+public:
+    static constexpr u32 kMaxScopes = 4096;
+
+    // Thread-safe; the same name always gets the same ID
+    static ProfileScopeId Intern(const char* name);
+
+    [[nodiscard]]
+    static const char* Name(ProfileScopeId id);
+    // IDs are [0, Count())
+    [[nodiscard]]
+    static u32 Count();
+};
+
+// =========================================================================
+// CpuTicks — the profilers' clock: the TSC where there is one, otherwise
+// steady_clock nanoseconds. Ticks are converted to milliseconds only when
+// a frame's results are published, never inside a scope.
+// =========================================================================
+class BAAMBOO_API CpuTicks
+{
+public:
+    static u64 Now()
+    {
+#if BAAMBOO_HAS_RDTSC
+        return __rdtsc();
+#else
+        return static_cast< u64 >(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    [[nodiscard]]
+    static double ToMs(u64 ticks);
+
+    // Refines the tick rate against steady_clock; cheap, meant to be called once per frame
+    static void Recalibrate();
+};
+
+} // namespace render
@@ -1,5 +1,6 @@
 #pragma once
 #include "RenderResources.h"
+#include "MemoryTracker.h"
 
 namespace render 
 {
@@ -21,6 +22,10 @@ public:
 
     virtual Arc< RenderTarget > CreateEmptyRenderTarget(const char* name = "") = 0;
 
+    // Rebinds each group of transient textures onto one shared allocation. The render graph
+    // guarantees the members of a group are never alive at the same time within a frame.
+    virtual void AliasTransientTextures(const std::vector< std::vector< Arc< Texture > > >& groups) { UNUSED(groups); }
+
     virtual Arc< Sampler > CreateSampler(const char* name, Sampler::CreationInfo&& info) = 0;
 
     virtual Arc< Shader > CreateShader(const char* name, Shader::CreationInfo&& info) = 0;
@@ -39,7 +44,13 @@ public:
 
     virtual bool SaveTextureToEXR(const Arc< Texture >& pTexture, const char* path) = 0;
 
+    // One entry per GPU memory heap, as the driver reports it; empty when the backend can't tell
+    virtual void QueryMemoryBudgets(std::vector< MemoryHeapBudget >& outBudgets) const { outBudgets.clear(); }
+
     inline u32 ContextIndex() const { return m_ContextIndex; }
+    // Frames submitted so far; stamps per-frame results of different queues so they can be paired up
+    inline u64 FrameIndex() const { return m_FrameIndex; }
+    void AdvanceFrame() { ++m_FrameIndex; }
     inline u32 NumContexts() const { return m_NumContexts; }
     void SetNumContexts(u32 num) { m_NumContexts = num; }
 
@@ -53,6 +64,7 @@ public:
 protected:
     u32 m_NumContexts  = 0;
     u32 m_ContextIndex = 0;
+    u64 m_FrameIndex   = 0;
 
     u32 m_WindowWidth  = 0;
     u32 m_WindowHeight = 0;
@@ -0,0 +1,89 @@
+#pragma once
+#include "BindingId.h"
+#include "RenderResources.h"
+
+#include <vector>
+
+namespace render
+{
+
+enum class eGraphAccess : u8
+{
+    ShaderRead,      // sampled / read-only storage
+    ShaderWrite,     // storage image or buffer write
+    ColorAttachment,
+    DepthAttachment,
+};
+
+struct GraphResourceUsage
+{
+    BindingId      id;
+    eGraphAccess   access = eGraphAccess::ShaderRead;
+    ePipelineStage stage  = ePipelineStage::ComputeShader;
+
+    // set by the writer only; readers resolve to the latest writer's resource
+    Arc< Texture > pTexture;
+    Arc< Buffer >  pBuffer;
+};
+
+// =========================================================================
+// RenderGraphBuilder — what one node reads and writes in a frame.
+//
+//   Ids name logical resources shared across the graph ("SceneColor"), not
+//   shader bindings. A write replaces the resource's contents, so a node that
+//   only updates part of it declares a read of the same id as well. Every node
+//   touching a declared id must declare it; nodes that declare nothing run as
+//   before, in place, with their own barriers.
+// =========================================================================
+class RenderGraphBuilder
+{
+public:
+    void Read(const BindingId& id, ePipelineStage stage)
+    {
+        for (auto& usage : m_Reads)
+        {
+            if (usage.id == id)
+            {
+                usage.stage = usage.stage | stage;
+                return;
+            }
+        }
+        m_Reads.push_back({ .id = id, .access = eGraphAccess::ShaderRead, .stage = stage });
+    }
+
+    void Write(const BindingId& id, Arc< Texture > pTexture, eGraphAccess access, ePipelineStage stage)
+    {
+        BB_ASSERT(access != eGraphAccess::ShaderRead, "Write of '%s' declared with read access!", id.name);
+        m_Writes.push_back({ .id = id, .access = access, .stage = stage, .pTexture = std::move(pTexture) });
+    }
+
+    void Write(const BindingId& id, Arc< Buffer > pBuffer, ePipelineStage stage)
+    {
+        m_Writes.push_back({ .id = id, .access = eGraphAccess::ShaderWrite, .stage = stage, .pBuffer = std::move(pBuffer) });
+    }
+
+    // transient texture used only inside this node; it may share memory with other transients
+    void Scratch(Arc< Texture > pTexture)
+    {
+        BB_ASSERT(pTexture && pTexture->IsTransient(), "Scratch texture must be created with bTransient!");
+        m_Scratch.push_back(std::move(pTexture));
+    }
+
+    // keeps the node alive even when none of its outputs are consumed (readback, present, ...)
+    void SetSideEffects() { m_bSideEffects = true; }
+
+    const std::vector< GraphResourceUsage >& GetReads() const { return m_Reads; }
+    const std::vector< GraphResourceUsage >& GetWrites() const { return m_Writes; }
+    const std::vector< Arc< Texture > >& GetScratch() const { return m_Scratch; }
+    bool HasSideEffects() const { return m_bSideEffects; }
+    bool IsEmpty() const { return m_Reads.empty() && m_Writes.empty() && !m_bSideEffects; }
+
+private:
+    std::vector< GraphResourceUsage > m_Reads;
+    std::vector< GraphResourceUsage > m_Writes;
+    std::vector< Arc< Texture > >     m_Scratch;
+
+    bool m_bSideEffects = false;
+};
+
+} // namespace render
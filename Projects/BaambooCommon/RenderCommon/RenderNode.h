@@ -1,5 +1,7 @@
 #pragma once
 #include "RenderResources.h"
+#include "RenderGraphBuilder.h"
+#include "ProfileScope.h"
 
 #include <unordered_map>
 
@@ -12,7 +14,7 @@ class RenderNode : public ArcBase
 {
 public:
     RenderNode(RenderDevice& rd, const std::string& name) 
-        : m_RenderDevice(rd), m_Name(name), m_bEnabled(true) {}
+        : m_RenderDevice(rd), m_Name(name), m_ProfileScopeId(ProfileScopeRegistry::Intern(name.c_str())), m_bEnabled(true) {}
     virtual ~RenderNode() = default;
 
     virtual void Apply(CommandContext& context, const SceneRenderView& renderView) = 0;
@@ -21,30 +23,39 @@ public:
     virtual void Resize(u32 width, u32 height, u32 depth = 1) { UNUSED(width); UNUSED(height); UNUSED(depth); }
 
     const std::string& GetName() const { return m_Name; }
+    // The node's name interned once, for the per-pass profile scopes
+    ProfileScopeId GetProfileScopeId() const { return m_ProfileScopeId; }
     bool IsEnabled() const { return m_bEnabled; }
     void SetEnabled(bool bEnable) { m_bEnabled = bEnable; }
 
-    // Dependency management (for future use) //
-    //void AddDependency(RenderNode* node) { m_pDependencies.push_back(node); }
-    //
-    //void AddOutput(const std::string& name, Arc< Texture > texture) { m_Outputs[name] = texture; }
-    //
-    //Arc< Texture > GetOutput(const std::string& name) const
-    //{
-    //    auto it = m_Outputs.find(name);
-    //    return (it != m_Outputs.end()) ? it->second : nullptr;
-    //}
-    //
-    //const std::vector< RenderNode* >& GetDependencies() const { return m_pDependencies; }
-    //
-    //std::vector< RenderNode* >                        m_pDependencies;
-    //std::unordered_map< std::string, Arc< Texture > > m_Outputs;
-    ////////////////////////////////////////////
+    // True when Apply only touches resources this node owns, declares every one it reads or
+    // writes, and leaves anything shared (g_FrameData) to PublishFrameData. The graph groups
+    // consecutive such nodes whose declarations do not overlap, and a group may be recorded on
+    // worker threads.
+    virtual bool SupportsParallelRecording() const { return false; }
+
+    // Called on the render thread once the node's commands are recorded, before any later node
+    // records. Hands what later nodes look up to them.
+    virtual void PublishFrameData() {}
+
+    // True when Apply only dispatches compute work on resources this node owns, reading nothing
+    // but its own resources and the outputs of earlier async nodes. The graph may then move it to
+    // the compute queue, ahead of the graphics passes that do not need its results.
+    virtual bool SupportsAsyncCompute() const { return false; }
+
+    // Reads and writes this node makes, gathered when the graph compiles. The graph orders,
+    // barriers and culls declaring nodes; a node that declares nothing always runs.
+    virtual void DeclareResources(RenderGraphBuilder& builder, const SceneRenderView& renderView) { UNUSED(builder); UNUSED(renderView); }
+
+    // Folded into the graph's compile key each frame. Return a value that changes whenever
+    // DeclareResources would declare something different for 'renderView'.
+    virtual u64 DeclarationKey(const SceneRenderView& renderView) const { UNUSED(renderView); return 0; }
 
 protected:
     RenderDevice& m_RenderDevice;
 
-    std::string m_Name;
+    std::string    m_Name;
+    ProfileScopeId m_ProfileScopeId;
 
     bool m_bEnabled;
 };
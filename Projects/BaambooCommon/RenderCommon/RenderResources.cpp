@@ -1,9 +1,39 @@
 #include "RenderResources.h"
 #include "RenderDevice.h"
+#include "SceneRenderView.h"
+
+#include <algorithm>
 
 namespace render
 {
 
+namespace
+{
+
+using BindingSlots = std::vector< std::pair< u64, u64 > >;
+
+void InsertBindingSlot(BindingSlots& slots, const std::string& name, u64 packedIndex)
+{
+	const u64 hash = HashBindingName(name.data(), name.size());
+	auto iter = std::lower_bound(slots.begin(), slots.end(), hash,
+		[](const std::pair< u64, u64 >& slot, u64 key) { return slot.first < key; });
+	BB_ASSERT(iter == slots.end() || iter->first != hash, "Binding name hash collision on '%s'.", name.c_str());
+
+	slots.insert(iter, { hash, packedIndex });
+}
+
+std::pair< u32, u32 > FindBindingSlot(const BindingSlots& slots, u64 hash)
+{
+	auto iter = std::lower_bound(slots.begin(), slots.end(), hash,
+		[](const std::pair< u64, u64 >& slot, u64 key) { return slot.first < key; });
+	if (iter == slots.end() || iter->first != hash)
+		return { kInvalidIndex, kInvalidIndex };
+
+	return { (u32)(iter->second >> 32), (u32)(iter->second & 0xFFFFFFFF) };
+}
+
+} // anonymous namespace
+
 //-------------------------------------------------------------------------
 // Buffer
 //-------------------------------------------------------------------------
@@ -359,6 +389,18 @@ std::pair< u32, u32 > GraphicsPipeline::GetResourceBindingIndex(const std::strin
 	return { (u32)(iter->second >> 32), (u32)(iter->second & 0xFFFFFFFF) };
 }
 
+std::pair< u32, u32 > GraphicsPipeline::GetResourceBindingIndex(const BindingId& id) const
+{
+	return FindBindingSlot(m_ResourceBindingSlots, id.hash);
+}
+
+void GraphicsPipeline::AddResourceBinding(const std::string& name, u64 packedIndex)
+{
+	// first registration wins, shared by every stage that declares the name
+	if (m_ResourceBindingMap.emplace(name, packedIndex).second)
+		InsertBindingSlot(m_ResourceBindingSlots, name, packedIndex);
+}
+
 
 //-------------------------------------------------------------------------
 // Compute Pipeline
@@ -388,6 +430,18 @@ std::pair< u32, u32 > ComputePipeline::GetResourceBindingIndex(const std::string
 	return { (u32)(iter->second >> 32), (u32)(iter->second & 0xFFFFFFFF) };
 }
 
+std::pair< u32, u32 > ComputePipeline::GetResourceBindingIndex(const BindingId& id) const
+{
+	return FindBindingSlot(m_ResourceBindingSlots, id.hash);
+}
+
+void ComputePipeline::AddResourceBinding(const std::string& name, u64 packedIndex)
+{
+	// first registration wins, shared by every stage that declares the name
+	if (m_ResourceBindingMap.emplace(name, packedIndex).second)
+		InsertBindingSlot(m_ResourceBindingSlots, name, packedIndex);
+}
+
 
 //-------------------------------------------------------------------------
 // DXR Pipeline
@@ -453,6 +507,52 @@ std::pair< u32, u32 > RaytracingPipeline::GetResourceBindingIndex(const std::str
 	return { (u32)(iter->second >> 32), (u32)(iter->second & 0xFFFFFFFF) };
 }
 
+std::pair< u32, u32 > RaytracingPipeline::GetResourceBindingIndex(const BindingId& id) const
+{
+	return FindBindingSlot(m_ResourceBindingSlots, id.hash);
+}
+
+void RaytracingPipeline::AddResourceBinding(const std::string& name, u64 packedIndex)
+{
+	// first registration wins, shared by every stage that declares the name
+	if (m_ResourceBindingMap.emplace(name, packedIndex).second)
+		InsertBindingSlot(m_ResourceBindingSlots, name, packedIndex);
+}
+
+
+//-------------------------------------------------------------------------
+// Scene Resource
+//-------------------------------------------------------------------------
+u32 SceneResource::PackDrawInstances(const SceneRenderView& renderView, std::vector< InstanceData >& outInstances) const
+{
+	outInstances.clear();
+	outInstances.reserve(m_DrawInstances.size() + 1); // +1 for the voxel chunk the backends prepend
+	if (!renderView.bCpuCulled)
+	{
+		for (const auto& drawInstance : m_DrawInstances)
+			outInstances.push_back(drawInstance.instance);
+		return static_cast< u32 >(outInstances.size());
+	}
+
+	const auto IsVisible = [&visibleDraws = renderView.visibleDraws](u32 drawId)
+	{
+		return std::binary_search(visibleDraws.begin(), visibleDraws.end(), drawId);
+	};
+	for (const auto& drawInstance : m_DrawInstances)
+	{
+		if (IsVisible(drawInstance.drawId))
+			outInstances.push_back(drawInstance.instance);
+	}
+
+	const u32 numVisible = static_cast< u32 >(outInstances.size());
+	for (const auto& drawInstance : m_DrawInstances)
+	{
+		if (!IsVisible(drawInstance.drawId))
+			outInstances.push_back(drawInstance.instance);
+	}
+	return numVisible;
+}
+
 
 //-------------------------------------------------------------------------
 // Resource Manager
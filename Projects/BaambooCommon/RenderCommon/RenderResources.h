@@ -1,6 +1,8 @@
 #pragma once
 #include "RendererAPI.h"
 #include "ShaderTypes.h"
+#include "BindingId.h"
+#include "ShaderPermutation.hpp"
 
 #pragma warning(disable : 4251)
 
@@ -219,6 +221,10 @@ public:
         u32  sampleCount   = 1;
         bool bFlipY        = false;
         bool bGenerateMips = false;
+
+        // contents never outlive the frame: the render graph may place it in memory shared
+        // with other transients whose lifetimes don't overlap
+        bool bTransient = false;
     };
 
     static Arc< Texture > Create(RenderDevice& rd, const char* name, CreationInfo&& desc);
@@ -234,8 +240,10 @@ public:
     u32 Height() const { return m_CreationInfo.resolution.y; }
     u32 Depth() const { return m_CreationInfo.resolution.z; }
     virtual u32 MipLevels() const = 0;
+    virtual u64 SizeInBytes() const { return 0; }
 
     virtual bool IsDepthTexture() const;
+    bool IsTransient() const { return m_CreationInfo.bTransient; }
 
 protected:
     CreationInfo m_CreationInfo = {};
@@ -449,6 +457,8 @@ public:
     {
         eShaderStage stage;
         std::string  filename;
+
+        std::vector< ShaderFeature > features; // permutation; empty for the plain shader
     };
 
     static Arc< Shader > Create(RenderDevice& rd, const char* name, CreationInfo&& info);
@@ -784,6 +794,7 @@ public:
     virtual void Build() = 0;
 
     std::pair< u32, u32 > GetResourceBindingIndex(const std::string& name);
+    std::pair< u32, u32 > GetResourceBindingIndex(const BindingId& id) const;
 
     inline bool IsMeshPipeline() const { return m_bMeshShader; }
 
@@ -801,9 +812,13 @@ protected:
 
     bool m_bMeshShader = false;
 
+    void AddResourceBinding(const std::string& name, u64 packedIndex);
+
     // [name, set:binding] - Vulkan
     // [name, offset:rootIndex] - Dx12
     std::unordered_map< std::string, u64 > m_ResourceBindingMap;
+    // [hash(name), packed index] sorted by hash — resolved once while building
+    std::vector< std::pair< u64, u64 > >   m_ResourceBindingSlots;
 };
 
 class BAAMBOO_API ComputePipeline : public ArcBase
@@ -820,15 +835,20 @@ public:
     virtual void Build() = 0;
 
     std::pair< u32, u32 > GetResourceBindingIndex(const std::string& name);
+    std::pair< u32, u32 > GetResourceBindingIndex(const BindingId& id) const;
 
 protected:
     std::string m_Name;
 
     Arc< Shader > m_pCS;
 
+    void AddResourceBinding(const std::string& name, u64 packedIndex);
+
     // [name, set:binding] - Vulkan
     // [name, offset:rootIndex] - Dx12
     std::unordered_map< std::string, u64 > m_ResourceBindingMap;
+    // [hash(name), packed index] sorted by hash — resolved once while building
+    std::vector< std::pair< u64, u64 > >   m_ResourceBindingSlots;
 };
 
 class BAAMBOO_API RaytracingPipeline : public ArcBase
@@ -861,6 +881,7 @@ public:
     virtual const void* GetShaderIdentifier(const std::string& exportName) const = 0;
 
     std::pair< u32, u32 > GetResourceBindingIndex(const std::string& name);
+    std::pair< u32, u32 > GetResourceBindingIndex(const BindingId& id) const;
 
 protected:
     std::string m_Name;
@@ -875,9 +896,13 @@ protected:
     u32 m_MaxPayloadSizeInBytes   = 4 * sizeof(float);
     u32 m_MaxAttributeSizeInBytes = 2 * sizeof(float);
 
+    void AddResourceBinding(const std::string& name, u64 packedIndex);
+
     // [name, set:binding] - Vulkan
     // [name, offset:rootIndex] - Dx12
     std::unordered_map< std::string, u64 > m_ResourceBindingMap;
+    // [hash(name), packed index] sorted by hash — resolved once while building
+    std::vector< std::pair< u64, u64 > >   m_ResourceBindingSlots;
 };
 
 
@@ -908,9 +933,23 @@ public:
     u32 NumMeshletVisibilitySlots() const { return m_NumMeshletVisibilitySlots; }
 
 protected:
+    // One per mesh draw of the last full rebuild. Visibility changes re-pack these
+    // without touching the mesh, material or transform buffers.
+    struct DrawInstance
+    {
+        u32          drawId;
+        InstanceData instance;
+    };
+
+    // Fills 'outInstances' with every draw instance, those in renderView.visibleDraws first,
+    // and returns how many are visible. The rest trail so the list keeps its length.
+    u32 PackDrawInstances(const SceneRenderView& renderView, std::vector< InstanceData >& outInstances) const;
+
     u32 m_ContextIndex = 0;
     u32 m_NumInstances = 0;
     u32 m_NumMeshletVisibilitySlots = 0;
+
+    std::vector< DrawInstance > m_DrawInstances;
 };
 
 
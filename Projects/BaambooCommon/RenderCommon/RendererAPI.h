@@ -51,6 +51,9 @@ struct DeviceSettings
 	bool bDrawUI     = true;
 	bool bRaytracing = false;
 	bool bMeshShader = false;
+
+	bool bParallelRecording = false;
+	bool bAsyncCompute      = false; // cleared by backends without a separate compute queue
 };
 
 class Renderer
@@ -63,6 +66,22 @@ public:
 	virtual Arc< render::CommandContext > BeginFrame() = 0;
 	virtual void EndFrame(Arc< render::CommandContext >&& context, Arc< render::Texture > scene, bool bDrawUI) = 0;
 
+	// Parallel recording. Contexts from BeginRecordingContext are filled on worker threads (one
+	// thread per index at a time) and replayed into the frame context by ExecuteRecordingContext,
+	// in call order. A backend returning 0 keeps every node on the frame context.
+	virtual u32 MaxRecordingThreads() const { return 0; }
+	virtual Arc< render::CommandContext > BeginRecordingContext(u32 threadIndex) { UNUSED(threadIndex); return nullptr; }
+	virtual void ExecuteRecordingContext(render::CommandContext& frameContext, Arc< render::CommandContext >&& pContext) { UNUSED(frameContext); UNUSED(pContext); }
+
+	// Async compute. The context from BeginAsyncCompute is recorded on the render thread and handed
+	// to SubmitAsyncCompute, which first submits what the frame context recorded so far (the compute
+	// work may read it) and then the compute work. Frame work recorded before JoinAsyncCompute
+	// overlaps it; everything after waits for it (the end of the frame joins if nothing did).
+	// A backend returning nullptr keeps every node on the frame context.
+	virtual Arc< render::CommandContext > BeginAsyncCompute() { return nullptr; }
+	virtual void SubmitAsyncCompute(render::CommandContext& frameContext, Arc< render::CommandContext >&& pContext) { UNUSED(frameContext); UNUSED(pContext); }
+	virtual void JoinAsyncCompute(render::CommandContext& frameContext) { UNUSED(frameContext); }
+
 	virtual void WaitIdle() = 0;
     virtual void Resize(i32 width, i32 height) = 0;
 
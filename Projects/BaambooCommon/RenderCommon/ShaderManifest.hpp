@@ -0,0 +1,144 @@
+#pragma once
+#include "BindingId.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace render
+{
+
+// =========================================================================
+// ShaderManifest — what ShaderBuilder last compiled into a binary folder.
+//
+//   One text line per binary: its filename, the build key (source,
+//   includes, defines and compiler version hashed together) and the hash
+//   of the binary it produced. ShaderBuilder compares keys to decide what
+//   to rebuild; the renderers compare binary hashes on load, so a binary
+//   that was never built by the tool, or was overwritten behind its back,
+//   is reported instead of silently used.
+// =========================================================================
+class ShaderManifest
+{
+public:
+    static constexpr const char* kHeader = "# BaambooShaderManifest 1";
+
+    struct Entry
+    {
+        std::string name;
+        u64         key        = 0;
+        u64         binaryHash = 0;
+    };
+
+    bool Load(const std::filesystem::path& path)
+    {
+        m_Entries.clear();
+        m_Indices.clear();
+
+        std::ifstream file(path);
+        std::string line;
+        if (!file.is_open() || !std::getline(file, line) || line != kHeader)
+            return false;
+
+        while (std::getline(file, line))
+        {
+            std::istringstream fields(line);
+            Entry entry = {};
+            if (fields >> entry.name >> std::hex >> entry.key >> entry.binaryHash)
+                Add(entry);
+        }
+        return true;
+    }
+
+    bool Save(const std::filesystem::path& path) const
+    {
+        std::vector< const Entry* > sorted;
+        sorted.reserve(m_Entries.size());
+        for (const auto& entry : m_Entries)
+            sorted.push_back(&entry);
+        std::sort(sorted.begin(), sorted.end(), [](const Entry* lhs, const Entry* rhs) { return lhs->name < rhs->name; });
+
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+
+        file << kHeader << '\n';
+        char hashes[48];
+        for (const Entry* pEntry : sorted)
+        {
+            snprintf(hashes, sizeof(hashes), "%016" PRIx64 " %016" PRIx64, pEntry->key, pEntry->binaryHash);
+            file << pEntry->name << ' ' << hashes << '\n';
+        }
+        return static_cast< bool >(file);
+    }
+
+    void Add(const Entry& entry)
+    {
+        auto [iter, bInserted] = m_Indices.try_emplace(entry.name, static_cast< u32 >(m_Entries.size()));
+        if (bInserted)
+            m_Entries.push_back(entry);
+        else
+            m_Entries[iter->second] = entry;
+    }
+
+    [[nodiscard]]
+    const Entry* Find(const std::string& name) const
+    {
+        auto iter = m_Indices.find(name);
+        return iter != m_Indices.end() ? &m_Entries[iter->second] : nullptr;
+    }
+
+    [[nodiscard]]
+    bool IsEmpty() const { return m_Entries.empty(); }
+
+private:
+    std::vector< Entry >                   m_Entries;
+    std::unordered_map< std::string, u32 > m_Indices;
+};
+
+inline std::filesystem::path GetShaderManifestPath(const std::filesystem::path& binaryDir)
+{
+    return binaryDir / "ShaderManifest.txt";
+}
+
+// Checks a loaded binary against the manifest in its folder and warns once if they disagree.
+// Returns false only for a known mismatch; a folder without a manifest is not checked.
+inline bool ValidateShaderBinary(const std::filesystem::path& binaryPath, u64 binaryHash)
+{
+    static std::mutex s_Mutex;
+    static std::unordered_map< std::string, ShaderManifest > s_Manifests; // by folder, loaded once
+
+    std::lock_guard< std::mutex > lock(s_Mutex);
+
+    const std::string folder = binaryPath.parent_path().string();
+    auto [iter, bInserted] = s_Manifests.try_emplace(folder);
+    if (bInserted && !iter->second.Load(GetShaderManifestPath(binaryPath.parent_path())))
+        printf("[Shader] no manifest in '%s'; run ShaderBuilder to track binaries\n", folder.c_str());
+
+    const ShaderManifest& manifest = iter->second;
+    if (manifest.IsEmpty())
+        return true;
+
+    const std::string name = binaryPath.filename().string();
+    const auto* pEntry = manifest.Find(name);
+    if (!pEntry)
+    {
+        printf("[Shader] '%s' is not in the shader manifest\n", name.c_str());
+        return false;
+    }
+    if (pEntry->binaryHash != binaryHash)
+    {
+        printf("[Shader] '%s' does not match the binary ShaderBuilder produced; it is stale or was replaced\n", name.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace render
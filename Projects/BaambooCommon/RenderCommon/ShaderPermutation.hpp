@@ -0,0 +1,224 @@
+#pragma once
+#include "BindingId.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace render
+{
+
+// =========================================================================
+// Shader permutations — static feature switches baked into a shader.
+//
+//   A feature is declared once per shader: a specialization constant on
+//   Vulkan (same SPIR-V, 'constantId' picks the constant) and a define on
+//   Dx12 (ShaderBuilder compiles one binary per recorded permutation).
+//   Zero is every feature's default and is left out of a permutation's
+//   name, so the all-default permutation is the plain shader binary.
+//
+//   The HLSL source declares each feature's value range on a line of its
+//   own, so ShaderBuilder can compile every value ahead of the first run:
+//
+//       // @permutation SURFACE_DEBUG_VIEW 8      (values 0..7)
+// =========================================================================
+struct ShaderFeature
+{
+    std::string name;
+    u32         constantId = 0;
+    u32         value      = 0;
+};
+
+// "" for the default permutation, else "__NAME_value" per non-default feature, sorted by name
+inline std::string GetPermutationSuffix(const std::vector< ShaderFeature >& features)
+{
+    std::vector< const ShaderFeature* > active;
+    for (const auto& feature : features)
+    {
+        if (feature.value != 0)
+            active.push_back(&feature);
+    }
+    std::sort(active.begin(), active.end(), [](const ShaderFeature* lhs, const ShaderFeature* rhs) { return lhs->name < rhs->name; });
+
+    std::string suffix;
+    for (const ShaderFeature* pFeature : active)
+        suffix += "__" + pFeature->name + "_" + std::to_string(pFeature->value);
+    return suffix;
+}
+
+struct ShaderFeatureRange
+{
+    std::string name;
+    u32         numValues = 1;
+};
+
+inline std::vector< ShaderFeatureRange > ParsePermutationDeclarations(std::istream& source)
+{
+    static constexpr std::string_view kTag = "// @permutation ";
+
+    std::vector< ShaderFeatureRange > ranges;
+    std::string line;
+    while (std::getline(source, line))
+    {
+        const size_t begin = line.find_first_not_of(" \t");
+        if (begin == std::string::npos || line.compare(begin, kTag.size(), kTag) != 0)
+            continue;
+
+        std::istringstream fields(line.substr(begin + kTag.size()));
+        ShaderFeatureRange range = {};
+        if (fields >> range.name >> range.numValues && range.numValues > 1)
+            ranges.push_back(std::move(range));
+    }
+    return ranges;
+}
+
+// Every combination of the ranges' values except the all-default one, at most 'maxPermutations'
+inline std::vector< std::vector< ShaderFeature > > EnumeratePermutations(const std::vector< ShaderFeatureRange >& ranges, u32 maxPermutations)
+{
+    std::vector< std::vector< ShaderFeature > > permutations;
+    if (ranges.empty())
+        return permutations;
+
+    std::vector< ShaderFeature > current;
+    for (const auto& range : ranges)
+        current.push_back({ range.name, 0, 0 });
+
+    // odometer over the values, the first range turning fastest
+    while (permutations.size() < maxPermutations)
+    {
+        size_t digit = 0;
+        while (digit < ranges.size() && ++current[digit].value == ranges[digit].numValues)
+            current[digit++].value = 0;
+        if (digit == ranges.size())
+            break;
+
+        permutations.push_back(current);
+    }
+    return permutations;
+}
+
+inline std::filesystem::path GetShaderPermutationListPath()
+{
+    return "Output/Shader/ShaderPermutations.txt";
+}
+
+// =========================================================================
+// ShaderPermutationList — every permutation the engine has built.
+//
+//   One text line per permutation: the shader filename followed by its
+//   non-default features as NAME=value. The engine appends to it as
+//   variants are requested and pre-warms from it at load; ShaderBuilder
+//   compiles the Dx12 define variants from it and from the ranges the
+//   sources declare.
+// =========================================================================
+class ShaderPermutationList
+{
+public:
+    static constexpr const char* kHeader = "# BaambooShaderPermutations 1";
+
+    struct Entry
+    {
+        std::string                  filename;
+        std::vector< ShaderFeature > features; // non-default only, constantId unknown (0)
+    };
+
+    bool Load(const std::filesystem::path& path)
+    {
+        m_Entries.clear();
+
+        std::ifstream file(path);
+        std::string line;
+        if (!file.is_open() || !std::getline(file, line) || line != kHeader)
+            return false;
+
+        while (std::getline(file, line))
+        {
+            std::istringstream fields(line);
+            Entry entry = {};
+            if (!(fields >> entry.filename))
+                continue;
+
+            std::string token;
+            while (fields >> token)
+            {
+                const size_t separator = token.find('=');
+                if (separator == std::string::npos || separator == 0)
+                    continue;
+
+                ShaderFeature& feature = entry.features.emplace_back();
+                feature.name  = token.substr(0, separator);
+                feature.value = static_cast< u32 >(std::strtoul(token.c_str() + separator + 1, nullptr, 10));
+            }
+            Add(entry.filename, entry.features);
+        }
+        return true;
+    }
+
+    bool Save(const std::filesystem::path& path) const
+    {
+        std::vector< std::string > lines;
+        lines.reserve(m_Entries.size());
+        for (const auto& entry : m_Entries)
+        {
+            std::string line = entry.filename;
+            for (const auto& feature : entry.features)
+                line += " " + feature.name + "=" + std::to_string(feature.value);
+            lines.push_back(std::move(line));
+        }
+        std::sort(lines.begin(), lines.end());
+
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+
+        file << kHeader << '\n';
+        for (const auto& line : lines)
+            file << line << '\n';
+        return static_cast< bool >(file);
+    }
+
+    // False if the permutation was already listed; default permutations are never listed
+    bool Add(const std::string& filename, const std::vector< ShaderFeature >& features)
+    {
+        const std::string suffix = GetPermutationSuffix(features);
+        if (suffix.empty() || Contains(filename, suffix))
+            return false;
+
+        Entry& entry = m_Entries.emplace_back();
+        entry.filename = filename;
+        for (const auto& feature : features)
+        {
+            if (feature.value != 0)
+                entry.features.push_back({ feature.name, 0, feature.value });
+        }
+        std::sort(entry.features.begin(), entry.features.end(),
+            [](const ShaderFeature& lhs, const ShaderFeature& rhs) { return lhs.name < rhs.name; });
+        return true;
+    }
+
+    [[nodiscard]]
+    const std::vector< Entry >& Entries() const { return m_Entries; }
+
+private:
+    bool Contains(const std::string& filename, const std::string& suffix) const
+    {
+        for (const auto& entry : m_Entries)
+        {
+            if (entry.filename == filename && GetPermutationSuffix(entry.features) == suffix)
+                return true;
+        }
+        return false;
+    }
+
+    std::vector< Entry > m_Entries;
+};
+
+} // namespace render
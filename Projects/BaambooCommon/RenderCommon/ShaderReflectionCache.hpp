@@ -0,0 +1,159 @@
+#pragma once
+#include "BindingId.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace render
+{
+
+// =========================================================================
+// Shader reflection sidecar — '<binary>.refl' next to a compiled shader.
+//
+//   Holds whatever a backend extracted by reflecting the binary, so the
+//   next load reads it back instead of re-running spirv_cross or DXC
+//   reflection. The header carries a hash of the binary it was made from;
+//   a stale or missing sidecar fails Load() and the backend regenerates it.
+//   The payload layout is up to the backend, written through
+//   ReflectionWriter and read back in the same order with ReflectionReader.
+// =========================================================================
+constexpr u32 kReflectionMagic = 0x46524242; // 'BBRF'
+
+inline u64 HashShaderBinary(const void* pData, size_t size)
+{
+    return HashBindingName(static_cast< const char* >(pData), size);
+}
+
+inline std::filesystem::path GetReflectionSidecarPath(const std::string& binaryPath)
+{
+    return std::filesystem::path(binaryPath + ".refl");
+}
+
+struct ReflectionHeader
+{
+    u32 magic       = kReflectionMagic;
+    u32 version     = 0; // backend's payload version
+    u64 binaryHash  = 0;
+    u64 payloadSize = 0;
+};
+
+class ReflectionWriter
+{
+public:
+    template< typename T >
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v< T >);
+        const size_t offset = m_Bytes.size();
+        m_Bytes.resize(offset + sizeof(T));
+        std::memcpy(m_Bytes.data() + offset, &value, sizeof(T));
+    }
+
+    void WriteString(const std::string& str)
+    {
+        Write(static_cast< u32 >(str.size()));
+        m_Bytes.insert(m_Bytes.end(), str.begin(), str.end());
+    }
+
+    // Failing to write is not an error; the shader just reflects again next time
+    bool Save(const std::filesystem::path& path, u32 version, u64 binaryHash) const
+    {
+        ReflectionHeader header = {};
+        header.version     = version;
+        header.binaryHash  = binaryHash;
+        header.payloadSize = m_Bytes.size();
+
+        std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+
+        file.write(reinterpret_cast< const char* >(&header), sizeof(header));
+        file.write(reinterpret_cast< const char* >(m_Bytes.data()), static_cast< std::streamsize >(m_Bytes.size()));
+        return static_cast< bool >(file);
+    }
+
+private:
+    std::vector< u8 > m_Bytes;
+};
+
+class ReflectionReader
+{
+public:
+    // False if the sidecar is missing, from another payload version or from another binary
+    bool Load(const std::filesystem::path& path, u32 version, u64 binaryHash)
+    {
+        m_Bytes.clear();
+        m_Offset = 0;
+        m_bValid = false;
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+            return false;
+
+        const std::streamoff fileSize = file.tellg();
+        file.seekg(0, std::ios::beg);
+
+        ReflectionHeader header = {};
+        file.read(reinterpret_cast< char* >(&header), sizeof(header));
+        if (!file ||
+            header.magic != kReflectionMagic ||
+            header.version != version ||
+            header.binaryHash != binaryHash ||
+            header.payloadSize != static_cast< u64 >(fileSize) - sizeof(header))
+        {
+            return false;
+        }
+
+        m_Bytes.resize(static_cast< size_t >(header.payloadSize));
+        file.read(reinterpret_cast< char* >(m_Bytes.data()), static_cast< std::streamsize >(m_Bytes.size()));
+        m_Offset = 0;
+        m_bValid = static_cast< bool >(file);
+        return m_bValid;
+    }
+
+    template< typename T >
+    T Read()
+    {
+        static_assert(std::is_trivially_copyable_v< T >);
+        T value = {};
+        if (!m_bValid || m_Offset + sizeof(T) > m_Bytes.size())
+        {
+            m_bValid = false;
+            return value;
+        }
+        std::memcpy(&value, m_Bytes.data() + m_Offset, sizeof(T));
+        m_Offset += sizeof(T);
+        return value;
+    }
+
+    std::string ReadString()
+    {
+        const u32 length = Read< u32 >();
+        if (!m_bValid || m_Offset + length > m_Bytes.size())
+        {
+            m_bValid = false;
+            return {};
+        }
+        std::string str(reinterpret_cast< const char* >(m_Bytes.data() + m_Offset), length);
+        m_Offset += length;
+        return str;
+    }
+
+    // True while every read so far stayed inside the payload
+    [[nodiscard]]
+    bool IsValid() const { return m_bValid; }
+    // ...and every byte of it was consumed
+    [[nodiscard]]
+    bool IsComplete() const { return m_bValid && m_Offset == m_Bytes.size(); }
+
+private:
+    std::vector< u8 > m_Bytes;
+    size_t            m_Offset = 0;
+    bool              m_bValid = false;
+};
+
+} // namespace render
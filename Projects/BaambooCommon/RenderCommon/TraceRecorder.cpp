@@ -0,0 +1,335 @@
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace render
+{
+
+namespace
+{
+
+// One event, readable while its owner overwrites it: 'sequence' is the event's index + 1 once
+// the fields hold that event and 0 while they are being written. A reader that sees the same
+// expected sequence before and after loading the fields has an untorn copy.
+struct TraceSlot
+{
+    std::atomic< u64 > sequence{ 0 };
+    std::atomic< u64 > ticks{ 0 };
+    std::atomic< u64 > payload{ 0 };
+    std::atomic< u64 > scopeAndType{ 0 }; // scopeId | type << 32
+};
+
+struct TraceRing
+{
+    std::string name; // guarded by the registry mutex
+    u32         tid   = 0;
+    u64         frame = 0; // owner thread only
+
+    std::atomic< u64 >                                      head{ 0 };
+    std::array< TraceSlot, TraceRecorder::kRingCapacity > slots;
+};
+
+struct RecorderState
+{
+    std::mutex mutex;
+
+    // Rings outlive their threads, so an export never reads a freed ring
+    std::vector< std::unique_ptr< TraceRing > > rings;
+
+    std::atomic< bool > bEnabled{ false };
+
+    std::array< std::atomic< u64 >, TraceRecorder::kMaxFrames > frameMarks;
+    std::atomic< u64 >                                          numFrames{ 0 };
+};
+
+// Lives in this DLL so the engine and every backend record into the same rings
+RecorderState& State()
+{
+    static RecorderState state;
+    return state;
+}
+
+TraceRing& ThreadRing()
+{
+    thread_local TraceRing* t_pRing = nullptr;
+    if (!t_pRing)
+    {
+        auto& state = State();
+        std::lock_guard< std::mutex > lock(state.mutex);
+
+        auto pRing  = std::make_unique< TraceRing >();
+        pRing->tid  = static_cast< u32 >(state.rings.size());
+        pRing->name = "Thread " + std::to_string(pRing->tid);
+        t_pRing = state.rings.emplace_back(std::move(pRing)).get();
+    }
+    return *t_pRing;
+}
+
+void Push(eTraceEvent type, ProfileScopeId scopeId, u64 ticks, u64 payload)
+{
+    if (!State().bEnabled.load(std::memory_order_relaxed))
+        return;
+
+    // Single writer: retire the slot, fill it, then publish it under the new sequence
+    TraceRing& ring = ThreadRing();
+    if (type == eTraceEvent::Begin)
+        payload = ring.frame;
+
+    const u64  head = ring.head.load(std::memory_order_relaxed);
+    TraceSlot& slot = ring.slots[head & (TraceRecorder::kRingCapacity - 1)];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.ticks.store(ticks, std::memory_order_relaxed);
+    slot.payload.store(payload, std::memory_order_relaxed);
+    slot.scopeAndType.store(scopeId | (static_cast< u64 >(type) << 32), std::memory_order_relaxed);
+    slot.sequence.store(head + 1, std::memory_order_release);
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+struct RingSnapshot
+{
+    std::string               name;
+    u32                       tid = 0;
+    std::vector< TraceEvent > events;
+};
+
+RingSnapshot Snapshot(const TraceRing& ring)
+{
+    constexpr u64 kCapacity = TraceRecorder::kRingCapacity;
+
+    RingSnapshot snapshot = { .name = ring.name, .tid = ring.tid };
+
+    const u64 head  = ring.head.load(std::memory_order_acquire);
+    const u64 first = head > kCapacity ? head - kCapacity : 0;
+    snapshot.events.reserve(head - first);
+
+    // The owner keeps recording during the copy; a slot it overwrote or is writing
+    // doesn't carry the expected sequence on both sides of the read and is dropped
+    for (u64 i = first; i < head; ++i)
+    {
+        const TraceSlot& slot = ring.slots[i & (kCapacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != i + 1)
+            continue;
+
+        const u64 ticks        = slot.ticks.load(std::memory_order_relaxed);
+        const u64 payload      = slot.payload.load(std::memory_order_relaxed);
+        const u64 scopeAndType = slot.scopeAndType.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != i + 1)
+            continue;
+
+        snapshot.events.push_back({
+            .ticks   = ticks,
+            .payload = payload,
+            .scopeId = static_cast< ProfileScopeId >(scopeAndType),
+            .type    = static_cast< eTraceEvent >(scopeAndType >> 32) });
+    }
+    return snapshot;
+}
+
+void WriteEscaped(std::ofstream& file, const char* str)
+{
+    file << '"';
+    for (const char* c = str; *c; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+            file << '\\' << *c;
+        else if (static_cast< unsigned char >(*c) >= 0x20)
+            file << *c;
+    }
+    file << '"';
+}
+
+} // anonymous namespace
+
+void TraceRecorder::SetEnabled(bool bEnabled)
+{
+    State().bEnabled.store(bEnabled, std::memory_order_relaxed);
+}
+
+bool TraceRecorder::IsEnabled()
+{
+    return State().bEnabled.load(std::memory_order_relaxed);
+}
+
+void TraceRecorder::SetThreadName(const char* name)
+{
+    TraceRing& ring = ThreadRing();
+
+    std::lock_guard< std::mutex > lock(State().mutex);
+    ring.name = name;
+}
+
+void TraceRecorder::SetFrame(u64 frameSequence)
+{
+    ThreadRing().frame = frameSequence;
+}
+
+void TraceRecorder::Begin(ProfileScopeId scopeId, u64 ticks)
+{
+    Push(eTraceEvent::Begin, scopeId, ticks, 0);
+}
+
+void TraceRecorder::End(u64 ticks)
+{
+    Push(eTraceEvent::End, kInvalidProfileScope, ticks, 0);
+}
+
+void TraceRecorder::FlowOut(ProfileScopeId scopeId, u64 flowId)
+{
+    Push(eTraceEvent::FlowOut, scopeId, CpuTicks::Now(), flowId);
+}
+
+void TraceRecorder::FlowIn(ProfileScopeId scopeId, u64 flowId)
+{
+    Push(eTraceEvent::FlowIn, scopeId, CpuTicks::Now(), flowId);
+}
+
+void TraceRecorder::Counter(ProfileScopeId scopeId, double value)
+{
+    Push(eTraceEvent::Counter, scopeId, CpuTicks::Now(), std::bit_cast< u64 >(value));
+}
+
+void TraceRecorder::MarkFrame()
+{
+    auto& state = State();
+    if (!state.bEnabled.load(std::memory_order_relaxed))
+        return;
+
+    const u64 frame = state.numFrames.load(std::memory_order_relaxed);
+    state.frameMarks[frame % kMaxFrames].store(CpuTicks::Now(), std::memory_order_relaxed);
+    state.numFrames.store(frame + 1, std::memory_order_release);
+}
+
+bool TraceRecorder::Export(const std::filesystem::path& path, u32 numFrames)
+{
+    auto& state = State();
+    numFrames = std::clamp(numFrames, 1u, kMaxFrames);
+
+    // **
+    // Window: from the start of the N-th last marked frame (everything recorded if fewer were marked)
+    // **
+    const u64 numMarked   = state.numFrames.load(std::memory_order_acquire);
+    const u64 windowBegin = numMarked > numFrames ? state.frameMarks[(numMarked - numFrames) % kMaxFrames].load(std::memory_order_relaxed) : 0;
+
+    std::vector< RingSnapshot > snapshots;
+    {
+        std::lock_guard< std::mutex > lock(state.mutex);
+        snapshots.reserve(state.rings.size());
+        for (const auto& pRing : state.rings)
+            snapshots.push_back(Snapshot(*pRing));
+    }
+
+    u64 originTicks = windowBegin;
+    if (originTicks == 0)
+    {
+        originTicks = ~0ull;
+        for (const auto& snapshot : snapshots)
+            for (const auto& event : snapshot.events)
+                originTicks = std::min(originTicks, event.ticks);
+    }
+    auto ToUs = [originTicks](u64 ticks) { return CpuTicks::ToMs(ticks - originTicks) * 1000.0; };
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        printf("[Trace] failed to open '%s' for writing\n", path.string().c_str());
+        return false;
+    }
+    file << std::fixed << std::setprecision(3);
+
+    // **
+    // Chrome trace JSON: scopes as complete ('X') events, flows as 's'/'f' pairs, counters as 'C'
+    // **
+    size_t numWritten = 0;
+    auto NextEvent = [&file, &numWritten]() -> std::ofstream&
+    {
+        file << (numWritten++ > 0 ? ",\n" : "\n");
+        return file;
+    };
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (const auto& snapshot : snapshots)
+    {
+        NextEvent() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << snapshot.tid << ",\"args\":{\"name\":";
+        WriteEscaped(file, snapshot.name.c_str());
+        file << "}}";
+
+        std::vector< const TraceEvent* > open;
+        for (const auto& event : snapshot.events)
+        {
+            if (event.type == eTraceEvent::Begin)
+            {
+                open.push_back(&event);
+                continue;
+            }
+
+            if (event.type == eTraceEvent::End)
+            {
+                // An End whose Begin was overwritten closes nothing
+                if (open.empty())
+                    continue;
+
+                const TraceEvent* pBegin = open.back();
+                open.pop_back();
+                if (pBegin->ticks < windowBegin)
+                    continue;
+
+                NextEvent() << "{\"name\":";
+                WriteEscaped(file, ProfileScopeRegistry::Name(pBegin->scopeId));
+                file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << snapshot.tid
+                     << ",\"ts\":" << ToUs(pBegin->ticks) << ",\"dur\":" << CpuTicks::ToMs(event.ticks - pBegin->ticks) * 1000.0
+                     << ",\"args\":{\"frame\":" << pBegin->payload << "}}";
+                continue;
+            }
+
+            if (event.ticks < windowBegin)
+                continue;
+
+            NextEvent() << "{\"name\":";
+            WriteEscaped(file, ProfileScopeRegistry::Name(event.scopeId));
+            file << ",\"pid\":1,\"tid\":" << snapshot.tid << ",\"ts\":" << ToUs(event.ticks);
+            switch (event.type)
+            {
+            case eTraceEvent::FlowOut:
+                file << ",\"cat\":\"flow\",\"ph\":\"s\",\"id\":" << event.payload << "}";
+                break;
+            case eTraceEvent::FlowIn:
+                file << ",\"cat\":\"flow\",\"ph\":\"f\",\"bp\":\"e\",\"id\":" << event.payload << "}";
+                break;
+            case eTraceEvent::Counter:
+                file << ",\"ph\":\"C\",\"args\":{\"value\":" << std::bit_cast< double >(event.payload) << "}}";
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    file << "\n]}\n";
+
+    if (!file.good())
+    {
+        printf("[Trace] failed to write '%s'\n", path.string().c_str());
+        return false;
+    }
+
+    printf("[Trace] wrote %zu events over %u frames from %zu threads to '%s'\n",
+        numWritten, numFrames, snapshots.size(), path.string().c_str());
+    return true;
+}
+
+} // namespace render
@@ -0,0 +1,83 @@
+#pragma once
+#include "ProfileScope.h"
+
+#include <filesystem>
+
+namespace render
+{
+
+enum class eTraceEvent : u8
+{
+    Begin,
+    End,
+    FlowOut, // the work item leaves this thread (e.g. a render view pushed to the render thread)
+    FlowIn,  // ... and is picked up here; matched to its FlowOut by ID
+    Counter,
+};
+
+struct TraceEvent
+{
+    u64            ticks   = 0;   // CpuTicks
+    u64            payload = 0;   // Begin: the thread's frame sequence, Flow*: flow ID, Counter: bit-cast double
+    ProfileScopeId scopeId = kInvalidProfileScope;
+    eTraceEvent    type    = eTraceEvent::Begin;
+};
+
+inline std::filesystem::path GetTraceExportPath(u64 frameSequence)
+{
+    return "Output/Trace/Trace_" + std::to_string(frameSequence) + ".json";
+}
+
+// =========================================================================
+// TraceRecorder — cross-thread timeline, exported as Chrome trace JSON.
+//
+//   Off until SetEnabled(true). Every thread that records gets its own
+//   fixed-size event ring on first use; the owning thread is the only
+//   writer, so recording an event is a few stores and a release of the
+//   slot's sequence number, no lock. Export() keeps only the slots whose
+//   sequence stayed put while it read them. CPU profiler scopes
+//   feed it automatically; flow events tie a frame's hand-off between
+//   threads together and counters track values over time. Export() walks
+//   the rings of all threads and writes the last N frames (as marked by
+//   MarkFrame()) for chrome://tracing or ui.perfetto.dev.
+// =========================================================================
+class BAAMBOO_API TraceRecorder
+{
+public:
+    static constexpr u32 kRingCapacity = 1u << 15; // events per thread, a power of two
+    static constexpr u32 kMaxFrames    = 240;      // frame marks kept for export
+
+    static void SetEnabled(bool bEnabled);
+    [[nodiscard]]
+    static bool IsEnabled();
+
+    // Per calling thread
+    static void SetThreadName(const char* name);
+    static void SetFrame(u64 frameSequence); // tags the thread's subsequent Begin events
+
+    static void Begin(ProfileScopeId scopeId, u64 ticks);
+    static void End(u64 ticks);
+    static void FlowOut(ProfileScopeId scopeId, u64 flowId);
+    static void FlowIn(ProfileScopeId scopeId, u64 flowId);
+    static void Counter(ProfileScopeId scopeId, double value);
+
+    // Start of a frame on the thread that paces the export window (the render thread)
+    static void MarkFrame();
+
+    // Writes the last 'numFrames' marked frames of every thread; false if nothing could be written
+    static bool Export(const std::filesystem::path& path, u32 numFrames);
+};
+
+// ================================================================================
+// TraceScope — RAII trace-only scope, for threads that don't run a CpuProfiler frame.
+// ================================================================================
+class TraceScope
+{
+public:
+    explicit TraceScope(ProfileScopeId scopeId) { TraceRecorder::Begin(scopeId, CpuTicks::Now()); }
+    ~TraceScope() { TraceRecorder::End(CpuTicks::Now()); }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+} // namespace render
@@ -264,6 +264,12 @@ struct SceneRenderView
 
 	std::unordered_map< u32, DrawRenderView > draws;
 
+	// CPU culling pre-pass: sorted draw ids that survived it. The layout above stays whole;
+	// only the instance lists are re-packed when visibilityRevision moves.
+	bool               bCpuCulled         = false;
+	u64                visibilityRevision = 0;
+	std::vector< u32 > visibleDraws;
+
 	CameraRenderView      camera;
 	LightRenderView       light;
 	AtmosphereRenderView  atmosphere;
@@ -281,4 +287,21 @@ struct SceneRenderView
 	std::vector< DebugLineVertex > debugLines;
 	u64 debugLinesVersion = 0u;
 
+	// Heap the view holds, estimated from container capacities (strings not included)
+	u64 SizeInBytes() const
+	{
+		u64 sizeInBytes = transforms.capacity() * sizeof(TransformRenderView)
+			+ meshes.capacity() * sizeof(StaticMeshRenderView)
+			+ materials.capacity() * sizeof(MaterialRenderView)
+			+ materialSlabs.capacity() * sizeof(MaterialSlabData)
+			+ visibleDraws.capacity() * sizeof(u32)
+			+ debugLines.capacity() * sizeof(DebugLineVertex);
+		for (const auto& material : materials)
+			sizeInBytes += material.textures.capacity() * sizeof(MaterialTextureRenderView);
+
+		// one node per entry plus the bucket array
+		sizeInBytes += draws.size() * (sizeof(std::pair< const u32, DrawRenderView >) + 2 * sizeof(void*))
+			+ draws.bucket_count() * sizeof(void*);
+		return sizeInBytes;
+	}
 };
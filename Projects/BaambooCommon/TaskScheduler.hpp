@@ -0,0 +1,145 @@
+#pragma once
+#include "Primitives.h"
+#include "Singleton.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace baamboo
+{
+
+// =========================================================================
+// TaskScheduler — fixed pool of worker threads for fork-join work.
+//
+//   ParallelFor blocks until every index has run. The calling thread takes
+//   part in the work, and a call that cannot get the pool (nested call from
+//   a task, or another thread already owns it) simply runs inline.
+// =========================================================================
+class TaskScheduler : public Singleton< TaskScheduler >
+{
+public:
+    TaskScheduler()
+    {
+        const u32 numHardwareThreads = std::max(std::thread::hardware_concurrency(), 2u);
+        const u32 numWorkers         = std::min(numHardwareThreads - 1, kMaxWorkers);
+
+        m_Workers.reserve(numWorkers);
+        for (u32 i = 0; i < numWorkers; ++i)
+            m_Workers.emplace_back(&TaskScheduler::WorkerLoop, this);
+    }
+
+    ~TaskScheduler()
+    {
+        {
+            std::lock_guard< std::mutex > lock(m_Mutex);
+            m_bStop = true;
+        }
+        m_WakeCv.notify_all();
+
+        for (auto& worker : m_Workers)
+            if (worker.joinable())
+                worker.join();
+    }
+
+    u32 NumWorkers() const { return static_cast< u32 >(m_Workers.size()); }
+
+    // fn(index) for every index in [0, count)
+    template< typename Fn >
+    void ParallelFor(u32 count, Fn&& fn)
+    {
+        if (count == 0)
+            return;
+
+        std::unique_lock< std::mutex > submitLock(m_SubmitMutex, std::try_to_lock);
+        if (count == 1 || m_Workers.empty() || !submitLock.owns_lock())
+        {
+            for (u32 i = 0; i < count; ++i)
+                fn(i);
+            return;
+        }
+
+        const std::function< void(u32) > task = std::ref(fn);
+
+        Job job;
+        job.pTask = &task;
+        job.count = count;
+        {
+            std::lock_guard< std::mutex > lock(m_Mutex);
+            m_pJob = &job;
+            ++m_JobGeneration;
+        }
+        m_WakeCv.notify_all();
+
+        RunJob(job);
+
+        // 'job' lives on this stack frame; no worker may still hold it on return
+        std::unique_lock< std::mutex > lock(m_Mutex);
+        m_DoneCv.wait(lock, [&job] { return job.numDone.load() == job.count && job.numWorkersInside == 0; });
+        m_pJob = nullptr;
+    }
+
+private:
+    static constexpr u32 kMaxWorkers = 15;
+
+    struct Job
+    {
+        const std::function< void(u32) >* pTask = nullptr;
+
+        u32                count            = 0;
+        std::atomic< u32 > nextIndex        = 0;
+        std::atomic< u32 > numDone          = 0;
+        u32                numWorkersInside = 0; // guarded by m_Mutex
+    };
+
+    static void RunJob(Job& job)
+    {
+        for (u32 i = job.nextIndex.fetch_add(1); i < job.count; i = job.nextIndex.fetch_add(1))
+        {
+            (*job.pTask)(i);
+            job.numDone.fetch_add(1);
+        }
+    }
+
+    void WorkerLoop()
+    {
+        u64 seenGeneration = 0;
+
+        std::unique_lock< std::mutex > lock(m_Mutex);
+        while (true)
+        {
+            m_WakeCv.wait(lock, [this, seenGeneration] { return m_bStop || (m_pJob && m_JobGeneration != seenGeneration); });
+            if (m_bStop)
+                return;
+
+            seenGeneration = m_JobGeneration;
+
+            Job& job = *m_pJob;
+            ++job.numWorkersInside;
+
+            lock.unlock();
+            RunJob(job);
+            lock.lock();
+
+            if (--job.numWorkersInside == 0)
+                m_DoneCv.notify_all();
+        }
+    }
+
+    std::vector< std::thread > m_Workers;
+
+    std::mutex              m_SubmitMutex;
+    std::mutex              m_Mutex;
+    std::condition_variable m_WakeCv;
+    std::condition_variable m_DoneCv;
+
+    Job* m_pJob          = nullptr;
+    u64  m_JobGeneration = 0;
+    bool m_bStop         = false;
+};
+
+} // namespace baamboo
@@ -33,6 +33,28 @@ public:
         m_cv.notify_one();
     }
 
+    // blocks while the queue is full instead of replacing, so every value gets consumed; false once closed
+    bool push_wait(T&& value, uint32_t capacity)
+    {
+        std::unique_lock< std::mutex > lock(m_mutex);
+        m_cv.wait(lock, [this, capacity] { return m_queue.size() < capacity || m_closed; });
+        if (m_closed)
+            return false;
+
+        m_queue.push(std::move(value));
+
+        m_cv.notify_all();
+        return true;
+    }
+
+    // blocks until a push_wait of the same capacity would not; false once closed
+    bool wait_for_space(uint32_t capacity)
+    {
+        std::unique_lock< std::mutex > lock(m_mutex);
+        m_cv.wait(lock, [this, capacity] { return m_queue.size() < capacity || m_closed; });
+        return !m_closed;
+    }
+
     std::optional< T > try_pop()
     {
         std::lock_guard< std::mutex > lock(m_mutex);
@@ -41,6 +63,7 @@ public:
 
         T value = std::move(m_queue.front());
         m_queue.pop();
+        m_cv.notify_all(); // wakes push_wait
         return value;
     }
 
@@ -53,17 +76,22 @@ public:
         {
             T value = std::move(m_queue.front());
             m_queue.pop();
+            m_cv.notify_all(); // wakes push_wait
             return value;
         }
 
         return std::nullopt;
     }
 
-    void clear()
+    // returns how many values were dropped
+    size_t clear()
     {
         std::lock_guard< std::mutex > lock(m_mutex);
 
+        const size_t numDropped = m_queue.size();
         m_queue = std::queue< T >();
+        m_cv.notify_all();
+        return numDropped;
     }
 
     bool empty() const
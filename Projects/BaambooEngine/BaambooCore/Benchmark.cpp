@@ -0,0 +1,321 @@
+#include "BaambooPch.h"
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <nlohmann/json.hpp>
+
+namespace baamboo
+{
+
+namespace
+{
+
+constexpr double kNoSample = std::numeric_limits< double >::quiet_NaN();
+
+float3 CatmullRom(const float3& p0, const float3& p1, const float3& p2, const float3& p3, float t)
+{
+	const float t2 = t * t;
+	const float t3 = t2 * t;
+	return 0.5f * ((2.0f * p1)
+		+ (p2 - p0) * t
+		+ (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2
+		+ (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+}
+
+float3 ReadFloat3(const nlohmann::json& value, const float3& fallback)
+{
+	if (!value.is_array() || value.size() != 3)
+		return fallback;
+	return float3(value[0].get< float >(), value[1].get< float >(), value[2].get< float >());
+}
+
+// Nearest rank on sorted samples
+double Percentile(const std::vector< double >& sorted, double pct)
+{
+	const size_t rank = static_cast< size_t >(std::ceil(pct / 100.0 * double(sorted.size())));
+	return sorted[std::clamp< size_t >(rank, 1, sorted.size()) - 1];
+}
+
+} // anonymous namespace
+
+bool Benchmark::LoadConfig(const fs::path& path, Config& outConfig)
+{
+	std::ifstream file(path);
+	if (!file.is_open())
+	{
+		printf("[Benchmark] failed to open '%s'\n", path.string().c_str());
+		return false;
+	}
+
+	try
+	{
+		const auto json = nlohmann::json::parse(file);
+
+		Config config;
+		config.name            = json.value("name", path.stem().string());
+		config.app             = json.value("app", config.app);
+		config.api             = json.value("api", config.api);
+		config.seed            = json.value("seed", config.seed);
+		config.numFrames       = json.value("frames", config.numFrames);
+		config.numWarmupFrames = json.value("warmupFrames", config.numWarmupFrames);
+		config.dt              = json.value("dt", config.dt);
+		config.bCpuOnly        = json.value("cpuOnly", config.bCpuOnly);
+		config.outputPath      = json.value("output", std::string());
+
+		if (json.contains("camera"))
+		{
+			const auto& camera = json["camera"];
+			config.bLoopCamera = camera.value("loop", false);
+			for (const auto& key : camera.value("keys", nlohmann::json::array()))
+			{
+				CameraKey cameraKey;
+				cameraKey.position = ReadFloat3(key.value("position", nlohmann::json()), cameraKey.position);
+				cameraKey.target   = ReadFloat3(key.value("target", nlohmann::json()), cameraKey.target);
+				config.cameraPath.push_back(cameraKey);
+			}
+		}
+
+		const auto budgetsJson = json.value("memoryBudgetsMB", nlohmann::json::object());
+		for (const auto& [tagName, budgetMB] : budgetsJson.items())
+		{
+			u32 tagIdx = 0;
+			while (tagIdx < static_cast< u32 >(render::eMemoryTag::Count) && tagName != render::MemoryTagName(render::eMemoryTag(tagIdx)))
+				++tagIdx;
+			if (tagIdx == static_cast< u32 >(render::eMemoryTag::Count))
+			{
+				printf("[Benchmark] '%s' has a budget for unknown memory tag '%s'\n", path.string().c_str(), tagName.c_str());
+				return false;
+			}
+			config.memoryBudgets.emplace_back(render::eMemoryTag(tagIdx), static_cast< u64 >(budgetMB.get< double >() * 1024.0 * 1024.0));
+		}
+
+		if (config.numFrames == 0 || config.dt <= 0.0f)
+		{
+			printf("[Benchmark] '%s' needs frames > 0 and dt > 0\n", path.string().c_str());
+			return false;
+		}
+
+		outConfig = std::move(config);
+		return true;
+	}
+	catch (const nlohmann::json::exception& e)
+	{
+		printf("[Benchmark] failed to parse '%s': %s\n", path.string().c_str(), e.what());
+		return false;
+	}
+}
+
+Benchmark::Benchmark(Config&& config)
+	: m_Config(std::move(config))
+{
+	if (m_Config.outputPath.empty())
+		m_Config.outputPath = OUTPUT_PATH / "Benchmark" / (m_Config.name + ".csv");
+
+	m_Rows.resize(m_Config.numFrames);
+}
+
+void Benchmark::Start(u64 firstSequence)
+{
+	m_FirstSequence = firstSequence;
+	m_NumProduced   = 0;
+	m_NumConsumed   = 0;
+	m_NumAnomalies  = 0;
+
+	printf("[Benchmark] '%s': %u frames (+%u warm-up) at a fixed %.2f ms%s\n", m_Config.name.c_str(),
+		m_Config.numFrames, m_Config.numWarmupFrames, m_Config.dt * 1000.0f, m_Config.bCpuOnly ? ", CPU only" : "");
+}
+
+Benchmark::CameraKey Benchmark::EvaluateCamera(u64 sequence) const
+{
+	const auto& keys = m_Config.cameraPath;
+	if (keys.size() < 2)
+		return keys.empty() ? CameraKey{} : keys[0];
+
+	// Warm-up frames sit on the first key
+	const u64   frame = sequence - m_FirstSequence;
+	const u64   index = frame > m_Config.numWarmupFrames ? frame - m_Config.numWarmupFrames : 0;
+	const float t     = m_Config.numFrames > 1 ? std::min(float(index) / float(m_Config.numFrames - 1), 1.0f) : 0.0f;
+
+	const i64   numKeys     = static_cast< i64 >(keys.size());
+	const i64   numSegments = m_Config.bLoopCamera ? numKeys : numKeys - 1;
+	const float u           = t * float(numSegments);
+	const i64   segment     = std::min(static_cast< i64 >(u), numSegments - 1);
+	const float local       = u - float(segment);
+
+	auto Key = [&](i64 i) -> const CameraKey&
+	{
+		return m_Config.bLoopCamera ? keys[((i % numKeys) + numKeys) % numKeys] : keys[std::clamp< i64 >(i, 0, numKeys - 1)];
+	};
+	const CameraKey& k0 = Key(segment - 1);
+	const CameraKey& k1 = Key(segment);
+	const CameraKey& k2 = Key(segment + 1);
+	const CameraKey& k3 = Key(segment + 2);
+
+	return {
+		.position = CatmullRom(k0.position, k1.position, k2.position, k3.position, local),
+		.target   = CatmullRom(k0.target, k1.target, k2.target, k3.target, local),
+	};
+}
+
+void Benchmark::WaitForConsumed()
+{
+	std::unique_lock< std::mutex > lock(m_ConsumedMutex);
+	m_ConsumedCv.wait(lock, [this] { return m_NumConsumed >= m_NumProduced; });
+}
+
+void Benchmark::Consumed(u64 numViews)
+{
+	{
+		std::lock_guard< std::mutex > lock(m_ConsumedMutex);
+		m_NumConsumed += numViews;
+	}
+	m_ConsumedCv.notify_all();
+}
+
+void Benchmark::NoteAnomaly(u64 sequence)
+{
+	if (sequence < m_FirstSequence)
+		return;
+
+	const u64 frame = sequence - m_FirstSequence;
+	if (frame >= m_Config.numWarmupFrames && frame - m_Config.numWarmupFrames < m_Config.numFrames)
+		++m_NumAnomalies;
+}
+
+void Benchmark::Sample(u64 sequence, eBenchmarkColumn column, render::ProfileScopeId scopeId, double value)
+{
+	if (sequence < m_FirstSequence || scopeId == render::kInvalidProfileScope)
+		return;
+
+	const u64 frame = sequence - m_FirstSequence;
+	if (frame < m_Config.numWarmupFrames || frame - m_Config.numWarmupFrames >= m_Config.numFrames)
+		return;
+
+	std::lock_guard< std::mutex > lock(m_SampleMutex);
+
+	const u64 key  = (u64(column) << 32) | scopeId;
+	auto      iter = m_ColumnIndices.find(key);
+	if (iter == m_ColumnIndices.end())
+	{
+		iter = m_ColumnIndices.emplace(key, static_cast< u32 >(m_Columns.size())).first;
+		m_Columns.emplace_back(column, scopeId);
+	}
+
+	auto& row = m_Rows[frame - m_Config.numWarmupFrames];
+	if (row.size() <= iter->second)
+		row.resize(m_Columns.size(), kNoSample);
+
+	double& cell = row[iter->second];
+	cell = std::isnan(cell) ? value : cell + value;
+}
+
+std::string Benchmark::ColumnName(u32 columnIdx) const
+{
+	const auto& [column, scopeId] = m_Columns[columnIdx];
+
+	const char* prefix = "count:";
+	switch (column)
+	{
+	case eBenchmarkColumn::Cpu:    prefix = "cpu:"; break;
+	case eBenchmarkColumn::Gpu:    prefix = "gpu:"; break;
+	case eBenchmarkColumn::Memory: prefix = "mem:"; break;
+	default: break;
+	}
+	return prefix + std::string(render::ProfileScopeRegistry::Name(scopeId));
+}
+
+std::vector< Benchmark::ColumnSummary > Benchmark::Summarize() const
+{
+	std::lock_guard< std::mutex > lock(m_SampleMutex);
+
+	std::vector< ColumnSummary > summary;
+	summary.reserve(m_Columns.size());
+
+	std::vector< double > samples;
+	samples.reserve(m_Rows.size());
+	for (u32 columnIdx = 0; columnIdx < static_cast< u32 >(m_Columns.size()); ++columnIdx)
+	{
+		samples.clear();
+		for (const auto& row : m_Rows)
+		{
+			if (columnIdx < row.size() && !std::isnan(row[columnIdx]))
+				samples.push_back(row[columnIdx]);
+		}
+		if (samples.empty())
+			continue;
+
+		std::sort(samples.begin(), samples.end());
+
+		double sum = 0.0;
+		for (double sample : samples)
+			sum += sample;
+
+		ColumnSummary& column = summary.emplace_back();
+		column.name       = ColumnName(columnIdx);
+		column.numSamples = static_cast< u32 >(samples.size());
+		column.mean       = sum / double(samples.size());
+		column.p50        = Percentile(samples, 50.0);
+		column.p95        = Percentile(samples, 95.0);
+		column.p99        = Percentile(samples, 99.0);
+	}
+
+	std::sort(summary.begin(), summary.end(), [](const ColumnSummary& lhs, const ColumnSummary& rhs) { return lhs.name < rhs.name; });
+	return summary;
+}
+
+void Benchmark::PrintSummary(const std::vector< ColumnSummary >& summary) const
+{
+	printf("[Benchmark] '%s' summary over %u frames\n", m_Config.name.c_str(), m_Config.numFrames);
+	printf("  %-40s %10s %10s %10s %10s\n", "column", "mean", "p50", "p95", "p99");
+	for (const auto& column : summary)
+		printf("  %-40s %10.3f %10.3f %10.3f %10.3f\n", column.name.c_str(), column.mean, column.p50, column.p95, column.p99);
+	printf("  frame anomalies captured: %u\n", NumAnomalies());
+}
+
+bool Benchmark::WriteCsv() const
+{
+	std::lock_guard< std::mutex > lock(m_SampleMutex);
+
+	std::error_code ec;
+	fs::create_directories(m_Config.outputPath.parent_path(), ec);
+
+	std::ofstream file(m_Config.outputPath, std::ios::out | std::ios::trunc);
+	if (!file.is_open())
+	{
+		printf("[Benchmark] failed to open '%s' for writing\n", m_Config.outputPath.string().c_str());
+		return false;
+	}
+
+	file << "frame";
+	for (u32 columnIdx = 0; columnIdx < static_cast< u32 >(m_Columns.size()); ++columnIdx)
+		file << ',' << ColumnName(columnIdx);
+	file << '\n';
+
+	file << std::fixed << std::setprecision(4);
+	for (size_t frame = 0; frame < m_Rows.size(); ++frame)
+	{
+		file << frame;
+		for (u32 columnIdx = 0; columnIdx < static_cast< u32 >(m_Columns.size()); ++columnIdx)
+		{
+			file << ',';
+			if (columnIdx < m_Rows[frame].size() && !std::isnan(m_Rows[frame][columnIdx]))
+				file << m_Rows[frame][columnIdx];
+		}
+		file << '\n';
+	}
+
+	if (!file.good())
+	{
+		printf("[Benchmark] failed to write '%s'\n", m_Config.outputPath.string().c_str());
+		return false;
+	}
+
+	printf("[Benchmark] wrote %zu frames x %zu columns to '%s'\n", m_Rows.size(), m_Columns.size(), m_Config.outputPath.string().c_str());
+	return true;
+}
+
+} // namespace baamboo
@@ -0,0 +1,133 @@
+#pragma once
+#include "RenderCommon/ProfileScope.h"
+#include "RenderCommon/MemoryTracker.h"
+
+#include <condition_variable>
+
+namespace baamboo
+{
+
+enum class eBenchmarkColumn : u8
+{
+	Cpu,     // ms: game-thread stages and render-thread profiler scopes
+	Gpu,     // ms: GPU profiler scopes
+	Counter, // pipeline statistics and draw counts
+	Memory,  // MB: memory tags and GPU heaps
+};
+
+// =========================================================================
+// Benchmark — a scripted, fixed-step run of the engine.
+//
+//   The config (JSON) names the app, the scene seed, the number of frames,
+//   the simulation dt and a camera path. While it runs the engine steps the
+//   simulation by that dt, moves the camera along the path (Catmull-Rom
+//   through the keys, evenly spread over the measured frames), never drops
+//   a render view, and samples every frame into columns keyed by profile
+//   scope. Game-thread columns belong to the frame they're sampled for;
+//   render-thread profiler and GPU columns hold the latest results resolved
+//   while that frame was processed (one and a few frames behind), which
+//   leaves the percentiles over the run unchanged. Memory budgets are
+//   checked against each tag's peak when the run finishes.
+// =========================================================================
+class Benchmark
+{
+public:
+	struct CameraKey
+	{
+		float3 position = float3(0.0f);
+		float3 target   = float3(0.0f, 0.0f, 1.0f);
+	};
+
+	struct Config
+	{
+		std::string name = "benchmark";
+		std::string app  = "Example";
+		std::string api  = "D3D12";
+		u32         seed = 42;
+
+		u32   numFrames       = 600;
+		u32   numWarmupFrames = 60; // run, but not sampled
+		float dt              = 1.0f / 60.0f;
+		bool  bCpuOnly        = false; // game thread only: render views are built, then dropped
+
+		fs::path outputPath; // CSV, Output/Benchmark/<name>.csv if empty
+
+		std::vector< CameraKey > cameraPath; // empty keeps the app's camera
+		bool                     bLoopCamera = false;
+
+		std::vector< std::pair< render::eMemoryTag, u64 > > memoryBudgets; // bytes; "memoryBudgetsMB" in the config
+	};
+
+	struct ColumnSummary
+	{
+		std::string name; // "cpu:GameLoop", "gpu:Frame", "count:Instances", "mem:Textures", ...
+		u32         numSamples = 0;
+		double      mean       = 0.0;
+		double      p50        = 0.0;
+		double      p95        = 0.0;
+		double      p99        = 0.0;
+	};
+
+	[[nodiscard]]
+	static bool LoadConfig(const fs::path& path, Config& outConfig);
+
+	explicit Benchmark(Config&& config);
+
+	[[nodiscard]]
+	const Config& GetConfig() const { return m_Config; }
+
+	// **
+	// Game thread
+	// **
+	void Start(u64 firstSequence);
+	void Produced() { ++m_NumProduced; }
+	[[nodiscard]]
+	bool IsProducing() const { return m_NumProduced < u64(m_Config.numWarmupFrames) + m_Config.numFrames; }
+	[[nodiscard]]
+	CameraKey EvaluateCamera(u64 sequence) const;
+	// Blocks until every produced render view was consumed
+	void WaitForConsumed();
+
+	// **
+	// Either thread; 'sequence' is the render view's producer sequence. A scope that
+	// repeats within a frame adds up.
+	// **
+	void Sample(u64 sequence, eBenchmarkColumn column, render::ProfileScopeId scopeId, double value);
+	// Once per render view the render thread is done with (the game thread's, in CPU-only runs),
+	// or for views dropped unrendered, so WaitForConsumed never waits on them
+	void Consumed(u64 numViews = 1);
+	// A frame anomaly was captured while processing this render view
+	void NoteAnomaly(u64 sequence);
+
+	[[nodiscard]]
+	std::vector< ColumnSummary > Summarize() const;
+	void PrintSummary(const std::vector< ColumnSummary >& summary) const;
+	bool WriteCsv() const;
+
+	[[nodiscard]]
+	u64 NumProduced() const { return m_NumProduced; }
+	[[nodiscard]]
+	u32 NumAnomalies() const { return m_NumAnomalies.load(); }
+
+private:
+	[[nodiscard]]
+	std::string ColumnName(u32 columnIdx) const;
+
+	Config m_Config;
+
+	u64 m_FirstSequence = 0;
+	u64 m_NumProduced   = 0; // game thread only
+
+	std::mutex              m_ConsumedMutex;
+	std::condition_variable m_ConsumedCv;
+	u64                     m_NumConsumed = 0;
+
+	mutable std::mutex                                                 m_SampleMutex;
+	std::unordered_map< u64, u32 >                                     m_ColumnIndices; // (column kind << 32 | scope ID) -> index
+	std::vector< std::pair< eBenchmarkColumn, render::ProfileScopeId > > m_Columns;
+	std::vector< std::vector< double > >                               m_Rows;          // [measured frame][column], NaN = no sample
+
+	std::atomic< u32 > m_NumAnomalies = 0; // measured frames only
+};
+
+} // namespace baamboo
@@ -0,0 +1,226 @@
+#include "BaambooPch.h"
+#include "PerfGate.h"
+
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace baamboo
+{
+
+namespace
+{
+
+// Unset fields inherit from the enclosing level
+PerfGate::Tolerance ReadTolerance(const nlohmann::json& json, const PerfGate::Tolerance& parent)
+{
+	PerfGate::Tolerance tolerance = parent;
+	tolerance.p50Pct     = json.value("p50Pct", parent.p50Pct);
+	tolerance.p95Pct     = json.value("p95Pct", parent.p95Pct);
+	tolerance.p99Pct     = json.value("p99Pct", parent.p99Pct);
+	tolerance.minDeltaMs = json.value("minDeltaMs", parent.minDeltaMs);
+	return tolerance;
+}
+
+nlohmann::json WriteTolerance(const PerfGate::Tolerance& tolerance)
+{
+	return {
+		{ "p50Pct", tolerance.p50Pct },
+		{ "p95Pct", tolerance.p95Pct },
+		{ "p99Pct", tolerance.p99Pct },
+		{ "minDeltaMs", tolerance.minDeltaMs },
+	};
+}
+
+bool IsTimingColumn(const std::string& column)
+{
+	return column.starts_with("cpu:") || column.starts_with("gpu:");
+}
+
+} // anonymous namespace
+
+PerfGate::ScenarioResult PerfGate::Collect(const Benchmark& benchmark)
+{
+	return {
+		.name         = benchmark.GetConfig().name,
+		.summary      = benchmark.Summarize(),
+		.numAnomalies = benchmark.NumAnomalies(),
+		.bComplete    = !benchmark.IsProducing(),
+	};
+}
+
+bool PerfGate::Load(const fs::path& path, bool bAllowMissing)
+{
+	std::ifstream file(path);
+	if (!file.is_open())
+	{
+		if (bAllowMissing)
+			return true;
+
+		printf("[PerfGate] failed to open baseline '%s'\n", path.string().c_str());
+		return false;
+	}
+
+	try
+	{
+		const auto json = nlohmann::json::parse(file);
+
+		m_Tolerance = ReadTolerance(json.value("tolerance", nlohmann::json::object()), Tolerance{});
+		m_Scenarios.clear();
+
+		const auto scenariosJson = json.value("scenarios", nlohmann::json::object());
+		for (const auto& [scenarioName, scenarioJson] : scenariosJson.items())
+		{
+			Scenario& scenario = m_Scenarios[scenarioName];
+			if (scenarioJson.contains("tolerance"))
+				scenario.tolerance = ReadTolerance(scenarioJson["tolerance"], m_Tolerance);
+			if (scenarioJson.contains("maxAnomalies"))
+				scenario.maxAnomalies = scenarioJson["maxAnomalies"].get< u32 >();
+
+			const Tolerance& scenarioTolerance = scenario.tolerance ? *scenario.tolerance : m_Tolerance;
+			const auto       columnsJson       = scenarioJson.value("columns", nlohmann::json::object());
+			for (const auto& [columnName, columnJson] : columnsJson.items())
+			{
+				Entry& entry = scenario.columns[columnName];
+				entry.p50 = columnJson.value("p50", 0.0);
+				entry.p95 = columnJson.value("p95", 0.0);
+				entry.p99 = columnJson.value("p99", 0.0);
+				if (columnJson.contains("tolerance"))
+					entry.tolerance = ReadTolerance(columnJson["tolerance"], scenarioTolerance);
+			}
+		}
+		return true;
+	}
+	catch (const nlohmann::json::exception& e)
+	{
+		printf("[PerfGate] failed to parse baseline '%s': %s\n", path.string().c_str(), e.what());
+		return false;
+	}
+}
+
+bool PerfGate::Save(const fs::path& path) const
+{
+	nlohmann::json json;
+	json["tolerance"] = WriteTolerance(m_Tolerance);
+
+	auto& scenariosJson = json["scenarios"] = nlohmann::json::object();
+	for (const auto& [scenarioName, scenario] : m_Scenarios)
+	{
+		auto& scenarioJson = scenariosJson[scenarioName];
+		if (scenario.tolerance)
+			scenarioJson["tolerance"] = WriteTolerance(*scenario.tolerance);
+		if (scenario.maxAnomalies)
+			scenarioJson["maxAnomalies"] = *scenario.maxAnomalies;
+
+		auto& columnsJson = scenarioJson["columns"] = nlohmann::json::object();
+		for (const auto& [columnName, entry] : scenario.columns)
+		{
+			auto& columnJson = columnsJson[columnName];
+			columnJson["p50"] = entry.p50;
+			columnJson["p95"] = entry.p95;
+			columnJson["p99"] = entry.p99;
+			if (entry.tolerance)
+				columnJson["tolerance"] = WriteTolerance(*entry.tolerance);
+		}
+	}
+
+	std::error_code ec;
+	fs::create_directories(path.parent_path(), ec);
+
+	std::ofstream file(path, std::ios::out | std::ios::trunc);
+	if (!file.is_open())
+	{
+		printf("[PerfGate] failed to open baseline '%s' for writing\n", path.string().c_str());
+		return false;
+	}
+	file << json.dump(2) << '\n';
+
+	printf("[PerfGate] wrote baseline for %zu scenarios to '%s'\n", m_Scenarios.size(), path.string().c_str());
+	return file.good();
+}
+
+std::vector< PerfGate::Regression > PerfGate::Check(const ScenarioResult& result) const
+{
+	std::vector< Regression > regressions;
+
+	auto iter = m_Scenarios.find(result.name);
+	if (iter == m_Scenarios.end())
+	{
+		regressions.push_back({ .scenario = result.name, .bMissing = true });
+		return regressions;
+	}
+	const Scenario& scenario = iter->second;
+
+	for (const auto& [columnName, entry] : scenario.columns)
+	{
+		auto column = std::find_if(result.summary.begin(), result.summary.end(),
+			[&columnName](const Benchmark::ColumnSummary& summary) { return summary.name == columnName; });
+		if (column == result.summary.end())
+		{
+			regressions.push_back({ .scenario = result.name, .column = columnName, .baseline = entry.p50, .bMissing = true });
+			continue;
+		}
+
+		const Tolerance& tolerance = entry.tolerance ? *entry.tolerance : scenario.tolerance ? *scenario.tolerance : m_Tolerance;
+		auto CheckPercentile = [&](const char* percentile, double baseline, double current, double pct)
+		{
+			const double limit = baseline * (1.0 + pct / 100.0);
+			if (current > limit && current - baseline > tolerance.minDeltaMs)
+				regressions.push_back({ result.name, columnName, percentile, baseline, current, limit });
+		};
+		CheckPercentile("p50", entry.p50, column->p50, tolerance.p50Pct);
+		CheckPercentile("p95", entry.p95, column->p95, tolerance.p95Pct);
+		CheckPercentile("p99", entry.p99, column->p99, tolerance.p99Pct);
+	}
+
+	if (scenario.maxAnomalies && result.numAnomalies > *scenario.maxAnomalies)
+	{
+		regressions.push_back({ result.name, "anomalies", "count",
+			double(*scenario.maxAnomalies), double(result.numAnomalies), double(*scenario.maxAnomalies) });
+	}
+	return regressions;
+}
+
+void PerfGate::Update(const ScenarioResult& result)
+{
+	Scenario& scenario = m_Scenarios[result.name];
+
+	std::map< std::string, Entry > columns;
+	for (const auto& summary : result.summary)
+	{
+		if (!IsTimingColumn(summary.name))
+			continue;
+
+		Entry& entry = columns[summary.name];
+		entry.p50 = summary.p50;
+		entry.p95 = summary.p95;
+		entry.p99 = summary.p99;
+
+		auto previous = scenario.columns.find(summary.name);
+		if (previous != scenario.columns.end())
+			entry.tolerance = previous->second.tolerance;
+	}
+	scenario.columns = std::move(columns);
+}
+
+void PerfGate::PrintRegressions(const std::vector< Regression >& regressions)
+{
+	printf("[PerfGate] %zu regression(s):\n", regressions.size());
+	for (const auto& regression : regressions)
+	{
+		if (regression.bMissing)
+		{
+			if (regression.column.empty())
+				printf("  %-24s has no baseline; record one with --update-baseline\n", regression.scenario.c_str());
+			else
+				printf("  %-24s %-40s has no samples this run (baseline p50 %.3f)\n", regression.scenario.c_str(), regression.column.c_str(), regression.baseline);
+			continue;
+		}
+
+		printf("  %-24s %-40s %-5s %10.3f > %10.3f (baseline %.3f, %+.1f%%)\n",
+			regression.scenario.c_str(), regression.column.c_str(), regression.percentile.c_str(),
+			regression.current, regression.limit, regression.baseline,
+			regression.baseline > 0.0 ? (regression.current / regression.baseline - 1.0) * 100.0 : 0.0);
+	}
+}
+
+} // namespace baamboo
@@ -0,0 +1,92 @@
+#pragma once
+#include "Benchmark.h"
+
+#include <map>
+#include <optional>
+
+namespace baamboo
+{
+
+// =========================================================================
+// PerfGate — benchmark results checked against a stored baseline.
+//
+//   The baseline (JSON) holds p50/p95/p99 per column for every named
+//   scenario, recorded from an earlier run with Update(). Check() flags a
+//   column when a percentile grows past its tolerance: a relative one per
+//   percentile, ignored below an absolute floor so sub-0.05 ms scopes don't
+//   trip on noise. Tolerances are set globally and can be overridden per
+//   scenario and per column. Only timing columns (cpu:/gpu:) are recorded;
+//   counters move with culling and would gate on noise. A scenario can also
+//   cap the number of frame anomalies captured during its run. A scenario
+//   without a baseline, or a baseline column without samples, fails the
+//   check too, so a renamed scenario or a dropped scope can't pass unseen;
+//   recording with Update() is the only way to accept them.
+// =========================================================================
+class PerfGate
+{
+public:
+	struct Tolerance
+	{
+		double p50Pct     = 5.0;
+		double p95Pct     = 10.0;
+		double p99Pct     = 20.0;
+		double minDeltaMs = 0.05;
+	};
+
+	struct ScenarioResult
+	{
+		std::string                            name;
+		std::vector< Benchmark::ColumnSummary > summary;
+		u32                                    numAnomalies = 0;
+		bool                                   bComplete    = false;
+	};
+
+	struct Regression
+	{
+		std::string scenario;
+		std::string column;     // or "anomalies", empty for a scenario without a baseline
+		std::string percentile; // "p50", "p95", "p99", "count"
+		double      baseline = 0.0;
+		double      current  = 0.0;
+		double      limit    = 0.0;
+
+		bool bMissing = false; // nothing to compare: no baseline, or no samples this run
+	};
+
+	[[nodiscard]]
+	static ScenarioResult Collect(const Benchmark& benchmark);
+
+	// A missing file is an empty baseline when 'bAllowMissing'
+	bool Load(const fs::path& path, bool bAllowMissing);
+	bool Save(const fs::path& path) const;
+
+	[[nodiscard]]
+	std::vector< Regression > Check(const ScenarioResult& result) const;
+	// Replaces the scenario's recorded percentiles, keeping its tolerances
+	void Update(const ScenarioResult& result);
+
+	static void PrintRegressions(const std::vector< Regression >& regressions);
+
+private:
+	struct Entry
+	{
+		double p50 = 0.0;
+		double p95 = 0.0;
+		double p99 = 0.0;
+
+		std::optional< Tolerance > tolerance;
+	};
+
+	struct Scenario
+	{
+		std::map< std::string, Entry > columns;
+
+		std::optional< Tolerance > tolerance;
+		std::optional< u32 >       maxAnomalies;
+	};
+
+	Tolerance                         m_Tolerance;
+	std::map< std::string, Scenario > m_Scenarios; // ordered, so saved baselines diff cleanly
+};
+
+} // namespace baamboo
@@ -4,10 +4,18 @@
 #include "BaambooCore/EngineCore.h"
 #include "BaambooCore/Input.hpp"
 #include "BaambooScene/Entity.h"
+#include "BaambooScene/Systems/TransformSystem.h"
+#include "BaambooScene/Systems/AnimationSystem.h"
+#include "BaambooScene/Systems/SpatialSystem.h"
+#include "BaambooScene/Systems/ScriptSystem.h"
 #include "RenderCommon/RenderDevice.h"
 #include "RenderCommon/CommandContext.h"
 #include "RenderCommon/CpuProfiler.h"
+#include "RenderCommon/PermutationCache.h"
+#include "RenderCommon/PipelineBuildQueue.h"
+#include "RenderCommon/TraceRecorder.h"
 #include "ThreadQueue.hpp"
+#include "TaskScheduler.hpp"
 #include "Utils/Math.hpp"
 
 #include <filesystem>
@@ -129,7 +137,7 @@ void Engine::Initialize(eRendererAPI eApi)
 		throw std::runtime_error("Failed to initialize window!");
 	if (!LoadRenderer(s_RendererAPI, m_pWindow, m_DeviceSettings, pImGuiContext, &m_pRendererBackend))
 		throw std::runtime_error("Failed to load backend!");
-	if (!LoadScene())
+	if (!BuildScene())
 		throw std::runtime_error("Failed to create scene!");
 
 	auto pDevice = m_pRendererBackend->GetDevice();
@@ -153,17 +161,23 @@ void Engine::Initialize(eRendererAPI eApi)
 
 i32 Engine::Run()
 {
+	render::TraceRecorder::SetThreadName("GameThread");
+	if (m_pBenchmark)
+		StartBenchmark();
+
 	m_RenderViewQueue.open();
 
 	m_bRunning = true;
 	m_RunningTime = 0.0;
 
-	m_RenderThread = std::thread(&Engine::RenderLoop, this);
+	if (!m_pBenchmark || !m_pBenchmark->GetConfig().bCpuOnly)
+		m_RenderThread = std::thread(&Engine::RenderLoop, this);
 	while (m_pWindow->PollEvent())
 	{
 		m_GameTimer.Tick();
 
-		auto dt        = m_GameTimer.GetDeltaSeconds();
+		// Benchmarks step the simulation by a fixed dt so every run simulates the same frames
+		auto dt        = m_pBenchmark ? double(m_pBenchmark->GetConfig().dt) : m_GameTimer.GetDeltaSeconds();
 		m_RunningTime += dt;
 
 		if (m_GameTimer.GetTotalSeconds() > 1.0)
@@ -176,8 +190,14 @@ i32 Engine::Run()
 		Update(static_cast<float>(dt));
 
 		Input::Inst()->EndFrame();
+
+		if (m_pBenchmark && !m_pBenchmark->IsProducing())
+			break;
 	}
 
+	if (m_pBenchmark)
+		return FinishBenchmark();
+
 	m_bRunning = false;
 	return 0;
 }
@@ -189,7 +209,7 @@ void Engine::Update(float dt)
 		if (m_ResizeWidth == 0 || m_ResizeHeight == 0)
 		{
 			std::lock_guard< std::mutex > lock(m_ImGuiMutex);
-			m_RenderViewQueue.clear();
+			ClearRenderViews();
 			m_PendingResize = {};
 			m_bRenderSuspended = true;
 			return;
@@ -199,7 +219,7 @@ void Engine::Update(float dt)
 			std::lock_guard< std::mutex > lock(m_ImGuiMutex);
 			m_pWindow->OnWindowResized(m_ResizeWidth, m_ResizeHeight);
 			m_pCamera->Resize(m_ResizeWidth, m_ResizeHeight);
-			m_RenderViewQueue.clear();
+			ClearRenderViews();
 			m_PendingResize.width = static_cast< u32 >(m_ResizeWidth);
 			m_PendingResize.height = static_cast< u32 >(m_ResizeHeight);
 			m_PendingResize.firstProducerSequence = m_ProducerSequence;
@@ -229,6 +249,7 @@ void Engine::Release()
 	ImGui::EntityDeletionQueue.clear(); // pending deletes hold Entity handles into the dying scene
 
 	m_pRendererBackend->WaitIdle();
+	render::ComputePermutationCache::SaveRecordedPermutations();
 
 	RELEASE(m_pCamera);
 	RELEASE(m_pScene);
@@ -283,7 +304,7 @@ bool Engine::ReloadScene()
 	m_bWindowResized = false;
 	m_ResizeWidth = m_ResizeHeight = -1;
 
-	if (!LoadScene())
+	if (!BuildScene())
 		return false;
 
 	m_RenderViewQueue.open();
@@ -292,46 +313,159 @@ bool Engine::ReloadScene()
 	return true;
 }
 
+bool Engine::BuildScene()
+{
+	// Render nodes build their pipelines while the scene loads; batch the driver compiles
+	render::PipelineBuildScope pipelineBuilds;
+	const bool bLoaded = LoadScene();
+	pipelineBuilds.Flush();
+	return bLoaded;
+}
+
 void Engine::ApplyScriptBehaviors(float dt)
 {
 	if (m_pScene == nullptr)
 		return;
 
-	m_pScene->Registry().view< TransformComponent, ScriptComponent >().each([this, dt](auto id, auto& transformComponent, auto& scriptComponent)
-		{
-			if (scriptComponent.bMove)
-			{
-				transformComponent.transform.position += scriptComponent.moveVelocity * dt;
-				m_pScene->Registry().patch< TransformComponent >(id, [](auto&) {});
-			}
-
-			if (scriptComponent.bRotate)
-			{
-				transformComponent.transform.Rotate(scriptComponent.rotationVelocity.y * dt, scriptComponent.rotationVelocity.x * dt, scriptComponent.rotationVelocity.z * dt);
-				m_pScene->Registry().patch< TransformComponent >(id, [](auto&) {});
-			}
-		});
+	m_pScene->GetScriptSystem()->Update(dt);
 }
 
 void Engine::GameLoop(float dt)
 {
-	ProcessInput();
+	render::TraceRecorder::SetFrame(m_ProducerSequence);
+	BAAMBOO_TRACE_SCOPE("GameLoop");
+	const u64 gameLoopStart = render::CpuTicks::Now();
+
+	// Benchmarks take no live input
+	if (!m_pBenchmark)
+		ProcessInput();
 
 	if (m_pScene == nullptr)
 		return;
 
+	// The render thread takes m_ImGuiMutex mid-frame before popping again, so a full queue is waited
+	// out here rather than in push_wait below. This thread is the only producer; the space stays free.
+	if (m_pBenchmark && !m_pBenchmark->GetConfig().bCpuOnly)
+	{
+		if (!m_RenderViewQueue.wait_for_space(kNumToleranceAsyncFrameGameToRender))
+			return;
+	}
+
 	std::lock_guard< std::mutex > lock(m_ImGuiMutex);
 
+	if (m_pBenchmark && m_pAppCamera)
+	{
+		const auto cameraKey = m_pBenchmark->EvaluateCamera(m_ProducerSequence);
+		m_BenchmarkCameraController.SetLookAt(cameraKey.position, cameraKey.target);
+	}
+
 	ApplyScriptBehaviors(dt);
 	m_pScene->Update(dt, *m_pCamera);
 
 	const u64 producerSequence = m_ProducerSequence++;
+	const u64 renderViewStart  = render::CpuTicks::Now();
 	auto renderView = m_pScene->RenderView(*m_pCamera, float2(m_pWindow->Width(), m_pWindow->Height()), producerSequence, m_pRendererBackend->GetDevice()->GetDeviceSettings());
-	m_RenderViewQueue.push_or_replace(std::move(renderView), kNumToleranceAsyncFrameGameToRender);
+	const u64 renderViewEnd    = render::CpuTicks::Now();
+
+	// Views are replaced rather than accumulated, so the tag holds the latest one
+	m_RenderViewMemory.Clear();
+	m_RenderViewMemory.Add(renderView.SizeInBytes());
+
+	// The render thread closes the flow when it picks the view up; a view replaced in the queue never does
+	static const render::ProfileScopeId s_RenderViewFlow = render::ProfileScopeRegistry::Intern("RenderView");
+	static const render::ProfileScopeId s_QueueDepth     = render::ProfileScopeRegistry::Intern("RenderViewQueue");
+	render::TraceRecorder::FlowOut(s_RenderViewFlow, producerSequence);
+	if (m_pBenchmark)
+	{
+		static const render::ProfileScopeId s_GameLoop   = render::ProfileScopeRegistry::Intern("GameLoop");
+		static const render::ProfileScopeId s_Transform  = render::ProfileScopeRegistry::Intern("TransformSystem");
+		static const render::ProfileScopeId s_Scripts    = render::ProfileScopeRegistry::Intern("ScriptSystem");
+		static const render::ProfileScopeId s_Animation  = render::ProfileScopeRegistry::Intern("AnimationSystem");
+		static const render::ProfileScopeId s_Spatial    = render::ProfileScopeRegistry::Intern("SpatialSystem");
+		static const render::ProfileScopeId s_RenderView = render::ProfileScopeRegistry::Intern("BuildRenderView");
+		m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Cpu, s_Transform, m_pScene->GetTransformSystem()->GetStats().elapsedMs);
+		m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Cpu, s_Scripts, m_pScene->GetScriptSystem()->GetStats().elapsedMs);
+		m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Cpu, s_Animation, m_pScene->GetAnimationSystem()->GetStats().elapsedMs);
+		m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Cpu, s_Spatial, m_pScene->GetSpatialSystem()->GetStats().elapsedMs);
+		m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Cpu, s_RenderView, render::CpuTicks::ToMs(renderViewEnd - renderViewStart));
+		m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Cpu, s_GameLoop, render::CpuTicks::ToMs(render::CpuTicks::Now() - gameLoopStart));
+		SampleBenchmarkMemory(producerSequence);
+		m_pBenchmark->Produced();
+
+		if (m_pBenchmark->GetConfig().bCpuOnly)
+		{
+			m_pBenchmark->Consumed();
+			return;
+		}
+
+		// Never drop a view while benchmarking; the wait for space happened before taking the lock
+		m_RenderViewQueue.push_wait(std::move(renderView), kNumToleranceAsyncFrameGameToRender);
+	}
+	else
+	{
+		m_RenderViewQueue.push_or_replace(std::move(renderView), kNumToleranceAsyncFrameGameToRender);
+	}
+	render::TraceRecorder::Counter(s_QueueDepth, static_cast< double >(m_RenderViewQueue.size()));
+}
+
+void Engine::ClearRenderViews()
+{
+	// A benchmark waits for every view it produced; dropped ones count as consumed
+	const size_t numDropped = m_RenderViewQueue.clear();
+	if (m_pBenchmark && numDropped > 0)
+		m_pBenchmark->Consumed(numDropped);
+}
+
+void Engine::PairQueueProfile(u64 frameIndex, const std::vector< render::GpuProfileEntry >& entries, bool bAsyncCompute)
+{
+	if (frameIndex == render::kNoProfileFrame)
+		return;
+
+	QueueProfilePair& pair = m_QueueProfilePairs[frameIndex % m_QueueProfilePairs.size()];
+	if (pair.frameIndex != frameIndex)
+	{
+		pair.frameIndex       = frameIndex;
+		pair.bHasGraphics     = false;
+		pair.bHasAsyncCompute = false;
+	}
+
+	if (bAsyncCompute)
+	{
+		pair.asyncCompute     = entries;
+		pair.bHasAsyncCompute = true;
+	}
+	else
+	{
+		pair.graphics     = entries;
+		pair.bHasGraphics = true;
+	}
+
+	// Either half may come back first; keep the last paired frame's overlap until both are in
+	if (!pair.bHasGraphics || !pair.bHasAsyncCompute)
+		return;
+
+	m_AsyncComputeOverlapMs = 0.0;
+	for (const auto& computeEntry : pair.asyncCompute)
+	{
+		if (computeEntry.depth != 1)
+			continue;
+
+		for (const auto& graphicsEntry : pair.graphics)
+		{
+			if (graphicsEntry.depth != 1)
+				continue;
+
+			const double beginMs = std::max(computeEntry.beginMs, graphicsEntry.beginMs);
+			const double endMs   = std::min(computeEntry.beginMs + computeEntry.elapsedMs, graphicsEntry.beginMs + graphicsEntry.elapsedMs);
+			m_AsyncComputeOverlapMs += std::max(endMs - beginMs, 0.0);
+		}
+	}
 }
 
 void Engine::RenderLoop()
 {
+	render::TraceRecorder::SetThreadName("RenderThread");
+
 	u64 renderSequence = 0;
 	while (m_bRunning)
 	{
@@ -340,10 +474,14 @@ void Engine::RenderLoop()
 			std::lock_guard< std::mutex > lock(m_ImGuiMutex);
 
 			m_pScene->RemoveEntity(entity.value());
-			m_RenderViewQueue.clear();
+			ClearRenderViews();
 		}
 
-		auto renderViewOptional = m_RenderViewQueue.wait_pop();
+		std::optional< SceneRenderView > renderViewOptional;
+		{
+			BAAMBOO_TRACE_SCOPE("WaitRenderView");
+			renderViewOptional = m_RenderViewQueue.wait_pop();
+		}
 
 		if (!renderViewOptional.has_value())
 			break;
@@ -391,10 +529,20 @@ void Engine::RenderLoop()
 		}
 
 		if (bDiscardRenderView)
+		{
+			if (m_pBenchmark)
+				m_pBenchmark->Consumed();
 			continue;
+		}
 
+		render::TraceRecorder::SetFrame(renderSequence);
+		render::TraceRecorder::MarkFrame();
+		const u64 renderFrameStart = render::CpuTicks::Now();
 		render::CpuProfiler::Thread().BeginFrame();
 
+		static const render::ProfileScopeId s_RenderViewFlow = render::ProfileScopeRegistry::Intern("RenderView");
+		render::TraceRecorder::FlowIn(s_RenderViewFlow, renderView.producerSequence);
+
 		// Render
 		{
 			auto& rm = m_pRendererBackend->GetDevice()->GetResourceManager();
@@ -412,7 +560,7 @@ void Engine::RenderLoop()
 				auto updateSnapshot = [](
 					const auto&                                     entries,     // vector of Gpu/CpuProfileEntry
 					std::vector< ProfileSnapshotEntry >&            snapshot,
-					std::unordered_map< std::string, ProfileStats >& statsByName)
+					std::vector< ProfileStats >&                    statsById)
 				{
 					snapshot.clear();
 					snapshot.reserve(entries.size());
@@ -422,8 +570,13 @@ void Engine::RenderLoop()
 
 					for (const auto& e : entries)
 					{
-						const char*   rawName = e.name ? e.name : "(null)";
-						ProfileStats& s       = statsByName[rawName];
+						if (e.scopeId == render::kInvalidProfileScope)
+							continue;
+
+						// Flat by scope ID; only grows when a scope is seen for the first time
+						if (e.scopeId >= statsById.size())
+							statsById.resize(render::ProfileScopeRegistry::Count());
+						ProfileStats& s = statsById[e.scopeId];
 
 						// EMA: ~20-frame moving average.
 						s.ema = 0.95 * s.ema + 0.05 * e.elapsedMs;
@@ -446,7 +599,8 @@ void Engine::RenderLoop()
 							: 0.0;
 
 						ProfileSnapshotEntry snap = {
-							.name           = rawName,
+							.name           = e.name,
+							.scopeId        = e.scopeId,
 							.depth          = e.depth,
 							.currentMs      = e.elapsedMs,
 							.emaMs          = s.ema,
@@ -480,11 +634,17 @@ void Engine::RenderLoop()
 
 				updateSnapshot(pContext->GetLastFrameProfile(),
 				               m_GpuProfileSnapshot,
-				               m_GpuProfileStatsByName);
+				               m_GpuProfileStats);
 
 				updateSnapshot(render::CpuProfiler::Thread().GetLastFrameProfile(),
 				               m_CpuProfileSnapshot,
-				               m_CpuProfileStatsByName);
+				               m_CpuProfileStats);
+
+				updateSnapshot(m_AsyncComputeProfile,
+				               m_AsyncComputeProfileSnapshot,
+				               m_AsyncComputeProfileStats);
+
+				PairQueueProfile(pContext->GetLastFrameProfileIndex(), pContext->GetLastFrameProfile(), false);
 
 				// Push this frame's GPU total (implicit "Frame" scope) to the ring-buffer.
 				const float frameTotalMs = m_GpuProfileSnapshot.empty()
@@ -493,6 +653,9 @@ void Engine::RenderLoop()
 				m_FrameTimeHistory[m_FrameTimeHistoryIdx] = frameTotalMs;
 				m_FrameTimeHistoryIdx = (m_FrameTimeHistoryIdx + 1) % kFrameHistorySize;
 
+				static const render::ProfileScopeId s_GpuFrameMs = render::ProfileScopeRegistry::Intern("GpuFrameMs");
+				render::TraceRecorder::Counter(s_GpuFrameMs, frameTotalMs);
+
 				// --- Frame anomaly detection ---
 				// Compare current Frame time against its EMA baseline; on large deviation,
 				// snapshot the full profile for post-hoc inspection.
@@ -526,6 +689,9 @@ void Engine::RenderLoop()
 							if (m_AnomalyLog.size() > kMaxAnomalyCaptures)
 								m_AnomalyLog.pop_front();
 							m_LastAnomalyFrame = m_FrameCounter;
+
+							if (m_pBenchmark)
+								m_pBenchmark->NoteAnomaly(renderView.producerSequence);
 						}
 					}
 				}
@@ -542,30 +708,292 @@ void Engine::RenderLoop()
 					ImGui::Render();
 				}
 
-				for (auto pNode : m_pScene->GetRenderNodes())
-				{
-					if (pNode)
-					{
-						BAAMBOO_PROFILE_SCOPE(*pContext, pNode->GetName().c_str());
-						pNode->Apply(*pContext, renderView);
-					}
-				}
+				ApplyRenderNodes(*pContext, renderView);
 
 				assert(g_FrameData.pColor);
 
 				m_pRendererBackend->EndFrame(std::move(pContext), g_FrameData.pColor.lock(), m_pRendererBackend->GetDevice()->GetDeviceSettings().bDrawUI);
 				++renderSequence;
+
+				if (m_pBenchmark)
+					SampleBenchmarkFrame(renderView.producerSequence, render::CpuTicks::ToMs(render::CpuTicks::Now() - renderFrameStart));
 			}
 
 			// Close the CPU-side "Frame" scope.
 			render::CpuProfiler::Thread().EndFrame();
 
+			if (m_TraceCaptureFrames > 0 && renderSequence >= m_TraceCaptureFrames)
+			{
+				render::TraceRecorder::Export(render::GetTraceExportPath(renderSequence), m_TraceCaptureFrames);
+				render::TraceRecorder::SetEnabled(false);
+				m_TraceCaptureFrames = 0;
+			}
+
+			if (m_pBenchmark)
+				m_pBenchmark->Consumed();
+
 			/*if (!m_GpuProfileSnapshot.empty() && m_pRendererBackend)
 				m_pRendererBackend->RecordFrameTime(m_GpuProfileSnapshot[0].currentMs);*/
 		}
 	}
 }
 
+void Engine::ConfigureTraceCapture(u32 numFrames)
+{
+	m_TraceCaptureFrames = numFrames;
+	if (numFrames > 0)
+		render::TraceRecorder::SetEnabled(true);
+}
+
+void Engine::ConfigureBenchmark(Benchmark::Config&& config)
+{
+	m_SceneSeed  = config.seed;
+
+	// Budgets are checked against peaks, which start over for every run
+	for (u32 tagIdx = 0; tagIdx < static_cast< u32 >(render::eMemoryTag::Count); ++tagIdx)
+		render::MemoryTracker::SetBudget(render::eMemoryTag(tagIdx), 0);
+	for (const auto& [tag, budgetBytes] : config.memoryBudgets)
+		render::MemoryTracker::SetBudget(tag, budgetBytes);
+	render::MemoryTracker::ResetPeaks();
+
+	m_pBenchmark = MakeBox< Benchmark >(std::move(config));
+}
+
+void Engine::StartBenchmark()
+{
+	// The path drives the view instead of the app's controller; the app camera is back once it's done
+	if (!m_pBenchmark->GetConfig().cameraPath.empty() && m_pCamera)
+	{
+		m_pBenchmarkCamera = MakeBox< EditorCamera >(m_BenchmarkCameraController, m_pWindow->Width(), m_pWindow->Height());
+		m_pBenchmarkCamera->zNear              = m_pCamera->zNear;
+		m_pBenchmarkCamera->zFar               = m_pCamera->zFar;
+		m_pBenchmarkCamera->fov                = m_pCamera->fov;
+		m_pBenchmarkCamera->maxVisibleDistance = m_pCamera->maxVisibleDistance;
+		m_pAppCamera = std::exchange(m_pCamera, m_pBenchmarkCamera.get());
+	}
+
+	m_pBenchmark->Start(m_ProducerSequence);
+}
+
+i32 Engine::FinishBenchmark()
+{
+	// Let the render thread drain what was produced before stopping it
+	m_pBenchmark->WaitForConsumed();
+
+	m_bRunning = false;
+	m_RenderViewQueue.close();
+	if (m_RenderThread.joinable())
+		m_RenderThread.join();
+
+	if (m_pAppCamera)
+	{
+		m_pCamera    = std::exchange(m_pAppCamera, nullptr);
+		m_pBenchmarkCamera.reset();
+	}
+
+	const auto& config    = m_pBenchmark->GetConfig();
+	const bool  bComplete = !m_pBenchmark->IsProducing();
+	if (!bComplete)
+		printf("[Benchmark] '%s' stopped after %llu of %u frames\n", config.name.c_str(),
+			static_cast< unsigned long long >(m_pBenchmark->NumProduced()), config.numWarmupFrames + config.numFrames);
+
+	m_pBenchmark->PrintSummary(m_pBenchmark->Summarize());
+	const bool bWritten = m_pBenchmark->WriteCsv();
+
+	bool bWithinBudgets = true;
+	for (const auto& [tag, budgetBytes] : config.memoryBudgets)
+	{
+		if (!render::MemoryTracker::IsOverBudget(tag))
+			continue;
+
+		const auto stats = render::MemoryTracker::Query(tag);
+		printf("[Benchmark] '%s' peaked at %.2f MB, over its %.2f MB budget\n", render::MemoryTagName(tag),
+			double(stats.peakBytes) / (1024.0 * 1024.0), double(stats.budgetBytes) / (1024.0 * 1024.0));
+		bWithinBudgets = false;
+	}
+
+	// 3 tells an over-budget run apart from a failed one (1) and a perf regression (2)
+	if (!bComplete || !bWritten)
+		return 1;
+	return bWithinBudgets ? 0 : 3;
+}
+
+void Engine::SampleBenchmarkFrame(u64 producerSequence, double renderCpuMs)
+{
+	static const render::ProfileScopeId s_RenderFrame   = render::ProfileScopeRegistry::Intern("RenderFrame");
+	static const render::ProfileScopeId s_Instances     = render::ProfileScopeRegistry::Intern("Instances");
+	static const render::ProfileScopeId s_Phase1Drawn   = render::ProfileScopeRegistry::Intern("Phase1Drawn");
+	static const render::ProfileScopeId s_Phase2Drawn   = render::ProfileScopeRegistry::Intern("Phase2Drawn");
+	static const render::ProfileScopeId s_ClippingInvs  = render::ProfileScopeRegistry::Intern("ClippingInvocations");
+	static const render::ProfileScopeId s_ClippingPrims = render::ProfileScopeRegistry::Intern("ClippingPrimitives");
+	static const render::ProfileScopeId s_FsInvocations = render::ProfileScopeRegistry::Intern("FsInvocations");
+
+	m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Cpu, s_RenderFrame, renderCpuMs);
+	for (const auto& e : m_CpuProfileSnapshot)
+		m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Cpu, e.scopeId, e.currentMs);
+
+	for (const auto& e : m_GpuProfileSnapshot)
+	{
+		m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Gpu, e.scopeId, e.currentMs);
+		if (e.bHasStats)
+		{
+			m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Counter, s_ClippingInvs, double(e.clippingInvs));
+			m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Counter, s_ClippingPrims, double(e.clippingPrims));
+			m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Counter, s_FsInvocations, double(e.fsInvocations));
+		}
+	}
+
+	m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Counter, s_Instances, double(g_FrameData.totalInstances));
+	m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Counter, s_Phase1Drawn, double(g_FrameData.phase1InstanceDrawCount));
+	m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Counter, s_Phase2Drawn, double(g_FrameData.phase2InstanceDrawCount));
+}
+
+void Engine::SampleBenchmarkMemory(u64 producerSequence)
+{
+	constexpr double kToMB = 1.0 / (1024.0 * 1024.0);
+
+	static const auto s_TagScopes = []()
+		{
+			std::array< render::ProfileScopeId, static_cast< size_t >(render::eMemoryTag::Count) > scopes = {};
+			for (u32 tagIdx = 0; tagIdx < static_cast< u32 >(scopes.size()); ++tagIdx)
+				scopes[tagIdx] = render::ProfileScopeRegistry::Intern(render::MemoryTagName(render::eMemoryTag(tagIdx)));
+			return scopes;
+		}();
+	static const render::ProfileScopeId s_HeapUsage  = render::ProfileScopeRegistry::Intern("GpuHeapUsage");
+	static const render::ProfileScopeId s_HeapBudget = render::ProfileScopeRegistry::Intern("GpuHeapBudget");
+
+	for (u32 tagIdx = 0; tagIdx < static_cast< u32 >(s_TagScopes.size()); ++tagIdx)
+	{
+		const auto stats = render::MemoryTracker::Query(render::eMemoryTag(tagIdx));
+		m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Memory, s_TagScopes[tagIdx], double(stats.currentBytes) * kToMB);
+	}
+
+	// Device-local heaps only; samples of one frame add up
+	std::vector< render::MemoryHeapBudget > heaps;
+	m_pRendererBackend->GetDevice()->QueryMemoryBudgets(heaps);
+	for (const auto& heap : heaps)
+	{
+		if (!heap.bDeviceLocal)
+			continue;
+
+		m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Memory, s_HeapUsage, double(heap.usageBytes) * kToMB);
+		m_pBenchmark->Sample(producerSequence, eBenchmarkColumn::Memory, s_HeapBudget, double(heap.budgetBytes) * kToMB);
+	}
+}
+
+void Engine::ApplyRenderNodes(render::CommandContext& context, const SceneRenderView& renderView)
+{
+	// culled passes are already gone from the compiled list
+	const auto& passes   = m_pScene->CompileRenderGraph(*m_pRendererBackend->GetDevice(), renderView);
+	const u32   numNodes = static_cast< u32 >(passes.size());
+
+	const u32 maxRecordingThreads = m_pRendererBackend->GetDevice()->GetDeviceSettings().bParallelRecording
+		? std::min(m_pRendererBackend->MaxRecordingThreads(), TaskScheduler::Inst()->NumWorkers() + 1)
+		: 0;
+
+	// **
+	// Async compute: async passes go to the compute queue ahead of everything else. Graphics
+	// passes before the join overlap them; the join pass and everything after wait for them.
+	// **
+	bool bAsyncCompute = false;
+	if (m_pRendererBackend->GetDevice()->GetDeviceSettings().bAsyncCompute
+		&& std::any_of(passes.begin(), passes.end(), [](const RenderGraph::Pass& pass) { return pass.bAsyncCompute; }))
+	{
+		if (auto pAsyncContext = m_pRendererBackend->BeginAsyncCompute())
+		{
+			BAAMBOO_CPU_SCOPE("AsyncCompute");
+			for (const auto& pass : passes)
+			{
+				if (!pass.bAsyncCompute)
+					continue;
+
+				BAAMBOO_PROFILE_SCOPE_ID(*pAsyncContext, pass.pNode->GetProfileScopeId());
+				RenderGraph::ApplyBarriers(*pAsyncContext, pass);
+				pass.pNode->Apply(*pAsyncContext, renderView);
+				pass.pNode->PublishFrameData();
+			}
+
+			m_AsyncComputeProfile = pAsyncContext->GetLastFrameProfile();
+			PairQueueProfile(pAsyncContext->GetLastFrameProfileIndex(), m_AsyncComputeProfile, true);
+			m_pRendererBackend->SubmitAsyncCompute(context, std::move(pAsyncContext));
+			bAsyncCompute = true;
+		}
+	}
+	if (!bAsyncCompute)
+	{
+		m_AsyncComputeProfile.clear();
+		m_AsyncComputeOverlapMs = 0.0;
+	}
+
+	const u32 joinPass = bAsyncCompute ? std::min(m_pScene->AsyncComputeJoinPass(), numNodes) : numNodes;
+
+	u32 nodeIdx = 0;
+	while (nodeIdx < numNodes)
+	{
+		if (bAsyncCompute && passes[nodeIdx].bAsyncCompute)
+		{
+			++nodeIdx;
+			continue;
+		}
+
+		if (nodeIdx == joinPass)
+			m_pRendererBackend->JoinAsyncCompute(context);
+
+		// the rest of the graph's recording run, not crossing the join
+		const u32 runLimit = nodeIdx < joinPass ? joinPass : numNodes;
+		const u32 run      = passes[nodeIdx].recordingRun;
+
+		u32 runEnd = nodeIdx;
+		while (maxRecordingThreads > 1 && IsValidIndex(run) && runEnd < runLimit && passes[runEnd].recordingRun == run
+			&& !(bAsyncCompute && passes[runEnd].bAsyncCompute))
+			++runEnd;
+
+		if (runEnd - nodeIdx < 2)
+		{
+			const auto& pass = passes[nodeIdx++];
+			{
+				BAAMBOO_PROFILE_SCOPE_ID(context, pass.pNode->GetProfileScopeId());
+				RenderGraph::ApplyBarriers(context, pass);
+				pass.pNode->Apply(context, renderView);
+			}
+			pass.pNode->PublishFrameData();
+			continue;
+		}
+
+		const u32 numRunNodes = runEnd - nodeIdx;
+		const u32 numThreads  = std::min(numRunNodes, maxRecordingThreads);
+
+		// contexts are handed out here so each thread index only ever records into its own pool
+		std::vector< Arc< render::CommandContext > > pRecordingContexts(numRunNodes);
+		{
+			BAAMBOO_CPU_SCOPE("ParallelRecord");
+			for (u32 i = 0; i < numRunNodes; ++i)
+				pRecordingContexts[i] = m_pRendererBackend->BeginRecordingContext(i % numThreads);
+
+			TaskScheduler::Inst()->ParallelFor(numThreads, [&](u32 threadIdx)
+				{
+					for (u32 i = threadIdx; i < numRunNodes; i += numThreads)
+					{
+						const auto& pass = passes[nodeIdx + i];
+						RenderGraph::ApplyBarriers(*pRecordingContexts[i], pass);
+						pass.pNode->Apply(*pRecordingContexts[i], renderView);
+					}
+				});
+		}
+
+		// stitch in graph order; what the run's nodes share is handed on only now, off the workers
+		for (u32 i = 0; i < numRunNodes; ++i)
+		{
+			BAAMBOO_GPU_SCOPE_ID(context, passes[nodeIdx + i].pNode->GetProfileScopeId());
+			m_pRendererBackend->ExecuteRecordingContext(context, std::move(pRecordingContexts[i]));
+		}
+		for (u32 i = 0; i < numRunNodes; ++i)
+			passes[nodeIdx + i].pNode->PublishFrameData();
+
+		nodeIdx = runEnd;
+	}
+}
+
 void Engine::DrawUI()
 {
 	// **
@@ -580,6 +1008,128 @@ void Engine::DrawUI()
 			gameElapsed_ms = m_GameElapsedTime.load(std::memory_order_relaxed);
 		}
 		ImGui::Text("GameLoop   %.3f ms(frame: %.1f FPS)", gameElapsed_ms, 1000.0f / gameElapsed_ms);
+		if (m_pScene)
+		{
+			const auto& transformStats = m_pScene->GetTransformSystem()->GetStats();
+			if (transformStats.numMarked > 0)
+				ImGui::Text("  Transform %.3f ms(%u marked, %u visited, %u updated)",
+					transformStats.elapsedMs, transformStats.numMarked, transformStats.numVisited, transformStats.numUpdated);
+
+			const auto& scriptStats = m_pScene->GetScriptSystem()->GetStats();
+			if (scriptStats.numMovers + scriptStats.numRotators > 0)
+				ImGui::Text("  Scripts   %.3f ms(%u movers, %u rotators, %u patched)",
+					scriptStats.elapsedMs, scriptStats.numMovers, scriptStats.numRotators, scriptStats.numPatched);
+
+			const auto& animationStats = m_pScene->GetAnimationSystem()->GetStats();
+			if (animationStats.numEntities > 0)
+				ImGui::Text("  Animation %.3f ms(%u entities, %u shared poses, %u bones)",
+					animationStats.elapsedMs, animationStats.numEntities, animationStats.numSharedPoses, animationStats.numBones);
+
+			const auto& spatialStats = m_pScene->GetSpatialSystem()->GetStats();
+			if (spatialStats.numProxies > 0)
+				ImGui::Text("  Spatial   %.3f ms(%u proxies, height %u, %u moved, %u reinserted)",
+					spatialStats.elapsedMs, spatialStats.numProxies, spatialStats.treeHeight, spatialStats.numMoved, spatialStats.numReinserted);
+		}
+
+		const auto pipelineStats = render::PipelineBuildQueue::GetStats();
+		if (pipelineStats.numPipelines > 0 && ImGui::TreeNode("PipelineBuild", "Pipelines %.1f ms(%u built, %u workers, %.1f ms serial)",
+			pipelineStats.elapsedMs, pipelineStats.numPipelines, pipelineStats.numWorkers, pipelineStats.serialMs))
+		{
+			for (const auto& record : render::PipelineBuildQueue::GetRecords())
+				ImGui::Text("%-32s %8.2f ms", record.name.c_str(), record.elapsedMs);
+			ImGui::TreePop();
+		}
+
+		const auto permutationUsage = render::ComputePermutationCache::GetUsageReport();
+		if (!permutationUsage.empty())
+		{
+			u32 numUsed = 0, numLazy = 0;
+			for (const auto& usage : permutationUsage)
+			{
+				numUsed += usage.numUses > 0 ? 1 : 0;
+				numLazy += usage.bPrewarmed ? 0 : 1;
+			}
+
+			if (ImGui::TreeNode("PermutationUsage", "Permutations %zu(%u used, %u built on first use)",
+				permutationUsage.size(), numUsed, numLazy))
+			{
+				for (const auto& usage : permutationUsage)
+				{
+					ImGui::Text("%-16s %-24s %8llu uses %s", usage.cacheName.c_str(),
+						usage.permutation.empty() ? "(default)" : usage.permutation.c_str(),
+						static_cast< unsigned long long >(usage.numUses), usage.bPrewarmed ? "pre-warmed" : "");
+					if (!usage.bPrewarmed && usage.buildMs > 0.0)
+					{
+						ImGui::SameLine();
+						ImGui::Text("%.2f ms hitch", usage.buildMs);
+					}
+				}
+				ImGui::TreePop();
+			}
+		}
+
+		if (ImGui::TreeNode("Trace", "Timeline trace"))
+		{
+			bool bRecording = render::TraceRecorder::IsEnabled();
+			if (ImGui::Checkbox("Record", &bRecording))
+				render::TraceRecorder::SetEnabled(bRecording);
+
+			ImGui::SliderInt("Frames", &m_TraceExportFrames, 1, static_cast< int >(render::TraceRecorder::kMaxFrames));
+			if (ImGui::Button("Export Chrome trace"))
+				render::TraceRecorder::Export(render::GetTraceExportPath(m_FrameCounter), static_cast< u32 >(m_TraceExportFrames));
+			ImGui::TreePop();
+		}
+
+		if (ImGui::TreeNode("Memory"))
+		{
+			constexpr double kToMB = 1.0 / (1024.0 * 1024.0);
+
+			if (ImGui::BeginTable("##memory_tags", 5, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerH))
+			{
+				ImGui::TableSetupColumn("Tag", ImGuiTableColumnFlags_WidthFixed, 140.0f);
+				ImGui::TableSetupColumn("MB", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+				ImGui::TableSetupColumn("peak", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+				ImGui::TableSetupColumn("budget", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+				ImGui::TableSetupColumn("allocs", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+				ImGui::TableHeadersRow();
+				for (u32 tagIdx = 0; tagIdx < static_cast< u32 >(render::eMemoryTag::Count); ++tagIdx)
+				{
+					const auto tag   = render::eMemoryTag(tagIdx);
+					const auto stats = render::MemoryTracker::Query(tag);
+
+					const bool bOverBudget = render::MemoryTracker::IsOverBudget(tag);
+					if (bOverBudget)
+						ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.3f, 0.3f, 1.0f));
+
+					ImGui::TableNextRow();
+					ImGui::TableSetColumnIndex(0); ImGui::Text("%s%s", render::IsGpuMemoryTag(tag) ? "gpu:" : "cpu:", render::MemoryTagName(tag));
+					ImGui::TableSetColumnIndex(1); ImGui::Text("%8.2f", double(stats.currentBytes) * kToMB);
+					ImGui::TableSetColumnIndex(2); ImGui::Text("%8.2f", double(stats.peakBytes) * kToMB);
+					ImGui::TableSetColumnIndex(3);
+					if (stats.budgetBytes > 0) ImGui::Text("%8.2f", double(stats.budgetBytes) * kToMB);
+					else ImGui::TextDisabled("-");
+					ImGui::TableSetColumnIndex(4); ImGui::Text("%u", stats.numAllocations);
+
+					if (bOverBudget)
+						ImGui::PopStyleColor();
+				}
+				ImGui::EndTable();
+			}
+
+			// The driver's view: everything the process has in each heap, not just what is tagged
+			std::vector< render::MemoryHeapBudget > heaps;
+			m_pRendererBackend->GetDevice()->QueryMemoryBudgets(heaps);
+			for (u32 heapIdx = 0; heapIdx < static_cast< u32 >(heaps.size()); ++heapIdx)
+			{
+				const auto& heap = heaps[heapIdx];
+				ImGui::Text("Heap %u (%s): %.1f / %.1f MB", heapIdx, heap.bDeviceLocal ? "device" : "system",
+					double(heap.usageBytes) * kToMB, double(heap.budgetBytes) * kToMB);
+			}
+
+			if (ImGui::Button("Reset peaks"))
+				render::MemoryTracker::ResetPeaks();
+			ImGui::TreePop();
+		}
 
 		static auto lastRenderStatsUpdate = std::chrono::steady_clock::now() - std::chrono::seconds(1);
 		static double renderElapsedCpu_ms = 0.0;
@@ -631,7 +1181,7 @@ void Engine::DrawUI()
 			for (const auto& e : m_GpuProfileSnapshot)
 			{
 				if (e.depth != 1) continue; // top-level only
-				slices.push_back({ e.name.c_str(), e.currentMs, render::GetGpuMarkerColor(e.name.c_str()) });
+				slices.push_back({ e.name, e.currentMs, render::GetGpuMarkerColor(e.name) });
 				accounted += e.currentMs;
 			}
 			const double residualMs = std::max(0.0, frameMs - accounted);
@@ -687,27 +1237,27 @@ void Engine::DrawUI()
 		auto drawProfileTable = [](
 			const char*                                       tableId,
 			const std::vector< ProfileSnapshotEntry >&         snapshot,
-			std::unordered_map< std::string, ProfileStats >&  stats)
+			std::vector< ProfileStats >&                      stats)
 		{
 			// Reset button clears min/max (ema survives so the moving avg doesn't jump).
 			if (ImGui::SmallButton((std::string("Reset Min/Max##minmax") + tableId).c_str()))
 			{
-				for (auto& kv : stats)
+				for (auto& s : stats)
 				{
-					kv.second.minMs   = 0.0;
-					kv.second.maxMs   = 0.0;
-					kv.second.bSeeded = false;
+					s.minMs   = 0.0;
+					s.maxMs   = 0.0;
+					s.bSeeded = false;
 				}
 			}
 			ImGui::SameLine();
 			if (ImGui::SmallButton((std::string("Reset EMA##ema") + tableId).c_str()))
 			{
-				for (auto& kv : stats)
+				for (auto& s : stats)
 				{
-					kv.second.ema          = 0.0;
-					kv.second.clipInsEma   = 0.0;
-					kv.second.clipPrimsEma = 0.0;
-					kv.second.fsInvocsEma  = 0.0;
+					s.ema          = 0.0;
+					s.clipInsEma   = 0.0;
+					s.clipPrimsEma = 0.0;
+					s.fsInvocsEma  = 0.0;
 				}
 			}
 
@@ -740,7 +1290,7 @@ void Engine::DrawUI()
 				{
 					ImGui::TableNextRow();
 					ImGui::TableSetColumnIndex(0);
-					ImGui::Text("%*s%s", int(e.depth) * 2, "", e.name.c_str());
+					ImGui::Text("%*s%s", int(e.depth) * 2, "", e.name);
 					ImGui::TableSetColumnIndex(1);
 					ImGui::Text("%6.3f", e.currentMs);
 					ImGui::TableSetColumnIndex(2);
@@ -759,12 +1309,18 @@ void Engine::DrawUI()
 		ImGui::Separator();
 		if (ImGui::CollapsingHeader("GPU Profile", ImGuiTreeNodeFlags_DefaultOpen))
 		{
-			drawProfileTable("##gpu_profile", m_GpuProfileSnapshot, m_GpuProfileStatsByName);
+			drawProfileTable("##gpu_profile", m_GpuProfileSnapshot, m_GpuProfileStats);
+		}
+
+		if (!m_AsyncComputeProfileSnapshot.empty() && ImGui::CollapsingHeader("GPU Profile (async compute)", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			ImGui::Text("Overlapped with graphics %6.3f ms", m_AsyncComputeOverlapMs);
+			drawProfileTable("##async_compute_profile", m_AsyncComputeProfileSnapshot, m_AsyncComputeProfileStats);
 		}
 
 		/*if (ImGui::CollapsingHeader("CPU Profile"))
 		{
-			drawProfileTable("##cpu_profile", m_CpuProfileSnapshot, m_CpuProfileStatsByName);
+			drawProfileTable("##cpu_profile", m_CpuProfileSnapshot, m_CpuProfileStats);
 		}*/
 
 		// --- Culling Controls [TEMP] ---
@@ -794,6 +1350,26 @@ void Engine::DrawUI()
 
 			ImGui::TextDisabled("LOD selection (SSE)");
 			ImGui::SliderFloat("SSE Threshold (px)##lodSse", &g_FrameData.sseThresholdPx, 0.1f, 4.0f, "%.2f");
+
+			if (m_pScene)
+			{
+				ImGui::TextDisabled("Per-instance (CPU pre-pass)");
+				bool bCpuCull = m_pScene->GetCpuFrustumCulling();
+				if (ImGui::Checkbox("Frustum##cpuCull", &bCpuCull))
+					m_pScene->SetCpuFrustumCulling(bCpuCull);
+				if (bCpuCull)
+				{
+					ImGui::SameLine();
+					bool bCpuOcclusion = m_pScene->GetCpuOcclusionCulling();
+					if (ImGui::Checkbox("Occlusion##cpuCull", &bCpuOcclusion))
+						m_pScene->SetCpuOcclusionCulling(bCpuOcclusion);
+
+					const auto& cullStats = m_pScene->GetCpuCullingStats();
+					ImGui::Text("%u kept, %u culled (%.3f ms)", cullStats.numKept, cullStats.numCulled, cullStats.elapsedMs);
+					if (bCpuOcclusion)
+						ImGui::Text("%u occluded by %u occluders", cullStats.numOccluded, cullStats.numOccluders);
+				}
+			}
 		}
 
 		// --- Pipeline Summary ---
@@ -854,10 +1430,12 @@ void Engine::DrawUI()
 			double phase1ClipInEma  = 0.0, phase2ClipInEma  = 0.0;
 			double phase1ClipOutEma = 0.0, phase2ClipOutEma = 0.0;
 			double phase1FsEma      = 0.0, phase2FsEma      = 0.0;
+			static const render::ProfileScopeId kPhase1Draw = render::ProfileScopeRegistry::Intern("Phase1Draw");
+			static const render::ProfileScopeId kPhase2Draw = render::ProfileScopeRegistry::Intern("Phase2Draw");
 			for (const auto& e : m_GpuProfileSnapshot)
 			{
 				if (!e.bHasStats) continue;
-				if (e.name == "Phase1Draw")
+				if (e.scopeId == kPhase1Draw)
 				{
 					phase1ClipIn     = e.clippingInvs;
 					phase1ClipOut    = e.clippingPrims;
@@ -866,7 +1444,7 @@ void Engine::DrawUI()
 					phase1ClipOutEma = e.clippingPrimsEma;
 					phase1FsEma      = e.fsInvocationsEma;
 				}
-				else if (e.name == "Phase2Draw")
+				else if (e.scopeId == kPhase2Draw)
 				{
 					phase2ClipIn     = e.clippingInvs;
 					phase2ClipOut    = e.clippingPrims;
@@ -1110,7 +1688,7 @@ void Engine::DrawUI()
 							{
 								ImGui::TableNextRow();
 								ImGui::TableSetColumnIndex(0);
-								ImGui::Text("%*s%s", int(e.depth) * 2, "", e.name.c_str());
+								ImGui::Text("%*s%s", int(e.depth) * 2, "", e.name);
 								ImGui::TableSetColumnIndex(1); ImGui::Text("%6.3f", e.currentMs);
 								ImGui::TableSetColumnIndex(2); ImGui::Text("%6.3f", e.emaMs);
 								ImGui::TableSetColumnIndex(3);
@@ -1992,11 +2570,16 @@ void Engine::DrawUI()
 				{
 					auto& scriptComponent = ImGui::SelectedEntity.GetComponent< ScriptComponent >();
 
-					ImGui::Checkbox("Move", &scriptComponent.bMove);
-					ImGui::DragFloat3("MoveVelocity", glm::value_ptr(scriptComponent.moveVelocity), 0.01f, -10.0f, 10.0f);
+					bool bMark = false;
+					bMark |= ImGui::Checkbox("Move", &scriptComponent.bMove);
+					bMark |= ImGui::DragFloat3("MoveVelocity", glm::value_ptr(scriptComponent.moveVelocity), 0.01f, -10.0f, 10.0f);
+
+					bMark |= ImGui::Checkbox("Rotate", &scriptComponent.bRotate);
+					bMark |= ImGui::DragFloat3("RotationVelocity", glm::value_ptr(scriptComponent.rotationVelocity), 0.001f, -1.0f, 1.0f);
 
-					ImGui::Checkbox("Rotate", &scriptComponent.bRotate);
-					ImGui::DragFloat3("RotationVelocity", glm::value_ptr(scriptComponent.rotationVelocity), 0.001f, -1.0f, 1.0f);
+					// behaviors are grouped by the script system; a patch regroups them
+					if (bMark)
+						m_pScene->Registry().patch< ScriptComponent >(ImGui::SelectedEntity.ID(), [](auto&) {});
 				}
 			}
 
@@ -2,10 +2,13 @@
 #include "BaambooScene/Scene.h"
 #include "BaambooScene/Camera.h"
 
+#include "BaambooCore/Benchmark.h"
 #include "Timer.h"
 #include "ThreadQueue.hpp"
 #include "RenderCommon/RendererAPI.h"
+#include "RenderCommon/CommandContext.h"
 
+#include <array>
 #include <deque>
 
 namespace baamboo { class Engine; }
@@ -26,6 +29,14 @@ public:
 	virtual void Initialize(eRendererAPI api);
 	virtual int  Run();
 
+	// Records and exports a timeline trace of the first 'numFrames' rendered frames, then keeps running
+	void ConfigureTraceCapture(u32 numFrames);
+	// Before Initialize(): Run() then plays the benchmark, writes its CSV and returns
+	void ConfigureBenchmark(Benchmark::Config&& config);
+	// The benchmark after Run() returned, null outside benchmark runs
+	[[nodiscard]]
+	const Benchmark* GetBenchmark() const { return m_pBenchmark.get(); }
+
 	[[nodiscard]]
 	class Scene* GetScene() const { return m_pScene; }
 	[[nodiscard]]
@@ -37,14 +48,21 @@ protected:
 	virtual void Release();
 	void RestartRuntime(eRendererAPI api);
 	bool ReloadScene();
+	bool BuildScene(); // LoadScene() with its pipeline compiles batched on worker threads
 
 	virtual void Update(float dt);
 	virtual void GameLoop(float dt);
 	virtual void RenderLoop();
 
+	void ApplyRenderNodes(render::CommandContext& context, const SceneRenderView& renderView);
+
 	virtual bool InitWindow() { return false; }
 	virtual bool LoadScene() { return false; }
 
+	// Seed for anything random in LoadScene(), so benchmark scenes are the same every run
+	[[nodiscard]]
+	u32 GetSceneSeed() const { return m_SceneSeed; }
+
 	virtual void DrawUI();
 	virtual void DrawEntityNode(Entity entity);
 
@@ -78,8 +96,23 @@ private:
 	PendingResizeRequest m_PendingResize;
 	bool                 m_bRenderSuspended = false;
 
+	// --- Benchmark ---
+	void StartBenchmark();
+	i32  FinishBenchmark();
+	void SampleBenchmarkFrame(u64 producerSequence, double renderCpuMs);
+	void SampleBenchmarkMemory(u64 producerSequence);
+
+	Box< Benchmark >             m_pBenchmark;
+	u32                          m_SceneSeed = 42;
+	CameraController_FirstPerson m_BenchmarkCameraController;
+	Box< EditorCamera >          m_pBenchmarkCamera;
+	EditorCamera*                m_pAppCamera = nullptr; // swapped out while the benchmark drives the view
+
 	std::thread                    m_RenderThread;
 	ThreadQueue< SceneRenderView > m_RenderViewQueue;
+	render::TrackedMemory          m_RenderViewMemory{ render::eMemoryTag::SceneRenderView }; // game thread only
+
+	void ClearRenderViews();
 	std::atomic_bool               m_bRunning;
 
 	Timer m_GameTimer = {};
@@ -92,7 +125,8 @@ private:
 	// at the start of each render-thread iteration. Read/written only on the render thread, so no synchronization is needed.
 	struct ProfileSnapshotEntry
 	{
-		std::string name;
+		const char*            name    = ""; // interned, outlives the snapshot
+		render::ProfileScopeId scopeId = render::kInvalidProfileScope;
 
 		u32    depth          = 0;
 		double currentMs      = 0.0;
@@ -128,8 +162,32 @@ private:
 	};
 	std::vector< ProfileSnapshotEntry >           m_GpuProfileSnapshot;
 	std::vector< ProfileSnapshotEntry >           m_CpuProfileSnapshot;
-	std::unordered_map< std::string, ProfileStats > m_GpuProfileStatsByName;
-	std::unordered_map< std::string, ProfileStats > m_CpuProfileStatsByName;
+	std::vector< ProfileStats >                   m_GpuProfileStats; // by profile scope ID
+	std::vector< ProfileStats >                   m_CpuProfileStats;
+
+	// Async compute queue, same previous-frame semantics as the graphics profile. The overlap is the
+	// time async passes ran while a top-level graphics pass was running too. The two queues' results
+	// come back from different contexts and frames, so they are paired by frame index first.
+	struct QueueProfilePair
+	{
+		u64                                    frameIndex = render::kNoProfileFrame;
+		std::vector< render::GpuProfileEntry > graphics;
+		std::vector< render::GpuProfileEntry > asyncCompute;
+		bool                                   bHasGraphics     = false;
+		bool                                   bHasAsyncCompute = false;
+	};
+
+	std::vector< render::GpuProfileEntry >         m_AsyncComputeProfile;
+	std::vector< ProfileSnapshotEntry >             m_AsyncComputeProfileSnapshot;
+	std::vector< ProfileStats >                     m_AsyncComputeProfileStats;
+	std::array< QueueProfilePair, 8 >               m_QueueProfilePairs; // by frame index; deeper than any context pool
+	double                                          m_AsyncComputeOverlapMs = 0.0;
+
+	void PairQueueProfile(u64 frameIndex, const std::vector< render::GpuProfileEntry >& entries, bool bAsyncCompute);
+
+	// --- Timeline trace ---
+	u32 m_TraceCaptureFrames = 0;   // command-line capture, 0 once written
+	int m_TraceExportFrames  = 120; // UI export window
 
 	// Frame-time history ring buffer for ImGui::PlotLines.
 	static constexpr u32 kFrameHistorySize = 200;
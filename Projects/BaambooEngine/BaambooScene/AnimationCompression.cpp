@@ -0,0 +1,366 @@
+#include "BaambooPch.h"
+#include "AnimationCompression.h"
+
+namespace
+{
+
+constexpr float kQuantize16 = 65535.0f;
+
+struct CompressionContext
+{
+    const AnimationClip&                clip;
+    const Skeleton&                     skeleton;
+    const AnimationCompressionSettings& settings;
+
+    std::vector< float > shellDistances; // per bone
+    std::vector< float > errorBudgets;   // per bone
+    std::vector< float > sampleTimes;    // every source key time, sorted
+    std::vector< mat4 >  mSourceWorlds;  // [sample][bone], uncompressed pose
+
+    const mat4& SourceWorld(u32 sampleIndex, u32 boneIndex) const
+    {
+        return mSourceWorlds[sampleIndex * skeleton.NumBones() + boneIndex];
+    }
+
+    mat4 SourceParentWorld(float time, u32 boneIndex) const
+    {
+        const u32 parentIndex = skeleton.parentIndices[boneIndex];
+        if (parentIndex == kInvalidIndex)
+            return mat4(1.0f);
+
+        const auto it = std::lower_bound(sampleTimes.begin(), sampleTimes.end(), time);
+        return SourceWorld(static_cast< u32 >(it - sampleTimes.begin()), parentIndex);
+    }
+};
+
+// largest displacement of the bone origin and its virtual vertices between two model-space transforms
+float MeasureError(const mat4& mExact, const mat4& mApprox, float shellDistance)
+{
+    float error = glm::length(float3(mExact[3]) - float3(mApprox[3]));
+    for (u32 axis = 0; axis < 3; ++axis)
+    {
+        float4 vertex = float4(0.0f, 0.0f, 0.0f, 1.0f);
+        vertex[axis]  = shellDistance;
+        error = std::max(error, glm::length(float3(mExact * vertex) - float3(mApprox * vertex)));
+    }
+    return error;
+}
+
+std::vector< float3 > BindPositions(const Skeleton& skeleton)
+{
+    std::vector< float3 > bindPositions(skeleton.NumBones());
+    for (u32 i = 0; i < skeleton.NumBones(); ++i)
+        bindPositions[i] = float3(glm::inverse(skeleton.mModelToBones[i])[3]);
+    return bindPositions;
+}
+
+// bind pose distance from each bone to its furthest descendant, 0 for end effectors
+std::vector< float > EndEffectorDistances(const Skeleton& skeleton, const std::vector< float3 >& bindPositions)
+{
+    const auto& parents = skeleton.parentIndices;
+
+    std::vector< float > distances(skeleton.NumBones(), 0.0f);
+    for (u32 i = 0; i < skeleton.NumBones(); ++i)
+    {
+        for (u32 ancestor = parents[i]; ancestor != kInvalidIndex; ancestor = parents[ancestor])
+            distances[ancestor] = std::max(distances[ancestor], glm::length(bindPositions[i] - bindPositions[ancestor]));
+    }
+    return distances;
+}
+
+void ComputeShellDistances(CompressionContext& ctx, const std::vector< float3 >& bindPositions, const std::vector< float >& effectorDistances)
+{
+    const auto& parents  = ctx.skeleton.parentIndices;
+    const u32   numBones = ctx.skeleton.NumBones();
+
+    if (ctx.settings.shellDistance > 0.0f)
+    {
+        ctx.shellDistances.assign(numBones, ctx.settings.shellDistance);
+        return;
+    }
+
+    // leaves fall back to their own length
+    ctx.shellDistances = effectorDistances;
+    float maxShell = 0.0f;
+    for (u32 i = 0; i < numBones; ++i)
+    {
+        if (ctx.shellDistances[i] == 0.0f && parents[i] != kInvalidIndex)
+            ctx.shellDistances[i] = glm::length(bindPositions[i] - bindPositions[parents[i]]);
+        maxShell = std::max(maxShell, ctx.shellDistances[i]);
+    }
+    for (auto& shell : ctx.shellDistances)
+    {
+        if (shell == 0.0f)
+            shell = maxShell > 0.0f ? maxShell : 1.0f;
+    }
+}
+
+void ComputeErrorBudgets(CompressionContext& ctx, const std::vector< float >& effectorDistances)
+{
+    const u32 numBones = ctx.skeleton.NumBones();
+    const auto& overrides = ctx.settings.boneMaxErrors;
+
+    const float maxDistance = effectorDistances.empty() ? 0.0f : *std::max_element(effectorDistances.begin(), effectorDistances.end());
+
+    ctx.errorBudgets.resize(numBones);
+    for (u32 i = 0; i < numBones; ++i)
+    {
+        if (i < overrides.size() && overrides[i] > 0.0f)
+        {
+            ctx.errorBudgets[i] = overrides[i];
+            continue;
+        }
+
+        const float t = maxDistance > 0.0f ? effectorDistances[i] / maxDistance : 0.0f;
+        ctx.errorBudgets[i] = ctx.settings.maxError * glm::mix(1.0f, ctx.settings.rootErrorScale, t);
+    }
+}
+
+void SampleSourcePoses(CompressionContext& ctx)
+{
+    for (const auto& channel : ctx.clip.channels)
+    {
+        for (const auto& key : channel.positionKeys) ctx.sampleTimes.push_back(key.timestamp);
+        for (const auto& key : channel.rotationKeys) ctx.sampleTimes.push_back(key.timestamp);
+        for (const auto& key : channel.scaleKeys)    ctx.sampleTimes.push_back(key.timestamp);
+    }
+    std::sort(ctx.sampleTimes.begin(), ctx.sampleTimes.end());
+    ctx.sampleTimes.erase(std::unique(ctx.sampleTimes.begin(), ctx.sampleTimes.end()), ctx.sampleTimes.end());
+
+    const u64 numBones = ctx.skeleton.NumBones();
+    ctx.mSourceWorlds.resize(ctx.sampleTimes.size() * numBones);
+
+    AnimationPose pose;
+    for (size_t i = 0; i < ctx.sampleTimes.size(); ++i)
+    {
+        pose.Sample(ctx.clip, ctx.skeleton, ctx.sampleTimes[i]);
+        pose.CalculateBoneMatrices(ctx.skeleton);
+        std::copy(pose.mWorlds.begin(), pose.mWorlds.end(), ctx.mSourceWorlds.begin() + i * numBones);
+    }
+}
+
+u16 QuantizeKeyTime(const CompressedAnimationClip& compressed, float ticks)
+{
+    return static_cast< u16 >(compressed.ToKeyTime(ticks) + 0.5f);
+}
+
+void QuantizeVec3(const float3& value, const float3& rangeMin, const float3& rangeExtent, u16* pOut)
+{
+    for (u32 i = 0; i < 3; ++i)
+    {
+        const float normalized = rangeExtent[i] > 0.0f ? (value[i] - rangeMin[i]) / rangeExtent[i] : 0.0f;
+        pOut[i] = static_cast< u16 >(glm::clamp(normalized, 0.0f, 1.0f) * kQuantize16 + 0.5f);
+    }
+}
+
+float3 DequantizeVec3(const u16* pValues, const float3& rangeMin, const float3& rangeExtent)
+{
+    return rangeMin + float3(pValues[0], pValues[1], pValues[2]) / kQuantize16 * rangeExtent;
+}
+
+// Greedy curve reduction over one track. A key is dropped when interpolating between the last
+// kept key and the next one reconstructs every key in between within the budget.
+// errorAt(j, value) is the error of reconstructing key j as 'value'.
+template< typename TValue, typename TLerpFn, typename TErrorFn >
+std::vector< u32 > ReduceKeys(const std::vector< u16 >& keyTimes, const std::vector< TValue >& values, float maxError, TLerpFn&& lerp, TErrorFn&& errorAt)
+{
+    const u32 numKeys = static_cast< u32 >(values.size());
+    if (numKeys <= 1)
+        return std::vector< u32 >(numKeys, 0);
+
+    std::vector< u32 > kept = { 0 };
+    for (u32 i = 1; i + 1 < numKeys; ++i)
+    {
+        const u32 prev = kept.back();
+        const u32 next = i + 1;
+
+        bool bDroppable = true;
+        for (u32 j = prev + 1; j <= i && bDroppable; ++j)
+        {
+            const float t = float(keyTimes[j] - keyTimes[prev]) / float(keyTimes[next] - keyTimes[prev]);
+            bDroppable = errorAt(j, lerp(values[prev], values[next], t)) <= maxError;
+        }
+
+        if (!bDroppable)
+            kept.push_back(i);
+    }
+    kept.push_back(numKeys - 1);
+
+    // constant track
+    if (kept.size() == 2)
+    {
+        bool bConstant = true;
+        for (u32 j = 1; j < numKeys && bConstant; ++j)
+            bConstant = errorAt(j, values[0]) <= maxError;
+
+        if (bConstant)
+            kept.pop_back();
+    }
+    return kept;
+}
+
+// source keys whose quantized times are distinct (later duplicates are dropped)
+template< typename TKey >
+std::vector< u32 > DistinctKeyTimes(const CompressedAnimationClip& compressed, const std::vector< TKey >& keys, std::vector< u16 >& outTimes)
+{
+    std::vector< u32 > indices;
+    for (u32 i = 0; i < keys.size(); ++i)
+    {
+        const u16 keyTime = QuantizeKeyTime(compressed, keys[i].timestamp);
+        if (!outTimes.empty() && keyTime <= outTimes.back())
+            continue;
+
+        indices.push_back(i);
+        outTimes.push_back(keyTime);
+    }
+    return indices;
+}
+
+// model-space error at 'time' of the channel's bone when one component of its local transform is replaced
+template< typename TPatchFn >
+float LocalTransformError(const CompressionContext& ctx, const AnimationChannel& channel, float time, TPatchFn&& patch)
+{
+    BoneTransform exact;
+    exact.position  = channel.InterpolatePosition(time);
+    exact.qRotation = channel.InterpolateRotation(time);
+    exact.scale     = channel.InterpolateScale(time);
+
+    BoneTransform approx = exact;
+    patch(approx);
+
+    const mat4 mParent = ctx.SourceParentWorld(time, channel.boneIndex);
+    return MeasureError(mParent * exact.ToMatrix(), mParent * approx.ToMatrix(), ctx.shellDistances[channel.boneIndex]);
+}
+
+template< typename TKey >
+void CompressVec3Track(const CompressionContext& ctx, const CompressedAnimationClip& compressed, const AnimationChannel& channel,
+                       const std::vector< TKey >& keys, float3 TKey::* pKeyValue, float3 BoneTransform::* pTransformValue,
+                       float3& outMin, float3& outExtent, std::vector< u16 >& outTimes, std::vector< u16 >& outValues)
+{
+    if (keys.empty())
+        return;
+
+    std::vector< u16 > keyTimes;
+    const auto indices = DistinctKeyTimes(compressed, keys, keyTimes);
+
+    float3 rangeMax = keys[indices[0]].*pKeyValue;
+    outMin = rangeMax;
+    for (u32 index : indices)
+    {
+        outMin   = glm::min(outMin, keys[index].*pKeyValue);
+        rangeMax = glm::max(rangeMax, keys[index].*pKeyValue);
+    }
+    outExtent = rangeMax - outMin;
+
+    std::vector< u16 >    quantized(indices.size() * 3);
+    std::vector< float3 > decoded(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        QuantizeVec3(keys[indices[i]].*pKeyValue, outMin, outExtent, &quantized[i * 3]);
+        decoded[i] = DequantizeVec3(&quantized[i * 3], outMin, outExtent);
+    }
+
+    const auto kept = ReduceKeys(keyTimes, decoded, ctx.errorBudgets[channel.boneIndex],
+        [](const float3& a, const float3& b, float t) { return glm::mix(a, b, t); },
+        [&](u32 j, const float3& value)
+        {
+            return LocalTransformError(ctx, channel, keys[indices[j]].timestamp, [&](BoneTransform& transform)
+                {
+                    transform.*pTransformValue = value;
+                });
+        });
+
+    for (u32 k : kept)
+    {
+        outTimes.push_back(keyTimes[k]);
+        outValues.insert(outValues.end(), quantized.begin() + k * 3, quantized.begin() + k * 3 + 3);
+    }
+}
+
+void CompressRotationTrack(const CompressionContext& ctx, const CompressedAnimationClip& compressed, const AnimationChannel& channel,
+                           std::vector< u16 >& outTimes, std::vector< PackedQuat >& outValues)
+{
+    if (channel.rotationKeys.empty())
+        return;
+
+    std::vector< u16 > keyTimes;
+    const auto indices = DistinctKeyTimes(compressed, channel.rotationKeys, keyTimes);
+
+    std::vector< PackedQuat > packed(indices.size());
+    std::vector< quat >       decoded(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        packed[i]  = PackedQuat::Pack(channel.rotationKeys[indices[i]].qRotation);
+        decoded[i] = packed[i].Unpack();
+    }
+
+    const auto kept = ReduceKeys(keyTimes, decoded, ctx.errorBudgets[channel.boneIndex],
+        [](const quat& a, const quat& b, float t) { return glm::slerp(a, b, t); },
+        [&](u32 j, const quat& value)
+        {
+            return LocalTransformError(ctx, channel, channel.rotationKeys[indices[j]].timestamp, [&](BoneTransform& transform)
+                {
+                    transform.qRotation = value;
+                });
+        });
+
+    for (u32 k : kept)
+    {
+        outTimes.push_back(keyTimes[k]);
+        outValues.push_back(packed[k]);
+    }
+}
+
+} // anonymous namespace
+
+CompressedAnimationClip CompressAnimationClip(const AnimationClip& clip, const Skeleton& skeleton, const AnimationCompressionSettings& settings)
+{
+    CompressedAnimationClip compressed = {};
+    compressed.name           = clip.name;
+    compressed.duration       = clip.duration;
+    compressed.ticksPerSecond = clip.ticksPerSecond;
+
+    CompressionContext ctx = { .clip = clip, .skeleton = skeleton, .settings = settings };
+    {
+        const auto bindPositions     = BindPositions(skeleton);
+        const auto effectorDistances = EndEffectorDistances(skeleton, bindPositions);
+        ComputeShellDistances(ctx, bindPositions, effectorDistances);
+        ComputeErrorBudgets(ctx, effectorDistances);
+    }
+    SampleSourcePoses(ctx);
+
+    for (const auto& channel : clip.channels)
+    {
+        compressed.rawSizeInBytes += channel.SizeInBytes();
+
+        // unbound channels are never sampled
+        if (channel.boneIndex >= skeleton.NumBones())
+            continue;
+
+        CompressedAnimationChannel& out = compressed.channels.emplace_back();
+        out.boneIndex = channel.boneIndex;
+
+        CompressVec3Track(ctx, compressed, channel, channel.positionKeys, &KeyPosition::position, &BoneTransform::position,
+                          out.positionMin, out.positionExtent, out.positionTimes, out.positionValues);
+        CompressRotationTrack(ctx, compressed, channel, out.rotationTimes, out.rotationValues);
+        CompressVec3Track(ctx, compressed, channel, channel.scaleKeys, &KeyScale::scale, &BoneTransform::scale,
+                          out.scaleMin, out.scaleExtent, out.scaleTimes, out.scaleValues);
+
+        compressed.sizeInBytes += out.SizeInBytes();
+    }
+
+    // remeasure on the whole compressed pose so error accumulated down the hierarchy is counted
+    const u32 numBones = skeleton.NumBones();
+
+    AnimationPose pose;
+    for (u32 i = 0; i < ctx.sampleTimes.size(); ++i)
+    {
+        pose.Sample(compressed, skeleton, ctx.sampleTimes[i]);
+        pose.CalculateBoneMatrices(skeleton);
+
+        for (u32 bone = 0; bone < numBones; ++bone)
+            compressed.maxError = std::max(compressed.maxError, MeasureError(ctx.SourceWorld(i, bone), pose.mWorlds[bone], ctx.shellDistances[bone]));
+    }
+
+    return compressed;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "AnimationTypes.h"
+
+//-------------------------------------------------------------------------
+// Animation clip compression
+//-------------------------------------------------------------------------
+struct AnimationCompressionSettings
+{
+    // Largest model-space displacement a bone may take, measured at its origin and at
+    // virtual vertices 'shell distance' away along its local axes
+    float maxError = 0.0001f;
+
+    // Every bone below a bone inherits its error, so bones far from their end effectors get a
+    // tighter budget: maxError scales linearly from 1 at the end effectors down to this at the
+    // bone with the furthest end effector (bind pose distances)
+    float rootErrorScale = 0.5f;
+
+    // Per-bone budgets by skeleton bone index, replacing the scaled maxError; entries <= 0 and
+    // bones past the end keep the scaled one
+    std::vector< float > boneMaxErrors;
+
+    // 0 derives each bone's shell distance from the bind pose (furthest descendant)
+    float shellDistance = 0.0f;
+};
+
+// Quantizes every track (smallest-three rotations, range-quantized translations and scales,
+// 16-bit key times) and drops keys the remaining ones reconstruct within their bone's budget.
+// Each key is checked in model space under the source pose of its bone's ancestors. The
+// reported maxError is then remeasured on the full compressed pose, error accumulated
+// down the hierarchy included.
+CompressedAnimationClip CompressAnimationClip(const AnimationClip& clip, const Skeleton& skeleton, const AnimationCompressionSettings& settings = {});
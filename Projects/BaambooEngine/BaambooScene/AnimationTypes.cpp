@@ -4,68 +4,106 @@
 //-------------------------------------------------------------------------
 // AnimationChannel
 //-------------------------------------------------------------------------
-float3 AnimationChannel::InterpolatePosition(float time) const
+namespace
 {
-    if (positionKeys.empty()) 
-        return float3(0.0f);
 
-    if (positionKeys.size() == 1) 
-        return positionKeys[0].position;
+// forward steps tried from the cursor before giving up on it
+constexpr u32 kMaxCursorSteps = 4;
 
-    // Find the two keys to interpolate between
-    size_t index = 0;
-    for (size_t i = 0; i < positionKeys.size() - 1; ++i)
+// Segment i with timeAt(i) <= time < timeAt(i + 1), clamped to [0, numKeys - 2].
+// Requires at least two keys.
+template< typename TTimeFn >
+u32 FindKeySegment(u32 numKeys, float time, u32& cursor, TTimeFn&& timeAt)
+{
+    const u32 lastSegment = numKeys - 2;
+
+    u32 segment = std::min(cursor, lastSegment);
+    for (u32 step = 0; step < kMaxCursorSteps && segment < lastSegment && time >= timeAt(segment + 1); ++step)
+        ++segment;
+
+    const bool bBehind = segment > 0 && time < timeAt(segment);
+    const bool bAhead  = segment < lastSegment && time >= timeAt(segment + 1);
+    if (bBehind || bAhead)
     {
-        if (time < positionKeys[i + 1].timestamp)
+        // first key later than 'time', in [1, lastSegment + 1]
+        u32 lo = 1;
+        u32 hi = lastSegment + 1;
+        while (lo < hi)
         {
-            index = i;
-            break;
+            const u32 mid = (lo + hi) / 2;
+            if (time < timeAt(mid))
+                hi = mid;
+            else
+                lo = mid + 1;
         }
+        segment = lo - 1;
     }
 
-    if (index >= positionKeys.size() - 1)
-        return positionKeys.back().position;
+    cursor = segment;
+    return segment;
+}
 
-    const auto& key1 = positionKeys[index];
-    const auto& key2 = positionKeys[index + 1];
+template< typename TKey >
+u32 FindKeySegment(const std::vector< TKey >& keys, float time, u32& cursor)
+{
+    return FindKeySegment(static_cast< u32 >(keys.size()), time, cursor, [&keys](u32 i) { return keys[i].timestamp; });
+}
 
-    float t = (time - key1.timestamp) / (key2.timestamp - key1.timestamp);
-    t = glm::clamp(t, 0.0f, 1.0f);
+float SegmentFactor(float time1, float time2, float time)
+{
+    const float t = (time - time1) / (time2 - time1);
+    return glm::clamp(t, 0.0f, 1.0f);
+}
 
-    return glm::mix(key1.position, key2.position, t);
+} // anonymous namespace
+
+float3 AnimationChannel::InterpolatePosition(float time) const
+{
+    u32 cursor = 0;
+    return InterpolatePosition(time, cursor);
 }
 
 quat AnimationChannel::InterpolateRotation(float time) const
 {
-    if (rotationKeys.empty()) 
-        return quat(1.0f, 0.0f, 0.0f, 0.0f);
+    u32 cursor = 0;
+    return InterpolateRotation(time, cursor);
+}
 
-    if (rotationKeys.size() == 1) 
-        return rotationKeys[0].qRotation;
+float3 AnimationChannel::InterpolateScale(float time) const
+{
+    u32 cursor = 0;
+    return InterpolateScale(time, cursor);
+}
 
-    u64 index = 0;
-    for (u64 i = 0; i < rotationKeys.size() - 1; ++i)
-    {
-        if (time < rotationKeys[i + 1].timestamp)
-        {
-            index = i;
-            break;
-        }
-    }
+float3 AnimationChannel::InterpolatePosition(float time, u32& cursor) const
+{
+    if (positionKeys.empty()) 
+        return float3(0.0f);
 
-    if (index >= rotationKeys.size() - 1)
-        return rotationKeys.back().qRotation;
+    if (positionKeys.size() == 1) 
+        return positionKeys[0].position;
 
-    const auto& key1 = rotationKeys[index];
-    const auto& key2 = rotationKeys[index + 1];
+    const u32   index = FindKeySegment(positionKeys, time, cursor);
+    const auto& key1  = positionKeys[index];
+    const auto& key2  = positionKeys[index + 1];
+    return glm::mix(key1.position, key2.position, SegmentFactor(key1.timestamp, key2.timestamp, time));
+}
+
+quat AnimationChannel::InterpolateRotation(float time, u32& cursor) const
+{
+    if (rotationKeys.empty()) 
+        return quat(1.0f, 0.0f, 0.0f, 0.0f);
 
-    float t = (time - key1.timestamp) / (key2.timestamp - key1.timestamp);
-    t = glm::clamp(t, 0.0f, 1.0f);
+    if (rotationKeys.size() == 1) 
+        return rotationKeys[0].qRotation;
 
-    return glm::slerp(key1.qRotation, key2.qRotation, t);
+    const u32   index = FindKeySegment(rotationKeys, time, cursor);
+    const auto& key1  = rotationKeys[index];
+    const auto& key2  = rotationKeys[index + 1];
+    return glm::slerp(key1.qRotation, key2.qRotation, SegmentFactor(key1.timestamp, key2.timestamp, time));
 }
 
-float3 AnimationChannel::InterpolateScale(float time) const
+float3 AnimationChannel::InterpolateScale(float time, u32& cursor) const
 {
     if (scaleKeys.empty()) 
         return float3(1.0f);
@@ -73,41 +111,185 @@ float3 AnimationChannel::InterpolateScale(float time) const
     if (scaleKeys.size() == 1) 
         return scaleKeys[0].scale;
 
-    u64 index = 0;
-    for (u64 i = 0; i < scaleKeys.size() - 1; ++i)
+    const u32   index = FindKeySegment(scaleKeys, time, cursor);
+    const auto& key1  = scaleKeys[index];
+    const auto& key2  = scaleKeys[index + 1];
+    return glm::mix(key1.scale, key2.scale, SegmentFactor(key1.timestamp, key2.timestamp, time));
+}
+
+u64 AnimationChannel::SizeInBytes() const
+{
+    return sizeof(boneIndex)
+        + positionKeys.size() * sizeof(KeyPosition)
+        + rotationKeys.size() * sizeof(KeyRotation)
+        + scaleKeys.size() * sizeof(KeyScale);
+}
+
+
+//-------------------------------------------------------------------------
+// PackedQuat
+//-------------------------------------------------------------------------
+namespace
+{
+
+constexpr float kSmallestThreeRange = 0.70710678f; // 1 / sqrt(2)
+constexpr float kQuantize15         = 32767.0f;
+constexpr float kQuantize16         = 65535.0f;
+
+float3 DequantizeVec3(const u16* pValues, const float3& rangeMin, const float3& rangeExtent)
+{
+    return rangeMin + float3(pValues[0], pValues[1], pValues[2]) / kQuantize16 * rangeExtent;
+}
+
+} // anonymous namespace
+
+PackedQuat PackedQuat::Pack(quat q)
+{
+    q = glm::normalize(q);
+
+    float c[4] = { q.x, q.y, q.z, q.w };
+
+    u32 largest = 0;
+    for (u32 i = 1; i < 4; ++i)
     {
-        if (time < scaleKeys[i + 1].timestamp)
-        {
-            index = i;
-            break;
-        }
+        if (std::abs(c[i]) > std::abs(c[largest]))
+            largest = i;
     }
 
-    if (index >= scaleKeys.size() - 1)
-        return scaleKeys.back().scale;
+    // q and -q are the same rotation; keep the dropped component positive
+    const float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+
+    PackedQuat packed = {};
+    for (u32 i = 0, slot = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
 
-    const auto& key1 = scaleKeys[index];
-    const auto& key2 = scaleKeys[index + 1];
+        const float normalized = glm::clamp(sign * c[i] / kSmallestThreeRange * 0.5f + 0.5f, 0.0f, 1.0f);
+        packed.data[slot++] = static_cast< u16 >(normalized * kQuantize15 + 0.5f);
+    }
+    packed.data[0] |= static_cast< u16 >((largest >> 1) << 15);
+    packed.data[1] |= static_cast< u16 >((largest & 1) << 15);
+    return packed;
+}
 
-    float t = (time - key1.timestamp) / (key2.timestamp - key1.timestamp);
-    t = glm::clamp(t, 0.0f, 1.0f);
+quat PackedQuat::Unpack() const
+{
+    const u32 largest = ((data[0] >> 15) << 1) | (data[1] >> 15);
 
-    return glm::mix(key1.scale, key2.scale, t);
+    float c[4];
+    float sumSq = 0.0f;
+    for (u32 i = 0, slot = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+
+        c[i] = ((data[slot++] & 0x7fff) / kQuantize15 * 2.0f - 1.0f) * kSmallestThreeRange;
+        sumSq += c[i] * c[i];
+    }
+    c[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSq));
+
+    return quat(c[3], c[0], c[1], c[2]);
+}
+
+
+//-------------------------------------------------------------------------
+// CompressedAnimationChannel
+//-------------------------------------------------------------------------
+float3 CompressedAnimationChannel::InterpolatePosition(float time, u32& cursor) const
+{
+    if (positionTimes.empty())
+        return float3(0.0f);
+
+    if (positionTimes.size() == 1)
+        return DequantizeVec3(&positionValues[0], positionMin, positionExtent);
+
+    const u32 index = FindKeySegment(static_cast< u32 >(positionTimes.size()), time, cursor, [this](u32 i) { return float(positionTimes[i]); });
+
+    const float3 p1 = DequantizeVec3(&positionValues[index * 3], positionMin, positionExtent);
+    const float3 p2 = DequantizeVec3(&positionValues[(index + 1) * 3], positionMin, positionExtent);
+    return glm::mix(p1, p2, SegmentFactor(positionTimes[index], positionTimes[index + 1], time));
+}
+
+quat CompressedAnimationChannel::InterpolateRotation(float time, u32& cursor) const
+{
+    if (rotationTimes.empty())
+        return quat(1.0f, 0.0f, 0.0f, 0.0f);
+
+    if (rotationTimes.size() == 1)
+        return rotationValues[0].Unpack();
+
+    const u32 index = FindKeySegment(static_cast< u32 >(rotationTimes.size()), time, cursor, [this](u32 i) { return float(rotationTimes[i]); });
+
+    const quat q1 = rotationValues[index].Unpack();
+    const quat q2 = rotationValues[index + 1].Unpack();
+    return glm::slerp(q1, q2, SegmentFactor(rotationTimes[index], rotationTimes[index + 1], time));
+}
+
+float3 CompressedAnimationChannel::InterpolateScale(float time, u32& cursor) const
+{
+    if (scaleTimes.empty())
+        return float3(1.0f);
+
+    if (scaleTimes.size() == 1)
+        return DequantizeVec3(&scaleValues[0], scaleMin, scaleExtent);
+
+    const u32 index = FindKeySegment(static_cast< u32 >(scaleTimes.size()), time, cursor, [this](u32 i) { return float(scaleTimes[i]); });
+
+    const float3 s1 = DequantizeVec3(&scaleValues[index * 3], scaleMin, scaleExtent);
+    const float3 s2 = DequantizeVec3(&scaleValues[(index + 1) * 3], scaleMin, scaleExtent);
+    return glm::mix(s1, s2, SegmentFactor(scaleTimes[index], scaleTimes[index + 1], time));
+}
+
+u64 CompressedAnimationChannel::SizeInBytes() const
+{
+    return sizeof(boneIndex) + 4 * sizeof(float3)
+        + (positionTimes.size() + positionValues.size() + rotationTimes.size() + scaleTimes.size() + scaleValues.size()) * sizeof(u16)
+        + rotationValues.size() * sizeof(PackedQuat);
 }
 
 
 //-------------------------------------------------------------------------
 // Skeleton
 //-------------------------------------------------------------------------
-u32 Skeleton::GetBoneIndex(const std::string& name) const
+u32 Skeleton::AddBone(const std::string& name, u32 parentIndex, const mat4& mBoneToParent, const mat4& mModelToBone)
 {
-    auto it = boneNameToIndex.find(name);
-    return (it != boneNameToIndex.end()) ? it->second : kInvalidIndex;
+    BB_ASSERT(parentIndex == kInvalidIndex || parentIndex < NumBones(), "Parent of bone '%s' must be added first!", name.c_str());
+
+    const BoneId boneId    = HashBoneName(name);
+    const u32    boneIndex = NumBones();
+
+    boneIds.push_back(boneId);
+    parentIndices.push_back(parentIndex);
+    mBoneToParents.push_back(mBoneToParent);
+    mModelToBones.push_back(mModelToBone);
+    boneNames.push_back(name);
+    boneIdToIndex.emplace(boneId, boneIndex); // first bone of a name wins the lookup
+    return boneIndex;
 }
 
-bool Skeleton::HasBone(const std::string& name) const
+u32 Skeleton::GetBoneIndex(BoneId boneId) const
 {
-    return boneNameToIndex.contains(name);
+    auto it = boneIdToIndex.find(boneId);
+    return (it != boneIdToIndex.end()) ? it->second : kInvalidIndex;
+}
+
+
+//-------------------------------------------------------------------------
+// AnimationClip
+//-------------------------------------------------------------------------
+void AnimationClip::Bind(const Skeleton& skeleton)
+{
+    for (auto& channel : channels)
+        channel.boneIndex = skeleton.GetBoneIndex(channel.boneId);
+}
+
+u64 AnimationClip::SizeInBytes() const
+{
+    u64 sizeInBytes = 0;
+    for (const auto& channel : channels)
+        sizeInBytes += channel.SizeInBytes();
+    return sizeInBytes;
 }
 
 
@@ -125,29 +307,111 @@ mat4 BoneTransform::ToMatrix() const
 //-------------------------------------------------------------------------
 // AnimationPose
 //-------------------------------------------------------------------------
-void AnimationPose::CalculateBoneMatrices(const Skeleton& skeleton)
+namespace
 {
-    u64 numBones = skeleton.bones.size();
-    mBones.resize(numBones);
 
-    std::vector< mat4 > mWorlds(numBones);
-    for (size_t i = 0; i < numBones; ++i)
+template< typename TClip >
+void SampleChannels(AnimationPose& pose, const TClip& clip, const Skeleton& skeleton, float keyTime)
+{
+    const u32 numBones = skeleton.NumBones();
+    if (pose.pCursorClip != &clip || pose.cursors.size() != clip.channels.size() || pose.boneTransforms.size() != numBones)
     {
-        const Bone& bone = skeleton.bones[i];
-        mat4 mModel = boneTransforms[i].ToMatrix();
+        pose.cursors.assign(clip.channels.size(), {});
+        pose.pCursorClip = &clip;
 
-        if (bone.parentIndex == kInvalidIndex)
-        {
-            // Root bone
-            mWorlds[i] = mModel;
-        }
-        else
+        pose.boneTransforms.assign(numBones, {});
+        pose.animatedBones.assign(numBones, 0);
+        for (const auto& channel : clip.channels)
         {
-            // Child bone - multiply with parent transform
-            mWorlds[i] = mWorlds[bone.parentIndex] * mModel;
+            if (channel.boneIndex < numBones)
+                pose.animatedBones[channel.boneIndex] = 1;
         }
+    }
+
+    // Blend/Add write layer motion into bones this clip does not animate; restart them every
+    // sample so layers apply over the clip rather than over last frame's result
+    for (u32 i = 0; i < numBones; ++i)
+    {
+        if (!pose.animatedBones[i])
+            pose.boneTransforms[i] = {};
+    }
+
+    for (size_t i = 0; i < clip.channels.size(); ++i)
+    {
+        const auto& channel = clip.channels[i];
+        if (channel.boneIndex >= pose.boneTransforms.size())
+            continue;
+
+        AnimationCursor& cursor    = pose.cursors[i];
+        BoneTransform&   transform = pose.boneTransforms[channel.boneIndex];
+        transform.position  = channel.InterpolatePosition(keyTime, cursor.position);
+        transform.qRotation = channel.InterpolateRotation(keyTime, cursor.rotation);
+        transform.scale     = channel.InterpolateScale(keyTime, cursor.scale);
+    }
+}
+
+} // anonymous namespace
+
+void AnimationPose::Sample(const AnimationClip& clip, const Skeleton& skeleton, float time)
+{
+    SampleChannels(*this, clip, skeleton, time);
+}
+
+void AnimationPose::Sample(const CompressedAnimationClip& clip, const Skeleton& skeleton, float time)
+{
+    SampleChannels(*this, clip, skeleton, clip.ToKeyTime(time));
+}
+
+void AnimationPose::CalculateBoneMatrices(const Skeleton& skeleton)
+{
+    const u32 numBones = skeleton.NumBones();
+    mBones.resize(numBones);
+    mWorlds.resize(numBones);
+
+    // parents precede children, so every parent world is final by the time it is read
+    const u32*  pParents      = skeleton.parentIndices.data();
+    const mat4* pModelToBones = skeleton.mModelToBones.data();
+    for (u32 i = 0; i < numBones; ++i)
+    {
+        const mat4 mLocal = boneTransforms[i].ToMatrix();
+        mWorlds[i] = pParents[i] == kInvalidIndex ? mLocal : mWorlds[pParents[i]] * mLocal;
 
         // Final bone matrix = globalInverse * worldTransform * inverseBindPose
-        mBones[i] = skeleton.mWorldInv * mWorlds[i] * bone.mModelToBone;
+        mBones[i] = skeleton.mWorldInv * mWorlds[i] * pModelToBones[i];
+    }
+}
+
+void AnimationPose::Blend(const AnimationPose& other, float weight)
+{
+    const size_t numBones = std::min(boneTransforms.size(), other.boneTransforms.size());
+    for (size_t i = 0; i < numBones; ++i)
+    {
+        if (!other.animatedBones[i])
+            continue;
+
+        BoneTransform&       dst = boneTransforms[i];
+        const BoneTransform& src = other.boneTransforms[i];
+        dst.position  = glm::mix(dst.position, src.position, weight);
+        dst.qRotation = glm::slerp(dst.qRotation, src.qRotation, weight);
+        dst.scale     = glm::mix(dst.scale, src.scale, weight);
+    }
+}
+
+void AnimationPose::Add(const AnimationPose& other, const AnimationPose& reference, float weight)
+{
+    const size_t numBones = std::min({ boneTransforms.size(), other.boneTransforms.size(), reference.boneTransforms.size() });
+    for (size_t i = 0; i < numBones; ++i)
+    {
+        if (!other.animatedBones[i])
+            continue;
+
+        BoneTransform&       dst = boneTransforms[i];
+        const BoneTransform& src = other.boneTransforms[i];
+        const BoneTransform& ref = reference.boneTransforms[i];
+
+        const quat qDelta = glm::inverse(ref.qRotation) * src.qRotation;
+        dst.position  += (src.position - ref.position) * weight;
+        dst.qRotation  = dst.qRotation * glm::slerp(quat(1.0f, 0.0f, 0.0f, 0.0f), qDelta, weight);
+        dst.scale     *= glm::mix(float3(1.0f), src.scale / ref.scale, weight);
     }
 }
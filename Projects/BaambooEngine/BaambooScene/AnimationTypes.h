@@ -1,17 +1,17 @@
 #pragma once
 #include "MathTypes.h"
+#include "RenderCommon/BindingId.h"
+
+#include <string_view>
 
 //-------------------------------------------------------------------------
 // Animation Data Structures
 //-------------------------------------------------------------------------
-struct Bone
-{
-    std::string name;
 
-    u32  parentIndex  = kInvalidIndex;
-    mat4 mBoneToModel = mat4(1.0f);
-    mat4 mModelToBone = mat4(1.0f);
-};
+// 64-bit FNV-1a of the bone name. Bones and channels are matched by id at load time only.
+using BoneId = u64;
+
+constexpr BoneId HashBoneName(std::string_view name) { return render::HashBindingName(name.data(), name.size()); }
 
 struct KeyPosition
 {
@@ -33,9 +33,8 @@ struct KeyScale
 
 struct AnimationChannel
 {
-    std::string boneName;
-
-    u32 boneIndex = kInvalidIndex;
+    BoneId boneId    = 0;
+    u32    boneIndex = kInvalidIndex; // bound by AnimationClip::Bind
 
     std::vector< KeyPosition > positionKeys;
     std::vector< KeyRotation > rotationKeys;
@@ -44,8 +43,25 @@ struct AnimationChannel
     float3 InterpolatePosition(float time) const;
     quat InterpolateRotation(float time) const;
     float3 InterpolateScale(float time) const;
+
+    // 'cursor' is the key segment found by the previous sample; forward playback resumes from it
+    // in a step or two, anything else (seek, loop wrap) falls back to a binary search
+    float3 InterpolatePosition(float time, u32& cursor) const;
+    quat InterpolateRotation(float time, u32& cursor) const;
+    float3 InterpolateScale(float time, u32& cursor) const;
+
+    u64 SizeInBytes() const;
+};
+
+struct AnimationCursor
+{
+    u32 position = 0;
+    u32 rotation = 0;
+    u32 scale    = 0;
 };
 
+struct Skeleton;
+
 struct AnimationClip
 {
     std::string name;
@@ -56,17 +72,94 @@ struct AnimationClip
     std::vector< AnimationChannel > channels;
 
     inline float GetDurationInSeconds() const { return duration / ticksPerSecond; }
+
+    // resolves every channel's boneIndex from its boneId; unknown bones get kInvalidIndex
+    void Bind(const Skeleton& skeleton);
+
+    u64 SizeInBytes() const;
+};
+
+// 48-bit smallest-three quaternion: the largest component is rebuilt from unit length,
+// the other three keep 15 bits each over [-1/sqrt(2), 1/sqrt(2)]
+struct PackedQuat
+{
+    u16 data[3] = {};
+
+    static PackedQuat Pack(quat q);
+    quat Unpack() const;
 };
 
+// Compressed counterpart of AnimationChannel. Key times are 16-bit over the clip duration,
+// translations and scales 16 bits per component over the track's own range.
+struct CompressedAnimationChannel
+{
+    u32 boneIndex = kInvalidIndex;
+
+    float3 positionMin    = float3(0.0f);
+    float3 positionExtent = float3(0.0f);
+    float3 scaleMin       = float3(1.0f);
+    float3 scaleExtent    = float3(0.0f);
+
+    std::vector< u16 >        positionTimes;
+    std::vector< u16 >        positionValues; // xyz per key
+    std::vector< u16 >        rotationTimes;
+    std::vector< PackedQuat > rotationValues;
+    std::vector< u16 >        scaleTimes;
+    std::vector< u16 >        scaleValues;    // xyz per key
+
+    // 'time' in quantized units, see CompressedAnimationClip::ToKeyTime
+    float3 InterpolatePosition(float time, u32& cursor) const;
+    quat InterpolateRotation(float time, u32& cursor) const;
+    float3 InterpolateScale(float time, u32& cursor) const;
+
+    u64 SizeInBytes() const;
+};
+
+struct CompressedAnimationClip
+{
+    static constexpr float kKeyTimeScale = 65535.0f;
+
+    std::string name;
+
+    float duration = 0.0f;
+    float ticksPerSecond = 25.0f;
+
+    std::vector< CompressedAnimationChannel > channels;
+
+    // compressor report
+    u64   rawSizeInBytes = 0;
+    u64   sizeInBytes    = 0;
+    float maxError       = 0.0f; // model space, over all bones and source key times
+
+    inline float GetDurationInSeconds() const { return duration / ticksPerSecond; }
+    inline float GetCompressionRatio() const { return sizeInBytes > 0 ? float(rawSizeInBytes) / float(sizeInBytes) : 0.0f; }
+    inline float ToKeyTime(float ticks) const { return duration > 0.0f ? glm::clamp(ticks / duration, 0.0f, 1.0f) * kKeyTimeScale : 0.0f; }
+};
+
+// Flat, parent-sorted bone arrays: a parent always precedes its children, so model-space
+// composition is a single forward pass over the arrays.
 struct Skeleton
 {
-    std::vector< Bone >                    bones;
-    std::unordered_map< std::string, u32 > boneNameToIndex;
+    std::vector< BoneId > boneIds;
+    std::vector< u32 >    parentIndices; // kInvalidIndex for roots
+    std::vector< mat4 >   mBoneToParents;
+    std::vector< mat4 >   mModelToBones; // inverse bind pose
+
+    std::vector< std::string > boneNames; // diagnostics only
+
+    std::unordered_map< BoneId, u32 > boneIdToIndex; // load-time binding only
 
     mat4 mWorldInv = mat4(1.0f);
 
-    u32 GetBoneIndex(const std::string& name) const;
-    bool HasBone(const std::string& name) const;
+    inline u32 NumBones() const { return static_cast< u32 >(boneIds.size()); }
+
+    // 'parentIndex' must already be in the skeleton (or kInvalidIndex)
+    u32 AddBone(const std::string& name, u32 parentIndex, const mat4& mBoneToParent, const mat4& mModelToBone);
+
+    u32 GetBoneIndex(BoneId boneId) const;
+    u32 GetBoneIndex(const std::string& name) const { return GetBoneIndex(HashBoneName(name)); }
+    bool HasBone(BoneId boneId) const { return boneIdToIndex.contains(boneId); }
+    bool HasBone(const std::string& name) const { return HasBone(HashBoneName(name)); }
 };
 
 struct BoneTransform
@@ -83,7 +176,25 @@ struct AnimationPose
     std::vector< BoneTransform > boneTransforms;
     std::vector< mat4 >          mBones;
 
+    // per-channel key cursors of the clip last sampled into this pose (raw or compressed)
+    std::vector< AnimationCursor > cursors;
+    const void*                    pCursorClip = nullptr;
+
+    // per bone, 1 when the sampled clip has a channel for it
+    std::vector< u8 > animatedBones;
+
+    // 'time' in ticks. Bones without a channel are reset to identity on every call.
+    void Sample(const AnimationClip& clip, const Skeleton& skeleton, float time);
+    void Sample(const CompressedAnimationClip& clip, const Skeleton& skeleton, float time);
     void CalculateBoneMatrices(const Skeleton& skeleton);
+
+    // Both touch only the bones 'other' animates.
+    //   Blend: this = lerp(this, other, weight)
+    //   Add  : this += weight * (other - reference), in each bone's local space
+    void Blend(const AnimationPose& other, float weight);
+    void Add(const AnimationPose& other, const AnimationPose& reference, float weight);
+
+    std::vector< mat4 > mWorlds; // CalculateBoneMatrices scratch, kept across calls
 };
 
 // Animation import data
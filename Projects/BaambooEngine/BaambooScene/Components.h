@@ -137,30 +137,39 @@ struct MaterialComponent
 //-------------------------------------------------------------------------
 struct AnimationComponent
 {
-	u32   skeletonID;
-	u32   currentClipID;
-	float currentTime;
-	float playbackSpeed;
-	bool  bPlaying;
-	bool  bLoop;
-
-	// Animation blending
+	u32   skeletonID    = kInvalidIndex;
+	u32   currentClipID = kInvalidIndex;
+	float currentTime   = 0.0f; // seconds
+	float playbackSpeed = 1.0f;
+	bool  bPlaying      = false;
+	bool  bLoop         = true;
+
+	// Animation blending : applied in order over the base clip, always looping
 	struct BlendLayer
 	{
-		u32   clipID = kInvalidIndex;
-		float weight = 1.0f;
-		float time   = 0.0f;
+		u32   clipID    = kInvalidIndex;
+		float weight    = 1.0f;
+		float time      = 0.0f;
+		bool  bAdditive = false; // adds the clip's motion relative to its first frame instead of blending toward it
+
+		AnimationPose pose;
+		AnimationPose referencePose; // additive only
 	};
 	std::vector< BlendLayer > blendLayers;
 
-	// Current pose
+	// Current pose. Entities playing a single clip share a cached pose instead (sharedPoseIndex),
+	// see AnimationSystem::GetBoneMatrices.
 	AnimationPose currentPose;
+	u32           sharedPoseIndex = kInvalidIndex;
+
+	// Transition state : cross-fades into 'transitionToClipID', started from its beginning,
+	// over 'transitionDuration' seconds. Set bTransitioning to start.
+	bool  bTransitioning     = false;
+	float transitionDuration = 0.0f;
+	float transitionTime     = 0.0f;
+	u32   transitionToClipID = kInvalidIndex;
 
-	// Transition state
-	bool  bTransitioning;
-	float transitionDuration;
-	float transitionTime;
-	u32   transitionToClipID;
+	AnimationPose transitionPose;
 };
 
 //-------------------------------------------------------------------------
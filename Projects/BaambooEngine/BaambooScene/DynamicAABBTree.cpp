@@ -0,0 +1,330 @@
+#include "BaambooPch.h"
+#include "DynamicAABBTree.h"
+
+namespace baamboo
+{
+
+namespace
+{
+
+float SurfaceArea(const float3& min, const float3& max)
+{
+	const float3 d = max - min;
+	return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+bool Contains(const float3& outerMin, const float3& outerMax, const float3& innerMin, const float3& innerMax)
+{
+	return glm::all(glm::lessThanEqual(outerMin, innerMin)) && glm::all(glm::lessThanEqual(innerMax, outerMax));
+}
+
+} // anonymous namespace
+
+u32 DynamicAABBTree::CreateProxy(const BoundingBox& aabb, u64 userData)
+{
+	const u32 proxy = AllocateNode();
+
+	Node& node = m_Nodes[proxy];
+	node.min      = aabb.Min() - float3(m_Margin);
+	node.max      = aabb.Max() + float3(m_Margin);
+	node.userData = userData;
+	node.height   = 0;
+
+	InsertLeaf(proxy);
+	++m_NumProxies;
+
+	return proxy;
+}
+
+void DynamicAABBTree::DestroyProxy(u32 proxy)
+{
+	BB_ASSERT(proxy < m_Nodes.size() && m_Nodes[proxy].IsLeaf() && m_Nodes[proxy].height == 0, "Invalid proxy %u!", proxy);
+
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	--m_NumProxies;
+}
+
+bool DynamicAABBTree::MoveProxy(u32 proxy, const BoundingBox& aabb)
+{
+	BB_ASSERT(proxy < m_Nodes.size() && m_Nodes[proxy].IsLeaf() && m_Nodes[proxy].height == 0, "Invalid proxy %u!", proxy);
+
+	const float3 fatMin = aabb.Min() - float3(m_Margin);
+	const float3 fatMax = aabb.Max() + float3(m_Margin);
+
+	// keep the fat box while it still holds the bounds and is not oversized for them
+	// (an object that shrank, e.g. scaled down, would otherwise stay loose forever)
+	Node& node = m_Nodes[proxy];
+	if (Contains(node.min, node.max, aabb.Min(), aabb.Max()))
+	{
+		const float3 hugeMin = fatMin - float3(4.0f * m_Margin);
+		const float3 hugeMax = fatMax + float3(4.0f * m_Margin);
+		if (Contains(hugeMin, hugeMax, node.min, node.max))
+			return false;
+	}
+
+	RemoveLeaf(proxy);
+
+	m_Nodes[proxy].min = fatMin;
+	m_Nodes[proxy].max = fatMax;
+
+	InsertLeaf(proxy);
+	return true;
+}
+
+float DynamicAABBTree::AreaRatio() const
+{
+	if (m_Root == kInvalidIndex)
+		return 0.0f;
+
+	const float rootArea = SurfaceArea(m_Nodes[m_Root].min, m_Nodes[m_Root].max);
+	if (rootArea <= 0.0f)
+		return 0.0f;
+
+	float totalArea = 0.0f;
+	for (const auto& node : m_Nodes)
+	{
+		if (node.height > 0)
+			totalArea += SurfaceArea(node.min, node.max);
+	}
+	return totalArea / rootArea;
+}
+
+u32 DynamicAABBTree::AllocateNode()
+{
+	if (m_FreeList == kInvalidIndex)
+	{
+		m_Nodes.emplace_back();
+		return static_cast< u32 >(m_Nodes.size() - 1);
+	}
+
+	const u32 index = m_FreeList;
+	m_FreeList = m_Nodes[index].parent;
+
+	m_Nodes[index] = Node{};
+	return index;
+}
+
+void DynamicAABBTree::FreeNode(u32 index)
+{
+	m_Nodes[index]        = Node{};
+	m_Nodes[index].parent = m_FreeList;
+	m_FreeList = index;
+}
+
+void DynamicAABBTree::InsertLeaf(u32 leaf)
+{
+	if (m_Root == kInvalidIndex)
+	{
+		m_Root = leaf;
+		m_Nodes[leaf].parent = kInvalidIndex;
+		return;
+	}
+
+	const float3 leafMin = m_Nodes[leaf].min;
+	const float3 leafMax = m_Nodes[leaf].max;
+
+	// descend toward the sibling that grows the tree's surface area least
+	u32 index = m_Root;
+	while (!m_Nodes[index].IsLeaf())
+	{
+		const Node& node = m_Nodes[index];
+
+		const float area         = SurfaceArea(node.min, node.max);
+		const float combinedArea = SurfaceArea(glm::min(node.min, leafMin), glm::max(node.max, leafMax));
+
+		// cost of pairing the leaf with this node, and the cost pushed down to either child
+		const float cost            = 2.0f * combinedArea;
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+
+		auto childCost = [&](u32 childIndex)
+			{
+				const Node& child = m_Nodes[childIndex];
+
+				const float newArea = SurfaceArea(glm::min(child.min, leafMin), glm::max(child.max, leafMax));
+				return (child.IsLeaf() ? newArea : newArea - SurfaceArea(child.min, child.max)) + inheritanceCost;
+			};
+		const float cost1 = childCost(node.child1);
+		const float cost2 = childCost(node.child2);
+
+		if (cost < cost1 && cost < cost2)
+			break;
+
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	const u32 sibling   = index;
+	const u32 newParent = AllocateNode();
+	const u32 oldParent = m_Nodes[sibling].parent;
+
+	Node& parentNode = m_Nodes[newParent];
+	parentNode.parent = oldParent;
+	parentNode.min    = glm::min(leafMin, m_Nodes[sibling].min);
+	parentNode.max    = glm::max(leafMax, m_Nodes[sibling].max);
+	parentNode.height = m_Nodes[sibling].height + 1;
+	parentNode.child1 = sibling;
+	parentNode.child2 = leaf;
+
+	if (oldParent != kInvalidIndex)
+	{
+		if (m_Nodes[oldParent].child1 == sibling)
+			m_Nodes[oldParent].child1 = newParent;
+		else
+			m_Nodes[oldParent].child2 = newParent;
+	}
+	else
+	{
+		m_Root = newParent;
+	}
+
+	m_Nodes[sibling].parent = newParent;
+	m_Nodes[leaf].parent    = newParent;
+
+	RefitAncestors(m_Nodes[leaf].parent);
+}
+
+void DynamicAABBTree::RemoveLeaf(u32 leaf)
+{
+	if (leaf == m_Root)
+	{
+		m_Root = kInvalidIndex;
+		return;
+	}
+
+	const u32 parent      = m_Nodes[leaf].parent;
+	const u32 grandParent = m_Nodes[parent].parent;
+	const u32 sibling     = m_Nodes[parent].child1 == leaf ? m_Nodes[parent].child2 : m_Nodes[parent].child1;
+
+	FreeNode(parent);
+	m_Nodes[leaf].parent = kInvalidIndex;
+
+	if (grandParent == kInvalidIndex)
+	{
+		m_Root = sibling;
+		m_Nodes[sibling].parent = kInvalidIndex;
+		return;
+	}
+
+	if (m_Nodes[grandParent].child1 == parent)
+		m_Nodes[grandParent].child1 = sibling;
+	else
+		m_Nodes[grandParent].child2 = sibling;
+	m_Nodes[sibling].parent = grandParent;
+
+	RefitAncestors(grandParent);
+}
+
+void DynamicAABBTree::RefitAncestors(u32 index)
+{
+	while (index != kInvalidIndex)
+	{
+		index = Balance(index);
+
+		Node& node = m_Nodes[index];
+		const Node& child1 = m_Nodes[node.child1];
+		const Node& child2 = m_Nodes[node.child2];
+
+		node.min    = glm::min(child1.min, child2.min);
+		node.max    = glm::max(child1.max, child2.max);
+		node.height = 1 + std::max(child1.height, child2.height);
+
+		index = node.parent;
+	}
+}
+
+// Rotates the taller grandchild subtree up when A's children differ in height by more than one.
+// Returns the index of the node now at A's place.
+u32 DynamicAABBTree::Balance(u32 iA)
+{
+	Node& A = m_Nodes[iA];
+	if (A.IsLeaf() || A.height < 2)
+		return iA;
+
+	const u32 iB = A.child1;
+	const u32 iC = A.child2;
+	Node& B = m_Nodes[iB];
+	Node& C = m_Nodes[iC];
+
+	auto replaceChild = [this](u32 parent, u32 oldChild, u32 newChild)
+		{
+			if (parent == kInvalidIndex)
+				m_Root = newChild;
+			else if (m_Nodes[parent].child1 == oldChild)
+				m_Nodes[parent].child1 = newChild;
+			else
+				m_Nodes[parent].child2 = newChild;
+		};
+
+	auto refit = [this](Node& node, u32 child1, u32 child2)
+		{
+			node.min    = glm::min(m_Nodes[child1].min, m_Nodes[child2].min);
+			node.max    = glm::max(m_Nodes[child1].max, m_Nodes[child2].max);
+			node.height = 1 + std::max(m_Nodes[child1].height, m_Nodes[child2].height);
+		};
+
+	const i32 balance = C.height - B.height;
+
+	// rotate C up
+	if (balance > 1)
+	{
+		const u32 iF = C.child1;
+		const u32 iG = C.child2;
+
+		C.child1 = iA;
+		C.parent = A.parent;
+		A.parent = iC;
+		replaceChild(C.parent, iA, iC);
+
+		if (m_Nodes[iF].height > m_Nodes[iG].height)
+		{
+			C.child2 = iF;
+			A.child2 = iG;
+			m_Nodes[iG].parent = iA;
+			refit(A, iB, iG);
+			refit(C, iA, iF);
+		}
+		else
+		{
+			C.child2 = iG;
+			A.child2 = iF;
+			m_Nodes[iF].parent = iA;
+			refit(A, iB, iF);
+			refit(C, iA, iG);
+		}
+		return iC;
+	}
+
+	// rotate B up
+	if (balance < -1)
+	{
+		const u32 iD = B.child1;
+		const u32 iE = B.child2;
+
+		B.child1 = iA;
+		B.parent = A.parent;
+		A.parent = iB;
+		replaceChild(B.parent, iA, iB);
+
+		if (m_Nodes[iD].height > m_Nodes[iE].height)
+		{
+			B.child2 = iD;
+			A.child1 = iE;
+			m_Nodes[iE].parent = iA;
+			refit(A, iC, iE);
+			refit(B, iA, iD);
+		}
+		else
+		{
+			B.child2 = iE;
+			A.child1 = iD;
+			m_Nodes[iD].parent = iA;
+			refit(A, iC, iD);
+			refit(B, iA, iE);
+		}
+		return iB;
+	}
+
+	return iA;
+}
+
+} // namespace baamboo
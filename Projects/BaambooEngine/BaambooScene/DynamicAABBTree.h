@@ -0,0 +1,301 @@
+#pragma once
+#include "Boundings.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <vector>
+
+namespace baamboo
+{
+
+// =========================================================================
+// DynamicAABBTree — incrementally maintained bounding volume hierarchy.
+//
+//   Every proxy is a leaf holding a fattened copy of its bounds, so small
+//   moves cost nothing; a proxy that leaves its fat box is removed and
+//   re-inserted at the cheapest sibling (surface area heuristic), and AVL
+//   style rotations on the way back up keep the tree balanced.
+//
+//   Query callbacks receive (proxy, userData). Returning false from a box,
+//   sphere or frustum callback stops the query.
+// =========================================================================
+class DynamicAABBTree
+{
+public:
+	explicit DynamicAABBTree(float margin = 0.1f) : m_Margin(margin) {}
+
+	u32  CreateProxy(const BoundingBox& aabb, u64 userData);
+	void DestroyProxy(u32 proxy);
+
+	// Returns true when the proxy had to be re-inserted, i.e. 'aabb' left its fat bounds
+	// or shrank well inside them.
+	bool MoveProxy(u32 proxy, const BoundingBox& aabb);
+
+	[[nodiscard]]
+	u64 GetUserData(u32 proxy) const { return m_Nodes[proxy].userData; }
+	[[nodiscard]]
+	BoundingBox GetFatAABB(u32 proxy) const { return BoundingBox(m_Nodes[proxy].min, m_Nodes[proxy].max); }
+
+	[[nodiscard]]
+	u32 NumProxies() const { return m_NumProxies; }
+	[[nodiscard]]
+	u32 Height() const { return m_Root != kInvalidIndex ? static_cast< u32 >(m_Nodes[m_Root].height) : 0; }
+	// summed surface area of the internal nodes over the root's; lower is a tighter tree
+	[[nodiscard]]
+	float AreaRatio() const;
+
+	template< typename Fn >
+	void Query(const BoundingBox& aabb, Fn&& fn) const
+	{
+		const float3 boxMin = aabb.Min();
+		const float3 boxMax = aabb.Max();
+		Traverse([&](const Node& node)
+			{
+				return node.min.x <= boxMax.x && boxMin.x <= node.max.x
+					&& node.min.y <= boxMax.y && boxMin.y <= node.max.y
+					&& node.min.z <= boxMax.z && boxMin.z <= node.max.z;
+			}, fn);
+	}
+
+	template< typename Fn >
+	void Query(const BoundingSphere& sphere, Fn&& fn) const
+	{
+		const float3 center  = sphere.Center();
+		const float  radius2 = sphere.Radius() * sphere.Radius();
+		Traverse([&](const Node& node)
+			{
+				const float3 closest = glm::clamp(center, node.min, node.max);
+				const float3 delta   = closest - center;
+				return glm::dot(delta, delta) <= radius2;
+			}, fn);
+	}
+
+	// Planes already passed by a node are not tested again below it, and a node inside
+	// every plane reports its whole subtree without further tests.
+	template< typename Fn >
+	void Query(const BoundingFrustum& frustum, Fn&& fn) const
+	{
+		if (m_Root == kInvalidIndex)
+			return;
+
+		constexpr u32 kAllPlanes = (1u << BoundingFrustum::kNumPlanes) - 1;
+
+		struct Entry
+		{
+			u32 node;
+			u32 planeMask; // planes still to test
+		};
+		std::vector< Entry > stack;
+		stack.reserve(64);
+		stack.push_back({ m_Root, kAllPlanes });
+
+		while (!stack.empty())
+		{
+			const Entry entry = stack.back();
+			stack.pop_back();
+
+			const Node& node = m_Nodes[entry.node];
+			const float3 center = (node.min + node.max) * 0.5f;
+			const float3 extent = (node.max - node.min) * 0.5f;
+
+			u32  planeMask = entry.planeMask;
+			bool bOutside  = false;
+			for (u32 i = 0; i < BoundingFrustum::kNumPlanes && !bOutside; ++i)
+			{
+				if ((planeMask & (1u << i)) == 0)
+					continue;
+
+				const float4& plane    = frustum.Plane(i);
+				const float   distance = glm::dot(float3(plane), center) + plane.w;
+				const float   radius   = glm::dot(glm::abs(float3(plane)), extent);
+				if (distance < -radius)
+					bOutside = true;
+				else if (distance >= radius)
+					planeMask &= ~(1u << i);
+			}
+
+			if (bOutside)
+				continue;
+
+			if (planeMask == 0)
+			{
+				if (!ReportSubtree(entry.node, fn))
+					return;
+			}
+			else if (node.IsLeaf())
+			{
+				if (!fn(entry.node, node.userData))
+					return;
+			}
+			else
+			{
+				stack.push_back({ node.child1, planeMask });
+				stack.push_back({ node.child2, planeMask });
+			}
+		}
+	}
+
+	// Nearest-first walk along the ray. fn(proxy, userData, distance) gets the distance at which
+	// the ray enters the proxy's fat bounds and returns the new maximum distance: 'distance'
+	// to keep only closer candidates, 'maxDistance' to visit all of them, 0 to stop.
+	template< typename Fn >
+	void RayCast(const float3& origin, const float3& direction, float maxDistance, Fn&& fn) const
+	{
+		if (m_Root == kInvalidIndex)
+			return;
+
+		constexpr float kMiss = FLT_MAX;
+
+		const float3 invDirection = 1.0f / direction;
+		auto enterDistance = [&](const Node& node)
+			{
+				const float3 t0   = (node.min - origin) * invDirection;
+				const float3 t1   = (node.max - origin) * invDirection;
+				const float3 tMin = glm::min(t0, t1);
+				const float3 tMax = glm::max(t0, t1);
+
+				const float enter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+				const float exit  = std::min(std::min(tMax.x, tMax.y), tMax.z);
+				return enter <= exit ? enter : kMiss;
+			};
+		// a miss must fail the distance test even while maxDistance is still FLT_MAX
+		auto isCandidate = [&maxDistance](float distance) { return distance != kMiss && distance <= maxDistance; };
+
+		struct Entry
+		{
+			u32   node;
+			float distance;
+		};
+		std::vector< Entry > stack;
+		stack.reserve(64);
+
+		const float rootDistance = enterDistance(m_Nodes[m_Root]);
+		if (isCandidate(rootDistance))
+			stack.push_back({ m_Root, rootDistance });
+
+		while (!stack.empty())
+		{
+			const Entry entry = stack.back();
+			stack.pop_back();
+
+			if (!isCandidate(entry.distance))
+				continue;
+
+			const Node& node = m_Nodes[entry.node];
+			if (node.IsLeaf())
+			{
+				maxDistance = fn(entry.node, node.userData, entry.distance);
+				if (maxDistance <= 0.0f)
+					return;
+				continue;
+			}
+
+			Entry nearChild = { node.child1, enterDistance(m_Nodes[node.child1]) };
+			Entry farChild  = { node.child2, enterDistance(m_Nodes[node.child2]) };
+			if (farChild.distance < nearChild.distance)
+				std::swap(nearChild, farChild);
+
+			// nearer child is popped first
+			if (isCandidate(farChild.distance))
+				stack.push_back(farChild);
+			if (isCandidate(nearChild.distance))
+				stack.push_back(nearChild);
+		}
+	}
+
+private:
+	struct Node
+	{
+		float3 min = float3(0.0f);
+		float3 max = float3(0.0f);
+
+		u64 userData = 0;
+
+		u32 parent = kInvalidIndex; // next free node while on the free list
+		u32 child1 = kInvalidIndex;
+		u32 child2 = kInvalidIndex;
+		i32 height = -1;            // 0 for leaves, -1 while free
+
+		bool IsLeaf() const { return child1 == kInvalidIndex; }
+	};
+
+	template< typename Test, typename Fn >
+	void Traverse(Test&& test, Fn& fn) const
+	{
+		if (m_Root == kInvalidIndex)
+			return;
+
+		std::vector< u32 > stack;
+		stack.reserve(64);
+		stack.push_back(m_Root);
+
+		while (!stack.empty())
+		{
+			const u32 index = stack.back();
+			stack.pop_back();
+
+			const Node& node = m_Nodes[index];
+			if (!test(node))
+				continue;
+
+			if (node.IsLeaf())
+			{
+				if (!fn(index, node.userData))
+					return;
+			}
+			else
+			{
+				stack.push_back(node.child1);
+				stack.push_back(node.child2);
+			}
+		}
+	}
+
+	template< typename Fn >
+	bool ReportSubtree(u32 root, Fn& fn) const
+	{
+		std::vector< u32 > stack;
+		stack.reserve(64);
+		stack.push_back(root);
+
+		while (!stack.empty())
+		{
+			const u32 index = stack.back();
+			stack.pop_back();
+
+			const Node& node = m_Nodes[index];
+			if (node.IsLeaf())
+			{
+				if (!fn(index, node.userData))
+					return false;
+			}
+			else
+			{
+				stack.push_back(node.child1);
+				stack.push_back(node.child2);
+			}
+		}
+		return true;
+	}
+
+	u32  AllocateNode();
+	void FreeNode(u32 index);
+
+	void InsertLeaf(u32 leaf);
+	void RemoveLeaf(u32 leaf);
+	u32  Balance(u32 index);
+
+	// recomputes bounds and heights from 'index' up to the root, rebalancing on the way
+	void RefitAncestors(u32 index);
+
+private:
+	std::vector< Node > m_Nodes;
+
+	u32 m_Root       = kInvalidIndex;
+	u32 m_FreeList   = kInvalidIndex;
+	u32 m_NumProxies = 0;
+
+	float m_Margin;
+};
+
+} // namespace baamboo
@@ -72,6 +72,15 @@ Entity Entity::Clone()
 				newComponent = orgComponent;
 			}
 
+			if (original.HasAll< AnimationComponent >())
+			{
+				cloned.AttachComponent< AnimationComponent >();
+
+				auto& orgComponent = original.GetComponent< AnimationComponent >();
+				auto& newComponent = cloned.GetComponent< AnimationComponent >();
+				newComponent = orgComponent;
+			}
+
 			if (original.HasAll< LightComponent >())
 			{
 				cloned.AttachComponent< LightComponent >();
@@ -88,6 +88,36 @@ std::vector< f32 > ComputeTangentHandedness(const aiMesh& mesh, bool bFlipUVs)
     return handedness;
 }
 
+template< typename T >
+u64 VectorSizeInBytes(const std::vector< T >& v)
+{
+    return v.capacity() * sizeof(T);
+}
+
+u64 MeshSizeInBytes(const MeshData& mesh)
+{
+    u64 sizeInBytes = VectorSizeInBytes(mesh.vertices) + VectorSizeInBytes(mesh.skinnedVertices)
+        + VectorSizeInBytes(mesh.boneIndices) + VectorSizeInBytes(mesh.boneWeights) + VectorSizeInBytes(mesh.lods);
+    for (const auto& lod : mesh.lods)
+    {
+        sizeInBytes += VectorSizeInBytes(lod.indices) + VectorSizeInBytes(lod.meshlets)
+            + VectorSizeInBytes(lod.meshletVertices) + VectorSizeInBytes(lod.meshletTriangles);
+    }
+    return sizeInBytes;
+}
+
+u64 AnimationSizeInBytes(const AnimationData& animation)
+{
+    const Skeleton& skeleton = animation.skeleton;
+
+    u64 sizeInBytes = VectorSizeInBytes(skeleton.boneIds) + VectorSizeInBytes(skeleton.parentIndices)
+        + VectorSizeInBytes(skeleton.mBoneToParents) + VectorSizeInBytes(skeleton.mModelToBones)
+        + VectorSizeInBytes(animation.clips);
+    for (const auto& clip : animation.clips)
+        sizeInBytes += clip.SizeInBytes();
+    return sizeInBytes;
+}
+
 } // namespace
 
 
@@ -136,6 +166,11 @@ ModelLoader::ModelLoader(fs::path filepath, MeshDescriptor descriptor)
 	m_pRootNode       = new ModelNode();
 	m_pRootNode->aabb = BoundingBox(float3(std::numeric_limits<float>::max()), float3(std::numeric_limits<float>::min()));
 	ProcessNode(aiScene->mRootNode, aiScene, m_pRootNode, descriptor);
+
+	u64 sizeInBytes = VectorSizeInBytes(m_Meshes) + VectorSizeInBytes(m_Materials) + AnimationSizeInBytes(m_AnimationData);
+	for (const auto& mesh : m_Meshes)
+		sizeInBytes += MeshSizeInBytes(mesh);
+	m_TrackedMemory.Add(sizeInBytes);
 }
 
 ModelLoader::~ModelLoader()
@@ -522,7 +557,15 @@ void ModelLoader::ProcessAnimations(const aiScene* scene)
 	if (!scene->HasAnimations())
 		return;
 
-	// First, build the bone hierarchy
+	// Collect mesh bones once so the hierarchy walk is a hash lookup per node
+	for (u32 i = 0; i < scene->mNumMeshes; ++i)
+	{
+		aiMesh* mesh = scene->mMeshes[i];
+		for (u32 j = 0; j < mesh->mNumBones; ++j)
+			m_BoneOffsets.emplace(HashBoneName(mesh->mBones[j]->mName.C_Str()), ConvertMatrix(mesh->mBones[j]->mOffsetMatrix));
+	}
+
+	// First, build the bone hierarchy (depth-first, so parents precede children)
 	ProcessBoneHierarchy(scene->mRootNode, scene);
 
 	// Store global inverse transform
@@ -532,6 +575,7 @@ void ModelLoader::ProcessAnimations(const aiScene* scene)
 	for (u32 i = 0; i < scene->mNumAnimations; ++i)
 	{
 		AnimationClip clip = ProcessAnimationClip(scene->mAnimations[i]);
+		clip.Bind(m_AnimationData.skeleton);
 		m_AnimationData.clips.push_back(std::move(clip));
 	}
 
@@ -540,53 +584,18 @@ void ModelLoader::ProcessAnimations(const aiScene* scene)
 
 void ModelLoader::ProcessBoneHierarchy(aiNode* node, const aiScene* scene, i32 parentIndex)
 {
-    std::string nodeName = node->mName.C_Str();
-
-    // Check if this node is a bone by looking through all meshes
-    bool bIsBone = false;
-    for (u32 i = 0; i < scene->mNumMeshes; ++i)
-    {
-        aiMesh* mesh = scene->mMeshes[i];
-        for (u32 j = 0; j < mesh->mNumBones; ++j)
-        {
-            if (nodeName == mesh->mBones[j]->mName.C_Str())
-            {
-                bIsBone = true;
-                break;
-            }
-        }
-
-        if (bIsBone) 
-            break;
-    }
+    const auto itOffset = m_BoneOffsets.find(HashBoneName(node->mName.C_Str()));
+    const bool bIsBone  = itOffset != m_BoneOffsets.end();
 
     // If this node is a bone or has bone children, add it to skeleton
     u32 currentBoneIndex = kInvalidIndex;
     if (bIsBone || parentIndex != -1)
     {
-        Bone bone;
-        bone.name = nodeName;
-        bone.parentIndex = (parentIndex >= 0) ? static_cast<u32>(parentIndex) : kInvalidIndex;
-        bone.mBoneToModel = ConvertMatrix(node->mTransformation);
-
-        // Find inverse bind pose from mesh bones
-        for (u32 i = 0; i < scene->mNumMeshes; ++i)
-        {
-            aiMesh* mesh = scene->mMeshes[i];
-            for (u32 j = 0; j < mesh->mNumBones; ++j)
-            {
-                if (nodeName == mesh->mBones[j]->mName.C_Str())
-                {
-                    bone.mModelToBone = ConvertMatrix(mesh->mBones[j]->mOffsetMatrix);
-                    break;
-                }
-            }
-        }
-
-        currentBoneIndex = static_cast<u32>(m_AnimationData.skeleton.bones.size());
-        m_AnimationData.skeleton.bones.push_back(bone);
-        m_AnimationData.skeleton.boneNameToIndex[nodeName] = currentBoneIndex;
-        m_BoneMap[nodeName] = currentBoneIndex;
+        currentBoneIndex = m_AnimationData.skeleton.AddBone(
+            node->mName.C_Str(),
+            (parentIndex >= 0) ? static_cast<u32>(parentIndex) : kInvalidIndex,
+            ConvertMatrix(node->mTransformation),
+            bIsBone ? itOffset->second : mat4(1.0f));
         m_BoneCount++;
     }
 
@@ -608,27 +617,14 @@ void ModelLoader::ProcessBoneWeights(aiMesh* mesh, MeshData& meshData)
     for (u32 boneIdx = 0; boneIdx < mesh->mNumBones; ++boneIdx)
     {
         aiBone* bone = mesh->mBones[boneIdx];
-        std::string boneName = bone->mName.C_Str();
 
         // Get bone index in skeleton
-        u32 boneIndex = kInvalidIndex;
-        auto it = m_BoneMap.find(boneName);
-        if (it != m_BoneMap.end())
+        Skeleton& skeleton  = m_AnimationData.skeleton;
+        u32       boneIndex = skeleton.GetBoneIndex(HashBoneName(bone->mName.C_Str()));
+        if (boneIndex == kInvalidIndex)
         {
-            boneIndex = it->second;
-        }
-        else
-        {
-            // This bone wasn't in hierarchy, add it
-            Bone newBone;
-            newBone.name = boneName;
-            newBone.parentIndex = kInvalidIndex; // Will be fixed later
-            newBone.mModelToBone = ConvertMatrix(bone->mOffsetMatrix);
-
-            boneIndex = static_cast<u32>(m_AnimationData.skeleton.bones.size());
-            m_AnimationData.skeleton.bones.push_back(newBone);
-            m_AnimationData.skeleton.boneNameToIndex[boneName] = boneIndex;
-            m_BoneMap[boneName] = boneIndex;
+            // This bone wasn't in hierarchy, add it as a root
+            boneIndex = skeleton.AddBone(bone->mName.C_Str(), kInvalidIndex, mat4(1.0f), ConvertMatrix(bone->mOffsetMatrix));
             m_BoneCount++;
         }
 
@@ -682,18 +678,7 @@ AnimationClip ModelLoader::ProcessAnimationClip(aiAnimation* animation)
     {
         aiNodeAnim* nodeAnim = animation->mChannels[i];
         AnimationChannel channel;
-        channel.boneName = nodeAnim->mNodeName.C_Str();
-
-        // Get bone index
-        auto it = m_BoneMap.find(channel.boneName);
-        if (it != m_BoneMap.end())
-        {
-            channel.boneIndex = it->second;
-        }
-        else
-        {
-            channel.boneIndex = kInvalidIndex;
-        }
+        channel.boneId = HashBoneName(nodeAnim->mNodeName.C_Str());
 
         // Position keys
         channel.positionKeys.reserve(nodeAnim->mNumPositionKeys);
@@ -3,6 +3,7 @@
 #include "AnimationTypes.h"
 #include "MaterialTypes.h"
 #include "Utils/FileIO.hpp"
+#include "RenderCommon/MemoryTracker.h"
 
 struct aiScene;
 struct aiNode;
@@ -73,6 +74,7 @@ struct MeshDescriptor
 	float scale = 1.0f;
 
 	bool bLoadAnimations   = false;
+	bool bCompressAnimations = false; // clips are kept only in compressed form, see AnimationCompression.h
 	bool bOptimize         = false;
 	bool bWindingCW        = false;
 	bool bConvertToLeftHanded = true;
@@ -138,7 +140,10 @@ private:
 	static u64 ms_GlobalMeshletTriangleOffset;
 
 	u32 m_BoneCount = 0;
-	std::unordered_map< std::string, u32 > m_BoneMap;
+	std::unordered_map< BoneId, mat4 > m_BoneOffsets; // inverse bind pose of every mesh bone
+
+	// meshes, materials and animation imports, estimated from vector capacities
+	render::TrackedMemory m_TrackedMemory{ render::eMemoryTag::ModelData };
 };
 
 } // namespace baamboo
@@ -0,0 +1,536 @@
+#include "BaambooPch.h"
+#include "OcclusionBuffer.h"
+#include "TaskScheduler.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BB_OCCLUSION_SSE
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define BB_OCCLUSION_NEON
+#endif
+
+namespace baamboo
+{
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+// Four-wide helpers; masks are all-ones lanes (0/1 in the scalar fallback)
+//-------------------------------------------------------------------------
+#if defined(BB_OCCLUSION_SSE)
+using f32x4 = __m128;
+
+inline f32x4 Splat(float v) { return _mm_set1_ps(v); }
+inline f32x4 Set(float a, float b, float c, float d) { return _mm_setr_ps(a, b, c, d); }
+inline f32x4 Load(const float* p) { return _mm_loadu_ps(p); }
+inline void  Store(float* p, f32x4 v) { _mm_storeu_ps(p, v); }
+inline f32x4 Add(f32x4 a, f32x4 b) { return _mm_add_ps(a, b); }
+inline f32x4 Mul(f32x4 a, f32x4 b) { return _mm_mul_ps(a, b); }
+inline f32x4 Min(f32x4 a, f32x4 b) { return _mm_min_ps(a, b); }
+inline f32x4 Max(f32x4 a, f32x4 b) { return _mm_max_ps(a, b); }
+inline f32x4 CmpGE(f32x4 a, f32x4 b) { return _mm_cmpge_ps(a, b); }
+inline f32x4 CmpLE(f32x4 a, f32x4 b) { return _mm_cmple_ps(a, b); }
+inline f32x4 And(f32x4 a, f32x4 b) { return _mm_and_ps(a, b); }
+inline f32x4 Select(f32x4 mask, f32x4 a, f32x4 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+inline bool  Any(f32x4 mask) { return _mm_movemask_ps(mask) != 0; }
+#elif defined(BB_OCCLUSION_NEON)
+using f32x4 = float32x4_t;
+
+inline f32x4 Splat(float v) { return vdupq_n_f32(v); }
+inline f32x4 Set(float a, float b, float c, float d) { const float v[4] = { a, b, c, d }; return vld1q_f32(v); }
+inline f32x4 Load(const float* p) { return vld1q_f32(p); }
+inline void  Store(float* p, f32x4 v) { vst1q_f32(p, v); }
+inline f32x4 Add(f32x4 a, f32x4 b) { return vaddq_f32(a, b); }
+inline f32x4 Mul(f32x4 a, f32x4 b) { return vmulq_f32(a, b); }
+inline f32x4 Min(f32x4 a, f32x4 b) { return vminq_f32(a, b); }
+inline f32x4 Max(f32x4 a, f32x4 b) { return vmaxq_f32(a, b); }
+inline f32x4 CmpGE(f32x4 a, f32x4 b) { return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+inline f32x4 CmpLE(f32x4 a, f32x4 b) { return vreinterpretq_f32_u32(vcleq_f32(a, b)); }
+inline f32x4 And(f32x4 a, f32x4 b) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+inline f32x4 Select(f32x4 mask, f32x4 a, f32x4 b) { return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+inline bool  Any(f32x4 mask) { return vmaxvq_u32(vreinterpretq_u32_f32(mask)) != 0; }
+#else
+struct f32x4 { float v[4]; };
+
+inline f32x4 Splat(float v) { return { v, v, v, v }; }
+inline f32x4 Set(float a, float b, float c, float d) { return { a, b, c, d }; }
+inline f32x4 Load(const float* p) { return { p[0], p[1], p[2], p[3] }; }
+inline void  Store(float* p, f32x4 v) { for (u32 i = 0; i < 4; ++i) p[i] = v.v[i]; }
+inline f32x4 Add(f32x4 a, f32x4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+inline f32x4 Mul(f32x4 a, f32x4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] *= b.v[i]; return a; }
+inline f32x4 Min(f32x4 a, f32x4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] = std::min(a.v[i], b.v[i]); return a; }
+inline f32x4 Max(f32x4 a, f32x4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] = std::max(a.v[i], b.v[i]); return a; }
+inline f32x4 CmpGE(f32x4 a, f32x4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] = a.v[i] >= b.v[i] ? 1.0f : 0.0f; return a; }
+inline f32x4 CmpLE(f32x4 a, f32x4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] = a.v[i] <= b.v[i] ? 1.0f : 0.0f; return a; }
+inline f32x4 And(f32x4 a, f32x4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] *= b.v[i]; return a; }
+inline f32x4 Select(f32x4 mask, f32x4 a, f32x4 b) { for (u32 i = 0; i < 4; ++i) a.v[i] = mask.v[i] != 0.0f ? a.v[i] : b.v[i]; return a; }
+inline bool  Any(f32x4 mask) { return mask.v[0] != 0.0f || mask.v[1] != 0.0f || mask.v[2] != 0.0f || mask.v[3] != 0.0f; }
+#endif
+
+// distance to the near plane of a reverse-Z projection (z == w), >= 0 in front of it
+inline float NearDistance(const float4& clip) { return clip.w - clip.z; }
+
+// stands in for a source edge where near-plane clipping cut a triangle
+constexpr u32 kNearPlaneEdge = 3;
+
+inline bool Before(const float3& lhs, const float3& rhs)
+{
+	if (lhs.x != rhs.x) return lhs.x < rhs.x;
+	if (lhs.y != rhs.y) return lhs.y < rhs.y;
+	return lhs.z < rhs.z;
+}
+
+} // anonymous namespace
+
+OcclusionBuffer::OcclusionBuffer()
+	: m_Depth(kWidth * kHeight, 0.0f)
+	, m_TileMinDepth(kNumTilesX * kNumBands, 0.0f)
+	, m_LayerCoverage(kWidth * kHeight, 0.0f)
+	, m_LayerDepth(kWidth * kHeight, 0.0f)
+{
+}
+
+void OcclusionBuffer::Render(const mat4& mViewProj, const std::vector< Occluder >& occluders)
+{
+	m_mViewProj    = mViewProj;
+	m_NumOccluders = static_cast< u32 >(occluders.size());
+
+	if (m_Bins.size() < occluders.size())
+		m_Bins.resize(occluders.size());
+
+	// setup and binning per occluder, each into its own bins, so no worker waits on another
+	TaskScheduler::Inst()->ParallelFor(m_NumOccluders, [&](u32 i)
+		{
+			SetupOccluder(occluders[i], m_Bins[i]);
+		});
+
+	m_NumTriangles = 0;
+	for (u32 i = 0; i < m_NumOccluders; ++i)
+		m_NumTriangles += static_cast< u32 >(m_Bins[i].triangles.size());
+
+	// bands own disjoint rows of the buffer
+	TaskScheduler::Inst()->ParallelFor(kNumBands, [&](u32 band)
+		{
+			RasterizeBand(band);
+		});
+}
+
+void OcclusionBuffer::SetupOccluder(const Occluder& occluder, Bins& bins) const
+{
+	bins.triangles.clear();
+	for (auto& band : bins.bands)
+		band.clear();
+
+	const u32  numSource      = occluder.numIndices / 3;
+	const mat4 mWorldViewProj = m_mViewProj * occluder.mWorld;
+
+	bins.clip.resize(numSource * 3);
+	bins.layers.assign(numSource, kInvalidIndex);
+	for (u32 t = 0; t < numSource; ++t)
+	{
+		float4* c = &bins.clip[t * 3];
+		for (u32 v = 0; v < 3; ++v)
+			c[v] = mWorldViewProj * float4(occluder.pVertices[occluder.pIndices[t * 3 + v]].position, 1.0f);
+		if (NearDistance(c[0]) < 0.0f && NearDistance(c[1]) < 0.0f && NearDistance(c[2]) < 0.0f)
+			continue;
+
+		// whatever survives near-plane clipping has w > 0, so it winds on screen the way this
+		// homogeneous determinant says
+		const float det = glm::dot(float3(c[0].x, c[0].y, c[0].w), glm::cross(float3(c[1].x, c[1].y, c[1].w), float3(c[2].x, c[2].y, c[2].w)));
+		if (det != 0.0f)
+			bins.layers[t] = det > 0.0f ? 0u : 1u;
+	}
+
+	FindBoundaryEdges(occluder, bins);
+
+	for (u32 t = 0; t < numSource; ++t)
+	{
+		const u32 layer = bins.layers[t];
+		if (layer == kInvalidIndex)
+			continue;
+
+		const float4* in       = &bins.clip[t * 3];
+		const u32     boundary = bins.boundary[t];
+
+		const float d[3] = { NearDistance(in[0]), NearDistance(in[1]), NearDistance(in[2]) };
+		if (d[0] >= 0.0f && d[1] >= 0.0f && d[2] >= 0.0f)
+		{
+			AddTriangle(in[0], in[1], in[2], boundary, layer, bins);
+			continue;
+		}
+
+		// clip against the near plane; a triangle becomes at most a quad. edgeOf[k] is the source
+		// edge polygon[k] -> polygon[k + 1] lies on, or the cut along the near plane.
+		float4 polygon[4];
+		u32    edgeOf[4];
+		u32    numVertices = 0;
+		for (u32 v = 0; v < 3; ++v)
+		{
+			const u32 next = (v + 1) % 3;
+			if (d[v] >= 0.0f)
+			{
+				polygon[numVertices] = in[v];
+				edgeOf[numVertices++] = v;
+			}
+			if ((d[v] >= 0.0f) != (d[next] >= 0.0f))
+			{
+				polygon[numVertices] = glm::mix(in[v], in[next], d[v] / (d[v] - d[next]));
+				edgeOf[numVertices++] = d[v] >= 0.0f ? kNearPlaneEdge : v;
+			}
+		}
+
+		// fan diagonals stay inside the polygon, so only its own sides can bound the coverage
+		const auto IsBoundary = [boundary](u32 edge) { return edge == kNearPlaneEdge || (boundary >> edge & 1u) != 0; };
+		for (u32 v = 2; v < numVertices; ++v)
+		{
+			u32 boundaryEdges = 0;
+			if (v == 2 && IsBoundary(edgeOf[0]))
+				boundaryEdges |= 1u;
+			if (IsBoundary(edgeOf[v - 1]))
+				boundaryEdges |= 2u;
+			if (v == numVertices - 1 && IsBoundary(edgeOf[numVertices - 1]))
+				boundaryEdges |= 4u;
+			AddTriangle(polygon[0], polygon[v - 1], polygon[v], boundaryEdges, layer, bins);
+		}
+	}
+}
+
+void OcclusionBuffer::FindBoundaryEdges(const Occluder& occluder, Bins& bins) const
+{
+	const u32 numSource = static_cast< u32 >(bins.layers.size());
+	bins.boundary.assign(numSource, 0b111u);
+
+	// Matched by position, not index: meshes split vertices along uv and normal seams. An edge
+	// is inside the coverage only between exactly two triangles of one layer on either side of it.
+	bins.edges.clear();
+	for (u32 t = 0; t < numSource; ++t)
+	{
+		if (bins.layers[t] == kInvalidIndex)
+			continue;
+
+		for (u32 e = 0; e < 3; ++e)
+		{
+			const float3& p0 = occluder.pVertices[occluder.pIndices[t * 3 + e]].position;
+			const float3& p1 = occluder.pVertices[occluder.pIndices[t * 3 + (e + 1) % 3]].position;
+			if (p0 == p1)
+				continue;
+
+			// the third vertex lies left of every edge of a layer-0 triangle
+			const bool bFlipped = Before(p1, p0);
+			bins.edges.push_back({ bFlipped ? p1 : p0, bFlipped ? p0 : p1, t, e, (bins.layers[t] == 0u) != bFlipped });
+		}
+	}
+
+	std::sort(bins.edges.begin(), bins.edges.end(), [](const SharedEdge& lhs, const SharedEdge& rhs)
+		{
+			return lhs.a != rhs.a ? Before(lhs.a, rhs.a) : Before(lhs.b, rhs.b);
+		});
+
+	for (size_t first = 0; first < bins.edges.size();)
+	{
+		size_t last = first + 1;
+		while (last < bins.edges.size() && bins.edges[last].a == bins.edges[first].a && bins.edges[last].b == bins.edges[first].b)
+			++last;
+
+		if (last - first == 2)
+		{
+			const SharedEdge& e0 = bins.edges[first];
+			const SharedEdge& e1 = bins.edges[first + 1];
+			if (bins.layers[e0.triangle] == bins.layers[e1.triangle] && e0.bLeft != e1.bLeft)
+			{
+				bins.boundary[e0.triangle] &= ~(1u << e0.edge);
+				bins.boundary[e1.triangle] &= ~(1u << e1.edge);
+			}
+		}
+		first = last;
+	}
+}
+
+void OcclusionBuffer::AddTriangle(const float4& c0, const float4& c1, const float4& c2, u32 boundaryEdges, u32 layer, Bins& bins) const
+{
+	auto toScreen = [](const float4& clip)
+		{
+			const float invW = 1.0f / clip.w;
+			return float3((clip.x * invW * 0.5f + 0.5f) * kWidth, (0.5f - clip.y * invW * 0.5f) * kHeight, clip.z * invW);
+		};
+	float3 v0 = toScreen(c0);
+	float3 v1 = toScreen(c1);
+	float3 v2 = toScreen(c2);
+
+	float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+	if (std::abs(area) < 1e-6f)
+		return;
+
+	// occluders are drawn two-sided; wind every triangle the same way, edges 0 and 2 trade places
+	if (area < 0.0f)
+	{
+		std::swap(v1, v2);
+		area = -area;
+		boundaryEdges = (boundaryEdges & 2u) | ((boundaryEdges & 1u) << 2) | ((boundaryEdges >> 2) & 1u);
+	}
+
+	Triangle tri = {};
+	tri.minX = std::max(static_cast< i32 >(std::floor(std::min({ v0.x, v1.x, v2.x }))), 0);
+	tri.maxX = std::min(static_cast< i32 >(std::floor(std::max({ v0.x, v1.x, v2.x }))), static_cast< i32 >(kWidth) - 1);
+	tri.minY = std::max(static_cast< i32 >(std::floor(std::min({ v0.y, v1.y, v2.y }))), 0);
+	tri.maxY = std::min(static_cast< i32 >(std::floor(std::max({ v0.y, v1.y, v2.y }))), static_cast< i32 >(kHeight) - 1);
+	if (tri.minX > tri.maxX || tri.minY > tri.maxY)
+		return;
+
+	auto edge = [](const float3& a, const float3& b)
+		{
+			const float A = a.y - b.y;
+			const float B = b.x - a.x;
+			return float3(A, B, -(A * a.x + B * a.y));
+		};
+	tri.edges[0] = edge(v0, v1);
+	tri.edges[1] = edge(v1, v2);
+	tri.edges[2] = edge(v2, v0);
+
+	// near-plane clipping leaves vertices far off screen; in float the plane would be off by
+	// more than the depth differences it has to resolve
+	const double e1x = double(v1.x) - v0.x, e1y = double(v1.y) - v0.y, e1z = double(v1.z) - v0.z;
+	const double e2x = double(v2.x) - v0.x, e2y = double(v2.y) - v0.y, e2z = double(v2.z) - v0.z;
+	const double dArea = e1x * e2y - e1y * e2x;
+	const double zA    = (e1z * e2y - e2z * e1y) / dArea;
+	const double zB    = (e2z * e1x - e1z * e2x) / dArea;
+	tri.depth = float3(static_cast< float >(zA), static_cast< float >(zB), static_cast< float >(v0.z - zA * v0.x - zB * v0.y));
+
+	// a plane over a pixel stays within half its x and y slopes of the value at the center
+	for (u32 i = 0; i < 3; ++i)
+		tri.edgeExtents[i] = 0.5f * (std::abs(tri.edges[i].x) + std::abs(tri.edges[i].y));
+	tri.depthExtent = 0.5f * (std::abs(tri.depth.x) + std::abs(tri.depth.y));
+
+	tri.points[0]     = float2(v0.x, v0.y);
+	tri.points[1]     = float2(v1.x, v1.y);
+	tri.points[2]     = float2(v2.x, v2.y);
+	tri.boundaryEdges = boundaryEdges;
+	tri.layer         = layer;
+
+	const u32 index = static_cast< u32 >(bins.triangles.size());
+	bins.triangles.push_back(tri);
+	for (u32 band = tri.minY / kTileSize; band <= tri.maxY / kTileSize; ++band)
+		bins.bands[band].push_back(index);
+}
+
+void OcclusionBuffer::RasterizeBand(u32 band)
+{
+	const i32 bandMinY = static_cast< i32 >(band * kTileSize);
+	const i32 bandMaxY = bandMinY + static_cast< i32 >(kTileSize) - 1;
+
+	std::fill(m_Depth.begin() + bandMinY * kWidth, m_Depth.begin() + (bandMaxY + 1) * kWidth, 0.0f);
+
+	const f32x4 laneOffset = Set(0.5f, 1.5f, 2.5f, 3.5f);
+	const f32x4 zero       = Splat(0.0f);
+	const f32x4 one        = Splat(1.0f);
+	for (u32 occluder = 0; occluder < m_NumOccluders; ++occluder)
+	{
+		const Bins& bins = m_Bins[occluder];
+		for (u32 layer = 0; layer < 2; ++layer)
+		{
+			// quads of this band the layer reaches
+			i32 minX = static_cast< i32 >(kWidth);
+			i32 maxX = -1;
+			for (u32 index : bins.bands[band])
+			{
+				const Triangle& tri = bins.triangles[index];
+				if (tri.layer == layer)
+				{
+					minX = std::min(minX, tri.minX & ~3); // kWidth is a multiple of 4, so the last quad stays in the row
+					maxX = std::max(maxX, tri.maxX | 3);
+				}
+			}
+			if (minX > maxX)
+				continue;
+
+			for (i32 y = bandMinY; y <= bandMaxY; ++y)
+			{
+				std::fill(m_LayerCoverage.begin() + y * kWidth + minX, m_LayerCoverage.begin() + y * kWidth + maxX + 1, 0.0f);
+				std::fill(m_LayerDepth.begin() + y * kWidth + minX, m_LayerDepth.begin() + y * kWidth + maxX + 1, FLT_MAX);
+			}
+
+			// 1) pixel centers the layer covers, and the farthest depth of each triangle over every pixel it touches
+			for (u32 index : bins.bands[band])
+			{
+				const Triangle& tri = bins.triangles[index];
+				if (tri.layer != layer)
+					continue;
+
+				const i32 triMinY = std::max(tri.minY, bandMinY);
+				const i32 triMaxY = std::min(tri.maxY, bandMaxY);
+				const i32 triMinX = tri.minX & ~3;
+
+				const f32x4 A0 = Splat(tri.edges[0].x), A1 = Splat(tri.edges[1].x), A2 = Splat(tri.edges[2].x);
+				const f32x4 X0 = Splat(-tri.edgeExtents.x), X1 = Splat(-tri.edgeExtents.y), X2 = Splat(-tri.edgeExtents.z);
+				const f32x4 zA = Splat(tri.depth.x);
+				for (i32 y = triMinY; y <= triMaxY; ++y)
+				{
+					const float yc = static_cast< float >(y) + 0.5f;
+					const f32x4 row0 = Splat(tri.edges[0].y * yc + tri.edges[0].z);
+					const f32x4 row1 = Splat(tri.edges[1].y * yc + tri.edges[1].z);
+					const f32x4 row2 = Splat(tri.edges[2].y * yc + tri.edges[2].z);
+					const f32x4 rowZ = Splat(tri.depth.y * yc + tri.depth.z - tri.depthExtent);
+
+					float* pCoverage = m_LayerCoverage.data() + y * kWidth;
+					float* pDepth    = m_LayerDepth.data() + y * kWidth;
+					for (i32 x = triMinX; x <= tri.maxX; x += 4)
+					{
+						const f32x4 xc = Add(Splat(static_cast< float >(x)), laneOffset);
+						const f32x4 e0 = Add(Mul(A0, xc), row0);
+						const f32x4 e1 = Add(Mul(A1, xc), row1);
+						const f32x4 e2 = Add(Mul(A2, xc), row2);
+
+						const f32x4 touched = And(And(CmpGE(e0, X0), CmpGE(e1, X1)), CmpGE(e2, X2));
+						if (!Any(touched))
+							continue;
+
+						const f32x4 inside = And(And(CmpGE(e0, zero), CmpGE(e1, zero)), CmpGE(e2, zero));
+						Store(pCoverage + x, Select(inside, one, Load(pCoverage + x)));
+
+						const f32x4 depth = Load(pDepth + x);
+						Store(pDepth + x, Select(touched, Min(depth, Add(Mul(zA, xc), rowZ)), depth));
+					}
+				}
+			}
+
+			// 2) pixels a boundary edge passes through are only partly covered
+			for (u32 index : bins.bands[band])
+			{
+				const Triangle& tri = bins.triangles[index];
+				if (tri.layer != layer || tri.boundaryEdges == 0)
+					continue;
+
+				for (u32 e = 0; e < 3; ++e)
+				{
+					if ((tri.boundaryEdges >> e & 1u) == 0)
+						continue;
+
+					const float2& p0 = tri.points[e];
+					const float2& p1 = tri.points[(e + 1) % 3];
+					const float   segMinY = std::max(std::min(p0.y, p1.y), static_cast< float >(bandMinY));
+					const float   segMaxY = std::min(std::max(p0.y, p1.y), static_cast< float >(bandMaxY + 1));
+					if (segMinY > segMaxY)
+						continue;
+
+					const float dy      = p1.y - p0.y;
+					const float dxPerDy = std::abs(dy) > 1e-6f ? (p1.x - p0.x) / dy : 0.0f;
+					for (i32 y = static_cast< i32 >(std::floor(segMinY)); y <= std::min(static_cast< i32 >(std::floor(segMaxY)), bandMaxY); ++y)
+					{
+						// the part of the segment within this row, widened a little against rounding
+						float spanMinX = std::min(p0.x, p1.x);
+						float spanMaxX = std::max(p0.x, p1.x);
+						if (std::abs(dy) > 1e-6f)
+						{
+							const float xTop    = p0.x + (std::max(segMinY, static_cast< float >(y)) - p0.y) * dxPerDy;
+							const float xBottom = p0.x + (std::min(segMaxY, static_cast< float >(y + 1)) - p0.y) * dxPerDy;
+							spanMinX = std::max(std::min(xTop, xBottom), spanMinX);
+							spanMaxX = std::min(std::max(xTop, xBottom), spanMaxX);
+						}
+
+						const i32 x0 = std::max(static_cast< i32 >(std::floor(spanMinX - 1e-3f)), 0);
+						const i32 x1 = std::min(static_cast< i32 >(std::floor(spanMaxX + 1e-3f)), static_cast< i32 >(kWidth) - 1);
+						if (x0 <= x1)
+							std::fill(m_LayerCoverage.begin() + y * kWidth + x0, m_LayerCoverage.begin() + y * kWidth + x1 + 1, 0.0f);
+					}
+				}
+			}
+
+			// 3) what is left is fully covered
+			for (i32 y = bandMinY; y <= bandMaxY; ++y)
+			{
+				const float* pCoverage = m_LayerCoverage.data() + y * kWidth;
+				const float* pLayer    = m_LayerDepth.data() + y * kWidth;
+				float*       pRow      = m_Depth.data() + y * kWidth;
+				for (i32 x = minX; x <= maxX; x += 4)
+				{
+					const f32x4 covered = CmpGE(Load(pCoverage + x), one);
+					if (!Any(covered))
+						continue;
+
+					const f32x4 depth = Load(pRow + x);
+					Store(pRow + x, Select(covered, Max(depth, Load(pLayer + x)), depth));
+				}
+			}
+		}
+	}
+
+	for (u32 tileX = 0; tileX < kNumTilesX; ++tileX)
+	{
+		float minDepth = FLT_MAX;
+		for (i32 y = bandMinY; y <= bandMaxY; ++y)
+		{
+			const float* pRow = m_Depth.data() + y * kWidth + tileX * kTileSize;
+			minDepth = std::min(minDepth, *std::min_element(pRow, pRow + kTileSize));
+		}
+		m_TileMinDepth[band * kNumTilesX + tileX] = minDepth;
+	}
+}
+
+bool OcclusionBuffer::IsVisible(const BoundingBox& worldAABB) const
+{
+	const float3 boxMin = worldAABB.Min();
+	const float3 boxMax = worldAABB.Max();
+
+	float2 screenMin  = float2(FLT_MAX);
+	float2 screenMax  = float2(-FLT_MAX);
+	float  nearestZ   = 0.0f;
+	for (u32 corner = 0; corner < 8; ++corner)
+	{
+		const float3 position = float3(corner & 1 ? boxMax.x : boxMin.x, corner & 2 ? boxMax.y : boxMin.y, corner & 4 ? boxMax.z : boxMin.z);
+		const float4 clip     = m_mViewProj * float4(position, 1.0f);
+
+		// crossing the near plane, its rect is unbounded
+		if (clip.w <= 1e-6f || NearDistance(clip) < 0.0f)
+			return true;
+
+		const float invW = 1.0f / clip.w;
+		const float2 screen = float2((clip.x * invW * 0.5f + 0.5f) * kWidth, (0.5f - clip.y * invW * 0.5f) * kHeight);
+		screenMin = glm::min(screenMin, screen);
+		screenMax = glm::max(screenMax, screen);
+		nearestZ  = std::max(nearestZ, clip.z * invW);
+	}
+
+	const i32 minX = std::max(static_cast< i32 >(std::floor(screenMin.x)), 0);
+	const i32 maxX = std::min(static_cast< i32 >(std::floor(screenMax.x)), static_cast< i32 >(kWidth) - 1);
+	const i32 minY = std::max(static_cast< i32 >(std::floor(screenMin.y)), 0);
+	const i32 maxY = std::min(static_cast< i32 >(std::floor(screenMax.y)), static_cast< i32 >(kHeight) - 1);
+	if (minX > maxX || minY > maxY)
+		return false;
+
+	const f32x4 boxDepth = Splat(nearestZ);
+	for (i32 tileY = minY / static_cast< i32 >(kTileSize); tileY <= maxY / static_cast< i32 >(kTileSize); ++tileY)
+	{
+		for (i32 tileX = minX / static_cast< i32 >(kTileSize); tileX <= maxX / static_cast< i32 >(kTileSize); ++tileX)
+		{
+			// every pixel of the tile is nearer than the box
+			if (m_TileMinDepth[tileY * kNumTilesX + tileX] > nearestZ)
+				continue;
+
+			const i32 x0 = std::max(tileX * static_cast< i32 >(kTileSize), minX);
+			const i32 x1 = std::min((tileX + 1) * static_cast< i32 >(kTileSize) - 1, maxX);
+			const i32 y0 = std::max(tileY * static_cast< i32 >(kTileSize), minY);
+			const i32 y1 = std::min((tileY + 1) * static_cast< i32 >(kTileSize) - 1, maxY);
+			for (i32 y = y0; y <= y1; ++y)
+			{
+				const float* pRow = m_Depth.data() + y * kWidth;
+
+				i32 x = x0;
+				for (; x + 3 <= x1; x += 4)
+				{
+					if (Any(CmpLE(Load(pRow + x), boxDepth)))
+						return true;
+				}
+				for (; x <= x1; ++x)
+				{
+					if (pRow[x] <= nearestZ)
+						return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+} // namespace baamboo
@@ -0,0 +1,112 @@
+#pragma once
+#include "Boundings.h"
+
+#include <vector>
+
+namespace baamboo
+{
+
+// =========================================================================
+// OcclusionBuffer — low-resolution software depth buffer for CPU occlusion.
+//
+//   A handful of large occluders are rasterized into a small reverse-Z
+//   buffer, then instance bounds are tested against it before submission.
+//   This covers what the previous frame's Hi-Z cannot: disocclusion and
+//   camera cuts. Triangle setup and binning run per occluder, rasterization
+//   per horizontal band, both on the TaskScheduler; the inner loops are
+//   four pixels wide (SSE2, NEON or scalar).
+//
+//   Coverage is inner-conservative: an occluder writes a pixel only if it
+//   covers all of it, at the farthest depth it has there, so the buffer
+//   never hides what shows past an occluder's edges. Edges shared by two
+//   triangles facing the same way are matched by vertex position and do
+//   not count, so the seams inside a mesh stay closed.
+//
+//   Nothing here touches the GPU, so the buffer can be rendered and read
+//   back headless through Depth().
+// =========================================================================
+class OcclusionBuffer
+{
+public:
+	static constexpr u32 kWidth      = 320; // multiple of 4 and of kTileSize
+	static constexpr u32 kHeight     = 192;
+	static constexpr u32 kTileSize   = 16;  // a band is one row of tiles
+	static constexpr u32 kNumTilesX  = kWidth / kTileSize;
+	static constexpr u32 kNumBands   = kHeight / kTileSize;
+
+	struct Occluder
+	{
+		const Vertex* pVertices  = nullptr;
+		const Index*  pIndices   = nullptr;
+		u32           numIndices = 0;
+		mat4          mWorld     = mat4(1.0f);
+	};
+
+	OcclusionBuffer();
+
+	// Clears the buffer and rasterizes 'occluders' as seen through 'mViewProj'
+	// (left-handed, zero-to-one reverse-Z projection)
+	void Render(const mat4& mViewProj, const std::vector< Occluder >& occluders);
+
+	// False only if every pixel the box's screen rect covers holds a nearer occluder
+	[[nodiscard]]
+	bool IsVisible(const BoundingBox& worldAABB) const;
+
+	// kWidth * kHeight depths, row-major from the top, 0 where nothing was drawn
+	[[nodiscard]]
+	const std::vector< float >& Depth() const { return m_Depth; }
+	[[nodiscard]]
+	u32 NumTriangles() const { return m_NumTriangles; }
+
+private:
+	struct Triangle
+	{
+		float3 edges[3];       // A, B, C of each edge function, >= 0 inside
+		float3 edgeExtents;    // how far each edge function varies from a pixel's center to its corners
+		float3 depth;          // z = x * A + y * B + C
+		float  depthExtent;    // likewise for depth
+		float2 points[3];      // screen vertices; edge i runs from points[i] to points[i + 1]
+		u32    boundaryEdges;  // bit i set when edge i bounds the occluder's coverage
+		u32    layer;          // 0 or 1 by facing; each layer is resolved on its own
+		i32    minX, maxX, minY, maxY;
+	};
+
+	struct SharedEdge
+	{
+		float3 a, b;     // object-space endpoints, a before b
+		u32    triangle; // source triangle
+		u32    edge;     // 0..2 within it
+		bool   bLeft;    // the triangle lies left of a -> b on screen
+	};
+
+	struct Bins
+	{
+		std::vector< Triangle > triangles;
+		std::vector< u32 >      bands[kNumBands]; // triangle indices touching each band
+
+		// setup scratch, kept to reuse its allocations
+		std::vector< float4 >     clip;     // three per source triangle
+		std::vector< u32 >        layers;   // facing per source triangle, kInvalidIndex when it draws nothing
+		std::vector< u32 >        boundary; // boundary edge bits per source triangle
+		std::vector< SharedEdge > edges;
+	};
+
+	void SetupOccluder(const Occluder& occluder, Bins& bins) const;
+	void FindBoundaryEdges(const Occluder& occluder, Bins& bins) const;
+	void AddTriangle(const float4& c0, const float4& c1, const float4& c2, u32 boundaryEdges, u32 layer, Bins& bins) const;
+	void RasterizeBand(u32 band);
+
+private:
+	mat4 m_mViewProj = mat4(1.0f);
+
+	std::vector< float > m_Depth;
+	std::vector< float > m_TileMinDepth;   // farthest depth of each tile, for early accepts in IsVisible
+	std::vector< float > m_LayerCoverage;  // per-layer scratch, 1 where fully covered; bands own their rows
+	std::vector< float > m_LayerDepth;     // per-layer scratch, farthest depth over each pixel
+	std::vector< Bins >  m_Bins;           // one per occluder
+
+	u32 m_NumOccluders = 0;
+	u32 m_NumTriangles = 0;
+};
+
+} // namespace baamboo
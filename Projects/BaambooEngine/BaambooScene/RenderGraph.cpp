@@ -1,6 +1,9 @@
 #include "BaambooPch.h"
 #include "RenderGraph.h"
+#include "Scene.h"
 #include "RenderCommon/RenderNode.h"
+#include "RenderCommon/RenderDevice.h"
+#include "RenderCommon/CommandContext.h"
 
 namespace baamboo
 {
@@ -14,6 +17,7 @@ void RenderGraph::AddRenderNode(const Arc< render::RenderNode >& pNode)
 
 	m_RenderNodes.push_back(pNode);
 	m_RenderNodeNameMap.emplace(pNode->GetName(), pNode);
+	m_bDirty = true;
 }
 
 void RenderGraph::RemoveRenderNode(const std::string& nodeName)
@@ -26,6 +30,396 @@ void RenderGraph::RemoveRenderNode(const std::string& nodeName)
 	}
 
 	std::erase(m_RenderNodes, pNode->second);
+	m_bDirty = true;
+}
+
+const std::vector< RenderGraph::Pass >& RenderGraph::Compile(render::RenderDevice& rd, const SceneRenderView& renderView)
+{
+	using namespace render;
+
+	u64 key = kFnv1aOffsetBasis;
+	for (const auto& pNode : m_RenderNodes)
+		key = (key ^ (pNode ? pNode->DeclarationKey(renderView) : 0)) * kFnv1aPrime;
+
+	if (!m_bDirty && key == m_CompiledKey)
+		return m_CompiledPasses;
+
+	const u32 numNodes = static_cast< u32 >(m_RenderNodes.size());
+
+	std::vector< RenderGraphBuilder > builders(numNodes);
+	for (u32 i = 0; i < numNodes; ++i)
+		if (m_RenderNodes[i])
+			m_RenderNodes[i]->DeclareResources(builders[i], renderView);
+
+	// **
+	// Culling: walk back from what the engine presents. A pass stays live if it declares
+	// nothing (legacy), has side effects, or writes something a later live pass reads.
+	// **
+	std::unordered_set< u64 > neededIds = { graph::kSceneColor.hash };
+
+	// a read with no earlier writer this frame sees last frame's value, so its writer must run
+	// (and its contents must survive the frame)
+	std::unordered_set< u64 > historyIds;
+	{
+		std::unordered_set< u64 > writtenIds;
+		for (const auto& builder : builders)
+		{
+			for (const auto& read : builder.GetReads())
+				if (!writtenIds.contains(read.id.hash))
+					historyIds.insert(read.id.hash);
+			for (const auto& write : builder.GetWrites())
+				writtenIds.insert(write.id.hash);
+		}
+	}
+	neededIds.insert(historyIds.begin(), historyIds.end());
+
+	std::vector< bool > bLive(numNodes, false);
+	m_ConsumedIds.clear();
+	for (u32 i = numNodes; i-- > 0;)
+	{
+		if (!m_RenderNodes[i])
+			continue;
+
+		const auto& builder = builders[i];
+
+		bool bNeeded = builder.IsEmpty() || builder.HasSideEffects();
+		for (const auto& write : builder.GetWrites())
+			bNeeded |= neededIds.contains(write.id.hash);
+		if (!bNeeded)
+			continue;
+
+		bLive[i] = true;
+		for (const auto& write : builder.GetWrites())
+			neededIds.erase(write.id.hash);
+		for (const auto& read : builder.GetReads())
+		{
+			neededIds.insert(read.id.hash);
+			m_ConsumedIds.insert(read.id.hash);
+		}
+	}
+
+	// **
+	// Barriers: one transition per write, and one per run of readers of the same version
+	// with the stages of every reader in the run merged into it.
+	// **
+	struct Version
+	{
+		Arc< Texture > pTexture;
+		Arc< Buffer >  pBuffer;
+
+		u32 readPass = kInvalidIndex; // pass holding the current read run's transition
+		u32 readSlot = kInvalidIndex;
+	};
+	std::unordered_map< u64, Version > versions;
+
+	// pass range over which each transient texture holds live contents
+	struct Lifetime
+	{
+		Arc< Texture > pTexture;
+
+		u32  firstPass  = 0;
+		u32  lastPass   = 0;
+		bool bAliasable = true;
+	};
+	std::vector< Lifetime >                   lifetimes;
+	std::unordered_map< const Texture*, u32 > lifetimeIndices;
+
+	const auto TouchTransient = [&](const Arc< Texture >& pTexture, u32 passIdx) -> Lifetime*
+	{
+		if (!pTexture || !pTexture->IsTransient())
+			return nullptr;
+
+		auto [it, bInserted] = lifetimeIndices.try_emplace(pTexture.get(), static_cast< u32 >(lifetimes.size()));
+		if (bInserted)
+			lifetimes.push_back({ .pTexture = pTexture, .firstPass = passIdx });
+
+		auto& lifetime = lifetimes[it->second];
+		lifetime.lastPass = passIdx;
+		return &lifetime;
+	};
+
+	// ids written on the compute queue; the first graphics pass reading one waits for it
+	std::unordered_set< u64 > asyncWrittenIds;
+
+	// node each pass was compiled from
+	std::vector< u32 > passNodes;
+
+	m_CompiledPasses.clear();
+	m_NumCulledPasses      = 0;
+	m_AsyncComputeJoinPass = kInvalidIndex;
+	for (u32 i = 0; i < numNodes; ++i)
+	{
+		if (!m_RenderNodes[i])
+			continue;
+
+		if (!bLive[i])
+		{
+			++m_NumCulledPasses;
+			continue;
+		}
+
+		const u32 passIdx = static_cast< u32 >(m_CompiledPasses.size());
+		Pass&     pass    = m_CompiledPasses.emplace_back();
+		passNodes.push_back(i);
+		pass.pNode         = m_RenderNodes[i];
+		pass.bAsyncCompute = pass.pNode->SupportsAsyncCompute();
+
+		if (pass.bAsyncCompute)
+		{
+			for (const auto& write : builders[i].GetWrites())
+				asyncWrittenIds.insert(write.id.hash);
+		}
+		else if (!IsValidIndex(m_AsyncComputeJoinPass))
+		{
+			bool bJoin = builders[i].IsEmpty();
+			for (const auto& read : builders[i].GetReads())
+				bJoin |= asyncWrittenIds.contains(read.id.hash);
+			if (bJoin)
+				m_AsyncComputeJoinPass = passIdx;
+		}
+
+		for (const auto& pScratch : builders[i].GetScratch())
+			TouchTransient(pScratch, passIdx);
+
+		// a legacy pass may transition anything on its own; the next reader re-issues its barrier
+		if (builders[i].IsEmpty())
+		{
+			for (auto& [_, version] : versions)
+				version.readPass = kInvalidIndex;
+			continue;
+		}
+
+		for (const auto& read : builders[i].GetReads())
+		{
+			// produced outside the graph (legacy node): its users keep their own barriers
+			auto it = versions.find(read.id.hash);
+			if (it == versions.end())
+				continue;
+
+			auto& version = it->second;
+			TouchTransient(version.pTexture, passIdx);
+
+			if (IsValidIndex(version.readPass))
+			{
+				auto& transition = m_CompiledPasses[version.readPass].transitions[version.readSlot];
+				transition.stage = transition.stage | read.stage;
+				continue;
+			}
+
+			version.readPass = passIdx;
+			version.readSlot = static_cast< u32 >(pass.transitions.size());
+			pass.transitions.push_back({ .id = read.id, .access = eGraphAccess::ShaderRead, .stage = read.stage, .pTexture = version.pTexture, .pBuffer = version.pBuffer });
+		}
+
+		for (const auto& write : builders[i].GetWrites())
+		{
+			versions[write.id.hash] = { .pTexture = write.pTexture, .pBuffer = write.pBuffer };
+			if (auto pLifetime = TouchTransient(write.pTexture, passIdx); pLifetime && historyIds.contains(write.id.hash))
+				pLifetime->bAliasable = false;
+
+			// updated in place: the write state already covers the read
+			auto inPlace = std::find_if(pass.transitions.begin(), pass.transitions.end(), [&write](const GraphResourceUsage& usage)
+				{
+					return usage.access == eGraphAccess::ShaderRead
+						&& ((write.pTexture && usage.pTexture == write.pTexture) || (write.pBuffer && usage.pBuffer == write.pBuffer));
+				});
+			if (inPlace != pass.transitions.end())
+				*inPlace = write;
+			else
+				pass.transitions.push_back(write);
+		}
+	}
+
+	// what the engine presents stays alive past the last pass
+	if (auto it = versions.find(graph::kSceneColor.hash); it != versions.end())
+		if (auto pLifetime = TouchTransient(it->second.pTexture, static_cast< u32 >(m_CompiledPasses.size())))
+			pLifetime->lastPass = kInvalidIndex;
+
+	// **
+	// Transient aliasing: interval partitioning over pass indices. Textures starting together go
+	// largest first, each into the free group it grows the least.
+	// **
+	std::sort(lifetimes.begin(), lifetimes.end(), [](const Lifetime& lhs, const Lifetime& rhs)
+		{
+			if (lhs.firstPass != rhs.firstPass)
+				return lhs.firstPass < rhs.firstPass;
+			return lhs.pTexture->SizeInBytes() > rhs.pTexture->SizeInBytes();
+		});
+
+	struct AliasGroup
+	{
+		std::vector< const Lifetime* > members;
+
+		u32 lastPass    = 0;
+		u64 sizeInBytes = 0;
+	};
+	std::vector< AliasGroup > aliasGroups;
+	for (const auto& lifetime : lifetimes)
+	{
+		if (!lifetime.bAliasable)
+			continue;
+
+		const u64 sizeInBytes = lifetime.pTexture->SizeInBytes();
+
+		AliasGroup* pBestGroup = nullptr;
+		for (auto& group : aliasGroups)
+		{
+			if (group.lastPass >= lifetime.firstPass)
+				continue;
+
+			if (!pBestGroup)
+			{
+				pBestGroup = &group;
+				continue;
+			}
+
+			const bool bFits     = group.sizeInBytes >= sizeInBytes;
+			const bool bBestFits = pBestGroup->sizeInBytes >= sizeInBytes;
+			if (bFits ? (!bBestFits || group.sizeInBytes < pBestGroup->sizeInBytes) : (!bBestFits && group.sizeInBytes > pBestGroup->sizeInBytes))
+				pBestGroup = &group;
+		}
+
+		if (!pBestGroup)
+			pBestGroup = &aliasGroups.emplace_back();
+
+		pBestGroup->members.push_back(&lifetime);
+		pBestGroup->lastPass    = lifetime.lastPass;
+		pBestGroup->sizeInBytes = std::max(pBestGroup->sizeInBytes, sizeInBytes);
+	}
+
+	std::vector< std::vector< Arc< Texture > > > transientGroups;
+	transientGroups.reserve(aliasGroups.size());
+	for (const auto& group : aliasGroups)
+	{
+		auto& textures = transientGroups.emplace_back();
+		for (u32 m = 0; m < static_cast< u32 >(group.members.size()); ++m)
+		{
+			textures.push_back(group.members[m]->pTexture);
+
+			// the first member takes over from the last one of the previous frame
+			if (group.members.size() > 1)
+			{
+				const auto& pBefore = group.members[(m + group.members.size() - 1) % group.members.size()]->pTexture;
+				m_CompiledPasses[group.members[m]->firstPass].aliasing.emplace_back(pBefore, group.members[m]->pTexture);
+			}
+		}
+	}
+
+	if (m_bRebindTransients || transientGroups != m_TransientGroups)
+	{
+		rd.AliasTransientTextures(transientGroups);
+		m_TransientGroups   = std::move(transientGroups);
+		m_bRebindTransients = false;
+	}
+
+	// **
+	// Recording runs: consecutive passes of nodes that support parallel recording, as long as
+	// none reads or writes an id another one writes, or shares transient memory with another.
+	// A pass that declares nothing may touch anything and ends the run.
+	// **
+	{
+		std::unordered_set< u64 >            runReads;
+		std::unordered_set< u64 >            runWrites;
+		std::unordered_set< const Texture* > runTextures; // written, scratch and aliased textures
+		u32  numRuns  = 0;
+		bool bRunOpen = false;
+		for (u32 passIdx = 0; passIdx < static_cast< u32 >(m_CompiledPasses.size()); ++passIdx)
+		{
+			Pass&       pass    = m_CompiledPasses[passIdx];
+			const auto& builder = builders[passNodes[passIdx]];
+			if (!pass.pNode->SupportsParallelRecording() || builder.IsEmpty())
+			{
+				bRunOpen = false;
+				continue;
+			}
+
+			bool bIndependent = bRunOpen;
+			for (const auto& read : builder.GetReads())
+				bIndependent &= !runWrites.contains(read.id.hash);
+			for (const auto& write : builder.GetWrites())
+				bIndependent &= !runWrites.contains(write.id.hash) && !runReads.contains(write.id.hash) && !runTextures.contains(write.pTexture.get());
+			for (const auto& pScratch : builder.GetScratch())
+				bIndependent &= !runTextures.contains(pScratch.get());
+			for (const auto& [pBefore, pAfter] : pass.aliasing)
+				bIndependent &= !runTextures.contains(pBefore.get()) && !runTextures.contains(pAfter.get());
+
+			if (!bIndependent)
+			{
+				runReads.clear();
+				runWrites.clear();
+				runTextures.clear();
+				++numRuns;
+			}
+
+			pass.recordingRun = numRuns - 1;
+			bRunOpen          = true;
+			for (const auto& read : builder.GetReads())
+				runReads.insert(read.id.hash);
+			for (const auto& write : builder.GetWrites())
+			{
+				runWrites.insert(write.id.hash);
+				if (write.pTexture)
+					runTextures.insert(write.pTexture.get());
+			}
+			for (const auto& pScratch : builder.GetScratch())
+				runTextures.insert(pScratch.get());
+			for (const auto& [pBefore, pAfter] : pass.aliasing)
+			{
+				runTextures.insert(pBefore.get());
+				runTextures.insert(pAfter.get());
+			}
+		}
+	}
+
+	u32 surfaceRequirements = 0;
+	if (IsConsumed(graph::kCoreNormal) || IsConsumed(graph::kCoreMaterial))
+		surfaceRequirements |= SURFACE_REQ_NORMAL_ROUGHNESS;
+	if (IsConsumed(graph::kVelocity))
+		surfaceRequirements |= SURFACE_REQ_VELOCITY;
+	g_FrameData.surfaceRequirements = surfaceRequirements;
+
+	m_CompiledKey = key;
+	m_bDirty      = false;
+	return m_CompiledPasses;
+}
+
+void RenderGraph::ApplyBarriers(render::CommandContext& context, const Pass& pass)
+{
+	using namespace render;
+
+	for (const auto& [pBefore, pAfter] : pass.aliasing)
+		context.AliasingBarrier(pBefore, pAfter);
+
+	for (const auto& usage : pass.transitions)
+	{
+		if (usage.pBuffer)
+		{
+			if (usage.access == eGraphAccess::ShaderRead)
+				context.TransitionBufferToRead(usage.pBuffer, usage.stage);
+			else
+				context.TransitionBufferToWrite(usage.pBuffer, usage.stage);
+			continue;
+		}
+
+		if (!usage.pTexture)
+			continue;
+
+		switch (usage.access)
+		{
+		case eGraphAccess::ShaderRead:
+			context.TransitionTextureToRead(usage.pTexture, usage.stage);
+			break;
+		case eGraphAccess::ShaderWrite:
+			context.TransitionTextureToWrite(usage.pTexture, usage.stage);
+			break;
+		case eGraphAccess::ColorAttachment:
+			context.TransitionBarrier(usage.pTexture, eTextureLayout::ColorAttachment);
+			break;
+		case eGraphAccess::DepthAttachment:
+			context.TransitionBarrier(usage.pTexture, eTextureLayout::DepthStencilAttachment);
+			break;
+		}
+	}
 }
 
 }
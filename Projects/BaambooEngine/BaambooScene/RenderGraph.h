@@ -1,19 +1,61 @@
 #pragma once
+#include "RenderCommon/RenderGraphBuilder.h"
+
+#include <unordered_set>
 
 namespace render
 {
 	class RenderNode;
+	class RenderDevice;
+	class CommandContext;
 }
 
+struct SceneRenderView;
+
 namespace baamboo
 {
 
 class RenderGraph
 {
 public:
+	struct Pass
+	{
+		Arc< render::RenderNode > pNode;
+
+		// transient textures taking over shared memory at this pass: { previous owner, new owner }
+		std::vector< std::pair< Arc< render::Texture >, Arc< render::Texture > > > aliasing;
+
+		// entry barriers of the pass, recorded unflushed so they go out as one batch
+		std::vector< render::GraphResourceUsage > transitions;
+
+		// recorded on the compute queue when the backend has one, otherwise in place
+		bool bAsyncCompute = false;
+
+		// Consecutive passes sharing a run touch nothing another one of them writes, so they may
+		// record on worker threads. kInvalidIndex: recorded on the frame context.
+		u32 recordingRun = kInvalidIndex;
+	};
+
 	void AddRenderNode(const Arc< render::RenderNode >& pNode);
 	void RemoveRenderNode(const std::string& nodeName);
 
+	// forces the next Compile to rebuild (e.g. nodes re-created resources on resize)
+	void Invalidate() { m_bDirty = true; m_bRebindTransients = true; }
+
+	// Rebuilds the live pass list when the node set or any node's declaration key changed,
+	// otherwise returns the cached one. Transient textures are re-aliased when their grouping changes.
+	const std::vector< Pass >& Compile(render::RenderDevice& rd, const SceneRenderView& renderView);
+
+	static void ApplyBarriers(render::CommandContext& context, const Pass& pass);
+
+	// true when a live pass reads 'id' (as of the last Compile)
+	bool IsConsumed(const render::BindingId& id) const { return m_ConsumedIds.contains(id.hash); }
+	u32 NumCulledPasses() const { return m_NumCulledPasses; }
+
+	// First non-async pass that needs the async passes' results: it reads what one of them writes,
+	// or declares nothing and may read anything. kInvalidIndex when no pass does.
+	u32 AsyncComputeJoinPass() const { return m_AsyncComputeJoinPass; }
+
 	const std::vector< Arc< render::RenderNode > >& GetRenderNodes() const { return m_RenderNodes; }
 
 	Arc< render::RenderNode > GetRenderNodeByName(const std::string& nodeName) const
@@ -27,6 +69,16 @@ private:
 
 	std::vector< Arc< render::RenderNode > >                     m_RenderNodes;
 	std::unordered_map< std::string, Arc< render::RenderNode > > m_RenderNodeNameMap;
+
+	std::vector< Pass >       m_CompiledPasses;
+	std::unordered_set< u64 > m_ConsumedIds;
+	u64                       m_CompiledKey          = 0;
+	u32                       m_NumCulledPasses      = 0;
+	u32                       m_AsyncComputeJoinPass = kInvalidIndex;
+	bool                      m_bDirty               = true;
+
+	std::vector< std::vector< Arc< render::Texture > > > m_TransientGroups;
+	bool                                                 m_bRebindTransients = true;
 };
 
 } // namespace baamboo
\ No newline at end of file
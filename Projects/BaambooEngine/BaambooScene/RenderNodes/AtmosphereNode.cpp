@@ -132,9 +132,7 @@ void AtmosphereNode::Apply(render::CommandContext& context, const SceneRenderVie
 	using namespace render;
 	auto& rm = m_RenderDevice.GetResourceManager();
 
-	const u64 atmosphereRevision = renderView.componentRevisions[eComponentType::CAtmosphere];
-	const bool atmosphereDirty = atmosphereRevision != m_LastAtmosphereRevision;
-	if (!m_bStaticLutsInitialized || atmosphereDirty)
+	if (NeedsStaticLuts(renderView))
 	{
 		context.SetRenderPipeline(m_pTransmittancePSO.get());
 
@@ -156,7 +154,7 @@ void AtmosphereNode::Apply(render::CommandContext& context, const SceneRenderVie
 		context.StageDescriptor("g_OutMultiScatteringLUT", m_pMultiScatteringLUT);
 		
 		context.Dispatch2D< 8, 8 >(kMultiScatteringLutResolution.x, kMultiScatteringLutResolution.y);
-		m_LastAtmosphereRevision = atmosphereRevision;
+		m_LastAtmosphereRevision = renderView.componentRevisions[eComponentType::CAtmosphere];
 		m_bStaticLutsInitialized = true;
 	}
 
@@ -213,7 +211,33 @@ void AtmosphereNode::Apply(render::CommandContext& context, const SceneRenderVie
 	context.StageDescriptor("g_OutSkyboxLUT", m_pSkyboxLUT);
 
 	context.Dispatch3D< 8, 8, 6 >(kSkyboxLutResolution.x, kSkyboxLutResolution.y, kSkyboxLutResolution.z);
+}
+
+void AtmosphereNode::DeclareResources(render::RenderGraphBuilder& builder, const SceneRenderView& renderView)
+{
+	using namespace render;
+
+	if (NeedsStaticLuts(renderView))
+	{
+		builder.Write(graph::kTransmittanceLUT, m_pTransmittanceLUT, eGraphAccess::ShaderWrite, ePipelineStage::ComputeShader);
+		builder.Write(graph::kMultiScatteringLUT, m_pMultiScatteringLUT, eGraphAccess::ShaderWrite, ePipelineStage::ComputeShader);
+	}
+	builder.Write(graph::kSkyViewLUT, m_pSkyViewLUT, eGraphAccess::ShaderWrite, ePipelineStage::ComputeShader);
+	builder.Write(graph::kAerialPerspectiveLUT, m_pAerialPerspectiveLUT, eGraphAccess::ShaderWrite, ePipelineStage::ComputeShader);
+	builder.Write(graph::kAtmosphereAmbientLUT, m_pAtmosphereAmbientLUT, eGraphAccess::ShaderWrite, ePipelineStage::ComputeShader);
+	builder.Write(graph::kSkyboxLUT, m_pSkyboxLUT, eGraphAccess::ShaderWrite, ePipelineStage::ComputeShader);
+
+	// the LUTs reach their readers through g_FrameData, outside the graph
+	builder.SetSideEffects();
+}
+
+u64 AtmosphereNode::DeclarationKey(const SceneRenderView& renderView) const
+{
+	return NeedsStaticLuts(renderView);
+}
 
+void AtmosphereNode::PublishFrameData()
+{
 	g_FrameData.pTransmittanceLUT     = m_pTransmittanceLUT;
 	g_FrameData.pMultiScatteringLUT   = m_pMultiScatteringLUT;
 	g_FrameData.pSkyViewLUT           = m_pSkyViewLUT;
@@ -222,4 +246,9 @@ void AtmosphereNode::Apply(render::CommandContext& context, const SceneRenderVie
 	g_FrameData.pSkyboxLUT            = m_pSkyboxLUT;
 }
 
+bool AtmosphereNode::NeedsStaticLuts(const SceneRenderView& renderView) const
+{
+	return !m_bStaticLutsInitialized || renderView.componentRevisions[eComponentType::CAtmosphere] != m_LastAtmosphereRevision;
+}
+
 } // namespace baamboo
\ No newline at end of file
@@ -12,6 +12,16 @@ public:
 	virtual ~AtmosphereNode() = default;
 
 	virtual void Apply(render::CommandContext& context, const SceneRenderView& renderView) override;
+	virtual void DeclareResources(render::RenderGraphBuilder& builder, const SceneRenderView& renderView) override;
+	virtual u64 DeclarationKey(const SceneRenderView& renderView) const override;
+	virtual void PublishFrameData() override;
+
+	virtual bool SupportsParallelRecording() const override { return true; }
+	virtual bool SupportsAsyncCompute() const override { return true; }
+
+private:
+	// transmittance and multi-scattering only change with the atmosphere component
+	bool NeedsStaticLuts(const SceneRenderView& renderView) const;
 
 private:
 	Arc< render::Texture > m_pTransmittanceLUT;
@@ -94,9 +94,7 @@ void CloudShapeNode::Apply(render::CommandContext& context, const SceneRenderVie
 
         context.Dispatch2D< 8, 8 >(kWeatherMapTextureResolution.x, kWeatherMapTextureResolution.y);*/
     }
-    const u64 cloudRevision = renderView.componentRevisions[eComponentType::CCloud];
-    const bool cloudDirty = cloudRevision != m_LastCloudRevision;
-    if (!m_bBaseNoiseInitialized || cloudDirty)
+    if (NeedsBaseNoise(renderView))
     {
         context.SetRenderPipeline(m_pCloudShapeBasePSO.get());
 
@@ -105,15 +103,39 @@ void CloudShapeNode::Apply(render::CommandContext& context, const SceneRenderVie
         context.StageDescriptor("g_OutBaseNoise", m_pBaseNoiseTexture);
 
         context.Dispatch3D< 8, 8, 8 >(kBaseNoiseTextureResolution.x, kBaseNoiseTextureResolution.y, kBaseNoiseTextureResolution.z);
-        m_LastCloudRevision = cloudRevision;
+        m_LastCloudRevision = renderView.componentRevisions[eComponentType::CCloud];
         m_bBaseNoiseInitialized = true;
     }
+}
+
+void CloudShapeNode::DeclareResources(render::RenderGraphBuilder& builder, const SceneRenderView& renderView)
+{
+    using namespace render;
+
+    if (NeedsBaseNoise(renderView))
+        builder.Write(graph::kCloudBaseNoise, m_pBaseNoiseTexture, eGraphAccess::ShaderWrite, ePipelineStage::ComputeShader);
+
+    // the shape textures reach their readers through g_FrameData, outside the graph
+    builder.SetSideEffects();
+}
 
+u64 CloudShapeNode::DeclarationKey(const SceneRenderView& renderView) const
+{
+    return NeedsBaseNoise(renderView);
+}
+
+void CloudShapeNode::PublishFrameData()
+{
     g_FrameData.pCloudWeatherMap   = m_pCloudWeatherMap;
-	g_FrameData.pCloudProfileLUT   = m_pCloudProfileLUT;
+    g_FrameData.pCloudProfileLUT   = m_pCloudProfileLUT;
     g_FrameData.pCloudBaseNoiseLUT = m_pBaseNoiseTexture;
 }
 
+bool CloudShapeNode::NeedsBaseNoise(const SceneRenderView& renderView) const
+{
+    return !m_bBaseNoiseInitialized || renderView.componentRevisions[eComponentType::CCloud] != m_LastCloudRevision;
+}
+
 
 //-------------------------------------------------------------------------
 // Cloud Scattering
@@ -18,6 +18,15 @@ public:
 	virtual ~CloudShapeNode();
 
 	virtual void Apply(render::CommandContext& context, const SceneRenderView& renderView) override;
+	virtual void DeclareResources(render::RenderGraphBuilder& builder, const SceneRenderView& renderView) override;
+	virtual u64 DeclarationKey(const SceneRenderView& renderView) const override;
+	virtual void PublishFrameData() override;
+
+	virtual bool SupportsParallelRecording() const override { return true; }
+	virtual bool SupportsAsyncCompute() const override { return true; }
+
+private:
+	bool NeedsBaseNoise(const SceneRenderView& renderView) const;
 
 private:
 	Arc< render::Texture > m_pCloudWeatherMap;
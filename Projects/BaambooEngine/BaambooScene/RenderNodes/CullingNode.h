@@ -45,6 +45,10 @@ public:
 	virtual void Apply(render::CommandContext& context, const SceneRenderView& renderView) override;
 	virtual void Resize(u32 width, u32 height, u32 depth = 1) override;
 
+	// Culls, draws the gbuffer and builds HiZ without touching any other node's output of the
+	// frame, so async compute passes overlap it instead of joining in front of it.
+	virtual void DeclareResources(render::RenderGraphBuilder& builder, const SceneRenderView& renderView) override { UNUSED(renderView); builder.SetSideEffects(); }
+
 private:
 	void DispatchMeshCull(render::CommandContext& context, u32 numInstances, u32 phase);
 	void PatchVoxelMeshData(render::CommandContext& context, const SceneRenderView& renderView);
@@ -80,7 +80,25 @@ void ClusterBuildNode::Apply(render::CommandContext& context, const SceneRenderV
 	context.Dispatch3D< 4, 4, 4 >(m_NumTilesX, m_NumTilesY, CLUSTER_SLICES_Z);
 
 	context.TransitionBufferToRead(m_pClusterAABBBuffer, ePipelineStage::ComputeShader);
+}
+
+void ClusterBuildNode::DeclareResources(render::RenderGraphBuilder& builder, const SceneRenderView& renderView)
+{
+	// frozen, the buffer keeps the clusters it was last built with
+	if (!renderView.bFrozen)
+		builder.Write(graph::kClusterAABBs, m_pClusterAABBBuffer, render::ePipelineStage::ComputeShader);
+
+	// light culling finds the buffer through g_FrameData, outside the graph
+	builder.SetSideEffects();
+}
 
+u64 ClusterBuildNode::DeclarationKey(const SceneRenderView& renderView) const
+{
+	return renderView.bFrozen;
+}
+
+void ClusterBuildNode::PublishFrameData()
+{
 	g_FrameData.pClusterAABBBuffer = m_pClusterAABBBuffer;
 }
 
@@ -229,7 +247,8 @@ LightingNode::LightingNode(render::RenderDevice& rd)
 			{
 				.resolution = { m_RenderDevice.WindowWidth(), m_RenderDevice.WindowHeight(), 1 },
 				.format     = eFormat::RGBA16_FLOAT,
-				.imageUsage = eTextureUsage_Sample | eTextureUsage_Storage | eTextureUsage_TransferSource | eTextureUsage_ColorAttachment
+				.imageUsage = eTextureUsage_Sample | eTextureUsage_Storage | eTextureUsage_TransferSource | eTextureUsage_ColorAttachment,
+				.bTransient = true
 			});
 
 	m_pLtcLut1 = rm.LoadTexture(TEXTURE_PATH.string() + "ltc_1.dds");
@@ -249,13 +268,15 @@ LightingNode::LightingNode(render::RenderDevice& rd)
 			.bufferUsage        = eBufferUsage_Storage | eBufferUsage_TransferDest,
 		});
 
-	m_pLightingPSO = ComputePipeline::Create(m_RenderDevice, "LightingPSO");
-	m_pLightingPSO->SetComputeShader(
-		Shader::Create(m_RenderDevice, "DeferredPBRLightingCS",
-			{
-				.stage    = eShaderStage::Compute,
-				.filename = "DeferredPBRLightingCS"
-			})).Build();
+	// The surface debug view is a permutation, so the lit path carries none of its branches
+	m_pLightingPSOs = MakeBox< ComputePermutationCache >(m_RenderDevice, "LightingPSO",
+		Shader::CreationInfo{
+			.stage    = eShaderStage::Compute,
+			.filename = "DeferredPBRLightingCS"
+		},
+		std::vector< ComputePermutationCache::Feature >{
+			{ .name = "SURFACE_DEBUG_VIEW", .constantId = 0, .numValues = 8 },
+		});
 }
 
 void LightingNode::Apply(render::CommandContext& context, const SceneRenderView& renderView)
@@ -263,10 +284,7 @@ void LightingNode::Apply(render::CommandContext& context, const SceneRenderView&
 	using namespace render;
 	auto& rm = m_RenderDevice.GetResourceManager();
 
-	context.SetRenderPipeline(m_pLightingPSO.get());
-
-	u32 debugView = renderView.debugFlags.surfaceDebugView;
-	context.SetComputeConstants(sizeof(u32), &debugView);
+	context.SetRenderPipeline(m_pLightingPSOs->Get({ renderView.debugFlags.surfaceDebugView }));
 
 	context.SetComputeDynamicUniformBuffer("g_VoxelChunkDesc", g_FrameData.voxelChunkDesc);
 
@@ -281,8 +299,6 @@ void LightingNode::Apply(render::CommandContext& context, const SceneRenderView&
 	context.TransitionBarrier(g_FrameData.pDepth.lock(), eTextureLayout::ShaderReadOnly);
 	context.TransitionBarrier(g_FrameData.pVBuf0.lock(), eTextureLayout::ShaderReadOnly);
 	context.TransitionBarrier(g_FrameData.pVBuf1.lock(), eTextureLayout::ShaderReadOnly);
-	context.TransitionBarrier(g_FrameData.pCoreNormal.lock(), eTextureLayout::ShaderReadOnly);
-	context.TransitionBarrier(g_FrameData.pCoreMaterial.lock(), eTextureLayout::ShaderReadOnly);
 	context.TransitionBarrier(g_FrameData.pAerialPerspectiveLUT ?
 		g_FrameData.pAerialPerspectiveLUT.lock() : rm.GetFlatBlackTexture3D(), eTextureLayout::ShaderReadOnly);
 	context.TransitionBarrier(g_FrameData.pCloudScatteringLUT ?
@@ -291,7 +307,6 @@ void LightingNode::Apply(render::CommandContext& context, const SceneRenderView&
 		g_FrameData.pSkyboxLUT.lock() : rm.GetFlatBlackTextureCube(), eTextureLayout::ShaderReadOnly);
 	context.TransitionBarrier(m_pLtcLut1, eTextureLayout::ShaderReadOnly);
 	context.TransitionBarrier(m_pLtcLut2, eTextureLayout::ShaderReadOnly);
-	context.TransitionBarrier(m_pSceneTexture, eTextureLayout::General);
 
 	context.StageDescriptor("g_DepthBuffer", g_FrameData.pDepth.lock(), g_FrameData.pPointClamp);
 	context.StageDescriptor("g_VBuf0", g_FrameData.pVBuf0.lock(), g_FrameData.pPointClampNearest);
@@ -329,6 +344,16 @@ void LightingNode::Apply(render::CommandContext& context, const SceneRenderView&
 	g_FrameData.pColor = m_pSceneTexture;
 }
 
+void LightingNode::DeclareResources(render::RenderGraphBuilder& builder, const SceneRenderView& renderView)
+{
+	UNUSED(renderView);
+	using namespace render;
+
+	builder.Read(graph::kCoreNormal, ePipelineStage::ComputeShader);
+	builder.Read(graph::kCoreMaterial, ePipelineStage::ComputeShader);
+	builder.Write(graph::kSceneColor, m_pSceneTexture, eGraphAccess::ShaderWrite, ePipelineStage::ComputeShader);
+}
+
 void LightingNode::Resize(u32 width, u32 height, u32 depth)
 {
 	if (m_pSceneTexture)
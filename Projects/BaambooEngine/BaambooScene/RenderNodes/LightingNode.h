@@ -1,5 +1,6 @@
 #pragma once
 #include "RenderCommon/RenderNode.h"
+#include "RenderCommon/PermutationCache.h"
 
 namespace baamboo
 {
@@ -15,8 +16,14 @@ public:
 	virtual ~ClusterBuildNode() = default;
 
 	virtual void Apply(render::CommandContext& context, const SceneRenderView& renderView) override;
+	virtual void DeclareResources(render::RenderGraphBuilder& builder, const SceneRenderView& renderView) override;
+	virtual u64 DeclarationKey(const SceneRenderView& renderView) const override;
+	virtual void PublishFrameData() override;
 	virtual void Resize(u32 width, u32 height, u32 depth = 1) override;
 
+	virtual bool SupportsParallelRecording() const override { return true; }
+	virtual bool SupportsAsyncCompute() const override { return true; }
+
 private:
 	Arc< render::Buffer > m_pClusterAABBBuffer;
 	Box< render::ComputePipeline > m_pClusterBuildPSO;
@@ -39,6 +46,8 @@ public:
 	virtual void Apply(render::CommandContext& context, const SceneRenderView& renderView) override;
 	virtual void Resize(u32 width, u32 height, u32 depth = 1) override;
 
+	virtual bool SupportsAsyncCompute() const override { return true; }
+
 private:
 	Arc< render::Buffer > m_pLightGridBuffer;
 	Arc< render::Buffer > m_pLightListDataBuffer;
@@ -63,6 +72,7 @@ public:
 	virtual ~LightingNode() = default;
 
 	virtual void Apply(render::CommandContext& context, const SceneRenderView& renderView) override;
+	virtual void DeclareResources(render::RenderGraphBuilder& builder, const SceneRenderView& renderView) override;
 	virtual void Resize(u32 width, u32 height, u32 depth = 1) override;
 
 private:
@@ -72,7 +82,7 @@ private:
 	Arc< render::Buffer >  m_pFallbackLightGridBuffer;
 	Arc< render::Buffer >  m_pFallbackLightListDataBuffer;
 
-	Box< render::ComputePipeline > m_pLightingPSO;
+	Box< render::ComputePermutationCache > m_pLightingPSOs;
 };
 
 
@@ -55,9 +55,9 @@ bool BytesEqual(const T& lhs, const T& rhs)
 // resize and dumping all iterate this table — add a row, get all five.
 struct ValidationAOVDesc
 {
-    const char* textureName;
-    const char* shaderName;
-    const char* fileName;
+    const char*       textureName;
+    render::BindingId shaderName;
+    const char*       fileName;
 };
 
 constexpr ValidationAOVDesc VALIDATION_AOVS[] =
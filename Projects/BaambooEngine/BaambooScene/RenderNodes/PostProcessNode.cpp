@@ -30,7 +30,8 @@ PostProcessNode::PostProcessNode(render::RenderDevice& rd)
 				{
 					.resolution = { m_RenderDevice.WindowWidth(), m_RenderDevice.WindowHeight(), 1 },
 					.format     = eFormat::RGBA16_FLOAT,
-					.imageUsage = eTextureUsage_Sample | eTextureUsage_Storage | eTextureUsage_TransferSource
+					.imageUsage = eTextureUsage_Sample | eTextureUsage_Storage | eTextureUsage_TransferSource,
+					.bTransient = true
 				});
 
 		m_TAA.pTemporalAntiAliasingPSO = ComputePipeline::Create(m_RenderDevice, "TemporalAntiAliasingPSO");
@@ -64,7 +65,8 @@ PostProcessNode::PostProcessNode(render::RenderDevice& rd)
 					{
 						.resolution = { w, h, 1 },
 						.format     = eFormat::RGBA16_FLOAT,
-						.imageUsage = eTextureUsage_Sample | eTextureUsage_Storage | eTextureUsage_TransferSource
+						.imageUsage = eTextureUsage_Sample | eTextureUsage_Storage | eTextureUsage_TransferSource,
+						.bTransient = true
 					});
 			m_Bloom.pUpChain[i] =
 				Texture::Create(
@@ -73,7 +75,8 @@ PostProcessNode::PostProcessNode(render::RenderDevice& rd)
 					{
 						.resolution = { w, h, 1 },
 						.format     = eFormat::RGBA16_FLOAT,
-						.imageUsage = eTextureUsage_Sample | eTextureUsage_Storage | eTextureUsage_TransferDest
+						.imageUsage = eTextureUsage_Sample | eTextureUsage_Storage | eTextureUsage_TransferDest,
+						.bTransient = true
 					});
 		}
 
@@ -130,6 +133,30 @@ void PostProcessNode::Apply(render::CommandContext& context, const SceneRenderVi
 	ApplyToneMapping(context, renderView);
 }
 
+void PostProcessNode::DeclareResources(render::RenderGraphBuilder& builder, const SceneRenderView& renderView)
+{
+	using namespace render;
+
+	builder.Read(graph::kSceneColor, ePipelineStage::ComputeShader);
+	if (renderView.postProcess.effectBits & (1 << ePostProcess::AntiAliasing))
+		builder.Read(graph::kVelocity, ePipelineStage::ComputeShader);
+
+	builder.Write(graph::kSceneColor, m_ToneMapping.pResolvedTexture, eGraphAccess::ShaderWrite, ePipelineStage::ComputeShader);
+
+	builder.Scratch(m_TAA.pAntiAliasedTexture);
+	for (u32 i = 0; i < kBloomMipCount; ++i)
+	{
+		builder.Scratch(m_Bloom.pDownChain[i]);
+		builder.Scratch(m_Bloom.pUpChain[i]);
+	}
+}
+
+u64 PostProcessNode::DeclarationKey(const SceneRenderView& renderView) const
+{
+	// velocity is only read with TAA on
+	return renderView.postProcess.effectBits & (1 << ePostProcess::AntiAliasing);
+}
+
 void PostProcessNode::Resize(u32 width, u32 height, u32 depth)
 {
 	m_TAA.ApplyCounter = 0;
@@ -233,7 +260,6 @@ void PostProcessNode::ApplyAntiAliasing(render::CommandContext& context, const S
 		context.SetRenderPipeline(m_TAA.pTemporalAntiAliasingPSO.get());
 
 		context.TransitionBarrier(pColor, eTextureLayout::ShaderReadOnly);
-		context.TransitionBarrier(pVelocity, eTextureLayout::ShaderReadOnly);
 		if (!bFirstApply)
 			context.TransitionBarrier(m_TAA.pHistoryTexture, eTextureLayout::ShaderReadOnly);
 		else
@@ -296,7 +322,6 @@ void PostProcessNode::ApplyToneMapping(render::CommandContext& context, const Sc
 
 	context.TransitionBarrier(pColor, eTextureLayout::ShaderReadOnly);
 	context.TransitionBarrier(pBloom, eTextureLayout::ShaderReadOnly);
-	context.TransitionBarrier(m_ToneMapping.pResolvedTexture, eTextureLayout::General);
 
 	// Tone mapping push constants
 	struct
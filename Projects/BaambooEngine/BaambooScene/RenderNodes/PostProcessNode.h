@@ -12,6 +12,8 @@ public:
 	virtual ~PostProcessNode() = default;
 
 	virtual void Apply(render::CommandContext& context, const SceneRenderView& renderView) override;
+	virtual void DeclareResources(render::RenderGraphBuilder& builder, const SceneRenderView& renderView) override;
+	virtual u64 DeclarationKey(const SceneRenderView& renderView) const override;
 	virtual void Resize(u32 width, u32 height, u32 depth = 1) override;
 
 private:
@@ -21,6 +21,7 @@ SurfaceResolveNode::SurfaceResolveNode(render::RenderDevice& rd)
 			.resolution = { rd.WindowWidth(), rd.WindowHeight(), 1 },
 			.format     = eFormat::RG16_SNORM,
 			.imageUsage = eTextureUsage_Sample | eTextureUsage_Storage,
+			.bTransient = true,
 		});
 
 	m_pCoreMaterial = Texture::Create(rd, "SurfaceResolvePass::CoreMaterial",
@@ -28,6 +29,7 @@ SurfaceResolveNode::SurfaceResolveNode(render::RenderDevice& rd)
 			.resolution = { rd.WindowWidth(), rd.WindowHeight(), 1 },
 			.format     = eFormat::RGBA8_UNORM,
 			.imageUsage = eTextureUsage_Sample | eTextureUsage_Storage,
+			.bTransient = true,
 		});
 
 	m_pVelocity = Texture::Create(rd, "SurfaceResolvePass::Velocity",
@@ -35,6 +37,7 @@ SurfaceResolveNode::SurfaceResolveNode(render::RenderDevice& rd)
 			.resolution = { rd.WindowWidth(), rd.WindowHeight(), 1 },
 			.format     = eFormat::RG16_FLOAT,
 			.imageUsage = eTextureUsage_Sample | eTextureUsage_Storage,
+			.bTransient = true,
 		});
 
 	m_pResolvePSO = ComputePipeline::Create(rd, "SurfaceResolvePSO");
@@ -82,9 +85,6 @@ void SurfaceResolveNode::Apply(render::CommandContext& context, const SceneRende
 
 	context.TransitionBarrier(pVBuf0, eTextureLayout::ShaderReadOnly);
 	context.TransitionBarrier(pVBuf1, eTextureLayout::ShaderReadOnly);
-	context.TransitionBarrier(m_pCoreNormal, eTextureLayout::General);
-	context.TransitionBarrier(m_pCoreMaterial, eTextureLayout::General);
-	context.TransitionBarrier(m_pVelocity, eTextureLayout::General);
 
 	struct SurfaceResolvePushConstants
 	{
@@ -129,15 +129,21 @@ void SurfaceResolveNode::Apply(render::CommandContext& context, const SceneRende
 
 	context.Dispatch2D< 16, 16 >(m_pCoreNormal->Width(), m_pCoreNormal->Height());
 
-	context.TransitionBarrier(m_pCoreNormal, eTextureLayout::ShaderReadOnly);
-	context.TransitionBarrier(m_pCoreMaterial, eTextureLayout::ShaderReadOnly);
-	context.TransitionBarrier(m_pVelocity, eTextureLayout::ShaderReadOnly);
-
 	g_FrameData.pCoreNormal   = m_pCoreNormal;
 	g_FrameData.pCoreMaterial = m_pCoreMaterial;
 	g_FrameData.pVelocity     = m_pVelocity;
 }
 
+void SurfaceResolveNode::DeclareResources(render::RenderGraphBuilder& builder, const SceneRenderView& renderView)
+{
+	UNUSED(renderView);
+	using namespace render;
+
+	builder.Write(graph::kCoreNormal, m_pCoreNormal, eGraphAccess::ShaderWrite, ePipelineStage::ComputeShader);
+	builder.Write(graph::kCoreMaterial, m_pCoreMaterial, eGraphAccess::ShaderWrite, ePipelineStage::ComputeShader);
+	builder.Write(graph::kVelocity, m_pVelocity, eGraphAccess::ShaderWrite, ePipelineStage::ComputeShader);
+}
+
 void SurfaceResolveNode::Resize(u32 width, u32 height, u32 depth)
 {
 	if (m_pCoreNormal)
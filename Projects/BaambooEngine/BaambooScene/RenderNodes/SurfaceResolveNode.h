@@ -13,6 +13,7 @@ public:
 	virtual ~SurfaceResolveNode() = default;
 
 	virtual void Apply(render::CommandContext& context, const SceneRenderView& renderView) override;
+	virtual void DeclareResources(render::RenderGraphBuilder& builder, const SceneRenderView& renderView) override;
 	virtual void Resize(u32 width, u32 height, u32 depth = 1) override;
 
 private:
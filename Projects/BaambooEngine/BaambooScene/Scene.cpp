@@ -3,6 +3,7 @@
 #include "Entity.h"
 #include "Components.h"
 #include "Camera.h"
+#include "AnimationCompression.h"
 #include "Systems/TransformSystem.h"
 #include "Systems/MeshSystem.h"
 #include "Systems/LightSystem.h"
@@ -10,8 +11,12 @@
 #include "Systems/CloudSystem.h"
 #include "Systems/PostProcessSystem.h"
 #include "Systems/VoxelTerrainSystem.h"
+#include "Systems/AnimationSystem.h"
+#include "Systems/SpatialSystem.h"
+#include "Systems/ScriptSystem.h"
 #include "Utils/Math.hpp"
 
+#include <numeric>
 #include <queue>
 #include <glm/gtx/matrix_decompose.hpp>
 
@@ -33,6 +38,9 @@ Scene::Scene(const std::string& name)
 	m_pCloudSystem       = new CloudSystem(m_Registry, m_pAtmosphereSystem);
 	m_pLocalLightSystem  = new LocalLightSystem(m_Registry, m_pTransformSystem);
 	m_pPostProcessSystem = new PostProcessSystem(m_Registry);
+	m_pAnimationSystem   = new AnimationSystem(m_Registry, *this);
+	m_pSpatialSystem     = new SpatialSystem(m_Registry, m_pTransformSystem);
+	m_pScriptSystem      = new ScriptSystem(m_Registry, m_pTransformSystem);
 }
 
 Scene::~Scene()
@@ -44,6 +52,9 @@ Scene::~Scene()
 	for (auto& [_, pLoader] : m_ModelLoaderCache)
 		RELEASE(pLoader);
 
+	RELEASE(m_pScriptSystem);
+	RELEASE(m_pSpatialSystem);
+	RELEASE(m_pAnimationSystem);
 	RELEASE(m_pPostProcessSystem);
 	RELEASE(m_pVoxelTerrainSystem);
 	RELEASE(m_pLocalLightSystem);
@@ -228,6 +239,39 @@ Entity Scene::ImportModel(Entity parentEntity, const fs::path& filepath, MeshDes
 
 	Entity rootEntity = ProcessNode(pRootNode, parentEntity);
 
+	// Animation
+	if (pLoader->HasAnimations())
+	{
+		const AnimationData& animationData = pLoader->GetAnimationData();
+
+		const u32 skeletonID = static_cast< u32 >(m_Skeletons.size());
+		m_Skeletons.emplace(skeletonID, animationData.skeleton);
+
+		auto& animationComponent = rootEntity.AttachComponent< AnimationComponent >();
+		animationComponent.skeletonID = skeletonID;
+		for (const auto& clip : animationData.clips)
+		{
+			const u32 clipID = GetAnimationClipCount();
+			if (descriptor.bCompressAnimations)
+			{
+				auto compressed = CompressAnimationClip(clip, animationData.skeleton);
+				printf("[Animation] compressed '%s': %llu -> %llu bytes (%.1f:1), max error %g\n",
+					compressed.name.c_str(), compressed.rawSizeInBytes, compressed.sizeInBytes, compressed.GetCompressionRatio(), compressed.maxError);
+
+				m_AnimationClipMemory.Add(compressed.sizeInBytes);
+				m_CompressedAnimationClips.emplace(clipID, std::move(compressed));
+			}
+			else
+			{
+				m_AnimationClipMemory.Add(clip.SizeInBytes());
+				m_AnimationClips.emplace(clipID, clip);
+			}
+
+			if (animationComponent.currentClipID == kInvalidIndex)
+				animationComponent.currentClipID = clipID;
+		}
+	}
+
 	m_bLoading = false;
 
 	s_ModelCache.emplace(filepath.string(), rootEntity);
@@ -278,12 +322,15 @@ void Scene::Update(f32 dt, const EditorCamera& edCamera)
 	const auto updateSystem = [&]< typename TSystem >(TSystem* pSystem, eComponentType component)
 	{
 		const bool bChanged = pSystem->HasPendingRenderDataChanges();
-		pSystem->UpdateRenderData(edCamera);
+		auto markedEntities = pSystem->UpdateRenderData(edCamera);
 		if (bChanged)
 			changedComponents |= 1ULL << component;
+		return markedEntities;
 	};
 
-	updateSystem(m_pTransformSystem, eComponentType::CTransform);
+	m_pAnimationSystem->Update(dt);
+
+	const auto transformedEntities = updateSystem(m_pTransformSystem, eComponentType::CTransform);
 
 	const bool bStaticMeshChanged = m_pStaticMeshSystem->HasPendingRenderDataChanges();
 	m_pStaticMeshSystem->UpdateRenderData(edCamera);
@@ -293,6 +340,9 @@ void Scene::Update(f32 dt, const EditorCamera& edCamera)
 		changedComponents |= 1ULL << eComponentType::CMaterial;
 	}
 
+	m_pSpatialSystem->OnTransformsUpdated(transformedEntities);
+	m_pSpatialSystem->Update();
+
 	updateSystem(m_pSkyLightSystem, eComponentType::CSkyLight);
 	updateSystem(m_pAtmosphereSystem, eComponentType::CAtmosphere);
 	updateSystem(m_pCloudSystem, eComponentType::CCloud);
@@ -316,6 +366,7 @@ void Scene::OnWindowResized(u32 width, u32 height)
 	for (auto node : m_RenderGraph.GetRenderNodes())
 		if (node)
 			node->Resize(width, height);
+	m_RenderGraph.Invalidate();
 }
 
 void Scene::SetDebugLines(std::vector< DebugLineVertex >&& lines)
@@ -349,8 +400,6 @@ SceneRenderView Scene::RenderView(const EditorCamera& edCamera, float2 viewport,
 	SceneRenderView view = {};
 	view.time               = s_SceneRunningTime;
 	view.producerSequence   = producerSequence;
-	view.sceneRevision      = m_SceneRevision;
-	view.componentRevisions = m_ComponentRevisions;
 	view.viewport       = viewport;
 	view.sseThresholdPx = g_FrameData.sseThresholdPx;
 	view.cullFlags      = g_FrameData.cullFlags;
@@ -401,7 +450,47 @@ SceneRenderView Scene::RenderView(const EditorCamera& edCamera, float2 viewport,
 	view.debugLinesVersion = m_DebugLinesVersion;
 
 	m_pTransformSystem->CollectRenderData(view);
+
 	m_pStaticMeshSystem->CollectRenderData(view);
+
+	// the pre-pass only narrows the instance list, so it moves visibilityRevision and leaves the
+	// scene and mesh/material revisions alone; those still force full rebuilds in the renderers
+	u64 visibilityHash = 0;
+	if (m_bCpuFrustumCulling.load(std::memory_order_relaxed))
+	{
+		const auto beginTime = std::chrono::steady_clock::now();
+		m_CpuCullingStats = {};
+
+		std::vector< entt::entity > visibleEntities;
+		visibleEntities.reserve(m_pStaticMeshSystem->NumRenderData());
+		m_pSpatialSystem->Query(BoundingFrustum(view.frozenCamera.mProj * view.frozenCamera.mView), visibleEntities);
+
+		const u32 numOccluded = m_bCpuOcclusionCulling.load(std::memory_order_relaxed) ? CullOccluded(view.frozenCamera, visibleEntities) : 0;
+		const u32 numKept     = m_pStaticMeshSystem->CollectVisibleDraws(view, visibleEntities);
+
+		visibilityHash = 14695981039346656037ull;
+		for (u32 id : view.visibleDraws)
+			visibilityHash = (visibilityHash ^ id) * 1099511628211ull;
+
+		m_CpuCullingStats.numKept     = numKept;
+		m_CpuCullingStats.numCulled   = m_pStaticMeshSystem->NumRenderData() - numKept;
+		m_CpuCullingStats.numOccluded = numOccluded;
+		m_CpuCullingStats.elapsedMs   = std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - beginTime).count();
+	}
+	else
+	{
+		m_CpuCullingStats = {};
+	}
+
+	if (visibilityHash != m_VisibilityHash)
+	{
+		m_VisibilityHash = visibilityHash;
+		++m_VisibilityRevision;
+	}
+	view.sceneRevision      = m_SceneRevision;
+	view.componentRevisions = m_ComponentRevisions;
+	view.visibilityRevision = m_VisibilityRevision;
+
 	m_pSkyLightSystem->CollectRenderData(view);
 	m_pLocalLightSystem->CollectRenderData(view);
 	m_pAtmosphereSystem->CollectRenderData(view);
@@ -411,4 +500,71 @@ SceneRenderView Scene::RenderView(const EditorCamera& edCamera, float2 viewport,
 	return view;
 }
 
+u32 Scene::CullOccluded(const CameraRenderView& camera, std::vector< entt::entity >& visibleEntities) const
+{
+	constexpr u32   kMaxOccluders         = 24;
+	constexpr u32   kMaxOccluderTriangles = 2048;
+	constexpr float kMinOccluderSize      = 0.1f; // bounding radius over distance
+
+	struct Candidate
+	{
+		entt::entity entity;
+		BoundingBox  worldAABB;
+		float        size;
+	};
+	std::vector< Candidate > candidates;
+	candidates.reserve(visibleEntities.size());
+	for (auto entity : visibleEntities)
+	{
+		const auto& meshComponent      = m_Registry.get< StaticMeshComponent >(entity);
+		const auto& transformComponent = m_Registry.get< TransformComponent >(entity);
+
+		const BoundingBox worldAABB = BoundingBox::Transformed(meshComponent.aabb, m_pTransformSystem->WorldMatrix(transformComponent.world));
+		const float3      center    = (worldAABB.Min() + worldAABB.Max()) * 0.5f;
+		const float       radius    = glm::length(worldAABB.Max() - center);
+		candidates.push_back({ entity, worldAABB, radius / std::max(glm::length(center - camera.pos), 1e-3f) });
+	}
+
+	// the largest on screen occlude the most; their coarsest lod is plenty at this resolution
+	std::vector< u32 > order(candidates.size());
+	std::iota(order.begin(), order.end(), 0u);
+	std::sort(order.begin(), order.end(), [&candidates](u32 lhs, u32 rhs) { return candidates[lhs].size > candidates[rhs].size; });
+
+	std::vector< OcclusionBuffer::Occluder > occluders;
+	for (u32 i = 0; i < order.size() && occluders.size() < kMaxOccluders; ++i)
+	{
+		const Candidate& candidate = candidates[order[i]];
+		if (candidate.size < kMinOccluderSize)
+			break;
+
+		const auto& meshComponent = m_Registry.get< StaticMeshComponent >(candidate.entity);
+		const auto& lod           = meshComponent.lods[meshComponent.maxLOD];
+		if (!lod.pIndices || lod.numIndices / 3 > kMaxOccluderTriangles)
+			continue;
+
+		OcclusionBuffer::Occluder occluder = {};
+		occluder.pVertices  = meshComponent.pVertices;
+		occluder.pIndices   = lod.pIndices;
+		occluder.numIndices = lod.numIndices;
+		occluder.mWorld     = m_pTransformSystem->WorldMatrix(m_Registry.get< TransformComponent >(candidate.entity).world);
+		occluders.push_back(occluder);
+	}
+	m_CpuCullingStats.numOccluders = static_cast< u32 >(occluders.size());
+
+	m_OcclusionBuffer.Render(camera.mProj * camera.mView, occluders);
+	if (occluders.empty())
+		return 0;
+
+	u32 numVisible = 0;
+	for (const auto& candidate : candidates)
+	{
+		if (m_OcclusionBuffer.IsVisible(candidate.worldAABB))
+			visibleEntities[numVisible++] = candidate.entity;
+	}
+
+	const u32 numOccluded = static_cast< u32 >(visibleEntities.size()) - numVisible;
+	visibleEntities.resize(numVisible);
+	return numOccluded;
+}
+
 } // namespace baamboo
@@ -3,6 +3,8 @@
 #include "SceneRenderView.h"
 #include "ModelLoader.h"
 #include "RenderGraph.h"
+#include "SceneSerializer.h"
+#include "OcclusionBuffer.h"
 
 #include <atomic>
 #include <mutex>
@@ -21,8 +23,12 @@ class AtmosphereSystem;
 class CloudSystem;
 class PostProcessSystem;
 class VoxelTerrainSystem;
+class AnimationSystem;
+class SpatialSystem;
+class ScriptSystem;
 
 // Lets the resolve skip producing caches that no pass consumes this frame (demand-driven).
+// Derived from the render graph's consumers each time it compiles.
 enum SurfaceRequirementBits : u32
 {
 	SURFACE_REQ_NORMAL_ROUGHNESS = 1u << 0, // CoreCache (oct normal + roughness + material class)
@@ -33,6 +39,24 @@ enum SurfaceRequirementBits : u32
 	SURFACE_REQ_ALL              = 0xFFFFFFFFu,
 };
 
+// Logical resources passed between nodes through the render graph
+namespace graph
+{
+	inline constexpr render::BindingId kCoreNormal   = "CoreNormal";
+	inline constexpr render::BindingId kCoreMaterial = "CoreMaterial";
+	inline constexpr render::BindingId kVelocity     = "Velocity";
+	inline constexpr render::BindingId kSceneColor   = "SceneColor"; // presented by the engine (g_FrameData.pColor)
+
+	inline constexpr render::BindingId kTransmittanceLUT     = "TransmittanceLUT";
+	inline constexpr render::BindingId kMultiScatteringLUT   = "MultiScatteringLUT";
+	inline constexpr render::BindingId kSkyViewLUT           = "SkyViewLUT";
+	inline constexpr render::BindingId kAerialPerspectiveLUT = "AerialPerspectiveLUT";
+	inline constexpr render::BindingId kAtmosphereAmbientLUT = "AtmosphereAmbientLUT";
+	inline constexpr render::BindingId kSkyboxLUT            = "SkyboxLUT";
+	inline constexpr render::BindingId kCloudBaseNoise       = "CloudBaseNoise";
+	inline constexpr render::BindingId kClusterAABBs         = "ClusterAABBs";
+}
+
 struct FrameData
 {
 	// MRT
@@ -141,6 +165,10 @@ public:
 	class Entity ImportModel(const fs::path& filepath, MeshDescriptor descriptor);
 	class Entity ImportModel(Entity rootEntity, const fs::path& filepath, MeshDescriptor descriptor);
 
+	// binary snapshot, see SceneSerializer
+	bool SaveToFile(const fs::path& filepath) const { return SceneSerializer::Save(*this, filepath); }
+	bool LoadFromFile(const fs::path& filepath) { return SceneSerializer::Load(*this, filepath); }
+
 	void AddRenderNode(Arc< render::RenderNode > pNode);
 	void RemoveRenderNode(const std::string& nodeName);
 
@@ -162,9 +190,17 @@ public:
 	const entt::registry& Registry() const { return m_Registry; }
 	[[nodiscard]]
 	TransformSystem* GetTransformSystem() const { return m_pTransformSystem; }
+	[[nodiscard]]
+	AnimationSystem* GetAnimationSystem() const { return m_pAnimationSystem; }
+	[[nodiscard]]
+	SpatialSystem* GetSpatialSystem() const { return m_pSpatialSystem; }
+	[[nodiscard]]
+	ScriptSystem* GetScriptSystem() const { return m_pScriptSystem; }
 
 	const std::vector< Arc< render::RenderNode > >& GetRenderNodes() const { return m_RenderGraph.GetRenderNodes(); }
 	Arc< render::RenderNode > GetRenderNodeByName(const std::string& nodeName) const { return m_RenderGraph.GetRenderNodeByName(nodeName); }
+	const std::vector< RenderGraph::Pass >& CompileRenderGraph(render::RenderDevice& rd, const SceneRenderView& renderView) { return m_RenderGraph.Compile(rd, renderView); }
+	u32 AsyncComputeJoinPass() const { return m_RenderGraph.AsyncComputeJoinPass(); }
 
 	
 	void SetCameraFreezeRequest(bool bFreeze) { m_CameraFreezeRequest.store(bFreeze); }
@@ -172,6 +208,26 @@ public:
 	bool IsCameraFrozen() const { return m_bCameraFrozen; }
 	u64  GetFrozenAtFrame() const { return m_FrozenAtFrame; }
 
+	// CPU frustum pre-pass over the spatial tree; culled static meshes are left out of the instance
+	// list the GPU culls and draws. Meshes and materials are still uploaded whole, so a changing
+	// visible set only re-packs instances.
+	// The occlusion stage on top rasterizes the largest visible meshes into an OcclusionBuffer and
+	// drops instances hidden behind them, independent of last frame's Hi-Z.
+	struct CpuCullingStats
+	{
+		u32    numKept      = 0;
+		u32    numCulled    = 0;
+		u32    numOccluded  = 0; // of numCulled, the ones rejected by the occlusion buffer
+		u32    numOccluders = 0;
+		double elapsedMs    = 0.0;
+	};
+	void SetCpuFrustumCulling(bool b) { m_bCpuFrustumCulling.store(b); }
+	bool GetCpuFrustumCulling() const { return m_bCpuFrustumCulling.load(); }
+	void SetCpuOcclusionCulling(bool b) { m_bCpuOcclusionCulling.store(b); }
+	bool GetCpuOcclusionCulling() const { return m_bCpuOcclusionCulling.load(); }
+	const OcclusionBuffer& GetOcclusionBuffer() const { return m_OcclusionBuffer; }
+	const CpuCullingStats& GetCpuCullingStats() const { return m_CpuCullingStats; }
+
 	void SetDebugClusterWireframe(bool b) { m_DebugShowCluster.store(b); }
 	bool GetDebugClusterWireframe() const { return m_DebugShowCluster.load(); }
 	void SetDebugClusterHeatmap(bool b) { m_DebugClusterHeatmap.store(b); }
@@ -192,15 +248,20 @@ public:
 	const MeshData* GetMeshData(u32 meshID) const { auto it = m_MeshData.find(meshID); return (it != m_MeshData.end()) ? &it->second : nullptr;  }
 	const Skeleton* GetSkeleton(u32 skeletonID) const { auto it = m_Skeletons.find(skeletonID); return (it != m_Skeletons.end()) ? &it->second : nullptr; }
 	const AnimationClip* GetAnimationClip(u32 clipID) const { auto it = m_AnimationClips.find(clipID); return (it != m_AnimationClips.end()) ? &it->second : nullptr; }
+	const CompressedAnimationClip* GetCompressedAnimationClip(u32 clipID) const { auto it = m_CompressedAnimationClips.find(clipID); return (it != m_CompressedAnimationClips.end()) ? &it->second : nullptr; }
 
 	u32 GetSkeletonCount() const { return static_cast<u32>(m_Skeletons.size()); }
-	u32 GetAnimationClipCount() const { return static_cast<u32>(m_AnimationClips.size()); }
+	u32 GetAnimationClipCount() const { return static_cast<u32>(m_AnimationClips.size() + m_CompressedAnimationClips.size()); }
 
 private:
 	void OnEntityRemoved(Entity entity);
 
+	// removes the entities hidden behind the largest ones; returns how many were removed
+	u32 CullOccluded(const CameraRenderView& camera, std::vector< entt::entity >& visibleEntities) const;
+
 private:
 	friend class Entity;
+	friend class SceneSerializer;
 	entt::registry m_Registry;
 
 	std::string m_Name;
@@ -218,6 +279,9 @@ private:
 	CloudSystem*        m_pCloudSystem       = nullptr;
 	PostProcessSystem*  m_pPostProcessSystem = nullptr;
 	VoxelTerrainSystem* m_pVoxelTerrainSystem = nullptr;
+	AnimationSystem*    m_pAnimationSystem   = nullptr;
+	SpatialSystem*      m_pSpatialSystem     = nullptr;
+	ScriptSystem*       m_pScriptSystem      = nullptr;
 
 	RenderGraph m_RenderGraph;
 
@@ -225,9 +289,14 @@ private:
 	std::unordered_map< u32, MeshData >      m_MeshData;
 	std::unordered_map< u32, Skeleton >      m_Skeletons;
 	std::unordered_map< u32, AnimationClip > m_AnimationClips;
+	std::unordered_map< u32, CompressedAnimationClip > m_CompressedAnimationClips; // same id space as m_AnimationClips
+	render::TrackedMemory m_AnimationClipMemory{ render::eMemoryTag::AnimationClips };
 
 	std::unordered_map< std::string, ModelLoader* > m_ModelLoaderCache;
 
+	// loaded scene files; static meshes point into their geometry
+	std::vector< std::unique_ptr< MappedSceneFile > > m_SceneFiles;
+
 	mutable std::mutex m_SceneMutex;
 
 	std::atomic< bool >      m_CameraFreezeRequest{ false };
@@ -236,6 +305,13 @@ private:
 	mutable float2           m_FrozenViewport  = float2(0.0f, 0.0f);
 	mutable u64              m_FrozenAtFrame   = 0;
 
+	std::atomic< bool >     m_bCpuFrustumCulling{ false };
+	std::atomic< bool >     m_bCpuOcclusionCulling{ false };
+	mutable OcclusionBuffer m_OcclusionBuffer;
+	mutable CpuCullingStats m_CpuCullingStats    = {};
+	mutable u64             m_VisibilityHash     = 0;
+	mutable u64             m_VisibilityRevision = 0; // bumped whenever the culled draw set changes; re-packs instances only
+
 	std::atomic< bool > m_DebugShowCluster{ false };
 	std::atomic< bool > m_DebugClusterHeatmap{ false };
 	std::atomic< bool > m_DebugSkipEmpty{ true };
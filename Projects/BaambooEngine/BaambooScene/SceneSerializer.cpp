@@ -0,0 +1,1114 @@
+#include "BaambooPch.h"
+#include "SceneSerializer.h"
+#include "Scene.h"
+#include "Components.h"
+
+#include <fstream>
+#include <span>
+
+#ifdef _WIN32
+	#define NOMINMAX
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace baamboo
+{
+
+namespace
+{
+
+constexpr u32 kSceneFileMagic = 0x4E435342; // "BSCN"
+
+// bump whenever a record below, or a component stored as-is in one, changes layout
+constexpr u32 kSceneFileVersion = 1;
+
+constexpr u64 kSectionAlignment = 16;
+constexpr u64 kNullBlob         = ~0ull;
+
+enum class eSceneSection : u32
+{
+	Tag,
+	Transform,
+	StaticMesh,
+	Material,
+	MaterialLayer,
+	Light,
+	Atmosphere,
+	Cloud,
+	PostProcess,
+	VoxelTerrain,
+	Strings,
+	Geometry,
+
+	Count
+};
+constexpr u32 kNumSceneSections = static_cast< u32 >(eSceneSection::Count);
+
+struct SceneFileHeader
+{
+	u32 magic;
+	u32 version;
+	u32 numEntities;
+	u32 reserved;
+
+	struct
+	{
+		u64 offset; // from the start of the file
+		u64 size;
+	} sections[kNumSceneSections];
+};
+
+struct StringRef
+{
+	u32 offset = 0; // into the string section
+	u32 length = 0;
+};
+
+//-------------------------------------------------------------------------
+// Records : one per component, 'entity' indexes the file's entity list
+//-------------------------------------------------------------------------
+struct TagRecord
+{
+	u32       entity;
+	StringRef tag;
+};
+
+struct TransformRecord
+{
+	u32       entity;
+	Transform transform;
+
+	// entity indices, kInvalidIndex for none
+	u32 parent;
+	u32 firstChild;
+	u32 lastChild;
+	u32 prevSibling;
+	u32 nextSibling;
+	i32 depth;
+};
+
+struct StaticMeshRecord
+{
+	u32       entity;
+	StringRef tag;
+	StringRef path;
+
+	float3 aabbMin;
+	float3 aabbMax;
+	float3 sphereCenter;
+	float  sphereRadius;
+
+	// offsets into the geometry section, kNullBlob for none
+	u64 vertices;
+	u32 numVertices;
+	u32 maxLOD;
+
+	struct
+	{
+		u64 indices;
+		u64 meshlets;
+		u64 meshletVertices;
+		u64 meshletTriangles;
+
+		u32 numIndices;
+		u32 numMeshlets;
+		u32 numMeshletVertices;
+		u32 numMeshletTriangles;
+
+		float simplifyError;
+	} lods[LOD_COUNT];
+};
+
+struct MaterialRecord
+{
+	u32 entity;
+	u32 firstLayer; // into the material layer section
+	u32 numLayers;
+	u32 bFaceNormals;
+};
+
+constexpr std::string MaterialData::* kMaterialTextures[] =
+{
+	&MaterialData::albedoTex,
+	&MaterialData::normalTex,
+	&MaterialData::aoTex,
+	&MaterialData::roughnessTex,
+	&MaterialData::metallicTex,
+	&MaterialData::emissionTex,
+	&MaterialData::clearcoatTex,
+	&MaterialData::sheenTex,
+	&MaterialData::anisotropyTex,
+	&MaterialData::subsurfaceTex,
+	&MaterialData::transmissionTex,
+};
+constexpr u32 kNumMaterialTextures = static_cast< u32 >(std::size(kMaterialTextures));
+
+// member names follow MaterialLayer, see CopyLayerValues
+struct MaterialLayerRecord
+{
+	struct
+	{
+		StringRef name;
+
+		float4 tint;
+
+		float metallic;
+		float roughness;
+		float ior;
+
+		float alphaCutoff;
+		float clearcoat;
+		float clearcoatRoughness;
+
+		float anisotropy;
+		float anisotropyRotation;
+
+		float3 specularColor;
+		float  specularStrength;
+
+		float3 sheenColor;
+		float  sheenRoughness;
+
+		float3 emissionColor;
+		float  emissivePower;
+
+		float subsurface;
+		float transmission;
+		u32   materialType;
+		u32   materialFlags;
+
+		eMaterialTextureChannel roughnessTexChannel;
+		eMaterialTextureChannel metallicTexChannel;
+
+		StringRef textures[kNumMaterialTextures]; // kMaterialTextures order
+	} material;
+
+	float3 sigmaA;
+	float  thickness;
+
+	float3 sigmaS;
+	float  phaseG;
+};
+
+struct LightRecord
+{
+	u32            entity;
+	LightComponent light;
+};
+static_assert(std::is_trivially_copyable_v< LightComponent >);
+
+// member names follow AtmosphereComponent, see CopyAtmosphereValues
+struct AtmosphereRecord
+{
+	u32 entity;
+
+	float planetRadiusKm;
+	float atmosphereRadiusKm;
+
+	float3 rayleighScattering;
+	float  rayleighDensityKm;
+
+	float mieScattering;
+	float mieAbsorption;
+	float mieDensityKm;
+	float miePhaseG;
+
+	float3 ozoneAbsorption;
+	float  ozoneCenterKm;
+	float  ozoneWidthKm;
+
+	eRaymarchResolution raymarchResolution;
+
+	StringRef skybox;
+};
+
+// member names follow CloudComponent, see CopyCloudValues
+struct CloudRecord
+{
+	u32 entity;
+
+	float bottomHeightKm;
+	float layerThicknessKm;
+	float shadowTracingDistanceMultiplier;
+	float groundContributionStrength;
+
+	float floorVariationClear;
+	float floorVariationCloudy;
+	float cloudsMacroUvScale;
+	float cloudsCoverage;
+	float clumpsVariation;
+
+	float baseDensity;
+	float baseErosionScale;
+	float baseErosionPower;
+	float baseErosionStrength;
+	float hfErosionStrength;
+	float hfErosionDistortion;
+
+	float extinctionScale;
+	float msContribution;
+	float msOcclusion;
+	float ambientIntensity;
+
+	float3 windDirection;
+	float  windSpeedMps;
+
+	eCloudUprezRatio uprezRatio;
+
+	i32   numCloudRaymarchSteps;
+	i32   numLightRaymarchSteps;
+	float frontDepthBias;
+	float temporalBlendAlpha;
+
+	StringRef blueNoiseTex;
+	StringRef weatherMap;
+	StringRef curlNoiseTex;
+};
+
+struct PostProcessRecord
+{
+	u32                  entity;
+	PostProcessComponent postProcess;
+};
+static_assert(std::is_trivially_copyable_v< PostProcessComponent >);
+
+struct VoxelTerrainRecord
+{
+	u32                   entity;
+	VoxelTerrainComponent terrain;
+};
+static_assert(std::is_trivially_copyable_v< VoxelTerrainComponent >);
+static_assert(std::is_trivially_copyable_v< Transform >);
+
+//-------------------------------------------------------------------------
+// Value copies shared by save (record <- component) and load (component <- record)
+//-------------------------------------------------------------------------
+template< typename TDst, typename TSrc >
+void CopyLayerValues(TDst& dst, const TSrc& src)
+{
+	dst.material.tint               = src.material.tint;
+	dst.material.metallic           = src.material.metallic;
+	dst.material.roughness          = src.material.roughness;
+	dst.material.ior                = src.material.ior;
+	dst.material.alphaCutoff        = src.material.alphaCutoff;
+	dst.material.clearcoat          = src.material.clearcoat;
+	dst.material.clearcoatRoughness = src.material.clearcoatRoughness;
+	dst.material.anisotropy         = src.material.anisotropy;
+	dst.material.anisotropyRotation = src.material.anisotropyRotation;
+	dst.material.specularColor      = src.material.specularColor;
+	dst.material.specularStrength   = src.material.specularStrength;
+	dst.material.sheenColor         = src.material.sheenColor;
+	dst.material.sheenRoughness     = src.material.sheenRoughness;
+	dst.material.emissionColor      = src.material.emissionColor;
+	dst.material.emissivePower      = src.material.emissivePower;
+	dst.material.subsurface         = src.material.subsurface;
+	dst.material.transmission       = src.material.transmission;
+	dst.material.materialType       = src.material.materialType;
+	dst.material.materialFlags      = src.material.materialFlags;
+
+	dst.material.roughnessTexChannel = src.material.roughnessTexChannel;
+	dst.material.metallicTexChannel  = src.material.metallicTexChannel;
+
+	dst.sigmaA    = src.sigmaA;
+	dst.thickness = src.thickness;
+	dst.sigmaS    = src.sigmaS;
+	dst.phaseG    = src.phaseG;
+}
+
+template< typename TDst, typename TSrc >
+void CopyAtmosphereValues(TDst& dst, const TSrc& src)
+{
+	dst.planetRadiusKm     = src.planetRadiusKm;
+	dst.atmosphereRadiusKm = src.atmosphereRadiusKm;
+	dst.rayleighScattering = src.rayleighScattering;
+	dst.rayleighDensityKm  = src.rayleighDensityKm;
+	dst.mieScattering      = src.mieScattering;
+	dst.mieAbsorption      = src.mieAbsorption;
+	dst.mieDensityKm       = src.mieDensityKm;
+	dst.miePhaseG          = src.miePhaseG;
+	dst.ozoneAbsorption    = src.ozoneAbsorption;
+	dst.ozoneCenterKm      = src.ozoneCenterKm;
+	dst.ozoneWidthKm       = src.ozoneWidthKm;
+	dst.raymarchResolution = src.raymarchResolution;
+}
+
+template< typename TDst, typename TSrc >
+void CopyCloudValues(TDst& dst, const TSrc& src)
+{
+	dst.bottomHeightKm                  = src.bottomHeightKm;
+	dst.layerThicknessKm                = src.layerThicknessKm;
+	dst.shadowTracingDistanceMultiplier = src.shadowTracingDistanceMultiplier;
+	dst.groundContributionStrength      = src.groundContributionStrength;
+	dst.floorVariationClear             = src.floorVariationClear;
+	dst.floorVariationCloudy            = src.floorVariationCloudy;
+	dst.cloudsMacroUvScale              = src.cloudsMacroUvScale;
+	dst.cloudsCoverage                  = src.cloudsCoverage;
+	dst.clumpsVariation                 = src.clumpsVariation;
+	dst.baseDensity                     = src.baseDensity;
+	dst.baseErosionScale                = src.baseErosionScale;
+	dst.baseErosionPower                = src.baseErosionPower;
+	dst.baseErosionStrength             = src.baseErosionStrength;
+	dst.hfErosionStrength               = src.hfErosionStrength;
+	dst.hfErosionDistortion             = src.hfErosionDistortion;
+	dst.extinctionScale                 = src.extinctionScale;
+	dst.msContribution                  = src.msContribution;
+	dst.msOcclusion                     = src.msOcclusion;
+	dst.ambientIntensity                = src.ambientIntensity;
+	dst.windDirection                   = src.windDirection;
+	dst.windSpeedMps                    = src.windSpeedMps;
+	dst.uprezRatio                      = src.uprezRatio;
+	dst.numCloudRaymarchSteps           = src.numCloudRaymarchSteps;
+	dst.numLightRaymarchSteps           = src.numLightRaymarchSteps;
+	dst.frontDepthBias                  = src.frontDepthBias;
+	dst.temporalBlendAlpha              = src.temporalBlendAlpha;
+}
+
+u64 AlignUp(u64 value, u64 alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+//-------------------------------------------------------------------------
+// Save helpers
+//-------------------------------------------------------------------------
+class SceneWriter
+{
+public:
+	StringRef AddString(const std::string& str)
+	{
+		if (str.empty())
+			return {};
+
+		if (auto it = m_StringOffsets.find(str); it != m_StringOffsets.end())
+			return { it->second, static_cast< u32 >(str.size()) };
+
+		const u32 offset = static_cast< u32 >(m_Strings.size());
+		m_Strings.insert(m_Strings.end(), str.begin(), str.end());
+		m_StringOffsets.emplace(str, offset);
+
+		return { offset, static_cast< u32 >(str.size()) };
+	}
+
+	// geometry shared between entities (cloned imports) is stored once
+	template< typename T >
+	u64 AddBlob(const T* pData, u32 count)
+	{
+		if (!pData || count == 0)
+			return kNullBlob;
+
+		if (auto it = m_BlobOffsets.find(pData); it != m_BlobOffsets.end())
+			return it->second;
+
+		const u64 offset = AlignUp(m_Geometry.size(), kSectionAlignment);
+		const u64 size   = sizeof(T) * count;
+		m_Geometry.resize(offset + size);
+		memcpy(m_Geometry.data() + offset, pData, size);
+
+		m_BlobOffsets.emplace(pData, offset);
+		return offset;
+	}
+
+	const std::vector< char >& Strings() const { return m_Strings; }
+	const std::vector< u8 >& Geometry() const { return m_Geometry; }
+
+private:
+	std::vector< char >                     m_Strings;
+	std::unordered_map< std::string, u32 >  m_StringOffsets;
+	std::vector< u8 >                       m_Geometry;
+	std::unordered_map< const void*, u64 >  m_BlobOffsets;
+};
+
+// hierarchy pre-order, so parents always come before their children
+std::vector< entt::entity > CollectEntities(const entt::registry& registry)
+{
+	std::vector< entt::entity > entities;
+	entities.reserve(registry.view< TransformComponent >().size());
+
+	std::vector< entt::entity > stack;
+	for (auto root : registry.view< RootComponent, TransformComponent >())
+	{
+		stack.push_back(root);
+		while (!stack.empty())
+		{
+			const entt::entity entity = stack.back();
+			stack.pop_back();
+			entities.push_back(entity);
+
+			// pushed last-to-first so siblings keep their order
+			for (auto child = registry.get< TransformComponent >(entity).hierarchy.lastChild; child != entt::null;
+				child = registry.get< TransformComponent >(child).hierarchy.prevSibling)
+			{
+				stack.push_back(child);
+			}
+		}
+	}
+
+	for (auto entity : registry.view< TagComponent >(entt::exclude< TransformComponent >))
+		entities.push_back(entity);
+
+	return entities;
+}
+
+//-------------------------------------------------------------------------
+// Load helpers
+//-------------------------------------------------------------------------
+template< typename TRecord >
+std::span< const TRecord > GetSection(const u8* pBase, const SceneFileHeader& header, eSceneSection section)
+{
+	const auto& entry = header.sections[static_cast< u32 >(section)];
+	return { reinterpret_cast< const TRecord* >(pBase + entry.offset), static_cast< size_t >(entry.size / sizeof(TRecord)) };
+}
+
+template< typename T >
+T* GetBlob(u8* pGeometry, u64 offset)
+{
+	return offset != kNullBlob ? reinterpret_cast< T* >(pGeometry + offset) : nullptr;
+}
+
+// What a file may address. Load checks every record against it before touching the registry,
+// so a truncated or corrupt file is rejected instead of read out of bounds.
+struct SceneFileBounds
+{
+	u32 numEntities  = 0;
+	u64 stringsSize  = 0;
+	u64 geometrySize = 0;
+
+	bool Entity(u32 index) const { return index < numEntities; }
+	bool EntityOrNone(u32 index) const { return !IsValidIndex(index) || index < numEntities; }
+	bool String(StringRef ref) const { return u64(ref.offset) + ref.length <= stringsSize; }
+
+	template< typename T >
+	bool Blob(u64 offset, u32 count) const
+	{
+		return offset == kNullBlob
+			|| (offset % alignof(T) == 0 && offset <= geometrySize && u64(count) * sizeof(T) <= geometrySize - offset);
+	}
+};
+
+// Every record must name a distinct entity of the file and pass 'validate'
+template< typename TRecord, typename Fn >
+bool ValidateRecords(std::span< const TRecord > records, const SceneFileBounds& bounds, std::vector< u8 >& owned, Fn&& validate)
+{
+	owned.assign(bounds.numEntities, 0);
+	for (const auto& record : records)
+	{
+		if (!bounds.Entity(record.entity) || owned[record.entity]++ || !validate(record))
+			return false;
+	}
+	return true;
+}
+
+// The links must describe a forest: roots have no siblings, every child list runs from first to
+// last child with matching back links and parents, and walking down from the roots reaches each
+// transform exactly once. That leaves no cycles and nothing the transform system could not walk.
+// Record entity indices are validated and distinct by the time this runs.
+bool ValidateHierarchy(std::span< const TransformRecord > transforms, u32 numEntities)
+{
+	std::vector< const TransformRecord* > byEntity(numEntities, nullptr);
+	for (const auto& record : transforms)
+		byEntity[record.entity] = &record;
+
+	std::vector< u32 > stack;
+	for (const auto& record : transforms)
+	{
+		if (IsValidIndex(record.parent))
+			continue;
+
+		if (IsValidIndex(record.prevSibling) || IsValidIndex(record.nextSibling))
+			return false;
+		stack.push_back(record.entity);
+	}
+
+	size_t numReached = stack.size();
+	while (!stack.empty())
+	{
+		const u32 entity = stack.back();
+		stack.pop_back();
+
+		u32 prevChild = kInvalidIndex;
+		for (u32 child = byEntity[entity]->firstChild; IsValidIndex(child); child = byEntity[child]->nextSibling)
+		{
+			const TransformRecord* pChild = byEntity[child];
+			if (!pChild || pChild->parent != entity || pChild->prevSibling != prevChild || ++numReached > transforms.size())
+				return false;
+
+			stack.push_back(child);
+			prevChild = child;
+		}
+
+		if (byEntity[entity]->lastChild != prevChild)
+			return false;
+	}
+	return numReached == transforms.size();
+}
+
+// Bulk-inserts TComponent for the records' entities. Systems apply their defaults on construct,
+// so the stored values are written afterwards, in place, without raising another signal.
+template< typename TComponent, typename TRecord, typename Fn >
+void InsertComponents(entt::registry& registry, const std::vector< entt::entity >& entities, std::span< const TRecord > records, Fn&& fill)
+{
+	if (records.empty())
+		return;
+
+	// entity indices are validated by Load
+	std::vector< entt::entity > owners;
+	owners.reserve(records.size());
+	for (const auto& record : records)
+		owners.push_back(entities[record.entity]);
+
+	registry.insert< TComponent >(owners.begin(), owners.end());
+
+	for (size_t i = 0; i < records.size(); ++i)
+		fill(registry.get< TComponent >(owners[i]), records[i]);
+}
+
+} // anonymous namespace
+
+
+//-------------------------------------------------------------------------
+// MappedSceneFile
+//-------------------------------------------------------------------------
+MappedSceneFile::~MappedSceneFile()
+{
+#ifdef _WIN32
+	if (m_pData)
+		UnmapViewOfFile(m_pData);
+	if (m_hMapping)
+		CloseHandle(m_hMapping);
+	if (m_hFile && m_hFile != INVALID_HANDLE_VALUE)
+		CloseHandle(m_hFile);
+#else
+	if (m_pData)
+		munmap(m_pData, m_Size);
+#endif
+}
+
+std::unique_ptr< MappedSceneFile > MappedSceneFile::Open(const fs::path& filepath)
+{
+	std::unique_ptr< MappedSceneFile > pFile(new MappedSceneFile());
+
+#ifdef _WIN32
+	pFile->m_hFile = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (pFile->m_hFile == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(pFile->m_hFile, &fileSize) || fileSize.QuadPart == 0)
+		return nullptr;
+	pFile->m_Size = static_cast< u64 >(fileSize.QuadPart);
+
+	// copy-on-write: loaded components hold non-const pointers into the view
+	pFile->m_hMapping = CreateFileMappingW(pFile->m_hFile, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	if (!pFile->m_hMapping)
+		return nullptr;
+
+	pFile->m_pData = static_cast< u8* >(MapViewOfFile(pFile->m_hMapping, FILE_MAP_COPY, 0, 0, 0));
+#else
+	const int fd = open(filepath.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	struct stat fileStat = {};
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		close(fd);
+		return nullptr;
+	}
+	pFile->m_Size = static_cast< u64 >(fileStat.st_size);
+
+	// copy-on-write: loaded components hold non-const pointers into the view
+	void* pData = mmap(nullptr, pFile->m_Size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	pFile->m_pData = pData != MAP_FAILED ? static_cast< u8* >(pData) : nullptr;
+#endif
+
+	return pFile->m_pData ? std::move(pFile) : nullptr;
+}
+
+
+//-------------------------------------------------------------------------
+// SceneSerializer
+//-------------------------------------------------------------------------
+bool SceneSerializer::Save(const Scene& scene, const fs::path& filepath)
+{
+	const auto& registry = scene.Registry();
+
+	const std::vector< entt::entity > entities = CollectEntities(registry);
+
+	std::unordered_map< entt::entity, u32 > entityIndices;
+	entityIndices.reserve(entities.size());
+	for (u32 i = 0; i < static_cast< u32 >(entities.size()); ++i)
+		entityIndices.emplace(entities[i], i);
+
+	auto toIndex = [&entityIndices](entt::entity entity)
+		{
+			auto it = entityIndices.find(entity);
+			return it != entityIndices.end() ? it->second : kInvalidIndex;
+		};
+
+	SceneWriter writer;
+
+	std::vector< TagRecord >           tags;
+	std::vector< TransformRecord >     transforms;
+	std::vector< StaticMeshRecord >    meshes;
+	std::vector< MaterialRecord >      materials;
+	std::vector< MaterialLayerRecord > materialLayers;
+	std::vector< LightRecord >         lights;
+	std::vector< AtmosphereRecord >    atmospheres;
+	std::vector< CloudRecord >         clouds;
+	std::vector< PostProcessRecord >   postProcesses;
+	std::vector< VoxelTerrainRecord >  terrains;
+
+	for (u32 index = 0; index < static_cast< u32 >(entities.size()); ++index)
+	{
+		const entt::entity entity = entities[index];
+
+		if (auto pTag = registry.try_get< TagComponent >(entity))
+		{
+			tags.push_back({ .entity = index, .tag = writer.AddString(pTag->tag) });
+		}
+
+		if (auto pTransform = registry.try_get< TransformComponent >(entity))
+		{
+			const auto& hierarchy = pTransform->hierarchy;
+			transforms.push_back({
+				.entity      = index,
+				.transform   = pTransform->transform,
+				.parent      = toIndex(hierarchy.parent),
+				.firstChild  = toIndex(hierarchy.firstChild),
+				.lastChild   = toIndex(hierarchy.lastChild),
+				.prevSibling = toIndex(hierarchy.prevSibling),
+				.nextSibling = toIndex(hierarchy.nextSibling),
+				.depth       = hierarchy.depth });
+		}
+
+		if (auto pMesh = registry.try_get< StaticMeshComponent >(entity))
+		{
+			StaticMeshRecord record = {};
+			record.entity       = index;
+			record.tag          = writer.AddString(pMesh->tag);
+			record.path         = writer.AddString(pMesh->path);
+			record.aabbMin      = pMesh->aabb.Min();
+			record.aabbMax      = pMesh->aabb.Max();
+			record.sphereCenter = pMesh->sphere.Center();
+			record.sphereRadius = pMesh->sphere.Radius();
+			record.vertices     = writer.AddBlob(pMesh->pVertices, pMesh->numVertices);
+			record.numVertices  = pMesh->numVertices;
+			record.maxLOD       = pMesh->maxLOD;
+			for (u32 i = 0; i < LOD_COUNT; ++i)
+			{
+				const auto& lod = pMesh->lods[i];
+				auto& lodRecord = record.lods[i];
+
+				lodRecord.indices             = writer.AddBlob(lod.pIndices, lod.numIndices);
+				lodRecord.meshlets            = writer.AddBlob(lod.pMeshlets, lod.numMeshlets);
+				lodRecord.meshletVertices     = writer.AddBlob(lod.pMeshletVertices, lod.numMeshletVertices);
+				lodRecord.meshletTriangles    = writer.AddBlob(lod.pMeshletTriangles, lod.numMeshletTriangles);
+				lodRecord.numIndices          = lod.numIndices;
+				lodRecord.numMeshlets         = lod.numMeshlets;
+				lodRecord.numMeshletVertices  = lod.numMeshletVertices;
+				lodRecord.numMeshletTriangles = lod.numMeshletTriangles;
+				lodRecord.simplifyError       = lod.simplifyError;
+			}
+			meshes.push_back(record);
+		}
+
+		if (auto pMaterial = registry.try_get< MaterialComponent >(entity))
+		{
+			materials.push_back({
+				.entity       = index,
+				.firstLayer   = static_cast< u32 >(materialLayers.size()),
+				.numLayers    = static_cast< u32 >(pMaterial->layers.size()),
+				.bFaceNormals = pMaterial->bFaceNormals ? 1u : 0u });
+
+			for (const auto& layer : pMaterial->layers)
+			{
+				MaterialLayerRecord record = {};
+				CopyLayerValues(record, layer);
+
+				record.material.name = writer.AddString(layer.material.name);
+				for (u32 i = 0; i < kNumMaterialTextures; ++i)
+					record.material.textures[i] = writer.AddString(layer.material.*kMaterialTextures[i]);
+
+				materialLayers.push_back(record);
+			}
+		}
+
+		if (auto pLight = registry.try_get< LightComponent >(entity))
+		{
+			lights.push_back({ .entity = index, .light = *pLight });
+		}
+
+		if (auto pAtmosphere = registry.try_get< AtmosphereComponent >(entity))
+		{
+			AtmosphereRecord record = {};
+			CopyAtmosphereValues(record, *pAtmosphere);
+			record.entity = index;
+			record.skybox = writer.AddString(pAtmosphere->skybox);
+			atmospheres.push_back(record);
+		}
+
+		if (auto pCloud = registry.try_get< CloudComponent >(entity))
+		{
+			CloudRecord record = {};
+			CopyCloudValues(record, *pCloud);
+			record.entity       = index;
+			record.blueNoiseTex = writer.AddString(pCloud->blueNoiseTex);
+			record.weatherMap   = writer.AddString(pCloud->weatherMap);
+			record.curlNoiseTex = writer.AddString(pCloud->curlNoiseTex);
+			clouds.push_back(record);
+		}
+
+		if (auto pPostProcess = registry.try_get< PostProcessComponent >(entity))
+		{
+			postProcesses.push_back({ .entity = index, .postProcess = *pPostProcess });
+		}
+
+		if (auto pTerrain = registry.try_get< VoxelTerrainComponent >(entity))
+		{
+			terrains.push_back({ .entity = index, .terrain = *pTerrain });
+		}
+	}
+
+	// layout : header | sections, each aligned to kSectionAlignment
+	struct SectionData
+	{
+		const void* pData = nullptr;
+		u64         size  = 0;
+	} sectionData[kNumSceneSections];
+
+	auto setSection = [&sectionData]< typename T >(eSceneSection section, const std::vector< T >& data)
+		{
+			sectionData[static_cast< u32 >(section)] = { data.data(), sizeof(T) * data.size() };
+		};
+	setSection(eSceneSection::Tag, tags);
+	setSection(eSceneSection::Transform, transforms);
+	setSection(eSceneSection::StaticMesh, meshes);
+	setSection(eSceneSection::Material, materials);
+	setSection(eSceneSection::MaterialLayer, materialLayers);
+	setSection(eSceneSection::Light, lights);
+	setSection(eSceneSection::Atmosphere, atmospheres);
+	setSection(eSceneSection::Cloud, clouds);
+	setSection(eSceneSection::PostProcess, postProcesses);
+	setSection(eSceneSection::VoxelTerrain, terrains);
+	setSection(eSceneSection::Strings, writer.Strings());
+	setSection(eSceneSection::Geometry, writer.Geometry());
+
+	SceneFileHeader header = {};
+	header.magic       = kSceneFileMagic;
+	header.version     = kSceneFileVersion;
+	header.numEntities = static_cast< u32 >(entities.size());
+
+	u64 offset = AlignUp(sizeof(SceneFileHeader), kSectionAlignment);
+	for (u32 i = 0; i < kNumSceneSections; ++i)
+	{
+		header.sections[i] = { offset, sectionData[i].size };
+		offset = AlignUp(offset + sectionData[i].size, kSectionAlignment);
+	}
+
+	if (filepath.has_parent_path())
+		fs::create_directories(filepath.parent_path());
+
+	std::ofstream file(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		fprintf(stderr, "[Scene] failed to open '%s' for writing\n", filepath.string().c_str());
+		return false;
+	}
+
+	const char padding[kSectionAlignment] = {};
+	auto writeAligned = [&file, &padding](const void* pData, u64 size)
+		{
+			file.write(static_cast< const char* >(pData), static_cast< std::streamsize >(size));
+			file.write(padding, static_cast< std::streamsize >(AlignUp(size, kSectionAlignment) - size));
+		};
+
+	writeAligned(&header, sizeof(header));
+	for (u32 i = 0; i < kNumSceneSections; ++i)
+		writeAligned(sectionData[i].pData, sectionData[i].size);
+
+	if (!file)
+	{
+		fprintf(stderr, "[Scene] failed to write '%s'\n", filepath.string().c_str());
+		return false;
+	}
+
+	printf("[Scene] saved '%s': %zu entities, %llu bytes\n", filepath.string().c_str(), entities.size(), offset);
+	return true;
+}
+
+bool SceneSerializer::Load(Scene& scene, const fs::path& filepath)
+{
+	const auto beginTime = std::chrono::steady_clock::now();
+
+	auto pFile = MappedSceneFile::Open(filepath);
+	if (!pFile)
+	{
+		fprintf(stderr, "[Scene] failed to map '%s'\n", filepath.string().c_str());
+		return false;
+	}
+
+	u8* pBase = pFile->Data();
+	if (pFile->Size() < sizeof(SceneFileHeader))
+	{
+		fprintf(stderr, "[Scene] '%s' is truncated\n", filepath.string().c_str());
+		return false;
+	}
+
+	const auto& header = *reinterpret_cast< const SceneFileHeader* >(pBase);
+	if (header.magic != kSceneFileMagic)
+	{
+		fprintf(stderr, "[Scene] '%s' is not a scene file\n", filepath.string().c_str());
+		return false;
+	}
+	if (header.version != kSceneFileVersion)
+	{
+		fprintf(stderr, "[Scene] '%s' has version %u, expected %u\n", filepath.string().c_str(), header.version, kSceneFileVersion);
+		return false;
+	}
+
+	for (const auto& section : header.sections)
+	{
+		if (section.offset > pFile->Size() || section.size > pFile->Size() - section.offset)
+		{
+			fprintf(stderr, "[Scene] '%s' is truncated\n", filepath.string().c_str());
+			return false;
+		}
+		if (section.offset % kSectionAlignment != 0)
+		{
+			fprintf(stderr, "[Scene] '%s' has a misaligned section\n", filepath.string().c_str());
+			return false;
+		}
+	}
+
+	const auto tags           = GetSection< TagRecord >(pBase, header, eSceneSection::Tag);
+	const auto transforms     = GetSection< TransformRecord >(pBase, header, eSceneSection::Transform);
+	const auto meshes         = GetSection< StaticMeshRecord >(pBase, header, eSceneSection::StaticMesh);
+	const auto materials      = GetSection< MaterialRecord >(pBase, header, eSceneSection::Material);
+	const auto materialLayers = GetSection< MaterialLayerRecord >(pBase, header, eSceneSection::MaterialLayer);
+	const auto lights         = GetSection< LightRecord >(pBase, header, eSceneSection::Light);
+	const auto atmospheres    = GetSection< AtmosphereRecord >(pBase, header, eSceneSection::Atmosphere);
+	const auto clouds         = GetSection< CloudRecord >(pBase, header, eSceneSection::Cloud);
+	const auto postProcesses  = GetSection< PostProcessRecord >(pBase, header, eSceneSection::PostProcess);
+	const auto terrains       = GetSection< VoxelTerrainRecord >(pBase, header, eSceneSection::VoxelTerrain);
+
+	// every saved entity has a tag or a transform
+	if (header.numEntities > tags.size() + transforms.size())
+	{
+		fprintf(stderr, "[Scene] '%s' claims %u entities but has records for at most %zu\n",
+			filepath.string().c_str(), header.numEntities, tags.size() + transforms.size());
+		return false;
+	}
+
+	const SceneFileBounds bounds = {
+		.numEntities  = header.numEntities,
+		.stringsSize  = header.sections[static_cast< u32 >(eSceneSection::Strings)].size,
+		.geometrySize = header.sections[static_cast< u32 >(eSceneSection::Geometry)].size,
+	};
+
+	auto isValidMesh = [&bounds](const StaticMeshRecord& record)
+		{
+			if (!bounds.String(record.tag) || !bounds.String(record.path) || record.maxLOD >= LOD_COUNT
+				|| !bounds.Blob< Vertex >(record.vertices, record.numVertices))
+				return false;
+
+			for (const auto& lod : record.lods)
+			{
+				if (!bounds.Blob< Index >(lod.indices, lod.numIndices)
+					|| !bounds.Blob< Meshlet >(lod.meshlets, lod.numMeshlets)
+					|| !bounds.Blob< u32 >(lod.meshletVertices, lod.numMeshletVertices)
+					|| !bounds.Blob< u32 >(lod.meshletTriangles, lod.numMeshletTriangles))
+					return false;
+			}
+			return true;
+		};
+	auto isValidLayer = [&bounds](const MaterialLayerRecord& record)
+		{
+			if (!bounds.String(record.material.name))
+				return false;
+			for (const auto& texture : record.material.textures)
+			{
+				if (!bounds.String(texture))
+					return false;
+			}
+			return true;
+		};
+	auto any = [](const auto&) { return true; };
+
+	std::vector< u8 > owned;
+	const char* pCorruptSection = nullptr;
+	if (!ValidateRecords(tags, bounds, owned, [&bounds](const TagRecord& record) { return bounds.String(record.tag); }))
+		pCorruptSection = "tag";
+	else if (!ValidateRecords(transforms, bounds, owned, [&bounds](const TransformRecord& record)
+		{
+			return bounds.EntityOrNone(record.parent) && bounds.EntityOrNone(record.firstChild) && bounds.EntityOrNone(record.lastChild)
+				&& bounds.EntityOrNone(record.prevSibling) && bounds.EntityOrNone(record.nextSibling);
+		}))
+		pCorruptSection = "transform";
+	else if (!ValidateRecords(meshes, bounds, owned, isValidMesh))
+		pCorruptSection = "static mesh";
+	else if (!ValidateRecords(materials, bounds, owned, [&materialLayers](const MaterialRecord& record)
+		{
+			return u64(record.firstLayer) + record.numLayers <= materialLayers.size();
+		}))
+		pCorruptSection = "material";
+	else if (!std::all_of(materialLayers.begin(), materialLayers.end(), isValidLayer))
+		pCorruptSection = "material layer";
+	else if (!ValidateRecords(lights, bounds, owned, any))
+		pCorruptSection = "light";
+	else if (!ValidateRecords(atmospheres, bounds, owned, [&bounds](const AtmosphereRecord& record) { return bounds.String(record.skybox); }))
+		pCorruptSection = "atmosphere";
+	else if (!ValidateRecords(clouds, bounds, owned, [&bounds](const CloudRecord& record)
+		{
+			return bounds.String(record.blueNoiseTex) && bounds.String(record.weatherMap) && bounds.String(record.curlNoiseTex);
+		}))
+		pCorruptSection = "cloud";
+	else if (!ValidateRecords(postProcesses, bounds, owned, any))
+		pCorruptSection = "post process";
+	else if (!ValidateRecords(terrains, bounds, owned, any))
+		pCorruptSection = "voxel terrain";
+
+	if (pCorruptSection)
+	{
+		fprintf(stderr, "[Scene] '%s' is corrupt: a %s record is out of range\n", filepath.string().c_str(), pCorruptSection);
+		return false;
+	}
+	if (!ValidateHierarchy(transforms, header.numEntities))
+	{
+		fprintf(stderr, "[Scene] '%s' is corrupt: its hierarchy links do not form a tree\n", filepath.string().c_str());
+		return false;
+	}
+
+	const char* pStrings  = reinterpret_cast< const char* >(pBase + header.sections[static_cast< u32 >(eSceneSection::Strings)].offset);
+	u8*         pGeometry = pBase + header.sections[static_cast< u32 >(eSceneSection::Geometry)].offset;
+
+	auto getString = [pStrings](StringRef ref) { return std::string(pStrings + ref.offset, ref.length); };
+
+	auto& registry = scene.m_Registry;
+
+	std::vector< entt::entity > entities(header.numEntities);
+	registry.create(entities.begin(), entities.end());
+
+	auto toEntity = [&entities](u32 index) { return IsValidIndex(index) ? entities[index] : entt::entity{ entt::null }; };
+
+	InsertComponents< TagComponent >(registry, entities, tags,
+		[&](TagComponent& component, const TagRecord& record)
+		{
+			component.tag = getString(record.tag);
+		});
+
+	// world index comes from construction, the hierarchy arrives already linked
+	std::vector< entt::entity > children;
+	InsertComponents< TransformComponent >(registry, entities, transforms,
+		[&](TransformComponent& component, const TransformRecord& record)
+		{
+			component.transform = record.transform;
+
+			auto& hierarchy = component.hierarchy;
+			hierarchy.parent      = toEntity(record.parent);
+			hierarchy.firstChild  = toEntity(record.firstChild);
+			hierarchy.lastChild   = toEntity(record.lastChild);
+			hierarchy.prevSibling = toEntity(record.prevSibling);
+			hierarchy.nextSibling = toEntity(record.nextSibling);
+			hierarchy.depth       = record.depth;
+
+			if (hierarchy.parent != entt::null)
+				children.push_back(entities[record.entity]);
+		});
+	registry.remove< RootComponent >(children.begin(), children.end());
+
+	// geometry stays in the mapping, the scene keeps the file alive
+	InsertComponents< StaticMeshComponent >(registry, entities, meshes,
+		[&](StaticMeshComponent& component, const StaticMeshRecord& record)
+		{
+			component.tag    = getString(record.tag);
+			component.path   = getString(record.path);
+			component.aabb   = BoundingBox(record.aabbMin, record.aabbMax);
+			component.sphere = BoundingSphere(record.sphereCenter, record.sphereRadius);
+
+			component.pVertices   = GetBlob< Vertex >(pGeometry, record.vertices);
+			component.numVertices = record.numVertices;
+			component.maxLOD      = static_cast< u8 >(record.maxLOD);
+			for (u32 i = 0; i < LOD_COUNT; ++i)
+			{
+				const auto& lodRecord = record.lods[i];
+				auto& lod = component.lods[i];
+
+				lod.pIndices            = GetBlob< Index >(pGeometry, lodRecord.indices);
+				lod.numIndices          = lodRecord.numIndices;
+				lod.pMeshlets           = GetBlob< Meshlet >(pGeometry, lodRecord.meshlets);
+				lod.numMeshlets         = lodRecord.numMeshlets;
+				lod.pMeshletVertices    = GetBlob< u32 >(pGeometry, lodRecord.meshletVertices);
+				lod.numMeshletVertices  = lodRecord.numMeshletVertices;
+				lod.pMeshletTriangles   = GetBlob< u32 >(pGeometry, lodRecord.meshletTriangles);
+				lod.numMeshletTriangles = lodRecord.numMeshletTriangles;
+				lod.simplifyError       = lodRecord.simplifyError;
+			}
+		});
+
+	InsertComponents< MaterialComponent >(registry, entities, materials,
+		[&](MaterialComponent& component, const MaterialRecord& record)
+		{
+			component.bFaceNormals = record.bFaceNormals != 0;
+			component.layers.resize(record.numLayers);
+			for (u32 i = 0; i < record.numLayers; ++i)
+			{
+				const auto& layerRecord = materialLayers[record.firstLayer + i];
+				auto& layer = component.layers[i];
+
+				CopyLayerValues(layer, layerRecord);
+				layer.material.name = getString(layerRecord.material.name);
+				for (u32 t = 0; t < kNumMaterialTextures; ++t)
+					layer.material.*kMaterialTextures[t] = getString(layerRecord.material.textures[t]);
+			}
+		});
+
+	InsertComponents< LightComponent >(registry, entities, lights,
+		[](LightComponent& component, const LightRecord& record)
+		{
+			component = record.light;
+		});
+
+	InsertComponents< AtmosphereComponent >(registry, entities, atmospheres,
+		[&](AtmosphereComponent& component, const AtmosphereRecord& record)
+		{
+			CopyAtmosphereValues(component, record);
+			component.skybox = getString(record.skybox);
+		});
+
+	InsertComponents< CloudComponent >(registry, entities, clouds,
+		[&](CloudComponent& component, const CloudRecord& record)
+		{
+			CopyCloudValues(component, record);
+			component.blueNoiseTex = getString(record.blueNoiseTex);
+			component.weatherMap   = getString(record.weatherMap);
+			component.curlNoiseTex = getString(record.curlNoiseTex);
+			component.bDirtyMark   = true;
+		});
+
+	InsertComponents< PostProcessComponent >(registry, entities, postProcesses,
+		[](PostProcessComponent& component, const PostProcessRecord& record)
+		{
+			component = record.postProcess;
+		});
+
+	InsertComponents< VoxelTerrainComponent >(registry, entities, terrains,
+		[](VoxelTerrainComponent& component, const VoxelTerrainRecord& record)
+		{
+			component = record.terrain;
+		});
+
+	scene.m_SceneFiles.push_back(std::move(pFile));
+
+	const double elapsedMs = std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - beginTime).count();
+	printf("[Scene] loaded '%s': %u entities in %.2f ms\n", filepath.string().c_str(), header.numEntities, elapsedMs);
+	return true;
+}
+
+} // namespace baamboo
@@ -0,0 +1,60 @@
+#pragma once
+#include "Primitives.h"
+#include "Defines.h"
+
+#include <memory>
+
+namespace baamboo
+{
+
+class Scene;
+
+//-------------------------------------------------------------------------
+// MappedSceneFile : scene file mapped copy-on-write into memory.
+// Loaded mesh components point into the mapping, so the scene keeps it alive.
+//-------------------------------------------------------------------------
+class MappedSceneFile
+{
+public:
+	~MappedSceneFile();
+
+	static std::unique_ptr< MappedSceneFile > Open(const fs::path& filepath);
+
+	u8* Data() const { return m_pData; }
+	u64 Size() const { return m_Size; }
+
+private:
+	MappedSceneFile() = default;
+
+	u8* m_pData = nullptr;
+	u64 m_Size  = 0;
+
+#ifdef _WIN32
+	void* m_hFile    = nullptr;
+	void* m_hMapping = nullptr;
+#endif
+};
+
+// =========================================================================
+// SceneSerializer — versioned binary snapshot of a scene's registry.
+//
+//   Entities are stored in hierarchy pre-order and referenced by index. Each
+//   component type is one section of fixed-size records, strings live in one
+//   shared table and mesh geometry in one deduplicated blob, all addressed by
+//   offsets from the start of the file. Load maps the file, creates every
+//   entity and component in bulk and points mesh components at the mapped
+//   geometry instead of copying it.
+//
+//   Camera, script, dynamic mesh and animation state are not stored: they
+//   reference runtime tables (skeletons, clips) that are rebuilt by import.
+// =========================================================================
+class SceneSerializer
+{
+public:
+	static bool Save(const Scene& scene, const fs::path& filepath);
+
+	// adds the file's entities to 'scene'; existing entities are left untouched
+	static bool Load(Scene& scene, const fs::path& filepath);
+};
+
+} // namespace baamboo
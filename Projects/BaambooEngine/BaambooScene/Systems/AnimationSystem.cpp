@@ -0,0 +1,218 @@
+#include "BaambooPch.h"
+#include "AnimationSystem.h"
+#include "BaambooScene/Scene.h"
+#include "TaskScheduler.hpp"
+
+#include <chrono>
+
+namespace baamboo
+{
+
+namespace
+{
+
+float WrapTime(float time, float duration, bool bLoop)
+{
+	if (duration <= 0.0f)
+		return 0.0f;
+
+	if (!bLoop)
+		return glm::clamp(time, 0.0f, duration);
+
+	time = std::fmod(time, duration);
+	return time < 0.0f ? time + duration : time;
+}
+
+} // anonymous namespace
+
+AnimationSystem::AnimationSystem(entt::registry& registry, const Scene& scene)
+	: Super(registry)
+	, m_Scene(scene)
+{
+}
+
+void AnimationSystem::Update(float dt)
+{
+	const auto beginTime = std::chrono::steady_clock::now();
+
+	// poses are evaluated every frame, change tracking has nothing to add
+	m_DirtyEntities.clear();
+	m_ExpiredEntities.clear();
+
+	m_BlendedEntities.clear();
+	m_SharedPoseKeys.clear();
+	m_SharedPoseSlots.clear();
+
+	// advance playback and bucket single-clip entities by the pose they need;
+	// one that just stopped gets its own pose so it holds after the slot is reused
+	u32 numEntities = 0;
+	auto view = m_Registry.view< AnimationComponent >();
+	for (auto entity : view)
+	{
+		auto& component = view.get< AnimationComponent >(entity);
+		if (!component.bPlaying)
+		{
+			// paused on a shared pose: keep a pose of its own, the slot goes to someone else
+			if (component.sharedPoseIndex != kInvalidIndex)
+			{
+				component.sharedPoseIndex = kInvalidIndex;
+				m_BlendedEntities.push_back(entity);
+			}
+			continue;
+		}
+
+		++numEntities;
+		AdvanceTime(component, dt);
+
+		const bool bHasLayers = std::any_of(component.blendLayers.begin(), component.blendLayers.end(),
+			[](const auto& layer) { return layer.weight > 0.0f; });
+		if (m_PoseCacheRate > 0.0f && component.bPlaying && !bHasLayers && !component.bTransitioning)
+		{
+			const PoseKey key = { component.skeletonID, component.currentClipID, static_cast< u32 >(component.currentTime * m_PoseCacheRate) };
+
+			auto [it, bInserted] = m_SharedPoseSlots.try_emplace(key, static_cast< u32 >(m_SharedPoseKeys.size()));
+			if (bInserted)
+				m_SharedPoseKeys.push_back(key);
+
+			component.sharedPoseIndex = it->second;
+		}
+		else
+		{
+			component.sharedPoseIndex = kInvalidIndex;
+			m_BlendedEntities.push_back(entity);
+		}
+	}
+
+	if (m_SharedPoses.size() < m_SharedPoseKeys.size())
+		m_SharedPoses.resize(m_SharedPoseKeys.size());
+
+	std::atomic< u32 > numBones = 0;
+	TaskScheduler::Inst()->ParallelFor(static_cast< u32 >(m_SharedPoseKeys.size()), [&](u32 slot)
+		{
+			const PoseKey&  key       = m_SharedPoseKeys[slot];
+			const Skeleton* pSkeleton = m_Scene.GetSkeleton(key.skeletonID);
+
+			AnimationPose& pose = m_SharedPoses[slot];
+			if (!pSkeleton || !SampleClip(pose, *pSkeleton, key.clipID, float(key.frame) / m_PoseCacheRate))
+			{
+				pose.mBones.clear();
+				return;
+			}
+			pose.CalculateBoneMatrices(*pSkeleton);
+
+			numBones.fetch_add(pSkeleton->NumBones(), std::memory_order_relaxed);
+		});
+
+	TaskScheduler::Inst()->ParallelFor(static_cast< u32 >(m_BlendedEntities.size()), [&](u32 i)
+		{
+			auto& component = view.get< AnimationComponent >(m_BlendedEntities[i]);
+			EvaluateBlendTree(component, dt);
+
+			numBones.fetch_add(static_cast< u32 >(component.currentPose.mBones.size()), std::memory_order_relaxed);
+		});
+
+	m_Stats.numEntities    = numEntities;
+	m_Stats.numSharedPoses = static_cast< u32 >(m_SharedPoseKeys.size());
+	m_Stats.numBones       = numBones.load();
+	m_Stats.elapsedMs      = std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - beginTime).count();
+}
+
+const std::vector< mat4 >& AnimationSystem::GetBoneMatrices(const AnimationComponent& component) const
+{
+	if (component.sharedPoseIndex < m_SharedPoses.size())
+		return m_SharedPoses[component.sharedPoseIndex].mBones;
+
+	return component.currentPose.mBones;
+}
+
+float AnimationSystem::ClipDuration(u32 clipID) const
+{
+	if (const AnimationClip* pClip = m_Scene.GetAnimationClip(clipID))
+		return pClip->GetDurationInSeconds();
+	if (const CompressedAnimationClip* pCompressed = m_Scene.GetCompressedAnimationClip(clipID))
+		return pCompressed->GetDurationInSeconds();
+	return 0.0f;
+}
+
+bool AnimationSystem::SampleClip(AnimationPose& pose, const Skeleton& skeleton, u32 clipID, float seconds) const
+{
+	if (const AnimationClip* pClip = m_Scene.GetAnimationClip(clipID))
+	{
+		pose.Sample(*pClip, skeleton, seconds * pClip->ticksPerSecond);
+		return true;
+	}
+	if (const CompressedAnimationClip* pCompressed = m_Scene.GetCompressedAnimationClip(clipID))
+	{
+		pose.Sample(*pCompressed, skeleton, seconds * pCompressed->ticksPerSecond);
+		return true;
+	}
+	return false;
+}
+
+void AnimationSystem::AdvanceTime(AnimationComponent& component, float dt) const
+{
+	const float duration = ClipDuration(component.currentClipID);
+	component.currentTime += dt * component.playbackSpeed;
+	if (!component.bLoop && (component.playbackSpeed >= 0.0f ? component.currentTime >= duration : component.currentTime <= 0.0f))
+		component.bPlaying = false;
+	component.currentTime = WrapTime(component.currentTime, duration, component.bLoop);
+
+	if (component.bTransitioning)
+	{
+		component.transitionTime += dt;
+		if (component.transitionTime >= component.transitionDuration)
+		{
+			component.currentClipID = component.transitionToClipID;
+			component.currentTime   = WrapTime(component.transitionTime * component.playbackSpeed, ClipDuration(component.currentClipID), component.bLoop);
+			component.bPlaying      = true;
+
+			component.bTransitioning     = false;
+			component.transitionTime     = 0.0f;
+			component.transitionToClipID = kInvalidIndex;
+		}
+	}
+}
+
+void AnimationSystem::EvaluateBlendTree(AnimationComponent& component, float dt) const
+{
+	const Skeleton* pSkeleton = m_Scene.GetSkeleton(component.skeletonID);
+	if (!pSkeleton)
+		return;
+
+	AnimationPose& pose = component.currentPose;
+	if (!SampleClip(pose, *pSkeleton, component.currentClipID, component.currentTime))
+		return;
+
+	// cross-fade
+	if (component.bTransitioning && component.transitionDuration > 0.0f)
+	{
+		const float targetTime = WrapTime(component.transitionTime * component.playbackSpeed, ClipDuration(component.transitionToClipID), component.bLoop);
+		if (SampleClip(component.transitionPose, *pSkeleton, component.transitionToClipID, targetTime))
+			pose.Blend(component.transitionPose, component.transitionTime / component.transitionDuration);
+	}
+
+	// layers
+	for (auto& layer : component.blendLayers)
+	{
+		if (layer.weight <= 0.0f)
+			continue;
+
+		layer.time = WrapTime(layer.time + dt * component.playbackSpeed, ClipDuration(layer.clipID), true);
+		if (!SampleClip(layer.pose, *pSkeleton, layer.clipID, layer.time))
+			continue;
+
+		if (layer.bAdditive)
+		{
+			SampleClip(layer.referencePose, *pSkeleton, layer.clipID, 0.0f);
+			pose.Add(layer.pose, layer.referencePose, layer.weight);
+		}
+		else
+		{
+			pose.Blend(layer.pose, layer.weight);
+		}
+	}
+
+	pose.CalculateBoneMatrices(*pSkeleton);
+}
+
+} // namespace baamboo
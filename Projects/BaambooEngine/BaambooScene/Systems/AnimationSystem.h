@@ -0,0 +1,72 @@
+#pragma once
+#include "SceneSystem.h"
+
+namespace baamboo
+{
+
+class Scene;
+
+class AnimationSystem : public SceneSystem< AnimationComponent >
+{
+using Super = SceneSystem< AnimationComponent >;
+public:
+	struct Stats
+	{
+		u32    numEntities    = 0;
+		u32    numSharedPoses = 0; // unique cached poses the single-clip entities resolved to
+		u32    numBones       = 0; // bones evaluated, shared poses counted once
+		double elapsedMs      = 0.0;
+	};
+
+	AnimationSystem(entt::registry& registry, const Scene& scene);
+
+	// Advances playback and evaluates the pose of every playing entity, spread over the task scheduler
+	void Update(float dt);
+
+	// Skinning palette of 'component' as of the last Update
+	const std::vector< mat4 >& GetBoneMatrices(const AnimationComponent& component) const;
+
+	// Entities playing one clip with no layers or transition sample it at this rate and share
+	// the pose with every other entity on the same (clip, frame). 0 evaluates each one on its own.
+	void SetPoseCacheRate(float samplesPerSecond) { m_PoseCacheRate = samplesPerSecond; }
+	float GetPoseCacheRate() const { return m_PoseCacheRate; }
+
+	const Stats& GetStats() const { return m_Stats; }
+
+private:
+	struct PoseKey
+	{
+		u32 skeletonID;
+		u32 clipID;
+		u32 frame;
+
+		bool operator==(const PoseKey&) const = default;
+	};
+	struct PoseKeyHash
+	{
+		size_t operator()(const PoseKey& key) const
+		{
+			return std::hash< u64 >()((u64(key.skeletonID) << 32 | key.clipID) * 0x9e3779b97f4a7c15ull ^ key.frame);
+		}
+	};
+
+	float ClipDuration(u32 clipID) const;
+	bool SampleClip(AnimationPose& pose, const Skeleton& skeleton, u32 clipID, float seconds) const;
+
+	void AdvanceTime(AnimationComponent& component, float dt) const;
+	void EvaluateBlendTree(AnimationComponent& component, float dt) const;
+
+private:
+	const Scene& m_Scene;
+
+	std::vector< entt::entity > m_BlendedEntities;
+
+	float                                             m_PoseCacheRate = 60.0f;
+	std::vector< AnimationPose >                      m_SharedPoses;    // slots reused across frames
+	std::vector< PoseKey >                            m_SharedPoseKeys; // this frame's key of each slot
+	std::unordered_map< PoseKey, u32, PoseKeyHash >   m_SharedPoseSlots;
+
+	Stats m_Stats = {};
+};
+
+} // namespace baamboo
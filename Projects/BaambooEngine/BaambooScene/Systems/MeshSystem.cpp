@@ -204,61 +204,72 @@ void StaticMeshSystem::CollectRenderData(SceneRenderView& outView) const
     outView.materialSlabs.reserve(outView.materialSlabs.size() + materialRecordCount);
 
     std::unordered_map< std::string_view, u32 > meshIndexMap;
-    std::unordered_map< u64, u32 >              materialIndexMap;
-
     for (const auto& [id, entry] : m_RenderData)
+        EmitDraw(outView, id, entry, meshIndexMap);
+}
+
+u32 StaticMeshSystem::CollectVisibleDraws(SceneRenderView& outView, const std::vector< entt::entity >& visibleEntities) const
+{
+    // culling only picks instances; the mesh/material layout stays whole so a moving camera
+    // never forces the renderers to re-upload it
+    outView.bCpuCulled = true;
+    outView.visibleDraws.clear();
+    outView.visibleDraws.reserve(visibleEntities.size());
+    for (auto entity : visibleEntities)
     {
-        u32 meshIndex = kInvalidIndex;
-        auto meshIt = meshIndexMap.find(entry.mesh.tag);
-        if (meshIt == meshIndexMap.end())
-        {
-            meshIndex = static_cast<u32>(outView.meshes.size());
+        const u64 id = entt::to_integral(entity);
+        if (m_RenderData.contains(id))
+            outView.visibleDraws.push_back(static_cast<u32>(id));
+    }
+    std::sort(outView.visibleDraws.begin(), outView.visibleDraws.end());
+    return static_cast<u32>(outView.visibleDraws.size());
+}
 
-            outView.meshes.push_back(entry.mesh);
-            meshIndexMap.emplace(entry.mesh.tag, meshIndex);
-        }
-        else
-        {
-            meshIndex = meshIt->second;
-        }
+void StaticMeshSystem::EmitDraw(SceneRenderView& outView, u64 id, const MeshRenderDataEntry& entry,
+    std::unordered_map< std::string_view, u32 >& meshIndexMap) const
+{
+    u32 meshIndex = kInvalidIndex;
+    auto meshIt = meshIndexMap.find(entry.mesh.tag);
+    if (meshIt == meshIndexMap.end())
+    {
+        meshIndex = static_cast<u32>(outView.meshes.size());
 
-        u32 materialIndex = kInvalidIndex;
-        if (entry.bHasMaterial)
+        outView.meshes.push_back(entry.mesh);
+        meshIndexMap.emplace(entry.mesh.tag, meshIndex);
+    }
+    else
+    {
+        meshIndex = meshIt->second;
+    }
+
+    // every entity owns its material stack, so it is appended once per draw
+    u32 materialIndex = kInvalidIndex;
+    if (entry.bHasMaterial)
+    {
+        BB_ASSERT(!entry.materials.empty(), "Material render stack must contain at least one closure");
+        BB_ASSERT(entry.materials.size() == entry.materialSlabs.size(), "Material closure/slab counts must match");
+
+        materialIndex = static_cast<u32>(outView.materials.size());
+        const u32 layerOffset = static_cast<u32>(outView.materialSlabs.size());
+        const u32 layerCount  = static_cast<u32>(entry.materials.size());
+
+        for (u32 layerIndex = 0; layerIndex < layerCount; ++layerIndex)
         {
-            BB_ASSERT(!entry.materials.empty(), "Material render stack must contain at least one closure");
-            BB_ASSERT(entry.materials.size() == entry.materialSlabs.size(), "Material closure/slab counts must match");
+            MaterialRenderView material = entry.materials[layerIndex];
+            material.layerOffset = layerIndex == 0u ? layerOffset : kInvalidIndex;
+            material.layerCount  = layerIndex == 0u ? layerCount : 0u;
 
-            auto matIt = materialIndexMap.find(id);
-            if (matIt == materialIndexMap.end())
-            {
-                materialIndex = static_cast<u32>(outView.materials.size());
-                const u32 layerOffset = static_cast<u32>(outView.materialSlabs.size());
-                const u32 layerCount  = static_cast<u32>(entry.materials.size());
-
-                for (u32 layerIndex = 0; layerIndex < layerCount; ++layerIndex)
-                {
-                    MaterialRenderView material = entry.materials[layerIndex];
-                    material.layerOffset = layerIndex == 0u ? layerOffset : kInvalidIndex;
-                    material.layerCount  = layerIndex == 0u ? layerCount : 0u;
-
-                    MaterialSlabData slab = entry.materialSlabs[layerIndex];
-                    slab.materialID = static_cast<u32>(outView.materials.size());
-
-                    outView.materials.push_back(std::move(material));
-                    outView.materialSlabs.push_back(slab);
-                }
-                materialIndexMap.emplace(id, materialIndex);
-            }
-            else
-            {
-                materialIndex = matIt->second;
-            }
-        }
+            MaterialSlabData slab = entry.materialSlabs[layerIndex];
+            slab.materialID = static_cast<u32>(outView.materials.size());
 
-        auto& draw = outView.draws[static_cast<u32>(id)];
-        draw.mesh     = meshIndex;
-        draw.material = materialIndex;
+            outView.materials.push_back(std::move(material));
+            outView.materialSlabs.push_back(slab);
+        }
     }
+
+    auto& draw = outView.draws[static_cast<u32>(id)];
+    draw.mesh     = meshIndex;
+    draw.material = materialIndex;
 }
 
 void StaticMeshSystem::RemoveRenderData(u64 entityId)
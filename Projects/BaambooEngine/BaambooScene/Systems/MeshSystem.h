@@ -16,8 +16,14 @@ public:
 
 	virtual std::vector< u64 > UpdateRenderData(const EditorCamera& edCamera) override;
 	virtual void CollectRenderData(SceneRenderView& outView) const override;
+	// Lists the draws of 'visibleEntities' (e.g. the CPU frustum pre-pass survivors) in outView.visibleDraws
+	// and returns how many had render data. The draws themselves come from CollectRenderData.
+	u32 CollectVisibleDraws(SceneRenderView& outView, const std::vector< entt::entity >& visibleEntities) const;
 	virtual void RemoveRenderData(u64 entityId) override;
 
+	[[nodiscard]]
+	u32 NumRenderData() const { return static_cast< u32 >(m_RenderData.size()); }
+
 private:
 	struct MeshRenderDataEntry
 	{
@@ -28,6 +34,9 @@ private:
 		bool bHasMaterial = false;
 	};
 
+	void EmitDraw(SceneRenderView& outView, u64 id, const MeshRenderDataEntry& entry,
+		std::unordered_map< std::string_view, u32 >& meshIndexMap) const;
+
 	std::unordered_map< u64, MeshRenderDataEntry > m_RenderData;
 };
 
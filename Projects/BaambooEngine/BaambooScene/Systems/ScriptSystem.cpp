@@ -0,0 +1,137 @@
+#include "BaambooPch.h"
+#include "ScriptSystem.h"
+#include "TransformSystem.h"
+#include "TaskScheduler.hpp"
+
+namespace baamboo
+{
+
+namespace
+{
+
+constexpr u32 kChunkSize = 256;
+
+u32 NumChunks(size_t count)
+{
+	return static_cast< u32 >((count + kChunkSize - 1) / kChunkSize);
+}
+
+} // anonymous namespace
+
+ScriptSystem::ScriptSystem(entt::registry& registry, TransformSystem* pTransformSystem)
+	: Super(registry)
+	, m_pTransformSystem(pTransformSystem)
+{
+	assert(m_pTransformSystem);
+
+	// a scripted entity gaining one of these must move to the patched list
+	auto invalidate = [this](entt::registry&, entt::entity) { m_bGroupsDirty = true; };
+	DependsOn< LightComponent >(invalidate);
+	DependsOn< AtmosphereComponent >(invalidate);
+	DependsOn< CloudComponent >(invalidate);
+}
+
+void ScriptSystem::OnComponentConstructed(entt::registry& registry, entt::entity entity)
+{
+	UNUSED(registry);
+	UNUSED(entity);
+	m_bGroupsDirty = true;
+}
+
+void ScriptSystem::OnComponentUpdated(entt::registry& registry, entt::entity entity)
+{
+	UNUSED(registry);
+	UNUSED(entity);
+	m_bGroupsDirty = true;
+}
+
+void ScriptSystem::OnComponentDestroyed(entt::registry& registry, entt::entity entity)
+{
+	UNUSED(registry);
+	UNUSED(entity);
+	m_bGroupsDirty = true;
+}
+
+void ScriptSystem::Update(float dt)
+{
+	const auto beginTime = std::chrono::steady_clock::now();
+
+	if (m_bGroupsDirty)
+		RebuildGroups();
+
+	auto resolveTransforms = [this](BehaviorGroup& group)
+		{
+			group.transforms.resize(group.entities.size());
+			for (size_t i = 0; i < group.entities.size(); ++i)
+				group.transforms[i] = &m_Registry.get< TransformComponent >(group.entities[i]).transform;
+		};
+	resolveTransforms(m_Movers);
+	resolveTransforms(m_Rotators);
+
+	// movers and rotators write different members, so an entity in both groups is safe
+	const u32 numMoverChunks   = NumChunks(m_Movers.entities.size());
+	const u32 numRotatorChunks = NumChunks(m_Rotators.entities.size());
+	TaskScheduler::Inst()->ParallelFor(numMoverChunks + numRotatorChunks, [&](u32 chunk)
+		{
+			const bool     bMover = chunk < numMoverChunks;
+			BehaviorGroup& group  = bMover ? m_Movers : m_Rotators;
+
+			const size_t begin = static_cast< size_t >(bMover ? chunk : chunk - numMoverChunks) * kChunkSize;
+			const size_t end   = std::min(begin + kChunkSize, group.entities.size());
+			if (bMover)
+			{
+				for (size_t i = begin; i < end; ++i)
+					group.transforms[i]->position += group.velocities[i] * dt;
+			}
+			else
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					const float3 delta = group.velocities[i] * dt;
+					group.transforms[i]->Rotate(delta.y, delta.x, delta.z);
+				}
+			}
+		});
+
+	m_pTransformSystem->MarkEntitiesDirty(m_BulkEntities);
+	for (auto entity : m_PatchedEntities)
+		m_Registry.patch< TransformComponent >(entity, [](auto&) {});
+
+	m_Stats.numMovers   = static_cast< u32 >(m_Movers.entities.size());
+	m_Stats.numRotators = static_cast< u32 >(m_Rotators.entities.size());
+	m_Stats.numPatched  = static_cast< u32 >(m_PatchedEntities.size());
+	m_Stats.elapsedMs   = std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - beginTime).count();
+}
+
+void ScriptSystem::RebuildGroups()
+{
+	m_Movers.Clear();
+	m_Rotators.Clear();
+	m_BulkEntities.clear();
+	m_PatchedEntities.clear();
+
+	m_Registry.view< TransformComponent, ScriptComponent >().each([this](auto entity, auto&, auto& scriptComponent)
+		{
+			if (scriptComponent.bMove)
+			{
+				m_Movers.entities.push_back(entity);
+				m_Movers.velocities.push_back(scriptComponent.moveVelocity);
+			}
+			if (scriptComponent.bRotate)
+			{
+				m_Rotators.entities.push_back(entity);
+				m_Rotators.velocities.push_back(scriptComponent.rotationVelocity);
+			}
+			if (!scriptComponent.bMove && !scriptComponent.bRotate)
+				return;
+
+			if (m_Registry.any_of< LightComponent, AtmosphereComponent, CloudComponent >(entity))
+				m_PatchedEntities.push_back(entity);
+			else
+				m_BulkEntities.push_back(entity);
+		});
+
+	m_bGroupsDirty = false;
+}
+
+} // namespace baamboo
@@ -0,0 +1,66 @@
+#pragma once
+#include "SceneSystem.h"
+
+namespace baamboo
+{
+
+class TransformSystem;
+
+// =========================================================================
+// ScriptSystem — batched evaluation of ScriptComponent behaviors.
+//
+//   Behaviors of one kind are kept in dense arrays, rebuilt only when a
+//   ScriptComponent changes, and evaluated in chunks on the task scheduler.
+//   The transforms they write are committed with one bulk MarkDirty on the
+//   TransformSystem instead of a registry patch per entity and behavior;
+//   only entities another system watches through DependsOn< Transform >
+//   (lights, atmosphere, clouds) still get a patch.
+// =========================================================================
+class ScriptSystem : public SceneSystem< ScriptComponent >
+{
+using Super = SceneSystem< ScriptComponent >;
+public:
+	struct Stats
+	{
+		u32    numMovers   = 0;
+		u32    numRotators = 0;
+		u32    numPatched  = 0; // entities committed through registry.patch
+		double elapsedMs   = 0.0;
+	};
+
+	ScriptSystem(entt::registry& registry, TransformSystem* pTransformSystem);
+
+	virtual void OnComponentConstructed(entt::registry& registry, entt::entity entity) override;
+	virtual void OnComponentUpdated(entt::registry& registry, entt::entity entity) override;
+	virtual void OnComponentDestroyed(entt::registry& registry, entt::entity entity) override;
+
+	void Update(float dt);
+
+	const Stats& GetStats() const { return m_Stats; }
+
+private:
+	void RebuildGroups();
+
+private:
+	TransformSystem* m_pTransformSystem = nullptr;
+
+	struct BehaviorGroup
+	{
+		std::vector< entt::entity > entities;
+		std::vector< float3 >       velocities;
+		std::vector< Transform* >   transforms; // resolved each Update, before the parallel pass
+
+		void Clear() { entities.clear(); velocities.clear(); transforms.clear(); }
+	};
+	BehaviorGroup m_Movers;    // velocity in units per second
+	BehaviorGroup m_Rotators;  // (pitch, yaw, roll) in radians per second
+
+	std::vector< entt::entity > m_BulkEntities;    // scripted, marked in one call
+	std::vector< entt::entity > m_PatchedEntities; // scripted, and watched by another system
+
+	bool m_bGroupsDirty = true;
+
+	Stats m_Stats = {};
+};
+
+} // namespace baamboo
@@ -0,0 +1,149 @@
+#include "BaambooPch.h"
+#include "SpatialSystem.h"
+#include "TransformSystem.h"
+
+namespace baamboo
+{
+
+namespace
+{
+
+// distance at which the ray enters 'aabb', FLT_MAX on a miss
+float RayBoxDistance(const float3& origin, const float3& invDirection, const BoundingBox& aabb)
+{
+	const float3 t0   = (aabb.Min() - origin) * invDirection;
+	const float3 t1   = (aabb.Max() - origin) * invDirection;
+	const float3 tMin = glm::min(t0, t1);
+	const float3 tMax = glm::max(t0, t1);
+
+	const float enter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+	const float exit  = std::min(std::min(tMax.x, tMax.y), tMax.z);
+	return enter <= exit ? enter : FLT_MAX;
+}
+
+} // anonymous namespace
+
+SpatialSystem::SpatialSystem(entt::registry& registry, TransformSystem* pTransformSystem)
+	: Super(registry)
+	, m_pTransformSystem(pTransformSystem)
+{
+	assert(m_pTransformSystem);
+}
+
+void SpatialSystem::OnComponentDestroyed(entt::registry& registry, entt::entity entity)
+{
+	UNUSED(registry);
+
+	// dropped right away so no query returns an entity being destroyed
+	if (auto it = m_Proxies.find(entity); it != m_Proxies.end())
+	{
+		m_Tree.DestroyProxy(it->second);
+		m_Proxies.erase(it);
+	}
+	m_DirtyEntities.erase(entity);
+}
+
+void SpatialSystem::OnTransformsUpdated(const std::vector< u64 >& entities)
+{
+	for (auto id : entities)
+	{
+		const auto entity = static_cast< entt::entity >(id);
+		if (m_Registry.valid(entity) && m_Registry.all_of< StaticMeshComponent >(entity))
+			MarkDirty(entity);
+	}
+}
+
+void SpatialSystem::Update()
+{
+	const auto beginTime = std::chrono::steady_clock::now();
+
+	u32 numMoved      = 0;
+	u32 numReinserted = 0;
+	for (auto entity : m_DirtyEntities)
+	{
+		if (!m_Registry.valid(entity) || !m_Registry.all_of< TransformComponent, StaticMeshComponent >(entity))
+			continue;
+
+		const auto& meshComponent = m_Registry.get< StaticMeshComponent >(entity);
+		if (!meshComponent.pVertices || meshComponent.numVertices == 0u)
+			continue;
+
+		const auto& transformComponent = m_Registry.get< TransformComponent >(entity);
+		const BoundingBox worldAABB = BoundingBox::Transformed(meshComponent.aabb, m_pTransformSystem->WorldMatrix(transformComponent.world));
+
+		if (auto it = m_Proxies.find(entity); it != m_Proxies.end())
+		{
+			++numMoved;
+			if (m_Tree.MoveProxy(it->second, worldAABB))
+				++numReinserted;
+		}
+		else
+		{
+			m_Proxies.emplace(entity, m_Tree.CreateProxy(worldAABB, entt::to_integral(entity)));
+		}
+	}
+	ClearDirtyEntities();
+
+	m_Stats.numProxies    = m_Tree.NumProxies();
+	m_Stats.treeHeight    = m_Tree.Height();
+	m_Stats.numMoved      = numMoved;
+	m_Stats.numReinserted = numReinserted;
+	m_Stats.elapsedMs     = std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - beginTime).count();
+}
+
+entt::entity SpatialSystem::RayCast(const float3& origin, const float3& direction, float maxDistance, float* pOutDistance) const
+{
+	const float3 invDirection = 1.0f / direction;
+
+	entt::entity closest  = entt::null;
+	float        distance = maxDistance;
+	m_Tree.RayCast(origin, direction, maxDistance, [&](u32, u64 userData, float)
+		{
+			// the tree tests fattened bounds, the hit is decided on the tight ones
+			const auto  entity             = static_cast< entt::entity >(userData);
+			const auto& meshComponent      = m_Registry.get< StaticMeshComponent >(entity);
+			const auto& transformComponent = m_Registry.get< TransformComponent >(entity);
+
+			const BoundingBox worldAABB = BoundingBox::Transformed(meshComponent.aabb, m_pTransformSystem->WorldMatrix(transformComponent.world));
+			const float hitDistance = RayBoxDistance(origin, invDirection, worldAABB);
+			if (hitDistance < distance)
+			{
+				closest  = entity;
+				distance = hitDistance;
+			}
+			return distance;
+		});
+
+	if (pOutDistance && closest != entt::null)
+		*pOutDistance = distance;
+	return closest;
+}
+
+void SpatialSystem::Query(const BoundingBox& aabb, std::vector< entt::entity >& outEntities) const
+{
+	m_Tree.Query(aabb, [&outEntities](u32, u64 userData)
+		{
+			outEntities.push_back(static_cast< entt::entity >(userData));
+			return true;
+		});
+}
+
+void SpatialSystem::Query(const BoundingSphere& sphere, std::vector< entt::entity >& outEntities) const
+{
+	m_Tree.Query(sphere, [&outEntities](u32, u64 userData)
+		{
+			outEntities.push_back(static_cast< entt::entity >(userData));
+			return true;
+		});
+}
+
+void SpatialSystem::Query(const BoundingFrustum& frustum, std::vector< entt::entity >& outEntities) const
+{
+	m_Tree.Query(frustum, [&outEntities](u32, u64 userData)
+		{
+			outEntities.push_back(static_cast< entt::entity >(userData));
+			return true;
+		});
+}
+
+} // namespace baamboo
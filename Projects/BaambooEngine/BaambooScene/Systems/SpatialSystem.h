@@ -0,0 +1,63 @@
+#pragma once
+#include "SceneSystem.h"
+#include "../DynamicAABBTree.h"
+
+namespace baamboo
+{
+
+class TransformSystem;
+
+// =========================================================================
+// SpatialSystem — world bounds of every static mesh in a DynamicAABBTree.
+//
+//   Picking, gameplay queries and CPU culling share the tree instead of
+//   walking the registry. Proxies follow mesh and transform changes in
+//   Update, which the scene runs after the transform system; queries see the
+//   bounds as of that call.
+// =========================================================================
+class SpatialSystem : public SceneSystem< StaticMeshComponent >
+{
+using Super = SceneSystem< StaticMeshComponent >;
+public:
+	struct Stats
+	{
+		u32    numProxies     = 0;
+		u32    treeHeight     = 0;
+		u32    numMoved       = 0; // proxies whose bounds were updated last Update
+		u32    numReinserted  = 0; // of those, the ones that left their fat bounds
+		double elapsedMs      = 0.0;
+	};
+
+	SpatialSystem(entt::registry& registry, TransformSystem* pTransformSystem);
+
+	virtual void OnComponentDestroyed(entt::registry& registry, entt::entity entity) override;
+
+	// 'entities' are the ids whose world matrix changed, as returned by TransformSystem::UpdateRenderData
+	void OnTransformsUpdated(const std::vector< u64 >& entities);
+	void Update();
+
+	// Closest entity whose world bounds the ray enters within 'maxDistance' (entt::null if none).
+	// 'direction' must be normalized.
+	[[nodiscard]]
+	entt::entity RayCast(const float3& origin, const float3& direction, float maxDistance = FLT_MAX, float* pOutDistance = nullptr) const;
+
+	// Appends every entity whose world bounds overlap the volume (tested against the fattened bounds)
+	void Query(const BoundingBox& aabb, std::vector< entt::entity >& outEntities) const;
+	void Query(const BoundingSphere& sphere, std::vector< entt::entity >& outEntities) const;
+	void Query(const BoundingFrustum& frustum, std::vector< entt::entity >& outEntities) const;
+
+	[[nodiscard]]
+	const DynamicAABBTree& GetTree() const { return m_Tree; }
+	[[nodiscard]]
+	const Stats& GetStats() const { return m_Stats; }
+
+private:
+	TransformSystem* m_pTransformSystem = nullptr;
+
+	DynamicAABBTree                         m_Tree;
+	std::unordered_map< entt::entity, u32 > m_Proxies;
+
+	Stats m_Stats = {};
+};
+
+} // namespace baamboo
@@ -8,21 +8,27 @@ TransformSystem::TransformSystem(entt::registry& registry)
 	: Super(registry)
 {
     m_mWorlds.resize(1024);
+    m_Versions.resize(1024);
     m_IndexAllocator.reserve(1024);
 }
 
 void TransformSystem::OnComponentConstructed(entt::registry& registry, entt::entity entity)
 {
-	MarkDirty(entity);
-
     auto index      = m_IndexAllocator.allocate();
     auto& transform = registry.get< TransformComponent >(entity);
     transform.world = index;
 
     if (index >= m_mWorlds.size())
+    {
         m_mWorlds.resize(static_cast<u64>(index) * 2);
+        m_Versions.resize(m_mWorlds.size());
+    }
+
+    m_mWorlds[index]  = mat4(1.0f);
+    m_Versions[index] = {};
 
-    m_mWorlds[index] = mat4(1.0f);
+    // after the slot is assigned, MarkDirty bumps its version
+    MarkDirty(entity);
 
     registry.emplace< RootComponent >(entity);
     m_bHierarchyDirty = true;
@@ -50,9 +56,12 @@ std::vector< u64 > TransformSystem::UpdateRenderData(const EditorCamera& edCamer
     std::vector< u64 > markedEntities;
     if (m_DirtyEntities.empty() && m_ExpiredEntities.empty())
     {
+        m_Stats = {};
         return markedEntities;
     }
 
+    const auto beginTime = std::chrono::steady_clock::now();
+
     for (auto entity : m_ExpiredEntities)
     {
         auto id = entt::to_integral(entity);
@@ -67,33 +76,67 @@ std::vector< u64 > TransformSystem::UpdateRenderData(const EditorCamera& edCamer
         RebuildHierarchyOrder();
 
     // Sort dirty entities by hierarchy order (guarantees parent-before-child)
-    std::vector< entt::entity > sortedDirty;
-    sortedDirty.reserve(m_DirtyEntities.size());
+    std::vector< u32 > dirtyPositions;
+    dirtyPositions.reserve(m_DirtyEntities.size());
     for (auto entity : m_DirtyEntities)
     {
-        if (m_Registry.valid(entity))
-            sortedDirty.push_back(entity);
+        if (!m_Registry.valid(entity))
+            continue;
+
+        if (auto it = m_HierarchyPosition.find(entity); it != m_HierarchyPosition.end())
+            dirtyPositions.push_back(it->second);
     }
-    std::sort(sortedDirty.begin(), sortedDirty.end(), [this](entt::entity a, entt::entity b)
-        {
-            return m_HierarchyPosition[a] < m_HierarchyPosition[b];
-        });
+    std::sort(dirtyPositions.begin(), dirtyPositions.end());
 
-    for (auto entity : sortedDirty)
+    // Each dirty subtree is contiguous in pre-order; one nested in an earlier one is covered by its walk
+    u32 numVisited = 0;
+    u32 walkEnd    = 0;
+    for (auto begin : dirtyPositions)
     {
-        auto& transformComponent = m_Registry.get<TransformComponent>(entity);
-        transformComponent.transform.Update();
-        UpdateWorldTransform(entity);
+        if (begin < walkEnd)
+            continue;
+
+        walkEnd = m_SubtreeEnd[begin];
+        for (u32 position = begin; position < walkEnd; ++position)
+        {
+            ++numVisited;
 
-        u64 id = entt::to_integral(entity);
-        TransformRenderView& view = m_RenderData[id];
-        view.id            = id;
-        view.mWorld        = WorldMatrix(transformComponent.world);
-        view.mWorldInverse = glm::inverse(view.mWorld);
+            auto  entity             = m_HierarchyOrder[position];
+            auto& transformComponent = m_Registry.get< TransformComponent >(entity);
+            auto& versions           = m_Versions[transformComponent.world];
 
-        markedEntities.emplace_back(id);
+            const auto parent        = transformComponent.hierarchy.parent;
+            const u32  parentVersion = parent != entt::null && m_Registry.valid(parent)
+                ? m_Versions[m_Registry.get< TransformComponent >(parent).world].world : 0;
+
+            const bool bLocalChanged  = versions.local != versions.consumedLocal;
+            const bool bParentChanged = versions.consumedParent != parentVersion;
+            if (!bLocalChanged && !bParentChanged)
+                continue;
+
+            if (bLocalChanged)
+                transformComponent.transform.Update();
+            UpdateWorldTransform(entity);
+
+            versions.consumedLocal  = versions.local;
+            versions.consumedParent = parentVersion;
+            ++versions.world;
+
+            u64 id = entt::to_integral(entity);
+            TransformRenderView& view = m_RenderData[id];
+            view.id            = id;
+            view.mWorld        = WorldMatrix(transformComponent.world);
+            view.mWorldInverse = glm::inverse(view.mWorld);
+
+            markedEntities.emplace_back(id);
+        }
     }
 
+    m_Stats.numMarked  = static_cast< u32 >(m_DirtyEntities.size());
+    m_Stats.numVisited = numVisited;
+    m_Stats.numUpdated = static_cast< u32 >(markedEntities.size());
+    m_Stats.elapsedMs  = std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - beginTime).count();
+
     ClearDirtyEntities();
     return markedEntities;
 }
@@ -120,16 +163,20 @@ void TransformSystem::RemoveRenderData(u64 entityId)
 
 void TransformSystem::MarkDirty(entt::entity entity)
 {
+    if (!m_Registry.valid(entity))
+        return;
+
     Super::MarkDirty(entity);
 
-    auto& transform = m_Registry.get< TransformComponent >(entity);
-    auto  child     = transform.hierarchy.firstChild;
-    while (child != entt::null) 
-    {
-        MarkDirty(child);
-        auto& childTransform = m_Registry.get< TransformComponent >(child);
-        child = childTransform.hierarchy.nextSibling;
-    }
+    // descendants are not marked; they see the parent's world version change in UpdateRenderData
+    ++m_Versions[m_Registry.get< TransformComponent >(entity).world].local;
+}
+
+void TransformSystem::MarkEntitiesDirty(const std::vector< entt::entity >& entities)
+{
+    m_DirtyEntities.reserve(m_DirtyEntities.size() + entities.size());
+    for (auto entity : entities)
+        MarkDirty(entity);
 }
 
 void TransformSystem::AttachChild(entt::entity parent, entt::entity child)
@@ -242,6 +289,7 @@ void TransformSystem::UpdateWorldTransform(entt::entity entity)
 void TransformSystem::RebuildHierarchyOrder()
 {
     m_HierarchyOrder.clear();
+    m_SubtreeEnd.clear();
     m_HierarchyPosition.clear();
 
     // Collect root entities
@@ -251,10 +299,13 @@ void TransformSystem::RebuildHierarchyOrder()
             roots.push_back(entity);
         });
 
-    m_HierarchyOrder.reserve(m_Registry.view< TransformComponent >().size());
+    const auto numTransforms = m_Registry.view< TransformComponent >().size();
+    m_HierarchyOrder.reserve(numTransforms);
+    m_SubtreeEnd.reserve(numTransforms);
 
-    // Iterative DFS pre-order traversal
+    // Iterative DFS pre-order traversal; 'open' holds the positions whose subtree is still being emitted
     std::vector< entt::entity > stack;
+    std::vector< u32 >          open;
     for (auto it = roots.rbegin(); it != roots.rend(); ++it)
         stack.push_back(*it);
 
@@ -263,8 +314,20 @@ void TransformSystem::RebuildHierarchyOrder()
         auto entity = stack.back();
         stack.pop_back();
 
-        m_HierarchyPosition[entity] = static_cast< u32 >(m_HierarchyOrder.size());
+        const u32 position = static_cast< u32 >(m_HierarchyOrder.size());
+        const auto parent  = m_Registry.get< TransformComponent >(entity).hierarchy.parent;
+
+        // close every open subtree that is not this entity's parent chain
+        while (!open.empty() && m_HierarchyOrder[open.back()] != parent)
+        {
+            m_SubtreeEnd[open.back()] = position;
+            open.pop_back();
+        }
+        open.push_back(position);
+
+        m_HierarchyPosition[entity] = position;
         m_HierarchyOrder.push_back(entity);
+        m_SubtreeEnd.push_back(position + 1);
 
         // Push children in reverse order so firstChild is processed first
         auto& tc = m_Registry.get< TransformComponent >(entity);
@@ -276,6 +339,10 @@ void TransformSystem::RebuildHierarchyOrder()
         }
     }
 
+    const u32 numEntities = static_cast< u32 >(m_HierarchyOrder.size());
+    for (auto position : open)
+        m_SubtreeEnd[position] = numEntities;
+
     m_bHierarchyDirty = false;
 }
 
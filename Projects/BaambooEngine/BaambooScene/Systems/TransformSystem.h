@@ -5,10 +5,28 @@
 namespace baamboo
 {
 
+// =========================================================================
+// TransformSystem — world matrices in hierarchy order.
+//
+//   Only the entity that changed is marked dirty. Every world slot carries
+//   generation counters: UpdateRenderData walks the pre-order subtree of
+//   each dirty entity and recomputes a node when its own transform changed
+//   or its parent's world version differs from the one it last consumed.
+//   Moving a root is therefore one hash-set insert plus a linear walk,
+//   regardless of how many descendants follow it.
+// =========================================================================
 class TransformSystem : public SceneSystem< TransformComponent >
 {
 using Super = SceneSystem< TransformComponent >;
 public:
+	struct Stats
+	{
+		u32    numMarked  = 0; // entities marked dirty since the last update
+		u32    numVisited = 0; // nodes walked in their subtrees
+		u32    numUpdated = 0; // world matrices recomputed
+		double elapsedMs  = 0.0;
+	};
+
 	TransformSystem(entt::registry& registry);
 
 	virtual void OnComponentConstructed(entt::registry& registry, entt::entity entity) override;
@@ -19,11 +37,17 @@ public:
 	virtual void CollectRenderData(SceneRenderView& outView) const override;
 	virtual void RemoveRenderData(u64 entityId) override;
 
+	// same as patching each entity's TransformComponent, without the per-entity signal;
+	// systems depending on TransformComponent are not notified
+	void MarkEntitiesDirty(const std::vector< entt::entity >& entities);
+
 	void AttachChild(entt::entity parent, entt::entity child);
 	void DetachChild(entt::entity child);
 
 	[[nodiscard]]
 	const mat4& WorldMatrix(u32 index) const { assert(index < m_mWorlds.size()); return m_mWorlds[index]; }
+	[[nodiscard]]
+	const Stats& GetStats() const { return m_Stats; }
 
 private:
 	virtual void MarkDirty(entt::entity entity) override;
@@ -32,15 +56,28 @@ private:
 	void RebuildHierarchyOrder();
 
 private:
-	std::vector< mat4 > m_mWorlds;
-	FreeList<>          m_IndexAllocator;
+	// generation counters per world slot; a node is stale when either pair differs
+	struct Versions
+	{
+		u32 local          = 0; // bumped by MarkDirty
+		u32 consumedLocal  = 0;
+		u32 world          = 0; // bumped whenever the world matrix is recomputed
+		u32 consumedParent = 0; // parent's 'world' when this matrix was last computed
+	};
+
+	std::vector< mat4 >     m_mWorlds;
+	std::vector< Versions > m_Versions;
+	FreeList<>              m_IndexAllocator;
 
 	std::unordered_map< u64, TransformRenderView > m_RenderData;
 
 	// DFS pre-order traversal cache — rebuilt only on structural hierarchy changes
 	std::vector< entt::entity >             m_HierarchyOrder;
+	std::vector< u32 >                      m_SubtreeEnd; // one past the last descendant of m_HierarchyOrder[i]
 	std::unordered_map< entt::entity, u32 > m_HierarchyPosition;
 	bool                                    m_bHierarchyDirty = true;
+
+	Stats m_Stats = {};
 };
 
 } // namespace baamboo
\ No newline at end of file
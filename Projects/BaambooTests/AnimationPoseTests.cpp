@@ -0,0 +1,120 @@
+#include "BaambooPch.h"
+#include "TestHarness.h"
+#include "BaambooScene/AnimationTypes.h"
+
+namespace baamboo
+{
+
+namespace
+{
+
+constexpr u32 kNumFrames = 30;
+
+// root -> arm; the base clip moves the root, the layer clip moves the arm
+struct Rig
+{
+	Skeleton      skeleton;
+	AnimationClip baseClip;
+	AnimationClip layerClip;
+
+	Rig()
+	{
+		const u32 root = skeleton.AddBone("root", kInvalidIndex, mat4(1.0f), mat4(1.0f));
+		skeleton.AddBone("arm", root, mat4(1.0f), mat4(1.0f));
+
+		baseClip.duration = 10.0f;
+		baseClip.channels.push_back(PositionChannel("root", float3(0.0f), float3(0.0f, 10.0f, 0.0f)));
+		baseClip.Bind(skeleton);
+
+		layerClip.duration = 10.0f;
+		layerClip.channels.push_back(PositionChannel("arm", float3(1.0f, 0.0f, 0.0f), float3(3.0f, 0.0f, 0.0f)));
+		layerClip.Bind(skeleton);
+	}
+
+	static AnimationChannel PositionChannel(const std::string& bone, const float3& from, const float3& to)
+	{
+		AnimationChannel channel;
+		channel.boneId       = HashBoneName(bone);
+		channel.positionKeys = { { from, 0.0f }, { to, 10.0f } };
+		return channel;
+	}
+};
+
+// one frame of AnimationSystem::EvaluateBlendTree with a single layer
+struct Evaluation
+{
+	AnimationPose pose;
+	AnimationPose layerPose;
+	AnimationPose referencePose;
+
+	void Frame(const Rig& rig, float time, float layerTime, float weight, bool bAdditive)
+	{
+		pose.Sample(rig.baseClip, rig.skeleton, time);
+		layerPose.Sample(rig.layerClip, rig.skeleton, layerTime);
+		if (bAdditive)
+		{
+			referencePose.Sample(rig.layerClip, rig.skeleton, 0.0f);
+			pose.Add(layerPose, referencePose, weight);
+		}
+		else
+		{
+			pose.Blend(layerPose, weight);
+		}
+	}
+
+	const float3& Arm() const { return pose.boneTransforms[1].position; }
+};
+
+bool NearlyEqual(const float3& lhs, const float3& rhs)
+{
+	return glm::all(glm::lessThanEqual(glm::abs(lhs - rhs), float3(1e-5f)));
+}
+
+} // anonymous namespace
+
+BB_TEST(AnimationPose_UnanimatedBonesRestartEachSample)
+{
+	const Rig rig;
+
+	AnimationPose pose;
+	pose.Sample(rig.baseClip, rig.skeleton, 5.0f);
+	BB_CHECK(pose.animatedBones[0] == 1 && pose.animatedBones[1] == 0);
+	BB_CHECK(NearlyEqual(pose.boneTransforms[0].position, float3(0.0f, 5.0f, 0.0f)));
+
+	pose.boneTransforms[1].position = float3(7.0f);
+	pose.Sample(rig.baseClip, rig.skeleton, 6.0f);
+	BB_CHECK(NearlyEqual(pose.boneTransforms[1].position, float3(0.0f)));
+}
+
+BB_TEST(AnimationPose_AdditiveLayerDoesNotAccumulate)
+{
+	const Rig rig;
+
+	// half the layer's motion from its first frame: 0.5 * (2 - 1) along x
+	Evaluation evaluation;
+	evaluation.Frame(rig, 0.0f, 5.0f, 0.5f, true);
+	const float3 afterOneFrame = evaluation.Arm();
+	BB_CHECK(NearlyEqual(afterOneFrame, float3(0.5f, 0.0f, 0.0f)));
+
+	for (u32 i = 1; i < kNumFrames; ++i)
+		evaluation.Frame(rig, static_cast< float >(i) * 0.1f, 5.0f, 0.5f, true);
+	BB_CHECK(NearlyEqual(evaluation.Arm(), afterOneFrame));
+}
+
+BB_TEST(AnimationPose_OverrideLayerHoldsItsWeight)
+{
+	const Rig rig;
+
+	// the arm rests at identity in the base clip, so a weight of 0.25 lands a quarter of the way
+	Evaluation evaluation;
+	for (u32 i = 0; i < kNumFrames; ++i)
+	{
+		evaluation.Frame(rig, static_cast< float >(i) * 0.1f, 10.0f, 0.25f, false);
+		BB_CHECK(NearlyEqual(evaluation.Arm(), float3(0.75f, 0.0f, 0.0f)));
+	}
+
+	// the base clip's own bones are sampled fresh and blended once
+	BB_CHECK(NearlyEqual(evaluation.pose.boneTransforms[0].position, float3(0.0f, static_cast< float >(kNumFrames - 1) * 0.1f, 0.0f)));
+}
+
+} // namespace baamboo
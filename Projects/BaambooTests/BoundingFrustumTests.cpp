@@ -0,0 +1,102 @@
+#include "BaambooPch.h"
+#include "TestHarness.h"
+#include "BaambooScene/Camera.h"
+#include "BaambooScene/DynamicAABBTree.h"
+
+namespace baamboo
+{
+
+namespace
+{
+
+// Scene::RenderView culls with the editor camera's infinite reverse-Z projection;
+// 'zFar' > 0 selects the finite one instead
+BoundingFrustum CameraFrustum(const float3& position, const float3& target, float zFar = 0.0f)
+{
+	CameraController_FirstPerson controller(position, target);
+	EditorCamera camera(controller, 1920, 1080);
+
+	const mat4 mProj = zFar > 0.0f ? camera.GetProj(zFar) : camera.GetProj();
+	return BoundingFrustum(mProj * camera.GetView());
+}
+
+BoundingBox BoxAt(const float3& center, float halfSize)
+{
+	return BoundingBox(center - float3(halfSize), center + float3(halfSize));
+}
+
+} // anonymous namespace
+
+BB_TEST(BoundingFrustum_InfiniteReverseZPlanesAreFinite)
+{
+	const BoundingFrustum frustum = CameraFrustum(float3(0.0f, 0.0f, -10.0f), float3(0.0f));
+	for (u32 i = 0; i < BoundingFrustum::kNumPlanes; ++i)
+	{
+		const float4& plane = frustum.Plane(i);
+		BB_CHECK(std::isfinite(plane.x) && std::isfinite(plane.y) && std::isfinite(plane.z) && std::isfinite(plane.w));
+
+		// depth 0 is the infinite far plane, which keeps everything
+		if (i == 4)
+			BB_CHECK(plane == float4(0.0f, 0.0f, 0.0f, 1.0f));
+		else
+			BB_CHECK_NEAR(glm::length(float3(plane)), 1.0f, 1e-4f);
+	}
+}
+
+BB_TEST(BoundingFrustum_CullsBoxesBehindTheCamera)
+{
+	// looking down +z from z = -10
+	const BoundingFrustum frustum = CameraFrustum(float3(0.0f, 0.0f, -10.0f), float3(0.0f));
+
+	BB_CHECK(frustum.Overlaps(BoxAt(float3(0.0f, 0.0f, 10.0f), 1.0f)));
+	BB_CHECK(frustum.Surrounds(BoxAt(float3(0.0f, 0.0f, 10.0f), 1.0f)));
+	BB_CHECK(frustum.Overlaps(BoundingSphere(float3(0.0f, 0.0f, 10.0f), 1.0f)));
+
+	BB_CHECK(!frustum.Overlaps(BoxAt(float3(0.0f, 0.0f, -30.0f), 1.0f)));
+	BB_CHECK(!frustum.Overlaps(BoundingSphere(float3(0.0f, 0.0f, -30.0f), 1.0f)));
+
+	// no far plane
+	BB_CHECK(frustum.Overlaps(BoxAt(float3(0.0f, 0.0f, 1e5f), 1.0f)));
+
+	// outside the 45 degree fov
+	BB_CHECK(!frustum.Overlaps(BoxAt(float3(100.0f, 0.0f, 0.0f), 1.0f)));
+	BB_CHECK(!frustum.Overlaps(BoxAt(float3(0.0f, 100.0f, 0.0f), 1.0f)));
+
+	// around the camera, crossing the near plane
+	BB_CHECK(frustum.Overlaps(BoxAt(float3(0.0f, 0.0f, -10.0f), 1.0f)));
+	BB_CHECK(!frustum.Surrounds(BoxAt(float3(0.0f, 0.0f, -10.0f), 1.0f)));
+
+	// turned to look down -x
+	const BoundingFrustum turned = CameraFrustum(float3(0.0f), float3(-1.0f, 0.0f, 0.0f));
+	BB_CHECK(turned.Overlaps(BoxAt(float3(-10.0f, 0.0f, 0.0f), 1.0f)));
+	BB_CHECK(!turned.Overlaps(BoxAt(float3(10.0f, 0.0f, 0.0f), 1.0f)));
+}
+
+BB_TEST(BoundingFrustum_FiniteFarPlaneCulls)
+{
+	const BoundingFrustum frustum = CameraFrustum(float3(0.0f), float3(0.0f, 0.0f, 1.0f), 100.0f);
+
+	BB_CHECK(frustum.Overlaps(BoxAt(float3(0.0f, 0.0f, 50.0f), 1.0f)));
+	BB_CHECK(!frustum.Overlaps(BoxAt(float3(0.0f, 0.0f, 500.0f), 1.0f)));
+	BB_CHECK(!frustum.Overlaps(BoxAt(float3(0.0f, 0.0f, -50.0f), 1.0f)));
+}
+
+// the pre-pass queries SpatialSystem's tree with the camera frustum
+BB_TEST(BoundingFrustum_TreeQueryKeepsOnlyVisible)
+{
+	const BoundingFrustum frustum = CameraFrustum(float3(0.0f, 0.0f, -10.0f), float3(0.0f));
+
+	DynamicAABBTree tree;
+	tree.CreateProxy(BoxAt(float3(0.0f, 0.0f, 10.0f), 1.0f), 1);
+	tree.CreateProxy(BoxAt(float3(0.0f, 0.0f, -30.0f), 1.0f), 2);
+	tree.CreateProxy(BoxAt(float3(2.0f, 1.0f, 1e4f), 1.0f), 3);
+	tree.CreateProxy(BoxAt(float3(-100.0f, 0.0f, 0.0f), 1.0f), 4);
+
+	std::vector< u64 > visible;
+	tree.Query(frustum, [&visible](u32, u64 userData) { visible.push_back(userData); return true; });
+	std::sort(visible.begin(), visible.end());
+
+	BB_CHECK(visible == std::vector< u64 >({ 1, 3 }));
+}
+
+} // namespace baamboo
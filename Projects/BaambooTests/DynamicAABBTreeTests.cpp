@@ -0,0 +1,288 @@
+#include "BaambooPch.h"
+#include "TestHarness.h"
+#include "BaambooScene/DynamicAABBTree.h"
+
+#include <random>
+
+namespace baamboo
+{
+
+namespace
+{
+
+struct Proxy
+{
+	u32         id;
+	BoundingBox aabb;
+};
+
+float3 RandomPoint(std::mt19937& rng, float worldExtent)
+{
+	std::uniform_real_distribution< float > position(-worldExtent, worldExtent);
+	return float3(position(rng), position(rng), position(rng));
+}
+
+BoundingBox RandomBox(std::mt19937& rng, float worldExtent, float maxSize)
+{
+	std::uniform_real_distribution< float > size(0.05f * maxSize, maxSize);
+
+	const float3 center = RandomPoint(rng, worldExtent);
+	const float3 extent = float3(size(rng), size(rng), size(rng)) * 0.5f;
+	return BoundingBox(center - extent, center + extent);
+}
+
+BoundingFrustum RandomFrustum(std::mt19937& rng, float worldExtent)
+{
+	const float3 eye    = RandomPoint(rng, worldExtent);
+	const float3 target = RandomPoint(rng, worldExtent);
+	const mat4   mView  = glm::lookAtLH(eye, target, float3(0.0f, 1.0f, 0.0f));
+	const mat4   mProj  = infinitePerspectiveFovReverseZLH_ZO(glm::radians(60.0f), 1920.0f, 1080.0f, 0.1f);
+	return BoundingFrustum(mProj * mView);
+}
+
+std::vector< Proxy > CreateProxies(DynamicAABBTree& tree, std::mt19937& rng, u32 count, float worldExtent, float maxSize)
+{
+	std::vector< Proxy > proxies;
+	proxies.reserve(count);
+	for (u32 i = 0; i < count; ++i)
+	{
+		const BoundingBox aabb = RandomBox(rng, worldExtent, maxSize);
+		proxies.push_back({ tree.CreateProxy(aabb, i), aabb });
+	}
+	return proxies;
+}
+
+// Queries test the fattened bounds, so the reference does too
+template< typename Test >
+std::vector< u64 > BruteForce(const DynamicAABBTree& tree, const std::vector< Proxy >& proxies, Test&& test)
+{
+	std::vector< u64 > hits;
+	for (const auto& proxy : proxies)
+	{
+		if (test(tree.GetFatAABB(proxy.id)))
+			hits.push_back(tree.GetUserData(proxy.id));
+	}
+	std::sort(hits.begin(), hits.end());
+	return hits;
+}
+
+template< typename Volume >
+std::vector< u64 > TreeQuery(const DynamicAABBTree& tree, const Volume& volume)
+{
+	std::vector< u64 > hits;
+	tree.Query(volume, [&hits](u32, u64 userData) { hits.push_back(userData); return true; });
+	std::sort(hits.begin(), hits.end());
+	return hits;
+}
+
+bool BoxesOverlap(const BoundingBox& lhs, const BoundingBox& rhs)
+{
+	return glm::all(glm::lessThanEqual(lhs.Min(), rhs.Max())) && glm::all(glm::lessThanEqual(rhs.Min(), lhs.Max()));
+}
+
+bool SphereOverlapsBox(const BoundingSphere& sphere, const BoundingBox& aabb)
+{
+	const float3 delta = glm::clamp(sphere.Center(), aabb.Min(), aabb.Max()) - sphere.Center();
+	return glm::dot(delta, delta) <= sphere.Radius() * sphere.Radius();
+}
+
+// distance at which the ray enters 'aabb', FLT_MAX on a miss
+float RayEnterDistance(const float3& origin, const float3& direction, const BoundingBox& aabb)
+{
+	const float3 invDirection = 1.0f / direction;
+	const float3 t0   = (aabb.Min() - origin) * invDirection;
+	const float3 t1   = (aabb.Max() - origin) * invDirection;
+	const float3 tMin = glm::min(t0, t1);
+	const float3 tMax = glm::max(t0, t1);
+
+	const float enter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+	const float exit  = std::min(std::min(tMax.x, tMax.y), tMax.z);
+	return enter <= exit ? enter : FLT_MAX;
+}
+
+float3 RandomDirection(std::mt19937& rng)
+{
+	std::uniform_real_distribution< float > component(-1.0f, 1.0f);
+	float3 direction;
+	do
+	{
+		direction = float3(component(rng), component(rng), component(rng));
+	} while (glm::dot(direction, direction) < 0.01f);
+	return glm::normalize(direction);
+}
+
+void CheckQueries(const DynamicAABBTree& tree, const std::vector< Proxy >& proxies, std::mt19937& rng, float worldExtent)
+{
+	for (u32 i = 0; i < 32; ++i)
+	{
+		const BoundingBox box = RandomBox(rng, worldExtent, worldExtent * 0.5f);
+		BB_CHECK(TreeQuery(tree, box) == BruteForce(tree, proxies, [&](const BoundingBox& fat) { return BoxesOverlap(box, fat); }));
+
+		std::uniform_real_distribution< float > radius(0.0f, worldExtent * 0.3f);
+		const BoundingSphere sphere(RandomPoint(rng, worldExtent), radius(rng));
+		BB_CHECK(TreeQuery(tree, sphere) == BruteForce(tree, proxies, [&](const BoundingBox& fat) { return SphereOverlapsBox(sphere, fat); }));
+
+		const BoundingFrustum frustum = RandomFrustum(rng, worldExtent);
+		BB_CHECK(TreeQuery(tree, frustum) == BruteForce(tree, proxies, [&](const BoundingBox& fat) { return frustum.Overlaps(fat); }));
+	}
+}
+
+} // anonymous namespace
+
+BB_TEST(DynamicAABBTree_QueriesMatchBruteForce)
+{
+	constexpr float kWorldExtent = 100.0f;
+
+	std::mt19937 rng(7);
+	DynamicAABBTree tree;
+	auto proxies = CreateProxies(tree, rng, 2'000, kWorldExtent, 4.0f);
+	BB_CHECK(tree.NumProxies() == 2'000);
+	CheckQueries(tree, proxies, rng, kWorldExtent);
+
+	// small moves stay in the fat bounds, large ones re-insert
+	std::uniform_real_distribution< float > jitter(-0.05f, 0.05f);
+	for (u32 i = 0; i < proxies.size(); i += 2)
+	{
+		auto& proxy = proxies[i];
+		proxy.aabb = i % 4 == 0
+			? RandomBox(rng, kWorldExtent, 4.0f)
+			: BoundingBox(proxy.aabb.Min() + float3(jitter(rng)), proxy.aabb.Max() + float3(jitter(rng)));
+		tree.MoveProxy(proxy.id, proxy.aabb);
+	}
+
+	for (u32 i = 0; i < proxies.size() / 4; ++i)
+	{
+		tree.DestroyProxy(proxies.back().id);
+		proxies.pop_back();
+	}
+	BB_CHECK(tree.NumProxies() == proxies.size());
+	CheckQueries(tree, proxies, rng, kWorldExtent);
+
+	// every proxy's bounds stay inside its fat bounds
+	for (const auto& proxy : proxies)
+	{
+		const BoundingBox fat = tree.GetFatAABB(proxy.id);
+		BB_CHECK(glm::all(glm::lessThanEqual(fat.Min(), proxy.aabb.Min())) && glm::all(glm::lessThanEqual(proxy.aabb.Max(), fat.Max())));
+	}
+}
+
+BB_TEST(DynamicAABBTree_RayCastReturnsClosest)
+{
+	constexpr float kWorldExtent = 100.0f;
+
+	std::mt19937 rng(11);
+	DynamicAABBTree tree;
+	const auto proxies = CreateProxies(tree, rng, 2'000, kWorldExtent, 4.0f);
+
+	for (u32 i = 0; i < 256; ++i)
+	{
+		const float3 origin    = RandomPoint(rng, kWorldExtent);
+		const float3 direction = RandomDirection(rng);
+
+		float closest = FLT_MAX;
+		for (const auto& proxy : proxies)
+			closest = std::min(closest, RayEnterDistance(origin, direction, tree.GetFatAABB(proxy.id)));
+
+		// FLT_MAX as the limit must still skip the proxies the ray misses
+		float treeClosest = FLT_MAX;
+		u32   numMissesReported = 0;
+		tree.RayCast(origin, direction, FLT_MAX, [&](u32, u64, float distance)
+			{
+				numMissesReported += distance == FLT_MAX ? 1 : 0;
+				treeClosest = std::min(treeClosest, distance);
+				return distance;
+			});
+
+		BB_CHECK(closest == treeClosest);
+		BB_CHECK(numMissesReported == 0);
+	}
+}
+
+BB_TEST(DynamicAABBTree_QueryStopsWhenCallbackReturnsFalse)
+{
+	std::mt19937 rng(3);
+	DynamicAABBTree tree;
+	CreateProxies(tree, rng, 256, 10.0f, 4.0f);
+
+	u32 numReported = 0;
+	tree.Query(BoundingBox(float3(-100.0f), float3(100.0f)), [&numReported](u32, u64) { return ++numReported < 5; });
+	BB_CHECK(numReported == 5);
+}
+
+BB_BENCH(DynamicAABBTree_100k)
+{
+	constexpr u32   kNumProxies  = 100'000;
+	constexpr float kWorldExtent = 1'000.0f;
+	constexpr u32   kNumQueries  = 1'000;
+
+	std::mt19937 rng(42);
+	DynamicAABBTree tree;
+
+	std::vector< Proxy > proxies;
+	const double buildMs = test::MeasureMs(1, [&]() { proxies = CreateProxies(tree, rng, kNumProxies, kWorldExtent, 8.0f); });
+	printf("  build      %8.2f ms  (%u proxies, height %u, area ratio %.1f)\n", buildMs, tree.NumProxies(), tree.Height(), tree.AreaRatio());
+
+	std::vector< BoundingBox >     boxes;
+	std::vector< BoundingSphere >  spheres;
+	std::vector< BoundingFrustum > frustums;
+	std::vector< float3 >          rayOrigins;
+	std::vector< float3 >          rayDirections;
+	std::uniform_real_distribution< float > radius(1.0f, 50.0f);
+	for (u32 i = 0; i < kNumQueries; ++i)
+	{
+		boxes.push_back(RandomBox(rng, kWorldExtent, 100.0f));
+		spheres.emplace_back(RandomPoint(rng, kWorldExtent), radius(rng));
+		rayOrigins.push_back(RandomPoint(rng, kWorldExtent));
+		rayDirections.push_back(RandomDirection(rng));
+	}
+	for (u32 i = 0; i < 16; ++i)
+		frustums.push_back(RandomFrustum(rng, kWorldExtent));
+
+	u64 numHits = 0;
+	auto countHits = [&numHits](u32, u64) { ++numHits; return true; };
+
+	const double boxMs = test::MeasureMs(3, [&]() { for (const auto& box : boxes) tree.Query(box, countHits); });
+	printf("  box        %8.4f ms / query\n", boxMs / kNumQueries);
+
+	const double sphereMs = test::MeasureMs(3, [&]() { for (const auto& sphere : spheres) tree.Query(sphere, countHits); });
+	printf("  sphere     %8.4f ms / query\n", sphereMs / kNumQueries);
+
+	numHits = 0;
+	const double frustumMs = test::MeasureMs(1, [&]() { for (const auto& frustum : frustums) tree.Query(frustum, countHits); });
+	printf("  frustum    %8.4f ms / query  (%.0f visible on average)\n", frustumMs / frustums.size(), static_cast< double >(numHits) / frustums.size());
+
+	const double rayMs = test::MeasureMs(3, [&]()
+		{
+			for (u32 i = 0; i < kNumQueries; ++i)
+				tree.RayCast(rayOrigins[i], rayDirections[i], FLT_MAX, [](u32, u64, float distance) { return distance; });
+		});
+	printf("  ray        %8.4f ms / query\n", rayMs / kNumQueries);
+
+	// the linear scan every query used to be
+	u64 numBruteHits = 0;
+	const double bruteMs = test::MeasureMs(1, [&]()
+		{
+			for (const auto& frustum : frustums)
+				for (const auto& proxy : proxies)
+					numBruteHits += frustum.Overlaps(tree.GetFatAABB(proxy.id)) ? 1 : 0;
+		});
+	printf("  brute      %8.4f ms / frustum\n", bruteMs / frustums.size());
+	BB_CHECK(numHits == numBruteHits);
+
+	std::uniform_real_distribution< float > jitter(-0.5f, 0.5f);
+	u32 numReinserted = 0;
+	const double moveMs = test::MeasureMs(1, [&]()
+		{
+			for (u32 i = 0; i < kNumProxies; i += 10)
+			{
+				const float3 offset = float3(jitter(rng), jitter(rng), jitter(rng));
+				proxies[i].aabb = BoundingBox(proxies[i].aabb.Min() + offset, proxies[i].aabb.Max() + offset);
+				numReinserted += tree.MoveProxy(proxies[i].id, proxies[i].aabb) ? 1 : 0;
+			}
+		});
+	printf("  move 10%%   %8.2f ms  (%u re-inserted, height %u)\n", moveMs, numReinserted, tree.Height());
+
+	BB_CHECK(TreeQuery(tree, frustums[0]) == BruteForce(tree, proxies, [&](const BoundingBox& fat) { return frustums[0].Overlaps(fat); }));
+}
+
+} // namespace baamboo
@@ -0,0 +1,316 @@
+#include "BaambooPch.h"
+#include "TestHarness.h"
+#include "BaambooScene/OcclusionBuffer.h"
+
+namespace baamboo
+{
+
+namespace
+{
+
+constexpr float kNear = 0.1f;
+
+struct View
+{
+	mat4 mView;
+	mat4 mProj;
+
+	mat4 ViewProj() const { return mProj * mView; }
+};
+
+View LookAt(const float3& eye, const float3& target)
+{
+	View view;
+	view.mView = glm::lookAtLH(eye, target, float3(0.0f, 1.0f, 0.0f));
+	view.mProj = infinitePerspectiveFovReverseZLH_ZO(glm::radians(90.0f), static_cast< float >(OcclusionBuffer::kWidth), static_cast< float >(OcclusionBuffer::kHeight), kNear);
+	return view;
+}
+
+// two triangles spanning [-1, 1] on x and y, facing -z
+struct Quad
+{
+	Vertex vertices[4] = {};
+	Index  indices[6]  = { 0, 1, 2, 0, 2, 3 };
+
+	Quad()
+	{
+		vertices[0].position = float3(-1.0f, -1.0f, 0.0f);
+		vertices[1].position = float3(-1.0f,  1.0f, 0.0f);
+		vertices[2].position = float3( 1.0f,  1.0f, 0.0f);
+		vertices[3].position = float3( 1.0f, -1.0f, 0.0f);
+	}
+
+	OcclusionBuffer::Occluder At(const mat4& mWorld) const { return { vertices, indices, 6, mWorld }; }
+};
+
+mat4 Place(const float3& position, const float3& halfSize, float yawDegrees = 0.0f)
+{
+	return glm::translate(mat4(1.0f), position)
+		* glm::mat4_cast(glm::angleAxis(glm::radians(yawDegrees), float3(0.0f, 1.0f, 0.0f)))
+		* glm::scale(mat4(1.0f), halfSize);
+}
+
+// Distance along 'direction' (view-space z of 1) to a two-sided triangle, FLT_MAX on a miss
+// or in front of the near plane. Moller-Trumbore with inclusive edges.
+float HitDistance(const float3& eye, const float3& direction, const float3* pTriangle)
+{
+	const float3 e1  = pTriangle[1] - pTriangle[0];
+	const float3 e2  = pTriangle[2] - pTriangle[0];
+	const float3 p   = glm::cross(direction, e2);
+	const float  det = glm::dot(e1, p);
+	if (std::abs(det) < 1e-12f)
+		return FLT_MAX;
+
+	const float3 s = eye - pTriangle[0];
+	const float  u = glm::dot(s, p) / det;
+	const float3 q = glm::cross(s, e1);
+	const float  v = glm::dot(direction, q) / det;
+	const float  distance = glm::dot(e2, q) / det;
+	return u >= 0.0f && v >= 0.0f && u + v <= 1.0f && distance >= kNear ? distance : FLT_MAX;
+}
+
+// Reference depth, inner-conservative like the buffer: rays on a 4x4 grid across each pixel,
+// borders included. An occluder covers a pixel when every ray hits one of its triangles, at
+// the farthest of those hits; the nearest covering occluder wins. A ray's view-space z is 1,
+// so the hit distance is the view depth and the reverse-Z depth is near / distance.
+std::vector< float > ReferenceDepth(const View& view, const std::vector< OcclusionBuffer::Occluder >& occluders)
+{
+	constexpr u32 kWidth    = OcclusionBuffer::kWidth;
+	constexpr u32 kHeight   = OcclusionBuffer::kHeight;
+	constexpr u32 kSamples  = 4;
+	constexpr u32 kSamplesX = kWidth * kSamples + 1;
+	constexpr u32 kSamplesY = kHeight * kSamples + 1;
+
+	const mat4   mInvView = glm::inverse(view.mView);
+	const float3 eye      = float3(mInvView[3]);
+
+	std::vector< float3 > directions(static_cast< size_t >(kSamplesX) * kSamplesY);
+	for (u32 y = 0; y < kSamplesY; ++y)
+	{
+		for (u32 x = 0; x < kSamplesX; ++x)
+		{
+			const float ndcX = static_cast< float >(x) / (kWidth * kSamples) * 2.0f - 1.0f;
+			const float ndcY = 1.0f - static_cast< float >(y) / (kHeight * kSamples) * 2.0f;
+			directions[y * kSamplesX + x] = float3(mInvView * float4(ndcX / view.mProj[0][0], ndcY / view.mProj[1][1], 1.0f, 0.0f));
+		}
+	}
+
+	std::vector< float > depth(kWidth * kHeight, 0.0f);
+	std::vector< float > sampleDepth(directions.size());
+	std::vector< float3 > triangles;
+	for (const auto& occluder : occluders)
+	{
+		triangles.clear();
+		for (u32 i = 0; i < occluder.numIndices; ++i)
+			triangles.push_back(float3(occluder.mWorld * float4(occluder.pVertices[occluder.pIndices[i]].position, 1.0f)));
+
+		// nearest hit on this occluder per ray, 0 on a miss
+		for (size_t i = 0; i < directions.size(); ++i)
+		{
+			float nearest = FLT_MAX;
+			for (size_t t = 0; t < triangles.size(); t += 3)
+				nearest = std::min(nearest, HitDistance(eye, directions[i], &triangles[t]));
+			sampleDepth[i] = nearest != FLT_MAX ? kNear / nearest : 0.0f;
+		}
+
+		for (u32 y = 0; y < kHeight; ++y)
+		{
+			for (u32 x = 0; x < kWidth; ++x)
+			{
+				float farthest = FLT_MAX;
+				for (u32 sy = 0; sy <= kSamples; ++sy)
+				{
+					for (u32 sx = 0; sx <= kSamples; ++sx)
+						farthest = std::min(farthest, sampleDepth[(y * kSamples + sy) * kSamplesX + x * kSamples + sx]);
+				}
+				depth[y * kWidth + x] = std::max(depth[y * kWidth + x], farthest);
+			}
+		}
+	}
+	return depth;
+}
+
+struct DepthDifference
+{
+	u32   numOverCovered  = 0; // drawn, but not fully covered in the reference
+	u32   numUnderCovered = 0; // fully covered in the reference, but not drawn
+	u32   numNearer       = 0; // drawn nearer than the reference; hides too much
+	float maxDepthError   = 0.0f; // in reverse-Z depth, where both drew
+	u32   numCovered      = 0;
+};
+
+DepthDifference Compare(const std::vector< float >& depth, const std::vector< float >& reference)
+{
+	DepthDifference difference;
+	for (size_t i = 0; i < depth.size(); ++i)
+	{
+		const bool bDrawn    = depth[i] > 0.0f;
+		const bool bExpected = reference[i] > 0.0f;
+		difference.numCovered      += bExpected ? 1 : 0;
+		difference.numOverCovered  += bDrawn && !bExpected ? 1 : 0;
+		difference.numUnderCovered += !bDrawn && bExpected ? 1 : 0;
+		if (bDrawn && bExpected)
+		{
+			difference.numNearer     += depth[i] > reference[i] + 1e-6f ? 1 : 0;
+			difference.maxDepthError  = std::max(difference.maxDepthError, std::abs(depth[i] - reference[i]));
+		}
+	}
+	return difference;
+}
+
+// world position at 'depth' along the view axis that lands on screen pixel coordinate 'screen'
+float3 Unproject(const View& view, const float2& screen, float depth)
+{
+	const float ndcX = screen.x / OcclusionBuffer::kWidth * 2.0f - 1.0f;
+	const float ndcY = 1.0f - screen.y / OcclusionBuffer::kHeight * 2.0f;
+	return float3(glm::inverse(view.mView) * float4(ndcX / view.mProj[0][0] * depth, ndcY / view.mProj[1][1] * depth, depth, 1.0f));
+}
+
+BoundingBox BoxAt(const float3& center, float halfSize)
+{
+	return BoundingBox(center - float3(halfSize), center + float3(halfSize));
+}
+
+} // anonymous namespace
+
+BB_TEST(OcclusionBuffer_FacingQuadMatchesReference)
+{
+	const View view = LookAt(float3(0.0f, 0.0f, -10.0f), float3(0.0f));
+	const Quad quad;
+	const std::vector< OcclusionBuffer::Occluder > occluders = { quad.At(Place(float3(0.0f), float3(2.0f))) };
+
+	OcclusionBuffer buffer;
+	buffer.Render(view.ViewProj(), occluders);
+	BB_CHECK(buffer.NumTriangles() == 2);
+
+	// no reference ray lies on an edge, so coverage must match exactly
+	const DepthDifference difference = Compare(buffer.Depth(), ReferenceDepth(view, occluders));
+	BB_CHECK(difference.numCovered > 0);
+	BB_CHECK(difference.numOverCovered == 0 && difference.numUnderCovered == 0);
+	BB_CHECK(difference.maxDepthError < 1e-6f);
+
+	// every covered pixel sits at the quad's depth, near / 10
+	const float quadDepth = kNear / 10.0f;
+	for (float depth : buffer.Depth())
+		BB_CHECK(depth == 0.0f || std::abs(depth - quadDepth) < 1e-6f);
+}
+
+BB_TEST(OcclusionBuffer_SlantedOccludersMatchReference)
+{
+	const View view = LookAt(float3(1.0f, 2.0f, -12.0f), float3(0.0f));
+	const Quad quad;
+	const std::vector< OcclusionBuffer::Occluder > occluders = {
+		quad.At(Place(float3(-2.0f, 0.0f, 0.0f), float3(3.0f, 2.0f, 1.0f), 50.0f)),
+		quad.At(Place(float3( 2.0f, 1.0f, 4.0f), float3(4.0f, 3.0f, 1.0f), -30.0f)),
+		quad.At(Place(float3( 0.0f, -1.0f, 2.0f), float3(1.0f), 80.0f)),
+	};
+
+	OcclusionBuffer buffer;
+	buffer.Render(view.ViewProj(), occluders);
+	BB_CHECK(buffer.NumTriangles() == 6);
+
+	// an edge may clip a pixel between the reference's rays; the buffer may only miss those
+	const DepthDifference difference = Compare(buffer.Depth(), ReferenceDepth(view, occluders));
+	BB_CHECK(difference.numCovered > 1'000);
+	BB_CHECK(difference.numOverCovered == 0);
+	BB_CHECK(difference.numUnderCovered <= 8);
+	BB_CHECK(difference.numNearer == 0);
+	BB_CHECK(difference.maxDepthError < 1e-5f);
+}
+
+BB_TEST(OcclusionBuffer_ClipsOccludersAtNearPlane)
+{
+	// a floor running under and behind the camera
+	const View view = LookAt(float3(0.0f, 1.0f, 0.0f), float3(0.0f, 0.5f, 10.0f));
+	const Quad quad;
+	const mat4 mFloor = glm::mat4_cast(glm::angleAxis(glm::radians(90.0f), float3(1.0f, 0.0f, 0.0f))) * glm::scale(mat4(1.0f), float3(50.0f));
+	const std::vector< OcclusionBuffer::Occluder > occluders = { quad.At(mFloor) };
+
+	OcclusionBuffer buffer;
+	buffer.Render(view.ViewProj(), occluders);
+	BB_CHECK(buffer.NumTriangles() > 2);
+
+	for (float depth : buffer.Depth())
+		BB_CHECK(std::isfinite(depth) && depth >= 0.0f && depth <= 1.0f);
+
+	// clipping splits the floor into more triangles than the reference has; the seams between
+	// them stay closed, and only the cut along the near plane bounds the coverage
+	const DepthDifference difference = Compare(buffer.Depth(), ReferenceDepth(view, occluders));
+	BB_CHECK(difference.numCovered > 1'000);
+	BB_CHECK(difference.numOverCovered == 0);
+	BB_CHECK(difference.numUnderCovered <= 8);
+	BB_CHECK(difference.numNearer == 0);
+	BB_CHECK(difference.maxDepthError < 1e-5f);
+}
+
+BB_TEST(OcclusionBuffer_KeepsObjectsPastOccluderEdges)
+{
+	const View view = LookAt(float3(0.0f, 0.0f, -10.0f), float3(0.0f));
+
+	// a quad 10 units out whose right edge crosses pixel column 200 at x = 200.7; that pixel's
+	// center is inside the quad, but its right third is not
+	const float3 topLeft     = Unproject(view, float2(100.3f, 50.3f), 10.0f);
+	const float3 bottomRight = Unproject(view, float2(200.7f, 150.3f), 10.0f);
+	const float3 halfSize    = glm::abs(bottomRight - topLeft) * 0.5f;
+	const Quad quad;
+	const std::vector< OcclusionBuffer::Occluder > occluders = { quad.At(Place((topLeft + bottomRight) * 0.5f, float3(halfSize.x, halfSize.y, 1.0f))) };
+
+	OcclusionBuffer buffer;
+	buffer.Render(view.ViewProj(), occluders);
+
+	const std::vector< float > reference = ReferenceDepth(view, occluders);
+	const DepthDifference difference = Compare(buffer.Depth(), reference);
+	BB_CHECK(difference.numCovered > 0);
+	BB_CHECK(difference.numOverCovered == 0 && difference.numUnderCovered == 0);
+	BB_CHECK(difference.numNearer == 0);
+
+	// the edge pixels are left empty, in the buffer as in the reference
+	for (u32 y = 60; y < 140; ++y)
+	{
+		BB_CHECK(buffer.Depth()[y * OcclusionBuffer::kWidth + 199] > 0.0f);
+		BB_CHECK(buffer.Depth()[y * OcclusionBuffer::kWidth + 200] == 0.0f);
+		BB_CHECK(reference[y * OcclusionBuffer::kWidth + 200] == 0.0f);
+	}
+
+	// a thin box 30 units out, covering columns 195-200 and showing past the quad from x = 200.7 to 200.85
+	const auto BoxBehind = [&view](float screenMinX, float screenMaxX)
+		{
+			const float3 boxMin = Unproject(view, float2(screenMinX, 110.8f), 30.0f);
+			const float3 boxMax = Unproject(view, float2(screenMaxX, 90.2f), 30.0f);
+			return BoundingBox(boxMin - float3(0.0f, 0.0f, 0.01f), boxMax + float3(0.0f, 0.0f, 0.01f));
+		};
+	BB_CHECK(buffer.IsVisible(BoxBehind(195.2f, 200.85f)));
+
+	// pulled back inside the edge, it is hidden
+	BB_CHECK(!buffer.IsVisible(BoxBehind(150.2f, 198.8f)));
+}
+
+BB_TEST(OcclusionBuffer_IsVisible)
+{
+	const View view = LookAt(float3(0.0f, 0.0f, -10.0f), float3(0.0f));
+	const Quad quad;
+
+	OcclusionBuffer buffer;
+	buffer.Render(view.ViewProj(), {});
+	BB_CHECK(buffer.IsVisible(BoxAt(float3(0.0f, 0.0f, 10.0f), 1.0f)));
+
+	buffer.Render(view.ViewProj(), { quad.At(Place(float3(0.0f), float3(4.0f))) });
+
+	// hidden behind the quad
+	BB_CHECK(!buffer.IsVisible(BoxAt(float3(0.0f, 0.0f, 10.0f), 1.0f)));
+	BB_CHECK(!buffer.IsVisible(BoxAt(float3(1.0f, -1.0f, 30.0f), 2.0f)));
+
+	// in front of it, poking out past its edge, or beside it
+	BB_CHECK(buffer.IsVisible(BoxAt(float3(0.0f, 0.0f, -2.0f), 1.0f)));
+	BB_CHECK(buffer.IsVisible(BoxAt(float3(0.0f, 0.0f, 0.0f), 0.5f)));
+	BB_CHECK(buffer.IsVisible(BoxAt(float3(8.0f, 0.0f, 10.0f), 2.0f)));
+	BB_CHECK(buffer.IsVisible(BoxAt(float3(-20.0f, 0.0f, 10.0f), 1.0f)));
+
+	// around the camera
+	BB_CHECK(buffer.IsVisible(BoxAt(float3(0.0f, 0.0f, -10.0f), 1.0f)));
+
+	// off screen, nothing to draw
+	BB_CHECK(!buffer.IsVisible(BoxAt(float3(0.0f, 100.0f, 10.0f), 1.0f)));
+}
+
+} // namespace baamboo
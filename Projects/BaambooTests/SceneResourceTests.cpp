@@ -0,0 +1,74 @@
+#include "BaambooPch.h"
+#include "TestHarness.h"
+#include "RenderCommon/RenderResources.h"
+#include "SceneRenderView.h"
+
+namespace baamboo
+{
+
+namespace
+{
+
+// exposes the backend-independent instance packing; draw i carries mesh i
+class PackingSceneResource : public render::SceneResource
+{
+public:
+	explicit PackingSceneResource(u32 numDraws)
+	{
+		for (u32 i = 0; i < numDraws; ++i)
+		{
+			InstanceData instance = {};
+			instance.meshID    = i;
+			instance.visOffset = i * 4;
+			m_DrawInstances.push_back({ 100 + i, instance });
+		}
+	}
+
+	virtual void UpdateSceneResources(const SceneRenderView&, render::CommandContext&) override {}
+	virtual void BindSceneResources(render::CommandContext&) override {}
+
+	u32 Pack(const SceneRenderView& view, std::vector< InstanceData >& outInstances) const { return PackDrawInstances(view, outInstances); }
+};
+
+std::vector< u32 > MeshIds(const std::vector< InstanceData >& instances)
+{
+	std::vector< u32 > meshIds;
+	for (const auto& instance : instances)
+		meshIds.push_back(instance.meshID);
+	return meshIds;
+}
+
+} // anonymous namespace
+
+BB_TEST(SceneResource_UnculledViewKeepsDrawOrder)
+{
+	const PackingSceneResource sceneResource(4);
+
+	SceneRenderView view = {};
+	std::vector< InstanceData > instances;
+	BB_CHECK(sceneResource.Pack(view, instances) == 4);
+	BB_CHECK(MeshIds(instances) == std::vector< u32 >({ 0, 1, 2, 3 }));
+}
+
+BB_TEST(SceneResource_VisibleDrawsPackFirst)
+{
+	const PackingSceneResource sceneResource(5);
+
+	SceneRenderView view = {};
+	view.bCpuCulled   = true;
+	view.visibleDraws = { 101, 104 };
+
+	std::vector< InstanceData > instances;
+	BB_CHECK(sceneResource.Pack(view, instances) == 2);
+	BB_CHECK(MeshIds(instances) == std::vector< u32 >({ 1, 4, 0, 2, 3 }));
+
+	// meshlet visibility slots stay with their draw
+	BB_CHECK(instances[1].visOffset == 16);
+
+	// re-packing reuses the list and nothing else changes
+	view.visibleDraws = {};
+	BB_CHECK(sceneResource.Pack(view, instances) == 0);
+	BB_CHECK(instances.size() == 5);
+}
+
+} // namespace baamboo
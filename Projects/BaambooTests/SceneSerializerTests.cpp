@@ -0,0 +1,360 @@
+#include "BaambooPch.h"
+#include "TestHarness.h"
+#include "BaambooScene/Camera.h"
+#include "BaambooScene/Entity.h"
+
+namespace baamboo
+{
+
+namespace
+{
+
+// a scene file in the temp directory, removed with it
+struct TempSceneFile
+{
+	fs::path path;
+
+	explicit TempSceneFile(const char* name) : path(fs::temp_directory_path() / name) {}
+	~TempSceneFile()
+	{
+		std::error_code error;
+		fs::remove(path, error);
+	}
+};
+
+// geometry outlives both scenes; mesh components only point at it
+struct Triangle
+{
+	Vertex vertices[3] = {};
+	Index  indices[3]  = { 0, 1, 2 };
+
+	Triangle()
+	{
+		vertices[0].position = float3(-1.0f, 0.0f, 0.0f);
+		vertices[1].position = float3( 0.0f, 1.0f, 0.0f);
+		vertices[2].position = float3( 1.0f, 0.0f, 0.0f);
+	}
+};
+
+Entity CreateChild(Scene& scene, Entity parent, const std::string& tag, const float3& localPosition)
+{
+	Entity entity = scene.CreateEntity(tag);
+	entity.GetComponent< TransformComponent >().transform.position = localPosition;
+	if (parent)
+		parent.AttachChild(entity.ID());
+	return entity;
+}
+
+//  Root ─┬─ Lamp (spot light)
+//        └─ Wall ── Brick (mesh, two-layer material)
+//  Sun (directional light, rotated)
+void BuildScene(Scene& scene, const Triangle& triangle)
+{
+	Entity root = CreateChild(scene, {}, "Root", float3(10.0f, 0.0f, 0.0f));
+	root.GetComponent< TransformComponent >().transform.scale = float3(2.0f);
+
+	Entity lamp = CreateChild(scene, root, "Lamp", float3(0.0f, 3.0f, 0.0f));
+	lamp.AttachComponent< LightComponent >().SetDefaultSpot();
+
+	Entity wall  = CreateChild(scene, root, "Wall", float3(0.0f, 0.0f, 5.0f));
+	Entity brick = CreateChild(scene, wall, "Brick", float3(1.0f, 0.0f, 0.0f));
+
+	auto& mesh = brick.AttachComponent< StaticMeshComponent >();
+	mesh.tag         = "triangle";
+	mesh.path        = "meshes/triangle.gltf";
+	mesh.aabb        = BoundingBox(float3(-1.0f, 0.0f, 0.0f), float3(1.0f, 1.0f, 0.0f));
+	mesh.sphere      = BoundingSphere(float3(0.0f, 0.5f, 0.0f), 1.2f);
+	mesh.pVertices   = const_cast< Vertex* >(triangle.vertices);
+	mesh.numVertices = 3;
+	mesh.lods[0].pIndices   = const_cast< Index* >(triangle.indices);
+	mesh.lods[0].numIndices = 3;
+	mesh.maxLOD = 0;
+
+	auto& material = brick.AttachComponent< MaterialComponent >();
+	material.layers.resize(2);
+	material.layers[0].material.name      = "Brick";
+	material.layers[0].material.albedoTex = "textures/brick_albedo.png";
+	material.layers[0].material.roughness = 0.8f;
+	material.layers[1].material.name      = "Dust";
+	material.layers[1].thickness          = 0.01f;
+	material.layers[1].sigmaA             = float3(0.1f, 0.2f, 0.3f);
+
+	Entity sun = CreateChild(scene, {}, "Sun", float3(0.0f, 100.0f, 0.0f));
+	sun.GetComponent< TransformComponent >().transform.rotation = float3(45.0f, 30.0f, 0.0f);
+	sun.AttachComponent< LightComponent >().SetDefaultDirectionalLight();
+}
+
+entt::entity FindByTag(const Scene& scene, const std::string& tag)
+{
+	for (auto entity : scene.Registry().view< TagComponent >())
+	{
+		if (scene.Registry().get< TagComponent >(entity).tag == tag)
+			return entity;
+	}
+	return entt::null;
+}
+
+std::string TagOf(const Scene& scene, entt::entity entity)
+{
+	return entity != entt::null ? scene.Registry().get< TagComponent >(entity).tag : std::string();
+}
+
+// parent's tag, then each child's tag in sibling order
+std::vector< std::string > HierarchyOf(const Scene& scene, entt::entity entity)
+{
+	const auto& hierarchy = scene.Registry().get< TransformComponent >(entity).hierarchy;
+
+	std::vector< std::string > tags = { TagOf(scene, hierarchy.parent) };
+	for (auto child = hierarchy.firstChild; child != entt::null; child = scene.Registry().get< TransformComponent >(child).hierarchy.nextSibling)
+		tags.push_back(TagOf(scene, child));
+	return tags;
+}
+
+float3 WorldPosition(const Scene& scene, entt::entity entity)
+{
+	const auto* pTransformSystem = scene.GetTransformSystem();
+	return float3(pTransformSystem->WorldMatrix(scene.Registry().get< TransformComponent >(entity).world)[3]);
+}
+
+void UpdateTransforms(Scene& scene)
+{
+	CameraController_FirstPerson controller;
+	EditorCamera camera(controller, 1, 1);
+	scene.GetTransformSystem()->UpdateRenderData(camera);
+}
+
+bool SameLight(const LightComponent& lhs, const LightComponent& rhs)
+{
+	return lhs.type == rhs.type
+		&& lhs.color == rhs.color
+		&& lhs.temperatureK == rhs.temperatureK
+		&& lhs.luminousFluxLm == rhs.luminousFluxLm
+		&& lhs.radiusM == rhs.radiusM
+		&& lhs.angularRadiusRad == rhs.angularRadiusRad
+		&& lhs.innerConeAngleRad == rhs.innerConeAngleRad
+		&& lhs.outerConeAngleRad == rhs.outerConeAngleRad;
+}
+
+// A saved file held in memory, to break it on purpose. A transform record stores the entity
+// index, the transform, then its hierarchy links as entity indices; the transform finds it.
+struct SceneFileBytes
+{
+	enum eLink : u32 { Parent, FirstChild, LastChild, PrevSibling, NextSibling };
+
+	std::vector< char > bytes;
+
+	explicit SceneFileBytes(const fs::path& path)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		bytes.assign(std::istreambuf_iterator< char >(stream), std::istreambuf_iterator< char >());
+	}
+
+	bool Save(const fs::path& path) const
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream.write(bytes.data(), static_cast< std::streamsize >(bytes.size()));
+		return static_cast< bool >(stream);
+	}
+
+	// offset of the links following 'transform', 0 when it is not in the file
+	size_t FindLinks(const Transform& transform) const
+	{
+		const char* pTransform = reinterpret_cast< const char* >(&transform);
+		const auto  it         = std::search(bytes.begin(), bytes.end(), pTransform, pTransform + sizeof(Transform));
+		return it != bytes.end() ? static_cast< size_t >(it - bytes.begin()) + sizeof(Transform) : 0;
+	}
+
+	u32 Link(size_t links, eLink link) const
+	{
+		u32 index = 0;
+		std::memcpy(&index, bytes.data() + links + link * sizeof(u32), sizeof(u32));
+		return index;
+	}
+
+	void SetLink(size_t links, eLink link, u32 index)
+	{
+		std::memcpy(bytes.data() + links + link * sizeof(u32), &index, sizeof(u32));
+	}
+};
+
+} // anonymous namespace
+
+BB_TEST(SceneSerializer_SaveLoadRoundTrip)
+{
+	const TempSceneFile file("BaambooTests_RoundTrip.bscene");
+	const Triangle      triangle;
+
+	Scene saved("Saved");
+	BuildScene(saved, triangle);
+	BB_CHECK(saved.SaveToFile(file.path));
+
+	Scene loaded("Loaded");
+	BB_CHECK(loaded.LoadFromFile(file.path));
+	BB_CHECK(loaded.Registry().view< TagComponent >().size() == saved.Registry().view< TagComponent >().size());
+
+	for (const char* tag : { "Root", "Lamp", "Wall", "Brick", "Sun" })
+	{
+		const entt::entity original = FindByTag(saved, tag);
+		const entt::entity restored = FindByTag(loaded, tag);
+		BB_CHECK(restored != entt::null);
+		if (restored == entt::null)
+			continue;
+
+		const auto& originalTransform = saved.Registry().get< TransformComponent >(original);
+		const auto& restoredTransform = loaded.Registry().get< TransformComponent >(restored);
+		BB_CHECK(restoredTransform.transform == originalTransform.transform);
+		BB_CHECK(restoredTransform.hierarchy.depth == originalTransform.hierarchy.depth);
+		BB_CHECK(HierarchyOf(loaded, restored) == HierarchyOf(saved, original));
+		BB_CHECK(loaded.Registry().all_of< RootComponent >(restored) == saved.Registry().all_of< RootComponent >(original));
+
+		BB_CHECK(loaded.Registry().all_of< LightComponent >(restored) == saved.Registry().all_of< LightComponent >(original));
+		if (saved.Registry().all_of< LightComponent >(original) && loaded.Registry().all_of< LightComponent >(restored))
+			BB_CHECK(SameLight(loaded.Registry().get< LightComponent >(restored), saved.Registry().get< LightComponent >(original)));
+	}
+
+	// the loaded hierarchy propagates like the one it was saved from
+	UpdateTransforms(saved);
+	UpdateTransforms(loaded);
+	for (const char* tag : { "Root", "Lamp", "Wall", "Brick", "Sun" })
+		BB_CHECK(glm::all(glm::equal(WorldPosition(loaded, FindByTag(loaded, tag)), WorldPosition(saved, FindByTag(saved, tag)))));
+	BB_CHECK(glm::all(glm::equal(WorldPosition(loaded, FindByTag(loaded, "Brick")), float3(12.0f, 0.0f, 10.0f))));
+
+	const entt::entity brick = FindByTag(loaded, "Brick");
+	BB_CHECK(loaded.Registry().all_of< StaticMeshComponent, MaterialComponent >(brick));
+	if (!loaded.Registry().all_of< StaticMeshComponent, MaterialComponent >(brick))
+		return;
+
+	// geometry is read from the mapped file, not from the saved scene's arrays
+	const auto& mesh = loaded.Registry().get< StaticMeshComponent >(brick);
+	BB_CHECK(mesh.tag == "triangle");
+	BB_CHECK(mesh.path == "meshes/triangle.gltf");
+	BB_CHECK(mesh.aabb.Min() == float3(-1.0f, 0.0f, 0.0f) && mesh.aabb.Max() == float3(1.0f, 1.0f, 0.0f));
+	BB_CHECK(mesh.sphere.Radius() == 1.2f);
+	BB_CHECK(mesh.numVertices == 3 && mesh.pVertices && mesh.pVertices != triangle.vertices);
+	BB_CHECK(mesh.lods[0].numIndices == 3 && mesh.lods[0].pIndices);
+	BB_CHECK(mesh.lods[1].pIndices == nullptr && mesh.lods[1].numIndices == 0);
+	if (mesh.pVertices && mesh.lods[0].pIndices)
+	{
+		for (u32 i = 0; i < 3; ++i)
+		{
+			BB_CHECK(mesh.pVertices[i].position == triangle.vertices[i].position);
+			BB_CHECK(mesh.lods[0].pIndices[i] == triangle.indices[i]);
+		}
+	}
+
+	const auto& layers = loaded.Registry().get< MaterialComponent >(brick).layers;
+	BB_CHECK(layers.size() == 2);
+	if (layers.size() == 2)
+	{
+		BB_CHECK(layers[0].material.name == "Brick");
+		BB_CHECK(layers[0].material.albedoTex == "textures/brick_albedo.png");
+		BB_CHECK(layers[0].material.normalTex.empty());
+		BB_CHECK(layers[0].material.roughness == 0.8f);
+		BB_CHECK(layers[1].material.name == "Dust");
+		BB_CHECK(layers[1].thickness == 0.01f);
+		BB_CHECK(layers[1].sigmaA == float3(0.1f, 0.2f, 0.3f));
+	}
+}
+
+BB_TEST(SceneSerializer_LoadAddsToExistingEntities)
+{
+	const TempSceneFile file("BaambooTests_Append.bscene");
+	const Triangle      triangle;
+
+	Scene saved("Saved");
+	BuildScene(saved, triangle);
+	BB_CHECK(saved.SaveToFile(file.path));
+
+	Scene scene("Existing");
+	Entity existing = CreateChild(scene, {}, "Existing", float3(1.0f));
+	BB_CHECK(scene.LoadFromFile(file.path));
+	BB_CHECK(scene.LoadFromFile(file.path));
+
+	BB_CHECK(existing.IsValid());
+	BB_CHECK(existing.GetComponent< TagComponent >().tag == "Existing");
+	BB_CHECK(scene.Registry().view< TagComponent >().size() == 1 + 2 * saved.Registry().view< TagComponent >().size());
+	BB_CHECK(scene.Registry().view< RootComponent >().size() == 1 + 2 * saved.Registry().view< RootComponent >().size());
+}
+
+BB_TEST(SceneSerializer_DamagedFileFailsLoad)
+{
+	const TempSceneFile file("BaambooTests_Damaged.bscene");
+	const Triangle      triangle;
+
+	Scene saved("Saved");
+	BuildScene(saved, triangle);
+	BB_CHECK(saved.SaveToFile(file.path));
+	const auto fileSize = fs::file_size(file.path);
+
+	// a failed load leaves the scene as it was
+	Scene scene("Damaged");
+	auto numEntities = [&scene]() { return scene.Registry().view< TagComponent >().size(); };
+
+	fs::resize_file(file.path, fileSize / 2);
+	BB_CHECK(!scene.LoadFromFile(file.path));
+	BB_CHECK(numEntities() == 0);
+
+	fs::resize_file(file.path, 8);
+	BB_CHECK(!scene.LoadFromFile(file.path));
+	BB_CHECK(numEntities() == 0);
+
+	// not a scene file
+	BB_CHECK(saved.SaveToFile(file.path));
+	{
+		std::fstream stream(file.path, std::ios::in | std::ios::out | std::ios::binary);
+		const u32 magic = 0;
+		stream.write(reinterpret_cast< const char* >(&magic), sizeof(magic));
+	}
+	BB_CHECK(!scene.LoadFromFile(file.path));
+	BB_CHECK(numEntities() == 0);
+
+	const TempSceneFile missing("BaambooTests_Missing.bscene");
+	BB_CHECK(!scene.LoadFromFile(missing.path));
+	BB_CHECK(numEntities() == 0);
+}
+
+BB_TEST(SceneSerializer_BrokenHierarchyFailsLoad)
+{
+	const TempSceneFile file("BaambooTests_Hierarchy.bscene");
+	const Triangle      triangle;
+
+	Scene saved("Saved");
+	BuildScene(saved, triangle);
+	BB_CHECK(saved.SaveToFile(file.path));
+
+	const SceneFileBytes original(file.path);
+	const size_t wall = original.FindLinks(saved.Registry().get< TransformComponent >(FindByTag(saved, "Wall")).transform);
+	BB_CHECK(wall != 0);
+	if (wall == 0)
+		return;
+
+	Scene scene("Broken");
+	auto numEntities = [&scene]() { return scene.Registry().view< TagComponent >().size(); };
+	auto LoadBroken  = [&](SceneFileBytes::eLink link, u32 index)
+		{
+			SceneFileBytes broken = original;
+			broken.SetLink(wall, link, index);
+			return broken.Save(file.path) && scene.LoadFromFile(file.path);
+		};
+
+	// every index stays in range; only the links disagree
+	const u32 brick = original.Link(wall, SceneFileBytes::FirstChild);
+	const u32 lamp  = original.Link(wall, SceneFileBytes::PrevSibling);
+
+	// Wall under its own child
+	BB_CHECK(!LoadBroken(SceneFileBytes::Parent, brick));
+	// Lamp still points on to Wall, Wall no longer points back
+	BB_CHECK(!LoadBroken(SceneFileBytes::PrevSibling, kInvalidIndex));
+	// Wall, the last child, leading back to Lamp
+	BB_CHECK(!LoadBroken(SceneFileBytes::NextSibling, lamp));
+	// Brick stays Wall's child but drops out of its child list
+	BB_CHECK(!LoadBroken(SceneFileBytes::FirstChild, kInvalidIndex));
+	BB_CHECK(numEntities() == 0);
+
+	// the untouched file still loads
+	BB_CHECK(original.Save(file.path));
+	BB_CHECK(scene.LoadFromFile(file.path));
+	BB_CHECK(numEntities() == saved.Registry().view< TagComponent >().size());
+}
+
+} // namespace baamboo
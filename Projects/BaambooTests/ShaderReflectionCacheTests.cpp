@@ -0,0 +1,219 @@
+#include "BaambooPch.h"
+#include "TestHarness.h"
+#include "RenderCommon/ShaderReflectionCache.hpp"
+
+namespace baamboo
+{
+
+namespace
+{
+
+constexpr u32 kVersion = 3;
+
+// laid out the way the backends write theirs: fixed fields, then counted lists
+struct Descriptor
+{
+	std::string name;
+	u32         binding   = 0;
+	u32         arraySize = 0;
+};
+
+struct Reflection
+{
+	u32                       localSize[3] = {};
+	std::vector< Descriptor > descriptors;
+};
+
+Reflection MakeReflection()
+{
+	Reflection reflection;
+	reflection.localSize[0] = 8;
+	reflection.localSize[1] = 8;
+	reflection.localSize[2] = 1;
+	reflection.descriptors  = { { "g_SceneData", 0, 1 }, { "g_Textures", 1, 4'096 }, { "", 2, 1 } };
+	return reflection;
+}
+
+render::ReflectionWriter Write(const Reflection& reflection)
+{
+	render::ReflectionWriter writer;
+	for (u32 size : reflection.localSize)
+		writer.Write(size);
+
+	writer.Write(static_cast< u32 >(reflection.descriptors.size()));
+	for (const auto& descriptor : reflection.descriptors)
+	{
+		writer.WriteString(descriptor.name);
+		writer.Write(descriptor.binding);
+		writer.Write(descriptor.arraySize);
+	}
+	return writer;
+}
+
+Reflection Read(render::ReflectionReader& reader)
+{
+	Reflection reflection;
+	for (u32& size : reflection.localSize)
+		size = reader.Read< u32 >();
+
+	const u32 numDescriptors = reader.Read< u32 >();
+	for (u32 i = 0; i < numDescriptors && reader.IsValid(); ++i)
+	{
+		Descriptor& descriptor = reflection.descriptors.emplace_back();
+		descriptor.name      = reader.ReadString();
+		descriptor.binding   = reader.Read< u32 >();
+		descriptor.arraySize = reader.Read< u32 >();
+	}
+	return reflection;
+}
+
+// a stand-in binary in the temp directory; its sidecar is removed with it
+struct TempBinary
+{
+	std::string       path;
+	std::vector< u8 > bytes;
+
+	explicit TempBinary(const char* name)
+		: path((std::filesystem::temp_directory_path() / name).string())
+	{
+		for (u32 i = 0; i < 256; ++i)
+			bytes.push_back(static_cast< u8 >(i * 31 + 7));
+	}
+
+	~TempBinary()
+	{
+		std::error_code error;
+		std::filesystem::remove(Sidecar(), error);
+	}
+
+	u64 Hash() const { return render::HashShaderBinary(bytes.data(), bytes.size()); }
+	std::filesystem::path Sidecar() const { return render::GetReflectionSidecarPath(path); }
+};
+
+} // anonymous namespace
+
+BB_TEST(ShaderReflectionCache_RoundTrip)
+{
+	const TempBinary binary("BaambooTests_RoundTrip.spv");
+	const Reflection written = MakeReflection();
+	BB_CHECK(Write(written).Save(binary.Sidecar(), kVersion, binary.Hash()));
+	BB_CHECK(binary.Sidecar().string() == binary.path + ".refl");
+
+	render::ReflectionReader reader;
+	BB_CHECK(reader.Load(binary.Sidecar(), kVersion, binary.Hash()));
+
+	const Reflection read = Read(reader);
+	BB_CHECK(reader.IsComplete());
+	BB_CHECK(std::equal(std::begin(read.localSize), std::end(read.localSize), std::begin(written.localSize)));
+	BB_CHECK(read.descriptors.size() == written.descriptors.size());
+	for (size_t i = 0; i < std::min(read.descriptors.size(), written.descriptors.size()); ++i)
+	{
+		BB_CHECK(read.descriptors[i].name == written.descriptors[i].name);
+		BB_CHECK(read.descriptors[i].binding == written.descriptors[i].binding);
+		BB_CHECK(read.descriptors[i].arraySize == written.descriptors[i].arraySize);
+	}
+}
+
+BB_TEST(ShaderReflectionCache_EmptyPayloadRoundTrips)
+{
+	const TempBinary binary("BaambooTests_EmptyPayload.spv");
+	BB_CHECK(render::ReflectionWriter().Save(binary.Sidecar(), kVersion, binary.Hash()));
+
+	render::ReflectionReader reader;
+	BB_CHECK(reader.Load(binary.Sidecar(), kVersion, binary.Hash()));
+	BB_CHECK(reader.IsComplete());
+
+	reader.Read< u8 >();
+	BB_CHECK(!reader.IsValid());
+}
+
+BB_TEST(ShaderReflectionCache_StaleSidecarFailsLoad)
+{
+	TempBinary binary("BaambooTests_Stale.spv");
+	BB_CHECK(Write(MakeReflection()).Save(binary.Sidecar(), kVersion, binary.Hash()));
+
+	render::ReflectionReader reader;
+	BB_CHECK(!reader.Load(binary.Sidecar(), kVersion + 1, binary.Hash()));
+	BB_CHECK(reader.Load(binary.Sidecar(), kVersion, binary.Hash()));
+
+	// the binary was recompiled
+	const u64 oldHash = binary.Hash();
+	binary.bytes[100] ^= 0x01;
+	BB_CHECK(binary.Hash() != oldHash);
+	BB_CHECK(!reader.Load(binary.Sidecar(), kVersion, binary.Hash()));
+
+	// a failed load reads nothing, not what the previous load left behind
+	BB_CHECK(reader.Read< u32 >() == 0);
+	BB_CHECK(!reader.IsValid());
+	BB_CHECK(!reader.IsComplete());
+}
+
+BB_TEST(ShaderReflectionCache_MissingSidecarFailsLoad)
+{
+	const TempBinary binary("BaambooTests_Missing.spv");
+
+	render::ReflectionReader reader;
+	BB_CHECK(!reader.Load(binary.Sidecar(), kVersion, binary.Hash()));
+}
+
+BB_TEST(ShaderReflectionCache_DamagedSidecarFailsLoad)
+{
+	const TempBinary binary("BaambooTests_Damaged.spv");
+	BB_CHECK(Write(MakeReflection()).Save(binary.Sidecar(), kVersion, binary.Hash()));
+	const auto fileSize = std::filesystem::file_size(binary.Sidecar());
+
+	// cut short, inside the payload and then inside the header
+	render::ReflectionReader reader;
+	std::filesystem::resize_file(binary.Sidecar(), fileSize - 1);
+	BB_CHECK(!reader.Load(binary.Sidecar(), kVersion, binary.Hash()));
+
+	std::filesystem::resize_file(binary.Sidecar(), sizeof(render::ReflectionHeader) - 4);
+	BB_CHECK(!reader.Load(binary.Sidecar(), kVersion, binary.Hash()));
+
+	// trailing bytes past the recorded payload
+	BB_CHECK(Write(MakeReflection()).Save(binary.Sidecar(), kVersion, binary.Hash()));
+	std::filesystem::resize_file(binary.Sidecar(), fileSize + 8);
+	BB_CHECK(!reader.Load(binary.Sidecar(), kVersion, binary.Hash()));
+
+	// not a sidecar at all
+	{
+		std::ofstream file(binary.Sidecar(), std::ios::binary | std::ios::trunc);
+		const std::vector< char > garbage(fileSize, 'x');
+		file.write(garbage.data(), static_cast< std::streamsize >(garbage.size()));
+	}
+	BB_CHECK(!reader.Load(binary.Sidecar(), kVersion, binary.Hash()));
+}
+
+BB_TEST(ShaderReflectionCache_ReadsStayInsidePayload)
+{
+	const TempBinary binary("BaambooTests_Bounds.spv");
+
+	render::ReflectionWriter writer;
+	writer.Write(u32(7));
+	writer.WriteString("g_Buffer");
+	BB_CHECK(writer.Save(binary.Sidecar(), kVersion, binary.Hash()));
+
+	// stopping early leaves the sidecar valid but incomplete
+	render::ReflectionReader reader;
+	BB_CHECK(reader.Load(binary.Sidecar(), kVersion, binary.Hash()));
+	BB_CHECK(reader.Read< u32 >() == 7);
+	BB_CHECK(reader.IsValid());
+	BB_CHECK(!reader.IsComplete());
+
+	BB_CHECK(reader.ReadString() == "g_Buffer");
+	BB_CHECK(reader.IsComplete());
+
+	// reading past the end zero-fills and stays invalid
+	BB_CHECK(reader.Read< u32 >() == 0);
+	BB_CHECK(!reader.IsValid());
+	BB_CHECK(!reader.IsComplete());
+	BB_CHECK(reader.ReadString().empty());
+
+	// misaligned, so the string length read runs past the end
+	BB_CHECK(reader.Load(binary.Sidecar(), kVersion, binary.Hash()));
+	BB_CHECK(reader.Read< u8 >() == 7);
+	BB_CHECK(reader.ReadString().empty());
+	BB_CHECK(!reader.IsValid());
+}
+
+} // namespace baamboo
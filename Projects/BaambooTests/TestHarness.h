@@ -0,0 +1,93 @@
+#pragma once
+#include "Primitives.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace baamboo::test
+{
+
+// =========================================================================
+// TestHarness — registry behind BaambooTests.
+//
+//   BB_TEST cases run on every invocation, BB_BENCH cases only with
+//   --bench. A failed BB_CHECK is reported and the case keeps going, so one
+//   run lists every broken expectation. Benchmarks print their own timings
+//   and check their results like any test.
+// =========================================================================
+struct TestCase
+{
+	const char* name       = nullptr;
+	void      (*fn)()      = nullptr;
+	bool        bBenchmark = false;
+};
+
+inline std::vector< TestCase >& Registry()
+{
+	static std::vector< TestCase > cases;
+	return cases;
+}
+
+inline u32& NumFailures()
+{
+	static u32 numFailures = 0;
+	return numFailures;
+}
+
+struct Registrar
+{
+	Registrar(const char* name, void (*fn)(), bool bBenchmark) { Registry().push_back({ name, fn, bBenchmark }); }
+};
+
+inline void ReportFailure(const char* expression, const char* file, int line)
+{
+	++NumFailures();
+	fprintf(stderr, "  check failed: %s\n    at %s:%d\n", expression, file, line);
+}
+
+inline void ReportFailure(const char* expression, double lhs, double rhs, const char* file, int line)
+{
+	++NumFailures();
+	fprintf(stderr, "  check failed: %s (%g vs %g)\n    at %s:%d\n", expression, lhs, rhs, file, line);
+}
+
+// fastest of 'numRuns' calls, in milliseconds
+template< typename Fn >
+double MeasureMs(u32 numRuns, Fn&& fn)
+{
+	double bestMs = 1e30;
+	for (u32 i = 0; i < numRuns; ++i)
+	{
+		const auto beginTime = std::chrono::steady_clock::now();
+		fn();
+		bestMs = std::min(bestMs, std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - beginTime).count());
+	}
+	return bestMs;
+}
+
+} // namespace baamboo::test
+
+#define BB_TEST_CASE(name, bBenchmark) \
+	static void name(); \
+	static const baamboo::test::Registrar name##_Registrar(#name, &name, bBenchmark); \
+	static void name()
+
+#define BB_TEST(name)  BB_TEST_CASE(name, false)
+#define BB_BENCH(name) BB_TEST_CASE(name, true)
+
+#define BB_CHECK(cond) \
+	do { \
+		if (!(cond)) \
+			baamboo::test::ReportFailure(#cond, __FILE__, __LINE__); \
+	} while (0)
+
+#define BB_CHECK_NEAR(lhs, rhs, tolerance) \
+	do { \
+		const double bbLhs = static_cast< double >(lhs); \
+		const double bbRhs = static_cast< double >(rhs); \
+		if (!(std::abs(bbLhs - bbRhs) <= static_cast< double >(tolerance))) \
+			baamboo::test::ReportFailure(#lhs " ~= " #rhs, bbLhs, bbRhs, __FILE__, __LINE__); \
+	} while (0)
@@ -0,0 +1,205 @@
+#include "BaambooPch.h"
+#include "TestHarness.h"
+#include "BaambooScene/Camera.h"
+#include "BaambooScene/Systems/TransformSystem.h"
+
+namespace baamboo
+{
+
+namespace
+{
+
+// a registry with only the transform system listening, as Scene wires it
+struct Hierarchy
+{
+	entt::registry  registry;
+	TransformSystem system{ registry };
+
+	CameraController_FirstPerson controller;
+	EditorCamera                 camera{ controller, 1, 1 };
+
+	entt::entity Create(entt::entity parent, const float3& localPosition)
+	{
+		const entt::entity entity = registry.create();
+		registry.emplace< TransformComponent >(entity).transform.position = localPosition;
+		if (parent != entt::null)
+			system.AttachChild(parent, entity);
+		return entity;
+	}
+
+	void Move(entt::entity entity, const float3& offset)
+	{
+		registry.patch< TransformComponent >(entity, [&offset](TransformComponent& component) { component.transform.position += offset; });
+	}
+
+	std::vector< u64 > Update() { return system.UpdateRenderData(camera); }
+
+	float3 WorldPosition(entt::entity entity) const
+	{
+		return float3(system.WorldMatrix(registry.get< TransformComponent >(entity).world)[3]);
+	}
+};
+
+// root, then each node one unit above its parent
+std::vector< entt::entity > CreateChain(Hierarchy& hierarchy, u32 depth)
+{
+	std::vector< entt::entity > chain;
+	chain.reserve(depth);
+	chain.push_back(hierarchy.Create(entt::null, float3(0.0f)));
+	for (u32 i = 1; i < depth; ++i)
+		chain.push_back(hierarchy.Create(chain.back(), float3(0.0f, 1.0f, 0.0f)));
+	return chain;
+}
+
+// root, then 'width' children in a row along x
+std::vector< entt::entity > CreateFan(Hierarchy& hierarchy, u32 width)
+{
+	std::vector< entt::entity > fan;
+	fan.reserve(width + 1);
+	fan.push_back(hierarchy.Create(entt::null, float3(0.0f)));
+	for (u32 i = 0; i < width; ++i)
+		fan.push_back(hierarchy.Create(fan.front(), float3(static_cast< float >(i), 0.0f, 0.0f)));
+	return fan;
+}
+
+bool NearlyEqual(const float3& lhs, const float3& rhs)
+{
+	return glm::all(glm::lessThanEqual(glm::abs(lhs - rhs), float3(1e-4f)));
+}
+
+void BenchRootMoves(const char* label, Hierarchy& hierarchy, entt::entity root, u32 subtreeSize)
+{
+	constexpr u32 kNumMoves = 100;
+
+	double updateMs = 0.0;
+	bool   bAllUpdated = true;
+	for (u32 i = 0; i < kNumMoves; ++i)
+	{
+		hierarchy.Move(root, float3(0.01f, 0.0f, 0.0f));
+		updateMs += test::MeasureMs(1, [&hierarchy]() { hierarchy.Update(); });
+
+		const auto& stats = hierarchy.system.GetStats();
+		bAllUpdated &= stats.numMarked == 1 && stats.numUpdated == subtreeSize;
+	}
+	BB_CHECK(bAllUpdated);
+
+	printf("  %-6s %7u nodes  %8.4f ms / root move  (system reports %.4f ms)\n",
+		label, subtreeSize, updateMs / kNumMoves, hierarchy.system.GetStats().elapsedMs);
+}
+
+} // anonymous namespace
+
+BB_TEST(TransformSystem_RootMoveUpdatesDeepChain)
+{
+	constexpr u32 kDepth = 64;
+
+	Hierarchy hierarchy;
+	const auto chain = CreateChain(hierarchy, kDepth);
+	BB_CHECK(hierarchy.Update().size() == kDepth);
+
+	hierarchy.Move(chain.front(), float3(10.0f, 0.0f, 0.0f));
+	BB_CHECK(hierarchy.Update().size() == kDepth);
+
+	// only the root is marked; the rest see their parent's version change
+	const auto& stats = hierarchy.system.GetStats();
+	BB_CHECK(stats.numMarked == 1);
+	BB_CHECK(stats.numVisited == kDepth);
+	BB_CHECK(stats.numUpdated == kDepth);
+
+	for (u32 i = 0; i < kDepth; ++i)
+		BB_CHECK(NearlyEqual(hierarchy.WorldPosition(chain[i]), float3(10.0f, static_cast< float >(i), 0.0f)));
+}
+
+BB_TEST(TransformSystem_RootMoveUpdatesWideFan)
+{
+	constexpr u32 kWidth = 256;
+
+	Hierarchy hierarchy;
+	const auto fan = CreateFan(hierarchy, kWidth);
+	hierarchy.Update();
+
+	hierarchy.Move(fan.front(), float3(0.0f, 0.0f, 5.0f));
+	hierarchy.Update();
+
+	const auto& stats = hierarchy.system.GetStats();
+	BB_CHECK(stats.numMarked == 1);
+	BB_CHECK(stats.numUpdated == kWidth + 1);
+
+	for (u32 i = 0; i < kWidth; ++i)
+		BB_CHECK(NearlyEqual(hierarchy.WorldPosition(fan[i + 1]), float3(static_cast< float >(i), 0.0f, 5.0f)));
+}
+
+BB_TEST(TransformSystem_InnerMoveUpdatesOnlyItsSubtree)
+{
+	constexpr u32 kDepth = 16;
+
+	Hierarchy hierarchy;
+	const auto chain = CreateChain(hierarchy, kDepth);
+	const auto fan   = CreateFan(hierarchy, 8);
+	hierarchy.Update();
+
+	// nothing changed, nothing recomputed
+	BB_CHECK(hierarchy.Update().empty());
+	BB_CHECK(hierarchy.system.GetStats().numUpdated == 0);
+
+	hierarchy.Move(chain[10], float3(1.0f, 0.0f, 0.0f));
+	hierarchy.Update();
+	BB_CHECK(hierarchy.system.GetStats().numUpdated == kDepth - 10);
+	BB_CHECK(NearlyEqual(hierarchy.WorldPosition(chain[9]), float3(0.0f, 9.0f, 0.0f)));
+	BB_CHECK(NearlyEqual(hierarchy.WorldPosition(chain[kDepth - 1]), float3(1.0f, static_cast< float >(kDepth - 1), 0.0f)));
+
+	// a leaf and a nested node marked together: the nested walk is covered by the outer one
+	hierarchy.Move(fan[3], float3(0.0f, 1.0f, 0.0f));
+	hierarchy.Move(chain[12], float3(0.0f, 0.0f, 1.0f));
+	hierarchy.Move(chain[14], float3(0.0f, 0.0f, 1.0f));
+	hierarchy.Update();
+	BB_CHECK(hierarchy.system.GetStats().numUpdated == 1 + (kDepth - 12));
+	BB_CHECK(NearlyEqual(hierarchy.WorldPosition(fan[3]), float3(2.0f, 1.0f, 0.0f)));
+	BB_CHECK(NearlyEqual(hierarchy.WorldPosition(chain[kDepth - 1]), float3(1.0f, static_cast< float >(kDepth - 1), 2.0f)));
+}
+
+BB_TEST(TransformSystem_ReparentRecomputesSubtree)
+{
+	Hierarchy hierarchy;
+	const auto chain = CreateChain(hierarchy, 4);
+	const auto fan   = CreateFan(hierarchy, 4);
+	hierarchy.Move(fan.front(), float3(100.0f, 0.0f, 0.0f));
+	hierarchy.Update();
+
+	// chain[2] and chain[3] move under the fan's root
+	hierarchy.system.AttachChild(fan.front(), chain[2]);
+	hierarchy.Update();
+	BB_CHECK(NearlyEqual(hierarchy.WorldPosition(chain[2]), float3(100.0f, 1.0f, 0.0f)));
+	BB_CHECK(NearlyEqual(hierarchy.WorldPosition(chain[3]), float3(100.0f, 2.0f, 0.0f)));
+
+	hierarchy.system.DetachChild(chain[2]);
+	hierarchy.Update();
+	BB_CHECK(NearlyEqual(hierarchy.WorldPosition(chain[3]), float3(0.0f, 2.0f, 0.0f)));
+	BB_CHECK(hierarchy.registry.all_of< RootComponent >(chain[2]));
+}
+
+BB_BENCH(TransformSystem_RootMoves)
+{
+	{
+		Hierarchy hierarchy;
+		const auto chain = CreateChain(hierarchy, 4'096);
+		hierarchy.Update();
+		BenchRootMoves("deep", hierarchy, chain.front(), static_cast< u32 >(chain.size()));
+	}
+	{
+		Hierarchy hierarchy;
+		const auto fan = CreateFan(hierarchy, 100'000);
+		hierarchy.Update();
+		BenchRootMoves("wide", hierarchy, fan.front(), static_cast< u32 >(fan.size()));
+	}
+	{
+		// a moved leaf next to the wide tree costs one node, not the tree
+		Hierarchy hierarchy;
+		const auto fan  = CreateFan(hierarchy, 100'000);
+		const auto leaf = hierarchy.Create(entt::null, float3(0.0f));
+		hierarchy.Update();
+		BenchRootMoves("single", hierarchy, leaf, 1);
+	}
+}
+
+} // namespace baamboo
@@ -0,0 +1,76 @@
+// =========================================================================
+// BaambooTests — headless unit tests and CPU benchmarks for the engine.
+//
+//   BaambooTests [--bench] [--list] [filter]...
+//
+//   Runs every test whose name contains one of the filters (all of them
+//   without one); --bench adds the benchmarks. Exits with 1 if any check
+//   failed. Nothing here creates a window or a device.
+// =========================================================================
+#include "TestHarness.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+	using namespace baamboo::test;
+
+	bool bBenchmarks = false;
+	bool bList       = false;
+	std::vector< std::string_view > filters;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string_view arg = argv[i];
+		if (arg == "--bench")
+			bBenchmarks = true;
+		else if (arg == "--list")
+			bList = true;
+		else
+			filters.push_back(arg);
+	}
+
+	// registration order across translation units is unspecified
+	auto cases = Registry();
+	std::sort(cases.begin(), cases.end(), [](const TestCase& lhs, const TestCase& rhs) { return std::strcmp(lhs.name, rhs.name) < 0; });
+
+	auto isSelected = [&](const TestCase& testCase)
+		{
+			if (testCase.bBenchmark && !bBenchmarks)
+				return false;
+			if (filters.empty())
+				return true;
+			return std::any_of(filters.begin(), filters.end(), [&](std::string_view filter) { return std::string_view(testCase.name).find(filter) != std::string_view::npos; });
+		};
+
+	u32 numRun    = 0;
+	u32 numFailed = 0;
+	for (const auto& testCase : cases)
+	{
+		if (!isSelected(testCase))
+			continue;
+
+		if (bList)
+		{
+			printf("%s%s\n", testCase.name, testCase.bBenchmark ? " (bench)" : "");
+			continue;
+		}
+
+		printf("[ RUN    ] %s\n", testCase.name);
+		fflush(stdout);
+
+		const u32 numFailuresBefore = NumFailures();
+		testCase.fn();
+		const bool bPassed = NumFailures() == numFailuresBefore;
+
+		printf("[ %s ] %s\n", bPassed ? "    OK" : "FAILED", testCase.name);
+		++numRun;
+		numFailed += bPassed ? 0 : 1;
+	}
+
+	if (!bList)
+		printf("\n%u run, %u failed\n", numRun, numFailed);
+	return numFailed == 0 ? 0 : 1;
+}
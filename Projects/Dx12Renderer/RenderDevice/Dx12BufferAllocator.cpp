@@ -88,6 +88,7 @@ DynamicBufferAllocator::Page::Page(Dx12RenderDevice& rd, size_t sizeInBytes)
 			.mapDirection       = 1,
 			.bufferUsage        = render::eBufferUsage_TransferSource
 		});
+	m_pBuffer->SetMemoryTag(render::eMemoryTag::DynamicBuffers);
 }
 
 DynamicBufferAllocator::Page::~Page()
@@ -183,6 +184,7 @@ void StaticBufferAllocator::Resize(u32 numElements)
 void StaticBufferAllocator::Resize(u64 elementSizeInBytes, u32 numElements)
 {
 	auto pNewBuffer = Dx12StructuredBuffer::Create(m_RenderDevice, m_Name.c_str(), elementSizeInBytes, numElements, render::eBufferUsage_TransferSource | render::eBufferUsage_TransferDest | m_ExtraUsage);
+	pNewBuffer->SetMemoryTag(render::eMemoryTag::StaticBuffers);
 
 	if (m_OffsetInBytes > 0 && m_pBuffer)
 	{
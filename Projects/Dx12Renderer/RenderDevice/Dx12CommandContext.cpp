@@ -82,42 +82,42 @@ public:
 	void SetComputeRootConstant(u32 rootIdx, u32 srcValue, u32 dstOffset = 0);
 	void SetComputeRootConstants(u32 srcSizeInBytes, const void* pSrcData, u32 dstOffsetInBytes = 0);
 
-	void SetGraphicsDynamicConstantBuffer(const std::string& name, size_t sizeInBytes, const void* pData);
+	void SetGraphicsDynamicConstantBuffer(const render::BindingId& id, size_t sizeInBytes, const void* pData);
 	template< typename T >
-	void SetGraphicsDynamicConstantBuffer(const std::string& name, const T& data)
+	void SetGraphicsDynamicConstantBuffer(const render::BindingId& id, const T& data)
 	{
-		SetGraphicsDynamicConstantBuffer(name, sizeof(T), &data);
+		SetGraphicsDynamicConstantBuffer(id, sizeof(T), &data);
 	}
-	void SetComputeDynamicConstantBuffer(const std::string& name, size_t sizeInBytes, const void* pData);
+	void SetComputeDynamicConstantBuffer(const render::BindingId& id, size_t sizeInBytes, const void* pData);
 	template< typename T >
-	void SetComputeDynamicConstantBuffer(const std::string& name, const T& data)
+	void SetComputeDynamicConstantBuffer(const render::BindingId& id, const T& data)
 	{
-		SetComputeDynamicConstantBuffer(name, sizeof(T), &data);
+		SetComputeDynamicConstantBuffer(id, sizeof(T), &data);
 	}
 
-	void SetGraphicsConstantBufferView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle);
-	void SetGraphicsShaderResourceView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle);
-	void SetComputeConstantBufferView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle);
-	void SetComputeShaderResourceView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle);
-	void SetComputeUnorderedAccessView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle);
+	void SetGraphicsConstantBufferView(const render::BindingId& id, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle);
+	void SetGraphicsShaderResourceView(const render::BindingId& id, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle);
+	void SetComputeConstantBufferView(const render::BindingId& id, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle);
+	void SetComputeShaderResourceView(const render::BindingId& id, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle);
+	void SetComputeUnorderedAccessView(const render::BindingId& id, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle);
 
-	void SetAccelerationStructureSRV(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS gpuAddress);
+	void SetAccelerationStructureSRV(const render::BindingId& id, D3D12_GPU_VIRTUAL_ADDRESS gpuAddress);
 
 	void StageDescriptor(
-		const std::string& name,
+		const render::BindingId& id,
 		Arc< Dx12Buffer > pBuffer,
 		D3D12_DESCRIPTOR_HEAP_TYPE heapType = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 	void StageDescriptor(
-		const std::string& name,
+		const render::BindingId& id,
 		Arc< Dx12Texture > pTexture,
 		D3D12_DESCRIPTOR_HEAP_TYPE heapType = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 	void StageDescriptorMip(
-		const std::string& name,
+		const render::BindingId& id,
 		Arc< Dx12Texture > pTexture,
 		u32 mipLevel,
 		D3D12_DESCRIPTOR_HEAP_TYPE heapType = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
-	void StageDescriptor(const std::string& name, u32 heapIdx, D3D12_DESCRIPTOR_HEAP_TYPE heapType = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	void StageDescriptor(const render::BindingId& id, u32 heapIdx, D3D12_DESCRIPTOR_HEAP_TYPE heapType = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 	void StageDescriptors(
 		std::vector< std::pair< std::string, u32 > >&& srcHandles,
 		D3D12_DESCRIPTOR_HEAP_TYPE heapType = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
@@ -137,9 +137,10 @@ public:
 
 	double GetLastFrameElapsedTime() const;
 
-	void BeginGpuMarker(const char* name, bool bWithStats);
+	void BeginGpuMarker(render::ProfileScopeId scopeId, bool bWithStats);
 	void EndGpuMarker();
 	const std::vector< render::GpuProfileEntry >& GetLastFrameProfile() const;
+	u64 GetLastFrameProfileIndex() const { return m_Timer.GetLastFrameIndex(); }
 
 private:
 	void AddTextureBarrier(const D3D12_TEXTURE_BARRIER& barrier, bool bFlushImmediate);
@@ -265,7 +266,7 @@ void Dx12CommandContext::Impl::Open()
 		m_d3d12CommandList10->SetGraphicsRootSignature(rm.GetGlobalRootSignature()->GetD3D12RootSignature());
 
 		// Reads previous frame's resolved timestamps and opens the implicit "Frame" scope.
-		m_Timer.BeginFrame(m_d3d12CommandList10);
+		m_Timer.BeginFrame(m_d3d12CommandList10, m_RenderDevice.FrameIndex());
 	}
 }
 
@@ -859,12 +860,12 @@ void Dx12CommandContext::Impl::SetComputeRootConstants(u32 srcSizeInBytes, const
 	m_d3d12CommandList10->SetComputeRoot32BitConstants(rootIndex, size, pSrcData, dstOffset);
 }
 
-void Dx12CommandContext::Impl::SetGraphicsDynamicConstantBuffer(const std::string& name, size_t sizeInBytes, const void* pData)
+void Dx12CommandContext::Impl::SetGraphicsDynamicConstantBuffer(const render::BindingId& id, size_t sizeInBytes, const void* pData)
 {
 	auto allocation = m_pConstantBufferPool->Allocate(sizeInBytes, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
 	memcpy(allocation.CPUHandle, pData, sizeInBytes);
 
-	auto [_, rootIndex] = m_pGraphicsPipeline->GetResourceBindingIndex(name);
+	auto [_, rootIndex] = m_pGraphicsPipeline->GetResourceBindingIndex(id);
 	if (rootIndex == kInvalidIndex)
 	{
 		return;
@@ -873,14 +874,14 @@ void Dx12CommandContext::Impl::SetGraphicsDynamicConstantBuffer(const std::strin
 	m_d3d12CommandList10->SetGraphicsRootConstantBufferView(rootIndex, allocation.GPUHandle);
 }
 
-void Dx12CommandContext::Impl::SetComputeDynamicConstantBuffer(const std::string& name, size_t sizeInBytes, const void* pData)
+void Dx12CommandContext::Impl::SetComputeDynamicConstantBuffer(const render::BindingId& id, size_t sizeInBytes, const void* pData)
 {
 	auto allocation = m_pConstantBufferPool->Allocate(sizeInBytes, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
 	memcpy(allocation.CPUHandle, pData, sizeInBytes);
 
 	if (m_pComputePipeline)
 	{
-		auto [_, rootIndex] = m_pComputePipeline->GetResourceBindingIndex(name);
+		auto [_, rootIndex] = m_pComputePipeline->GetResourceBindingIndex(id);
 		if (rootIndex == kInvalidIndex)
 		{
 			return;
@@ -890,7 +891,7 @@ void Dx12CommandContext::Impl::SetComputeDynamicConstantBuffer(const std::string
 	}
 	else if (m_pRaytracingPipeline)
 	{
-		auto [_, rootIndex] = m_pRaytracingPipeline->GetResourceBindingIndex(name);
+		auto [_, rootIndex] = m_pRaytracingPipeline->GetResourceBindingIndex(id);
 		if (rootIndex == kInvalidIndex)
 		{
 			return;
@@ -900,11 +901,11 @@ void Dx12CommandContext::Impl::SetComputeDynamicConstantBuffer(const std::string
 	}
 }
 
-void Dx12CommandContext::Impl::SetGraphicsConstantBufferView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle)
+void Dx12CommandContext::Impl::SetGraphicsConstantBufferView(const render::BindingId& id, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle)
 {
 	assert(IsGraphicsContext());
 
-	auto [_, rootIndex] = m_pComputePipeline->GetResourceBindingIndex(name);
+	auto [_, rootIndex] = m_pComputePipeline->GetResourceBindingIndex(id);
 	if (rootIndex == kInvalidIndex)
 	{
 		return;
@@ -913,9 +914,9 @@ void Dx12CommandContext::Impl::SetGraphicsConstantBufferView(const std::string&
 	m_d3d12CommandList10->SetGraphicsRootConstantBufferView(rootIndex, gpuHandle);
 }
 
-void Dx12CommandContext::Impl::SetGraphicsShaderResourceView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle)
+void Dx12CommandContext::Impl::SetGraphicsShaderResourceView(const render::BindingId& id, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle)
 {
-	auto [_, rootIndex] = m_pGraphicsPipeline->GetResourceBindingIndex(name);
+	auto [_, rootIndex] = m_pGraphicsPipeline->GetResourceBindingIndex(id);
 	if (rootIndex == kInvalidIndex)
 	{
 		return;
@@ -924,9 +925,9 @@ void Dx12CommandContext::Impl::SetGraphicsShaderResourceView(const std::string&
 	m_d3d12CommandList10->SetGraphicsRootShaderResourceView(rootIndex, gpuHandle);
 }
 
-void Dx12CommandContext::Impl::SetComputeConstantBufferView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle)
+void Dx12CommandContext::Impl::SetComputeConstantBufferView(const render::BindingId& id, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle)
 {
-	auto [_, rootIndex] = m_pComputePipeline->GetResourceBindingIndex(name);
+	auto [_, rootIndex] = m_pComputePipeline->GetResourceBindingIndex(id);
 	if (rootIndex == kInvalidIndex)
 	{
 		return;
@@ -935,9 +936,9 @@ void Dx12CommandContext::Impl::SetComputeConstantBufferView(const std::string& n
 	m_d3d12CommandList10->SetComputeRootConstantBufferView(rootIndex, gpuHandle);
 }
 
-void Dx12CommandContext::Impl::SetComputeShaderResourceView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle)
+void Dx12CommandContext::Impl::SetComputeShaderResourceView(const render::BindingId& id, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle)
 {
-	auto [_, rootIndex] = m_pComputePipeline->GetResourceBindingIndex(name);
+	auto [_, rootIndex] = m_pComputePipeline->GetResourceBindingIndex(id);
 	if (rootIndex == kInvalidIndex)
 	{
 		return;
@@ -946,9 +947,9 @@ void Dx12CommandContext::Impl::SetComputeShaderResourceView(const std::string& n
 	m_d3d12CommandList10->SetComputeRootShaderResourceView(rootIndex, gpuHandle);
 }
 
-void Dx12CommandContext::Impl::SetComputeUnorderedAccessView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle)
+void Dx12CommandContext::Impl::SetComputeUnorderedAccessView(const render::BindingId& id, D3D12_GPU_VIRTUAL_ADDRESS gpuHandle)
 {
-	auto [_, rootIndex] = m_pComputePipeline->GetResourceBindingIndex(name);
+	auto [_, rootIndex] = m_pComputePipeline->GetResourceBindingIndex(id);
 	if (rootIndex == kInvalidIndex)
 	{
 		return;
@@ -957,18 +958,18 @@ void Dx12CommandContext::Impl::SetComputeUnorderedAccessView(const std::string&
 	m_d3d12CommandList10->SetComputeRootUnorderedAccessView(rootIndex, gpuHandle);
 }
 
-void Dx12CommandContext::Impl::SetAccelerationStructureSRV(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS gpuAddress)
+void Dx12CommandContext::Impl::SetAccelerationStructureSRV(const render::BindingId& id, D3D12_GPU_VIRTUAL_ADDRESS gpuAddress)
 {
 	u32 rootIndex = kInvalidIndex;
 
 	if (IsRaytracingContext())
 	{
-		auto [_, idx] = m_pRaytracingPipeline->GetResourceBindingIndex(name);
+		auto [_, idx] = m_pRaytracingPipeline->GetResourceBindingIndex(id);
 		rootIndex = idx;
 	}
 	else if (IsComputeContext())
 	{
-		auto [_, idx] = m_pComputePipeline->GetResourceBindingIndex(name);
+		auto [_, idx] = m_pComputePipeline->GetResourceBindingIndex(id);
 		rootIndex = idx;
 	}
 
@@ -981,7 +982,7 @@ void Dx12CommandContext::Impl::SetAccelerationStructureSRV(const std::string& na
 }
 
 void Dx12CommandContext::Impl::StageDescriptor(
-	const std::string& name,
+	const render::BindingId& id,
 	Arc< Dx12Buffer > pBuffer,
 	D3D12_DESCRIPTOR_HEAP_TYPE heapType)
 {
@@ -989,13 +990,13 @@ void Dx12CommandContext::Impl::StageDescriptor(
 	bool bIsUAV = state.GetSubresourceState().Access & D3D12_BARRIER_ACCESS_UNORDERED_ACCESS;
 
 	if (bIsUAV)
-		StageDescriptor(name, pBuffer->GetUnorderedAccessHandle(), heapType);
+		StageDescriptor(id, pBuffer->GetUnorderedAccessHandle(), heapType);
 	else
-		StageDescriptor(name, pBuffer->GetShaderResourceHandle(), heapType);
+		StageDescriptor(id, pBuffer->GetShaderResourceHandle(), heapType);
 }
 
 void Dx12CommandContext::Impl::StageDescriptor(
-	const std::string& name,
+	const render::BindingId& id,
 	Arc< Dx12Texture > pTexture,
 	D3D12_DESCRIPTOR_HEAP_TYPE heapType)
 {
@@ -1005,28 +1006,28 @@ void Dx12CommandContext::Impl::StageDescriptor(
 
 	if (bIsUAV)
 	{
-		StageDescriptor(name, pTexture->GetUnorderedAccessHandle(), heapType);
+		StageDescriptor(id, pTexture->GetUnorderedAccessHandle(), heapType);
 	}
 	else
 	{
-		StageDescriptor(name, pTexture->GetShaderResourceHandle(), heapType);
+		StageDescriptor(id, pTexture->GetShaderResourceHandle(), heapType);
 	}
 }
 
 void Dx12CommandContext::Impl::StageDescriptorMip(
-	const std::string& name,
+	const render::BindingId& id,
 	Arc< Dx12Texture > pTexture,
 	u32 mipLevel,
 	D3D12_DESCRIPTOR_HEAP_TYPE heapType)
 {
-	StageDescriptor(name, pTexture->GetUnorderedAccessHandle(mipLevel), heapType);
+	StageDescriptor(id, pTexture->GetUnorderedAccessHandle(mipLevel), heapType);
 }
 
-void Dx12CommandContext::Impl::StageDescriptor(const std::string& name, u32 heapIdx, D3D12_DESCRIPTOR_HEAP_TYPE heapType)
+void Dx12CommandContext::Impl::StageDescriptor(const render::BindingId& id, u32 heapIdx, D3D12_DESCRIPTOR_HEAP_TYPE heapType)
 {
 	if (IsGraphicsContext())
 	{
-		auto [offset, rootIndex] = m_pGraphicsPipeline->GetResourceBindingIndex(name);
+		auto [offset, rootIndex] = m_pGraphicsPipeline->GetResourceBindingIndex(id);
 		if (rootIndex == kInvalidIndex)
 		{
 			return;
@@ -1036,7 +1037,7 @@ void Dx12CommandContext::Impl::StageDescriptor(const std::string& name, u32 heap
 	}
 	else if (IsComputeContext())
 	{
-		auto [offset, rootIndex] = m_pComputePipeline->GetResourceBindingIndex(name);
+		auto [offset, rootIndex] = m_pComputePipeline->GetResourceBindingIndex(id);
 		if (rootIndex == kInvalidIndex)
 		{
 			return;
@@ -1046,7 +1047,7 @@ void Dx12CommandContext::Impl::StageDescriptor(const std::string& name, u32 heap
 	}
 	else if (IsRaytracingContext())
 	{
-		auto [offset, rootIndex] = m_pRaytracingPipeline->GetResourceBindingIndex(name);
+		auto [offset, rootIndex] = m_pRaytracingPipeline->GetResourceBindingIndex(id);
 		if (rootIndex == kInvalidIndex)
 		{
 			return;
@@ -1062,7 +1063,7 @@ void Dx12CommandContext::Impl::StageDescriptors(
 {
 	for (const auto& [name, srcHandle] : srcHandles)
 	{
-		StageDescriptor(name, srcHandle, heapType);
+		StageDescriptor(render::BindingId(name), srcHandle, heapType);
 	}
 }
 
@@ -1145,11 +1146,11 @@ double Dx12CommandContext::Impl::GetLastFrameElapsedTime() const
 	return m_Timer.GetLastFrameTotalNs();
 }
 
-void Dx12CommandContext::Impl::BeginGpuMarker(const char* name, bool bWithStats)
+void Dx12CommandContext::Impl::BeginGpuMarker(render::ProfileScopeId scopeId, bool bWithStats)
 {
 	if (m_Type == D3D12_COMMAND_LIST_TYPE_COPY)
 		return;
-	m_Timer.BeginMarker(m_d3d12CommandList10, name, bWithStats);
+	m_Timer.BeginMarker(m_d3d12CommandList10, scopeId, bWithStats);
 }
 
 void Dx12CommandContext::Impl::EndGpuMarker()
@@ -1493,17 +1494,17 @@ void Dx12CommandContext::SetGraphicsConstants(u32 sizeInBytes, const void* pData
 	m_Impl->SetGraphicsRootConstants(sizeInBytes, pData, offsetInBytes);
 }
 
-void Dx12CommandContext::SetComputeDynamicUniformBuffer(const std::string& name, u32 sizeInBytes, const void* pData)
+void Dx12CommandContext::SetComputeDynamicUniformBuffer(const render::BindingId& id, u32 sizeInBytes, const void* pData)
 {
-	m_Impl->SetComputeDynamicConstantBuffer(name, sizeInBytes, pData);
+	m_Impl->SetComputeDynamicConstantBuffer(id, sizeInBytes, pData);
 }
 
-void Dx12CommandContext::SetGraphicsDynamicUniformBuffer(const std::string& name, u32 sizeInBytes, const void* pData)
+void Dx12CommandContext::SetGraphicsDynamicUniformBuffer(const render::BindingId& id, u32 sizeInBytes, const void* pData)
 {
-	m_Impl->SetGraphicsDynamicConstantBuffer(name, sizeInBytes, pData);
+	m_Impl->SetGraphicsDynamicConstantBuffer(id, sizeInBytes, pData);
 }
 
-void Dx12CommandContext::SetComputeShaderResource(const std::string& name, Arc< render::Buffer > pBuffer)
+void Dx12CommandContext::SetComputeShaderResource(const render::BindingId& id, Arc< render::Buffer > pBuffer)
 {
 	auto rhiBuffer = StaticCast<Dx12Buffer>(pBuffer);
 	assert(rhiBuffer);
@@ -1512,12 +1513,12 @@ void Dx12CommandContext::SetComputeShaderResource(const std::string& name, Arc<
 	bool bIsUAV = state.GetSubresourceState() == BarrierStates::BufferUnorderedAccess;
 
 	if (bIsUAV)
-		m_Impl->SetComputeUnorderedAccessView(name, rhiBuffer->GpuAddress());
+		m_Impl->SetComputeUnorderedAccessView(id, rhiBuffer->GpuAddress());
 	else
-		m_Impl->SetComputeShaderResourceView(name, rhiBuffer->GpuAddress());
+		m_Impl->SetComputeShaderResourceView(id, rhiBuffer->GpuAddress());
 }
 
-void Dx12CommandContext::SetComputeShaderResource(const std::string& name, Arc< render::Texture > pTexture, Arc< render::Sampler > pSamplerInCharge)
+void Dx12CommandContext::SetComputeShaderResource(const render::BindingId& id, Arc< render::Texture > pTexture, Arc< render::Sampler > pSamplerInCharge)
 {
 	UNUSED(pSamplerInCharge);
 
@@ -1528,69 +1529,69 @@ void Dx12CommandContext::SetComputeShaderResource(const std::string& name, Arc<
 	bool bIsUAV = state.GetSubresourceState() == BarrierStates::NonPixelShaderResource;
 
 	if (bIsUAV)
-		m_Impl->SetComputeUnorderedAccessView(name, rhiTexture->GpuAddress());
+		m_Impl->SetComputeUnorderedAccessView(id, rhiTexture->GpuAddress());
 	else
-		m_Impl->SetComputeShaderResourceView(name, rhiTexture->GpuAddress());
+		m_Impl->SetComputeShaderResourceView(id, rhiTexture->GpuAddress());
 }
 
-void Dx12CommandContext::SetGraphicsShaderResource(const std::string& name, Arc< render::Texture > pTexture, Arc< render::Sampler > pSamplerInCharge)
+void Dx12CommandContext::SetGraphicsShaderResource(const render::BindingId& id, Arc< render::Texture > pTexture, Arc< render::Sampler > pSamplerInCharge)
 {
 	UNUSED(pSamplerInCharge);
 
 	auto rhiTexture = StaticCast<Dx12Texture>(pTexture);
 	assert(rhiTexture);
 
-	m_Impl->SetGraphicsShaderResourceView(name, rhiTexture->GpuAddress());
+	m_Impl->SetGraphicsShaderResourceView(id, rhiTexture->GpuAddress());
 }
 
-void Dx12CommandContext::SetGraphicsShaderResource(const std::string& name, Arc< render::Buffer > pBuffer)
+void Dx12CommandContext::SetGraphicsShaderResource(const render::BindingId& id, Arc< render::Buffer > pBuffer)
 {
 	auto rhiBuffer = StaticCast<Dx12Buffer>(pBuffer);
 	assert(rhiBuffer);
 
 	if (rhiBuffer->GetType() == eBufferType::Structured)
-		m_Impl->SetGraphicsShaderResourceView(name, StaticCast<Dx12StructuredBuffer>(rhiBuffer)->GpuAddress());
+		m_Impl->SetGraphicsShaderResourceView(id, StaticCast<Dx12StructuredBuffer>(rhiBuffer)->GpuAddress());
 	else
-		m_Impl->SetGraphicsConstantBufferView(name, rhiBuffer->GpuAddress());
+		m_Impl->SetGraphicsConstantBufferView(id, rhiBuffer->GpuAddress());
 }
 
 void Dx12CommandContext::SetComputeConstantBufferView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS srv)
 {
-	m_Impl->SetComputeConstantBufferView(name, srv);
+	m_Impl->SetComputeConstantBufferView(render::BindingId(name), srv);
 }
 
 void Dx12CommandContext::SetGraphicsConstantBufferView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS srv)
 {
-	m_Impl->SetGraphicsConstantBufferView(name, srv);
+	m_Impl->SetGraphicsConstantBufferView(render::BindingId(name), srv);
 }
 
 void Dx12CommandContext::SetComputeShaderResourceView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS srv)
 {
-	m_Impl->SetComputeShaderResourceView(name, srv);
+	m_Impl->SetComputeShaderResourceView(render::BindingId(name), srv);
 }
 
 void Dx12CommandContext::SetGraphicsShaderResourceView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS srv)
 {
-	m_Impl->SetGraphicsShaderResourceView(name, srv);
+	m_Impl->SetGraphicsShaderResourceView(render::BindingId(name), srv);
 }
 
 void Dx12CommandContext::SetAccelerationStructure(const std::string& name, render::TopLevelAccelerationStructure& tlas)
 {
 	auto& dx12TLAS = static_cast<Dx12TopLevelAS&>(tlas);
-	m_Impl->SetAccelerationStructureSRV(name, dx12TLAS.GetGPUVirtualAddress());
+	m_Impl->SetAccelerationStructureSRV(render::BindingId(name), dx12TLAS.GetGPUVirtualAddress());
 }
 
-void Dx12CommandContext::StageDescriptor(const std::string& name, Arc< render::Buffer > pBuffer, u32 offset)
+void Dx12CommandContext::StageDescriptor(const render::BindingId& id, Arc< render::Buffer > pBuffer, u32 offset)
 {
 	UNUSED(offset);
 
 	auto rhiBuffer = StaticCast<Dx12Buffer>(pBuffer);
 	assert(rhiBuffer);
 
-	m_Impl->StageDescriptor(name, rhiBuffer);
+	m_Impl->StageDescriptor(id, rhiBuffer);
 }
 
-void Dx12CommandContext::StageDescriptor(const std::string& name, Arc< render::Texture > pTexture, Arc< render::Sampler > pSamplerInCharge, u32 offset)
+void Dx12CommandContext::StageDescriptor(const render::BindingId& id, Arc< render::Texture > pTexture, Arc< render::Sampler > pSamplerInCharge, u32 offset)
 {
 	UNUSED(offset);
 	UNUSED(pSamplerInCharge);
@@ -1598,10 +1599,10 @@ void Dx12CommandContext::StageDescriptor(const std::string& name, Arc< render::T
 	auto rhiTexture = StaticCast<Dx12Texture>(pTexture);
 	assert(rhiTexture);
 
-	m_Impl->StageDescriptor(name, rhiTexture);
+	m_Impl->StageDescriptor(id, rhiTexture);
 }
 
-void Dx12CommandContext::StageDescriptorMip(const std::string& name, Arc< render::Texture > pTexture, u32 mipLevel, Arc< render::Sampler > pSamplerInCharge)
+void Dx12CommandContext::StageDescriptorMip(const render::BindingId& id, Arc< render::Texture > pTexture, u32 mipLevel, Arc< render::Sampler > pSamplerInCharge)
 {
 	UNUSED(pSamplerInCharge);
 
@@ -1611,9 +1612,9 @@ void Dx12CommandContext::StageDescriptorMip(const std::string& name, Arc< render
 	// With sampler: SRV read of a specific mip.
 	// Without sampler: UAV write via per-mip UAV descriptor.
 	if (pSamplerInCharge)
-		m_Impl->StageDescriptor(name, rhiTexture);
+		m_Impl->StageDescriptor(id, rhiTexture);
 	else
-		m_Impl->StageDescriptorMip(name, rhiTexture, mipLevel);
+		m_Impl->StageDescriptorMip(id, rhiTexture, mipLevel);
 }
 
 void Dx12CommandContext::StageDescriptors(std::vector< std::pair< std::string, u32 > >&& srcHandles, D3D12_DESCRIPTOR_HEAP_TYPE heapType)
@@ -1679,9 +1680,9 @@ double Dx12CommandContext::GetLastFrameElapsedTime() const
 	return m_Impl->GetLastFrameElapsedTime();
 }
 
-void Dx12CommandContext::BeginGpuMarker(const char* name, bool bWithStats)
+void Dx12CommandContext::BeginGpuMarker(render::ProfileScopeId scopeId, bool bWithStats)
 {
-	m_Impl->BeginGpuMarker(name, bWithStats);
+	m_Impl->BeginGpuMarker(scopeId, bWithStats);
 }
 
 void Dx12CommandContext::EndGpuMarker()
@@ -1694,6 +1695,11 @@ const std::vector< render::GpuProfileEntry >& Dx12CommandContext::GetLastFramePr
 	return m_Impl->GetLastFrameProfile();
 }
 
+u64 Dx12CommandContext::GetLastFrameProfileIndex() const
+{
+	return m_Impl->GetLastFrameProfileIndex();
+}
+
 bool Dx12CommandContext::IsComputeContext() const
 {
 	return m_Impl->IsComputeContext();
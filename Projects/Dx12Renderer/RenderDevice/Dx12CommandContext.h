@@ -61,13 +61,20 @@ public:
 	virtual void SetComputeConstants(u32 sizeInBytes, const void* pData, u32 offsetInBytes = 0) override;
 	virtual void SetGraphicsConstants(u32 sizeInBytes, const void* pData, u32 offsetInBytes = 0) override;
 
-	virtual void SetComputeDynamicUniformBuffer(const std::string& name, u32 sizeInBytes, const void* pData) override;
-	virtual void SetGraphicsDynamicUniformBuffer(const std::string& name, u32 sizeInBytes, const void* pData) override;
+	using render::CommandContext::SetComputeDynamicUniformBuffer;
+	using render::CommandContext::SetGraphicsDynamicUniformBuffer;
+	using render::CommandContext::SetComputeShaderResource;
+	using render::CommandContext::SetGraphicsShaderResource;
+	using render::CommandContext::StageDescriptor;
+	using render::CommandContext::StageDescriptorMip;
 
-	virtual void SetComputeShaderResource(const std::string& name, Arc< render::Texture > pTexture, Arc< render::Sampler > pSamplerInCharge) override;
-	virtual void SetGraphicsShaderResource(const std::string& name, Arc< render::Texture > pTexture, Arc< render::Sampler > pSamplerInCharge) override;
-	virtual void SetComputeShaderResource(const std::string& name, Arc< render::Buffer > pBuffer) override;
-	virtual void SetGraphicsShaderResource(const std::string& name, Arc< render::Buffer > pBuffer) override;
+	virtual void SetComputeDynamicUniformBuffer(const render::BindingId& id, u32 sizeInBytes, const void* pData) override;
+	virtual void SetGraphicsDynamicUniformBuffer(const render::BindingId& id, u32 sizeInBytes, const void* pData) override;
+
+	virtual void SetComputeShaderResource(const render::BindingId& id, Arc< render::Texture > pTexture, Arc< render::Sampler > pSamplerInCharge) override;
+	virtual void SetGraphicsShaderResource(const render::BindingId& id, Arc< render::Texture > pTexture, Arc< render::Sampler > pSamplerInCharge) override;
+	virtual void SetComputeShaderResource(const render::BindingId& id, Arc< render::Buffer > pBuffer) override;
+	virtual void SetGraphicsShaderResource(const render::BindingId& id, Arc< render::Buffer > pBuffer) override;
 
 	void SetComputeConstantBufferView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS srv);
 	void SetGraphicsConstantBufferView(const std::string& name, D3D12_GPU_VIRTUAL_ADDRESS srv);
@@ -76,9 +83,9 @@ public:
 
 	virtual void SetAccelerationStructure(const std::string& name, render::TopLevelAccelerationStructure& tlas) override;
 
-	virtual void StageDescriptor(const std::string& name, Arc< render::Buffer > pBuffer, u32 offset = 0) override;
-	virtual void StageDescriptor(const std::string& name, Arc< render::Texture > pTexture, Arc< render::Sampler > pSamplerInCharge, u32 offset = 0) override;
-	virtual void StageDescriptorMip(const std::string& name, Arc< render::Texture > pTexture, u32 mipLevel, Arc< render::Sampler > samplerInCharge = nullptr) override;
+	virtual void StageDescriptor(const render::BindingId& id, Arc< render::Buffer > pBuffer, u32 offset = 0) override;
+	virtual void StageDescriptor(const render::BindingId& id, Arc< render::Texture > pTexture, Arc< render::Sampler > pSamplerInCharge, u32 offset = 0) override;
+	virtual void StageDescriptorMip(const render::BindingId& id, Arc< render::Texture > pTexture, u32 mipLevel, Arc< render::Sampler > samplerInCharge = nullptr) override;
 	void StageDescriptors(
 		std::vector< std::pair< std::string, u32 > > && srcHandles,
 		D3D12_DESCRIPTOR_HEAP_TYPE heapType = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
@@ -99,9 +106,10 @@ public:
 	virtual void Dispatch(u32 numGroupsX, u32 numGroupsY, u32 numGroupsZ) override;
 	virtual void DispatchRays(render::ShaderBindingTable& sbt, u32 numGroupsX, u32 numGroupsY, u32 numGroupsZ = 1) override;
 
-	virtual void BeginGpuMarker(const char* name, bool bWithStats = false) override;
+	virtual void BeginGpuMarker(render::ProfileScopeId scopeId, bool bWithStats = false) override;
 	virtual void EndGpuMarker() override;
 	virtual const std::vector< render::GpuProfileEntry >& GetLastFrameProfile() const override;
+	virtual u64 GetLastFrameProfileIndex() const override;
 	virtual double GetLastFrameElapsedTime() const override;
 
 public:
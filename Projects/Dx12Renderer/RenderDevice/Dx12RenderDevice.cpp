@@ -192,6 +192,7 @@ Box< render::RaytracingPipeline > Dx12RenderDevice::CreateRaytracingPipeline(con
 u32 Dx12RenderDevice::Swap()
 {
 	m_ContextIndex = (m_ContextIndex + 1) % kMaxFramesInFlight;
+	AdvanceFrame();
 
 	return m_ContextIndex;
 }
@@ -461,6 +462,22 @@ bool Dx12RenderDevice::SaveTextureToEXR(const Arc< render::Texture >& pTexture,
 	return true;
 }
 
+void Dx12RenderDevice::QueryMemoryBudgets(std::vector< render::MemoryHeapBudget >& outBudgets) const
+{
+	outBudgets.clear();
+	if (!m_dmaAllocator)
+		return;
+
+	// D3D12MA reads these from DXGI, so they cover committed resources created outside of it too
+	D3D12MA::Budget localBudget = {};
+	D3D12MA::Budget nonLocalBudget = {};
+	m_dmaAllocator->GetBudget(&localBudget, &nonLocalBudget);
+
+	outBudgets.push_back({ .bDeviceLocal = true, .usageBytes = localBudget.UsageBytes, .budgetBytes = localBudget.BudgetBytes });
+	if (!m_dmaAllocator->IsUMA())
+		outBudgets.push_back({ .bDeviceLocal = false, .usageBytes = nonLocalBudget.UsageBytes, .budgetBytes = nonLocalBudget.BudgetBytes });
+}
+
 DXGI_SAMPLE_DESC Dx12RenderDevice::GetMultisampleQualityLevels(DXGI_FORMAT format, D3D12_MULTISAMPLE_QUALITY_LEVEL_FLAGS flags) const
 {
 	DXGI_SAMPLE_DESC sampleDesc = { 1, 0 };
@@ -80,6 +80,8 @@ public:
 
 	virtual bool SaveTextureToEXR(const Arc< render::Texture >& pTexture, const char* path) override;
 
+	virtual void QueryMemoryBudgets(std::vector< render::MemoryHeapBudget >& outBudgets) const override;
+
 	[[nodiscard]]
 	inline u32 GetSRVDescriptorSize() const { return m_SRVDescriptorSize; }
 	[[nodiscard]]
@@ -8,6 +8,8 @@
 #include "RenderResource/Dx12RenderTarget.h"
 #include "RenderResource/Dx12SceneResource.h"
 
+#include "RenderCommon/PipelineBuildQueue.h"
+
 namespace dx12
 {
 
@@ -168,6 +170,9 @@ Dx12GraphicsPipeline::Dx12GraphicsPipeline(Dx12RenderDevice& rd, const char* nam
 
 Dx12GraphicsPipeline::~Dx12GraphicsPipeline()
 {
+    // a queued compile captures this pipeline
+    PipelineBuildQueue::Cancel(this);
+
     COM_RELEASE(m_d3d12PipelineState);
 
     m_InputLayoutDesc.clear();
@@ -349,14 +354,17 @@ void Dx12GraphicsPipeline::Build()
         if (d3d12AS) ParseRootParameters(d3d12AS->Reflection());
         Stream.pRootSignature = m_pRootSignature->GetD3D12RootSignature();
 
-        D3D12_PIPELINE_STATE_STREAM_DESC streamDesc = {};
-        streamDesc.SizeInBytes                   = sizeof(MeshPipelineStream);
-        streamDesc.pPipelineStateSubobjectStream = &Stream;
-
-        auto d3d12Device = m_RenderDevice.GetD3D12Device();
-        ThrowIfFailed(
-            d3d12Device->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&m_d3d12PipelineState))
-        );
+        PipelineBuildQueue::Submit(this, m_Name, [this, Stream]() mutable
+        {
+            D3D12_PIPELINE_STATE_STREAM_DESC streamDesc = {};
+            streamDesc.SizeInBytes                   = sizeof(MeshPipelineStream);
+            streamDesc.pPipelineStateSubobjectStream = &Stream;
+
+            auto d3d12Device = m_RenderDevice.GetD3D12Device();
+            ThrowIfFailed(
+                d3d12Device->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&m_d3d12PipelineState))
+            );
+        });
     }
     else
     {
@@ -386,10 +394,13 @@ void Dx12GraphicsPipeline::Build()
         if (d3d12DS) ParseRootParameters(d3d12DS->Reflection());
         m_PipelineDesc.pRootSignature = m_pRootSignature->GetD3D12RootSignature();
 
-        auto d3d12Device = m_RenderDevice.GetD3D12Device();
-        ThrowIfFailed(
-            d3d12Device->CreateGraphicsPipelineState(&m_PipelineDesc, IID_PPV_ARGS(&m_d3d12PipelineState))
-        );
+        PipelineBuildQueue::Submit(this, m_Name, [this]()
+        {
+            auto d3d12Device = m_RenderDevice.GetD3D12Device();
+            ThrowIfFailed(
+                d3d12Device->CreateGraphicsPipelineState(&m_PipelineDesc, IID_PPV_ARGS(&m_d3d12PipelineState))
+            );
+        });
     }
 }
 
@@ -437,7 +448,7 @@ void Dx12GraphicsPipeline::ParseRootParameters(const Dx12Shader::ShaderReflectio
 
                 auto rootIndex = m_pRootSignature->GetRootIndex(type, space, descriptor.baseRegister);
 
-                m_ResourceBindingMap.emplace(descriptor.name, rootIndex);
+                AddResourceBinding(descriptor.name, rootIndex);
                 break;
             }
             case D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER:
@@ -461,6 +472,9 @@ Dx12ComputePipeline::Dx12ComputePipeline(Dx12RenderDevice& rd, const char* name)
 
 Dx12ComputePipeline::~Dx12ComputePipeline()
 {
+    // a queued compile captures this pipeline
+    PipelineBuildQueue::Cancel(this);
+
     COM_RELEASE(m_d3d12PipelineState);
 }
 
@@ -475,10 +489,14 @@ void Dx12ComputePipeline::Build()
     ParseRootParameters(d3d12CS->Reflection());
     m_PipelineDesc.pRootSignature = m_pRootSignature->GetD3D12RootSignature();
 
-    auto d3d12Device = m_RenderDevice.GetD3D12Device();
-    ThrowIfFailed(
-        d3d12Device->CreateComputePipelineState(&m_PipelineDesc, IID_PPV_ARGS(&m_d3d12PipelineState))
-    );
+    // Root signature and bindings are resolved; the compile may run on a PipelineBuildQueue worker
+    PipelineBuildQueue::Submit(this, m_Name, [this]()
+    {
+        auto d3d12Device = m_RenderDevice.GetD3D12Device();
+        ThrowIfFailed(
+            d3d12Device->CreateComputePipelineState(&m_PipelineDesc, IID_PPV_ARGS(&m_d3d12PipelineState))
+        );
+    });
 }
 
 void Dx12ComputePipeline::ParseRootParameters(const Dx12Shader::ShaderReflection& reflection)
@@ -500,7 +518,7 @@ void Dx12ComputePipeline::ParseRootParameters(const Dx12Shader::ShaderReflection
 
                 auto rootIndex = m_pRootSignature->GetRootIndex(type, space, descriptor.baseRegister);
 
-                m_ResourceBindingMap.emplace(descriptor.name, rootIndex);
+                AddResourceBinding(descriptor.name, rootIndex);
                 break;
             }
             case D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER:
@@ -768,7 +786,7 @@ void Dx12RaytracingPipeline::ParseRootParameters(const Dx12Shader::ShaderReflect
 
                 auto rootIndex = m_pGlobalRootSignature->GetRootIndex(type, space, descriptor.baseRegister);
 
-                m_ResourceBindingMap.emplace(descriptor.name, rootIndex);
+                AddResourceBinding(descriptor.name, rootIndex);
                 break;
             }
             case D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER:
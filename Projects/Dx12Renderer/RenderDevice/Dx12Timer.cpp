@@ -98,7 +98,7 @@ void Dx12Timer::Destroy()
 	m_StatsReadbackBuffer.Reset();
 }
 
-void Dx12Timer::BeginFrame(ID3D12GraphicsCommandList* d3d12CommandList)
+void Dx12Timer::BeginFrame(ID3D12GraphicsCommandList* d3d12CommandList, u64 frameIndex)
 {
 	// 1) Read previous frame's results from the readback buffers.
 	if (m_bHasPreviousFrame && !m_Building.empty() && m_GpuFrequency != 0)
@@ -116,6 +116,7 @@ void Dx12Timer::BeginFrame(ID3D12GraphicsCommandList* d3d12CommandList)
 				const auto [startIdx, endIdx] = m_QueryIndices[i];
 				const UINT64 delta = pTicks[endIdx] - pTicks[startIdx];
 				m_Building[i].elapsedMs = static_cast<double>(delta) * tickToMs;
+				m_Building[i].beginMs   = static_cast<double>(pTicks[startIdx]) * tickToMs;
 			}
 
 			D3D12_RANGE writeRange = { 0, 0 };
@@ -171,7 +172,9 @@ void Dx12Timer::BeginFrame(ID3D12GraphicsCommandList* d3d12CommandList)
 			}
 		}
 
-		m_LastResults = std::move(m_Building);
+		// Swap rather than move so both buffers keep their capacity
+		m_LastResults.swap(m_Building);
+		m_LastFrameIndex = m_BuildingFrameIndex;
 	}
 
 	// 2) Reset bookkeeping for new frame
@@ -182,9 +185,11 @@ void Dx12Timer::BeginFrame(ID3D12GraphicsCommandList* d3d12CommandList)
 	m_NextQueryIdx = 0;
 	m_NextStatsIdx = 0;
 	m_CurrentDepth = 0;
+	m_BuildingFrameIndex = frameIndex;
 
 	// 3) Open the implicit "Frame" scope (DX12 has no explicit query heap reset)
-	BeginMarker(d3d12CommandList, "Frame");
+	static const render::ProfileScopeId s_FrameScope = render::ProfileScopeRegistry::Intern("Frame");
+	BeginMarker(d3d12CommandList, s_FrameScope);
 
 	m_bHasPreviousFrame = true;
 }
@@ -221,7 +226,7 @@ void Dx12Timer::EndFrame(ID3D12GraphicsCommandList* d3d12CommandList)
 	}
 }
 
-void Dx12Timer::BeginMarker(ID3D12GraphicsCommandList* d3d12CommandList, const char* name, bool bStats)
+void Dx12Timer::BeginMarker(ID3D12GraphicsCommandList* d3d12CommandList, render::ProfileScopeId scopeId, bool bStats)
 {
 	if (m_NextQueryIdx + 2 > m_MaxQueries)
 	{
@@ -231,10 +236,13 @@ void Dx12Timer::BeginMarker(ID3D12GraphicsCommandList* d3d12CommandList, const c
 
 	const UINT startIdx = m_NextQueryIdx++;
 
+	const char* name = render::ProfileScopeRegistry::Name(scopeId);
+
 	render::GpuProfileEntry entry = {
 		.name      = name,
 		.depth     = m_CurrentDepth,
 		.elapsedMs = 0.0,
+		.scopeId   = scopeId,
 	};
 
 	const UINT entryIdx = static_cast<UINT>(m_Building.size());
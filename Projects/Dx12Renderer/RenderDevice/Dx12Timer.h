@@ -22,15 +22,16 @@ public:
 	void Destroy();
 
 	// Frame lifecycle
-	void BeginFrame(ID3D12GraphicsCommandList* d3d12CommandList);
+	void BeginFrame(ID3D12GraphicsCommandList* d3d12CommandList, u64 frameIndex);
 	void EndFrame(ID3D12GraphicsCommandList* d3d12CommandList);
 
 	// Scoped markers (called between BeginFrame and EndFrame)
-	void BeginMarker(ID3D12GraphicsCommandList* d3d12CommandList, const char* name, bool bStats = false);
+	void BeginMarker(ID3D12GraphicsCommandList* d3d12CommandList, render::ProfileScopeId scopeId, bool bStats = false);
 	void EndMarker(ID3D12GraphicsCommandList* d3d12CommandList);
 
 	// Results from previous completed frame
 	const std::vector< render::GpuProfileEntry >& GetLastFrameProfile() const { return m_LastResults; }
+	u64 GetLastFrameIndex() const { return m_LastFrameIndex; }
 	double GetLastFrameTotalNs() const;
 
 private:
@@ -59,6 +60,9 @@ private:
 	std::vector< UINT >                    m_OpenStack;
 	UINT                                   m_CurrentDepth = 0;
 
+	u64 m_BuildingFrameIndex = render::kNoProfileFrame;
+	u64 m_LastFrameIndex     = render::kNoProfileFrame;
+
 	bool m_bHasPreviousFrame = false;
 };
 
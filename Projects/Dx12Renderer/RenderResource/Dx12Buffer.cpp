@@ -149,6 +149,7 @@ void Dx12Buffer::Resize(u64 sizeInBytes, bool bReset)
 	m_d3d12Resource->SetName(m_wName.data());
 	m_ResourceDesc = m_d3d12Resource->GetDesc1();
 	m_BufferSize   = alignedSize;
+	TrackAllocation();
 
 	// m_Count must be refreshed before creating views (see BugHistory.md for details)
 	if (m_ElementSize > 0)
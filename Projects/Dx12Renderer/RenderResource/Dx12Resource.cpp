@@ -84,6 +84,7 @@ Dx12Resource::Dx12Resource(Dx12RenderDevice& rd, const char* name, Dx12ResourceC
 	assert(m_d3d12Resource);
 	m_d3d12Resource->SetName(m_wName.data());
 	m_ResourceDesc = m_d3d12Resource->GetDesc1();
+	TrackAllocation();
 
 	SetFormatSupported();
 }
@@ -98,6 +99,28 @@ Dx12Resource::~Dx12Resource()
 void Dx12Resource::Reset()
 {
 	COM_RELEASE(m_d3d12Resource);
+	m_TrackedMemory.Clear();
+}
+
+void Dx12Resource::TrackAllocation()
+{
+	m_TrackedMemory.Clear();
+	if (!m_d3d12Resource)
+		return;
+
+	if (!m_bMemoryTagSet)
+	{
+		// Textures the GPU writes count as render targets, the rest as sampled textures
+		constexpr D3D12_RESOURCE_FLAGS kWriteFlags =
+			D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL | D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+		if (m_ResourceDesc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+			m_TrackedMemory.Retag(render::eMemoryTag::Buffers);
+		else
+			m_TrackedMemory.Retag((m_ResourceDesc.Flags & kWriteFlags) ? render::eMemoryTag::RenderTargets : render::eMemoryTag::Textures);
+	}
+
+	const auto allocationInfo = m_RenderDevice.GetD3D12Device()->GetResourceAllocationInfo2(0, 1, &m_ResourceDesc, nullptr);
+	m_TrackedMemory.Add(allocationInfo.SizeInBytes);
 }
 
 bool Dx12Resource::IsFormatSupported(D3D12_FORMAT_SUPPORT1 formatSupport) const
@@ -118,6 +141,7 @@ void Dx12Resource::SetD3D12Resource(ID3D12Resource2* d3d12Resource, const Barrie
 	m_d3d12Resource = d3d12Resource;
 	m_ResourceDesc  = m_d3d12Resource->GetDesc1();
 	ThrowIfFailed(m_d3d12Resource->SetName(m_wName.data()));
+	TrackAllocation();
 
 	SetFormatSupported();
 	m_CurrentState.SetSubresourceState(initialState, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
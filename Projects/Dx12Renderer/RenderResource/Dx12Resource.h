@@ -1,6 +1,7 @@
 #pragma once
 #include "Dx12BarrierState.h"
 #include "RenderDevice/Dx12DescriptorAllocation.h"
+#include "RenderCommon/MemoryTracker.h"
 
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -109,12 +110,22 @@ public:
 	virtual void SetD3D12Resource(ID3D12Resource2* d3d12Resource, const BarrierState& initialState = BarrierStates::Common);
 	void SetCurrentState(const BarrierState& state, u32 subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES) { m_CurrentState.SetSubresourceState(state, subresource); }
 
+	// Reports this resource's memory under 'tag' from now on, instead of the one its type and flags imply
+	void SetMemoryTag(render::eMemoryTag tag)
+	{
+		m_TrackedMemory.Retag(tag);
+		m_bMemoryTagSet = true;
+	}
+
 protected:
 	bool IsFormatSupported(D3D12_FORMAT_SUPPORT1 formatSupport) const;
 	bool IsFormatSupported(D3D12_FORMAT_SUPPORT2 formatSupport) const;
 
 	virtual void Reset();
 
+	// Reports the memory of m_d3d12Resource, replacing what was reported before
+	void TrackAllocation();
+
 private:
 	void SetFormatSupported();
 
@@ -131,6 +142,9 @@ protected:
 	ResourceState m_CurrentState = {};
 
 	D3D12_CLEAR_VALUE* m_pClearValue = nullptr;
+
+	render::TrackedMemory m_TrackedMemory{ render::eMemoryTag::Buffers };
+	bool                  m_bMemoryTagSet = false;
 };
 
 }
\ No newline at end of file
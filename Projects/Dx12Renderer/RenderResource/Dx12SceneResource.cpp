@@ -196,6 +196,10 @@ void Dx12SceneResource::UpdateSceneResources(const SceneRenderView& sceneView, r
     }
     else if (m_FrameData[m_ContextIndex].bInitialized)
     {
+        if (m_FrameData[m_ContextIndex].visibilityRevision != sceneView.visibilityRevision)
+            UpdateInstances(sceneView, ctx);
+        m_NumInstances = m_FrameData[m_ContextIndex].numInstances;
+
         UpdateCameraAndEnvironment(sceneView, ctx);
         return;
     }
@@ -350,8 +354,13 @@ void Dx12SceneResource::UpdateSceneResources(const SceneRenderView& sceneView, r
     if (m_pMeshletTriangleAllocator->GetElementCount() < mtTotalCount) 
         m_pMeshletTriangleAllocator->Resize(mtTotalCount * 2);
 
-    u32 instID = 0;
-    std::vector< InstanceData > instances;
+    // the TLAS indexes the stable copy UpdateInstances appends after the packed list, so its
+    // instance IDs survive visibility changes and culled geometry stays visible to rays
+    u32 stableInstanceBase = sceneView.voxelTerrain.bValid ? 1u : 0u;
+    for (auto& [id, data] : sceneView.draws)
+        stableInstanceBase += IsValidIndex(data.mesh) ? 1u : 0u;
+
+    m_DrawInstances.clear();
     for (auto& [id, data] : sceneView.draws)
     {
         InstanceData instance = {};
@@ -360,6 +369,7 @@ void Dx12SceneResource::UpdateSceneResources(const SceneRenderView& sceneView, r
             assert(data.mesh < sceneView.meshes.size());
             auto& meshView = sceneView.meshes[data.mesh];
 
+            const u32 drawIndex = (u32)m_DrawInstances.size();
             {
                 auto vHandle = GetOrUpdateVertex(meshView.id, meshView.tag, meshView.vData, meshView.vCount);
                 auto iHandle = GetOrUpdateIndex(meshView.id, meshView.tag, meshView.lods[0].iData, meshView.lods[0].iCount);
@@ -377,6 +387,7 @@ void Dx12SceneResource::UpdateSceneResources(const SceneRenderView& sceneView, r
                     instance.materialID = data.material;
                 }
 
+                // slots follow the draw, not its packed position, so visibility history survives re-packing
                 instance.visOffset = m_NumMeshletVisibilitySlots;
 
                 u32 maxLodMeshletCount = 0;
@@ -384,9 +395,7 @@ void Dx12SceneResource::UpdateSceneResources(const SceneRenderView& sceneView, r
                     maxLodMeshletCount = std::max(maxLodMeshletCount, meshes[data.mesh].lods[i].mCount);
                 m_NumMeshletVisibilitySlots += maxLodMeshletCount;
 
-                instances.push_back(instance);
-
-                m_NumInstances++;
+                m_DrawInstances.push_back({ id, instance });
             }
             {
                 auto& transformView = sceneView.transforms[data.transform];
@@ -403,7 +412,7 @@ void Dx12SceneResource::UpdateSceneResources(const SceneRenderView& sceneView, r
                 inst.transform[1][0] = m[0][1]; inst.transform[1][1] = m[1][1]; inst.transform[1][2] = m[2][1]; inst.transform[1][3] = m[3][1];
                 inst.transform[2][0] = m[0][2]; inst.transform[2][1] = m[1][2]; inst.transform[2][2] = m[2][2]; inst.transform[2][3] = m[3][2];
 
-                inst.instanceID                          = instID++;
+                inst.instanceID                          = stableInstanceBase + drawIndex;
                 inst.pBLAS                               = blasIter->second.get();
                 inst.instanceContributionToHitGroupIndex = 0;
 
@@ -411,6 +420,29 @@ void Dx12SceneResource::UpdateSceneResources(const SceneRenderView& sceneView, r
             }
         }
     }
+
+    if (m_pTLAS->NumInstances() > 0)
+    {
+        m_pTLAS->Prepare();
+    }
+    BuildAccelerationStructures();
+
+    UpdateInstances(sceneView, ctx);
+    UpdateFrameBuffer(ctx, &sceneView.light, 1, sizeof(LightData), *m_FrameData[m_ContextIndex].pLightAllocator, BarrierStates::ConstantBuffer);
+
+    UpdateCameraAndEnvironment(sceneView, ctx);
+    m_FrameData[m_ContextIndex].bInitialized = true;
+    m_LastSceneRevision = sceneView.sceneRevision;
+}
+
+void Dx12SceneResource::UpdateInstances(const SceneRenderView& sceneView, Dx12CommandContext& ctx)
+{
+    auto& frameData = m_FrameData[m_ContextIndex];
+    frameData.pInstanceAllocator->Reset();
+
+    std::vector< InstanceData > instances;
+    u32 numVisible = PackDrawInstances(sceneView, instances);
+
     // Voxel chunk: prepend it at the head of instance buffer
     if (sceneView.voxelTerrain.bValid)
     {
@@ -421,21 +453,19 @@ void Dx12SceneResource::UpdateSceneResources(const SceneRenderView& sceneView, r
         voxelInstance.visOffset   = 0;                                 // unused: voxel skips per-meshlet cull
         voxelInstance.isVoxel     = 1;
         instances.insert(instances.begin() + kVoxelChunkInstanceBase, voxelInstance); // instanceID == chunkID
+        ++numVisible;
     }
-    m_NumInstances = (u32)instances.size();
 
-    if (m_pTLAS->NumInstances() > 0)
-    {
-        m_pTLAS->Prepare();
-    }
-    BuildAccelerationStructures();
+    // stable copy for the TLAS, in the order its instance IDs were assigned
+    for (const auto& drawInstance : m_DrawInstances)
+        instances.push_back(drawInstance.instance);
 
-    UpdateFrameBuffer(ctx, instances.data(), (u32)instances.size(), sizeof(InstanceData), *m_FrameData[m_ContextIndex].pInstanceAllocator, BarrierStates::ShaderResource);
-    UpdateFrameBuffer(ctx, &sceneView.light, 1, sizeof(LightData), *m_FrameData[m_ContextIndex].pLightAllocator, BarrierStates::ConstantBuffer);
+    UpdateFrameBuffer(ctx, instances.data(), (u32)instances.size(), sizeof(InstanceData), *frameData.pInstanceAllocator, BarrierStates::ShaderResource);
 
-    UpdateCameraAndEnvironment(sceneView, ctx);
-    m_FrameData[m_ContextIndex].bInitialized = true;
-    m_LastSceneRevision = sceneView.sceneRevision;
+    // culled instances trail the visible ones and fall outside the cull/draw dispatch
+    m_NumInstances               = numVisible;
+    frameData.numInstances       = numVisible;
+    frameData.visibilityRevision = sceneView.visibilityRevision;
 }
 
 void Dx12SceneResource::BindSceneResources(render::CommandContext& context)
@@ -643,6 +673,8 @@ Arc< Dx12Texture > Dx12SceneResource::GetOrLoadTexture(const std::string& filepa
 
     auto& rm   = static_cast<Dx12ResourceManager&>(m_RenderDevice.GetResourceManager());
     auto  pTex = StaticCast<Dx12Texture>(rm.LoadTexture(filepath, true, colorSpace));
+    if (pTex)
+        pTex->SetMemoryTag(render::eMemoryTag::TextureCache);
 
     m_TextureCache.emplace(cacheKey, pTex);
     return pTex;
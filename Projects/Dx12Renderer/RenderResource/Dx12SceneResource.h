@@ -64,6 +64,7 @@ private:
     void UpdateFrameBuffer(Dx12CommandContext& context, const void* pData, u32 count, u64 elementSizeInBytes, StaticBufferAllocator& targetBuffer, const BarrierState& stateAfter);
     void BuildAccelerationStructures();
     void UpdateCameraAndEnvironment(const SceneRenderView& sceneView, Dx12CommandContext& ctx);
+    void UpdateInstances(const SceneRenderView& sceneView, Dx12CommandContext& ctx);
 
     Dx12RenderDevice& m_RenderDevice;
 
@@ -93,7 +94,9 @@ private:
         Arc< Dx12ConstantBuffer > pFrozenCameraBuffer;
         Arc< Dx12ConstantBuffer > pMeshStreamsBuffer; // CBV holding the 5 geometry-pool heap indices (g_MeshStreams)
 
-        bool bInitialized = false;
+        u64  visibilityRevision = 0;
+        u32  numInstances       = 0; // NumInstances() while this frame's instance list is bound
+        bool bInitialized       = false;
 
         void Reset();
     };
@@ -1,6 +1,8 @@
 #include "RendererPch.h"
 #include "Dx12Shader.h"
 #include "RenderDevice/Dx12RenderDevice.h"
+#include "RenderCommon/ShaderManifest.hpp"
+#include "RenderCommon/ShaderReflectionCache.hpp"
 
 #include <fstream>
 #include <iostream>
@@ -141,6 +143,63 @@ void ParseDescriptors(TReflection* pReflection, Dx12Shader::ShaderReflection& re
     }
 }
 
+// Sidecar payload version, tied to ShaderReflection and the layout below
+constexpr u32 kReflectionVersion = 1;
+
+// Leaves 'reflection' untouched unless the whole sidecar reads back
+bool LoadReflection(const std::string& csoPath, u64 binaryHash, Dx12Shader::ShaderReflection& reflection)
+{
+    render::ReflectionReader reader;
+    if (!reader.Load(render::GetReflectionSidecarPath(csoPath), kReflectionVersion, binaryHash))
+        return false;
+
+    Dx12Shader::ShaderReflection loaded = {};
+    const u32 numSpaces = reader.Read< u32 >();
+    for (u32 i = 0; i < numSpaces && reader.IsValid(); ++i)
+    {
+        const u32 space          = reader.Read< u32 >();
+        const u32 numDescriptors = reader.Read< u32 >();
+
+        auto& descriptors = loaded.descriptors[space];
+        for (u32 j = 0; j < numDescriptors && reader.IsValid(); ++j)
+        {
+            Dx12Shader::DescriptorInfo& info = descriptors.emplace_back();
+            info.name           = reader.ReadString();
+            info.baseRegister   = reader.Read< UINT >();
+            info.numDescriptors = reader.Read< UINT >();
+            info.inputType      = reader.Read< D3D_SHADER_INPUT_TYPE >();
+            info.rangeType      = reader.Read< D3D12_DESCRIPTOR_RANGE_TYPE >();
+        }
+    }
+
+    if (!reader.IsComplete())
+        return false;
+
+    reflection = std::move(loaded);
+    return true;
+}
+
+void SaveReflection(const std::string& csoPath, u64 binaryHash, const Dx12Shader::ShaderReflection& reflection)
+{
+    render::ReflectionWriter writer;
+    writer.Write(static_cast< u32 >(reflection.descriptors.size()));
+    for (const auto& [space, descriptors] : reflection.descriptors)
+    {
+        writer.Write(space);
+        writer.Write(static_cast< u32 >(descriptors.size()));
+        for (const auto& info : descriptors)
+        {
+            writer.WriteString(info.name);
+            writer.Write(info.baseRegister);
+            writer.Write(info.numDescriptors);
+            writer.Write(info.inputType);
+            writer.Write(info.rangeType);
+        }
+    }
+
+    writer.Save(render::GetReflectionSidecarPath(csoPath), kReflectionVersion, binaryHash);
+}
+
 }
 
 
@@ -153,8 +212,24 @@ Dx12Shader::Dx12Shader(Dx12RenderDevice& rd, const char* name, CreationInfo&& in
 	: render::Shader(name, std::move(info))
     , Dx12Resource(rd, name, eResourceType::Shader)
 {
-    LoadBinary(DX12_SHADER_PATH(m_CreationInfo.filename));
-    Reflect();
+    // A permutation is its own binary, compiled by ShaderBuilder from the values the source declares.
+    // Never substitute another permutation: it would render something other than what was asked for
+    const std::string csoPath = DX12_SHADER_PATH(m_CreationInfo.filename + render::GetPermutationSuffix(m_CreationInfo.features));
+    BB_ASSERT(m_CreationInfo.features.empty() || fs::exists(csoPath),
+        "[Shader] '%s' is not built; declare the feature's values with '// @permutation' and rerun ShaderBuilder", csoPath.c_str());
+    LoadBinary(csoPath);
+
+    // Vertex shaders and libraries keep their live reflection objects (input layout, exports),
+    // every other stage only needs the descriptor table the sidecar holds
+    const bool bNeedsReflectionObject = m_CreationInfo.stage == render::eShaderStage::Vertex || render::IsRaytracingShader(m_CreationInfo.stage);
+    const u64  binaryHash = render::HashShaderBinary(m_d3dShaderBlob->GetBufferPointer(), m_d3dShaderBlob->GetBufferSize());
+    render::ValidateShaderBinary(csoPath, binaryHash);
+    if (bNeedsReflectionObject || !LoadReflection(csoPath, binaryHash, m_Reflection))
+    {
+        Reflect();
+        if (!bNeedsReflectionObject)
+            SaveReflection(csoPath, binaryHash, m_Reflection);
+    }
 
     ms_RefCount++;
 }
@@ -207,6 +282,9 @@ void Dx12Shader::Reflect()
         );
     }
 
+    // ParseDescriptors appends; start from nothing so a reflection is never merged into a stale one
+    m_Reflection = {};
+
     DxcBuffer dxcBuffer = {};
     dxcBuffer.Ptr      = m_d3dShaderBlob->GetBufferPointer();
     dxcBuffer.Size     = m_d3dShaderBlob->GetBufferSize();
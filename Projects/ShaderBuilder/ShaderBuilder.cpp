@@ -0,0 +1,507 @@
+// =========================================================================
+// ShaderBuilder — incremental offline shader compiler.
+//
+//   Scans the GLSL (Vulkan) or HLSL (Dx12) sources, follows their quoted
+//   #include graph, and gives every output a key hashed from the source,
+//   all of its includes, the defines and compiler arguments, and the
+//   compiler's own version string. Only outputs whose key differs from the
+//   previous manifest (or whose binary is missing) are recompiled, in
+//   parallel. The manifest it writes next to the binaries also records a
+//   hash of each binary, which the renderers check when they load shaders.
+//   For Dx12 it also compiles one binary per permutation the engine has
+//   recorded, with that permutation's features passed as defines.
+//
+//   ShaderBuilder --api vulkan|dx12 [--root <dir>] [--compiler <path>]
+//                 [--jobs N] [--force] [-D NAME[=VALUE]]...
+// =========================================================================
+#include "RenderCommon/ShaderManifest.hpp"
+#include "RenderCommon/ShaderPermutation.hpp"
+#include "RenderCommon/ShaderReflectionCache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+constexpr u32 kToolVersion = 1; // bump to invalidate every key, e.g. when the command lines below change
+
+struct Options
+{
+	std::string api;
+	fs::path    root     = ".";
+	std::string compiler;
+	u32         numJobs  = 0;
+	bool        bForce   = false;
+
+	std::vector< std::string > defines;
+};
+
+struct Job
+{
+	fs::path    source;
+	fs::path    output;
+	std::string outputName; // manifest key, the output's filename
+	std::string arguments;  // everything but the input and output paths
+	std::string outputFlag;
+	u64         key = 0;
+};
+
+//-------------------------------------------------------------------------
+// Process helpers
+//-------------------------------------------------------------------------
+#ifdef _WIN32
+#define BB_POPEN  _popen
+#define BB_PCLOSE _pclose
+#else
+#define BB_POPEN  popen
+#define BB_PCLOSE pclose
+#endif
+
+// Runs 'command' through the shell and returns its exit code, with stdout and stderr in 'output'
+int RunCommand(const std::string& command, std::string& output)
+{
+#ifdef _WIN32
+	// cmd /c strips the first and last quote when the line starts with one
+	const std::string shellCommand = "\"" + command + " 2>&1\"";
+#else
+	const std::string shellCommand = command + " 2>&1";
+#endif
+	FILE* pipe = BB_POPEN(shellCommand.c_str(), "r");
+	if (!pipe)
+		return -1;
+
+	char buffer[512];
+	while (fgets(buffer, sizeof(buffer), pipe))
+		output += buffer;
+
+	const int status = BB_PCLOSE(pipe);
+#ifdef _WIN32
+	return status;
+#else
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+}
+
+std::string Quote(const fs::path& path)
+{
+	return "\"" + path.string() + "\"";
+}
+
+bool ReadText(const fs::path& path, std::string& outText)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	std::ostringstream stream;
+	stream << file.rdbuf();
+	outText = stream.str();
+	return true;
+}
+
+u64 HashCombine(u64 hash, std::string_view data)
+{
+	for (const char c : data)
+	{
+		hash ^= static_cast< u64 >(static_cast< u8 >(c));
+		hash *= render::kFnv1aPrime;
+	}
+	return hash;
+}
+
+//-------------------------------------------------------------------------
+// Include graph
+//-------------------------------------------------------------------------
+class IncludeScanner
+{
+public:
+	IncludeScanner(std::vector< fs::path > includeDirs) : m_IncludeDirs(std::move(includeDirs)) {}
+
+	// Hash of 'source' and every file it reaches through quoted #includes, each counted once
+	u64 HashWithIncludes(const fs::path& source)
+	{
+		std::vector< fs::path > reached;
+		Collect(fs::weakly_canonical(source), reached);
+		std::sort(reached.begin(), reached.end());
+
+		u64 hash = render::kFnv1aOffsetBasis;
+		for (const auto& path : reached)
+		{
+			const File& file = m_Files[path.string()];
+			hash = HashCombine(hash, path.filename().string());
+			hash ^= file.contentHash;
+			hash *= render::kFnv1aPrime;
+		}
+		return hash;
+	}
+
+private:
+	struct File
+	{
+		u64                     contentHash = 0;
+		std::vector< fs::path > includes;
+	};
+
+	const File& Parse(const fs::path& path)
+	{
+		auto [iter, bInserted] = m_Files.try_emplace(path.string());
+		if (!bInserted)
+			return iter->second;
+
+		File& file = iter->second;
+
+		std::string text;
+		if (!ReadText(path, text))
+		{
+			// A missing include still changes the key, so fixing it triggers a rebuild
+			file.contentHash = HashCombine(render::kFnv1aOffsetBasis, "<missing>");
+			return file;
+		}
+		file.contentHash = render::HashShaderBinary(text.data(), text.size());
+
+		std::istringstream lines(text);
+		std::string line;
+		while (std::getline(lines, line))
+		{
+			// Only directives at the start of a line; commented-out includes don't count
+			size_t pos = line.find_first_not_of(" \t");
+			if (pos == std::string::npos || line[pos] != '#')
+				continue;
+			pos = line.find_first_not_of(" \t", pos + 1);
+			if (pos == std::string::npos || line.compare(pos, 7, "include") != 0)
+				continue;
+
+			const size_t open  = line.find('"', pos + 7);
+			const size_t close = open == std::string::npos ? std::string::npos : line.find('"', open + 1);
+			if (close == std::string::npos)
+				continue;
+
+			const std::string name = line.substr(open + 1, close - open - 1);
+			file.includes.push_back(Resolve(path.parent_path(), name));
+		}
+		return file;
+	}
+
+	fs::path Resolve(const fs::path& directory, const std::string& name) const
+	{
+		std::error_code ec;
+		const fs::path local = directory / name;
+		if (fs::exists(local, ec))
+			return fs::weakly_canonical(local, ec);
+
+		for (const auto& includeDir : m_IncludeDirs)
+		{
+			const fs::path candidate = includeDir / name;
+			if (fs::exists(candidate, ec))
+				return fs::weakly_canonical(candidate, ec);
+		}
+		return fs::weakly_canonical(local, ec);
+	}
+
+	void Collect(const fs::path& path, std::vector< fs::path >& reached)
+	{
+		if (std::find(reached.begin(), reached.end(), path) != reached.end())
+			return;
+
+		reached.push_back(path);
+
+		// Copy: Parse() may grow m_Files while we recurse
+		const std::vector< fs::path > includes = Parse(path).includes;
+		for (const auto& include : includes)
+			Collect(include, reached);
+	}
+
+	std::vector< fs::path >                 m_IncludeDirs;
+	std::unordered_map< std::string, File > m_Files;
+};
+
+//-------------------------------------------------------------------------
+// Per-API job lists
+//-------------------------------------------------------------------------
+std::string DefineArguments(const Options& options)
+{
+	std::string arguments;
+	for (const auto& define : options.defines)
+		arguments += " -D" + define;
+	return arguments;
+}
+
+// Mirrors the stage extensions GetCompiledShaderPath() expects in VkShader.cpp
+std::vector< Job > CollectVulkanJobs(const Options& options)
+{
+	static constexpr std::string_view kStageExtensions[] =
+		{ ".vert", ".frag", ".geom", ".hull", ".domain", ".task", ".mesh", ".comp" };
+
+	const fs::path sourceDir = options.root / "Assets/Shader/GLSL";
+	const fs::path outputDir = options.root / "Output/Shader/spv";
+
+	std::vector< Job > jobs;
+	for (const auto& entry : fs::recursive_directory_iterator(sourceDir))
+	{
+		const std::string extension = entry.path().extension().string();
+		if (!entry.is_regular_file() ||
+			std::find(std::begin(kStageExtensions), std::end(kStageExtensions), extension) == std::end(kStageExtensions))
+		{
+			continue;
+		}
+
+		Job& job = jobs.emplace_back();
+		job.source     = entry.path();
+		job.outputName = entry.path().filename().string() + ".spv";
+		job.output     = outputDir / job.outputName;
+		job.arguments  = "-V -gVS --target-env vulkan1.4" + DefineArguments(options);
+		job.outputFlag = "-o";
+	}
+	return jobs;
+}
+
+// Mirrors the <Name><Stage>.hlsl convention the premake shadertype filters used
+std::vector< Job > CollectDx12Jobs(const Options& options)
+{
+	static constexpr std::pair< std::string_view, std::string_view > kStageProfiles[] =
+	{
+		{ "VS.hlsl", "vs_6_6" }, { "PS.hlsl", "ps_6_6" }, { "GS.hlsl", "gs_6_6" },
+		{ "DS.hlsl", "ds_6_6" }, { "HS.hlsl", "hs_6_6" }, { "CS.hlsl", "cs_6_6" },
+		{ "MS.hlsl", "ms_6_6" }, { "TS.hlsl", "as_6_6" }, { "LIB.hlsl", "lib_6_6" },
+	};
+
+	const fs::path sourceDir = options.root / "Assets/Shader/HLSL";
+	const fs::path outputDir = options.root / "Output/Shader/cso";
+
+	// Dx12 has no specialization constants; every declared and every recorded permutation is its own binary
+	static constexpr u32 kMaxDeclaredPermutations = 256;
+
+	render::ShaderPermutationList permutations;
+	permutations.Load(options.root / render::GetShaderPermutationListPath());
+
+	std::vector< Job > jobs;
+	for (const auto& entry : fs::recursive_directory_iterator(sourceDir))
+	{
+		if (!entry.is_regular_file())
+			continue;
+
+		const std::string filename = entry.path().filename().string();
+		for (const auto& [suffix, profile] : kStageProfiles)
+		{
+			if (!filename.ends_with(suffix))
+				continue;
+
+			const std::string stem = entry.path().stem().string();
+
+			Job& job = jobs.emplace_back();
+			job.source     = entry.path();
+			job.outputName = stem + ".cso";
+			job.output     = outputDir / job.outputName;
+			job.arguments  = "-T " + std::string(profile) + (profile == "lib_6_6" ? "" : " -E main") + DefineArguments(options);
+			job.outputFlag = "-Fo";
+
+			std::ifstream source(entry.path());
+			const auto    ranges   = render::ParsePermutationDeclarations(source);
+			const auto    declared = render::EnumeratePermutations(ranges, kMaxDeclaredPermutations);
+			if (declared.size() == kMaxDeclaredPermutations)
+				printf("[ShaderBuilder] '%s' declares more than %u permutations; the rest are built from the recorded list only\n", filename.c_str(), kMaxDeclaredPermutations);
+			for (const auto& features : declared)
+				permutations.Add(stem, features);
+
+			// copy the base job; 'job' dangles once the first variant is pushed
+			const Job base = job;
+			for (const auto& permutation : permutations.Entries())
+			{
+				if (permutation.filename != stem)
+					continue;
+
+				Job variant = base;
+				variant.outputName = stem + render::GetPermutationSuffix(permutation.features) + ".cso";
+				variant.output     = outputDir / variant.outputName;
+				for (const auto& feature : permutation.features)
+					variant.arguments += " -D" + feature.name + "=" + std::to_string(feature.value);
+				jobs.push_back(std::move(variant));
+			}
+			break;
+		}
+	}
+	return jobs;
+}
+
+std::string DefaultCompiler(const std::string& api)
+{
+	if (api == "vulkan")
+	{
+		const char* vulkanSdk = std::getenv("VULKAN_SDK");
+		return vulkanSdk ? (fs::path(vulkanSdk) / "Bin" / "glslangValidator").string() : "glslangValidator";
+	}
+	return "dxc";
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string_view arg = argv[i];
+		const bool bHasValue = i + 1 < argc;
+		if (arg == "--api" && bHasValue)
+			options.api = argv[++i];
+		else if (arg == "--root" && bHasValue)
+			options.root = argv[++i];
+		else if (arg == "--compiler" && bHasValue)
+			options.compiler = argv[++i];
+		else if (arg == "--jobs" && bHasValue)
+			options.numJobs = static_cast< u32 >(std::strtoul(argv[++i], nullptr, 10));
+		else if (arg == "--force")
+			options.bForce = true;
+		else if (arg == "-D" && bHasValue)
+			options.defines.push_back(argv[++i]);
+		else if (arg.starts_with("-D") && arg.size() > 2)
+			options.defines.emplace_back(arg.substr(2));
+		else
+			return false;
+	}
+
+	if (options.api != "vulkan" && options.api != "dx12")
+		return false;
+
+	if (options.compiler.empty())
+		options.compiler = DefaultCompiler(options.api);
+	if (options.numJobs == 0)
+		options.numJobs = std::max(1u, std::thread::hardware_concurrency());
+	return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		fprintf(stderr, "usage: ShaderBuilder --api vulkan|dx12 [--root <dir>] [--compiler <path>] [--jobs N] [--force] [-D NAME[=VALUE]]...\n");
+		return 2;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	// The compiler's version string is part of every key, so a toolchain update rebuilds everything
+	std::string compilerVersion;
+	if (RunCommand(Quote(options.compiler) + " --version", compilerVersion) != 0)
+	{
+		fprintf(stderr, "[ShaderBuilder] cannot run '%s'\n%s", options.compiler.c_str(), compilerVersion.c_str());
+		return 1;
+	}
+
+	std::vector< Job > jobs = options.api == "vulkan" ? CollectVulkanJobs(options) : CollectDx12Jobs(options);
+	std::sort(jobs.begin(), jobs.end(), [](const Job& lhs, const Job& rhs) { return lhs.outputName < rhs.outputName; });
+
+	const fs::path shaderRoot   = options.root / "Assets/Shader";
+	const fs::path manifestPath = render::GetShaderManifestPath(
+		options.root / (options.api == "vulkan" ? "Output/Shader/spv" : "Output/Shader/cso"));
+
+	render::ShaderManifest previous;
+	previous.Load(manifestPath);
+
+	// **
+	// Keys
+	// **
+	IncludeScanner scanner({ shaderRoot });
+
+	u64 toolHash = render::kFnv1aOffsetBasis;
+	toolHash = HashCombine(toolHash, std::to_string(kToolVersion));
+	toolHash = HashCombine(toolHash, options.api);
+	toolHash = HashCombine(toolHash, compilerVersion);
+
+	std::vector< u32 > dirty;
+	render::ShaderManifest manifest;
+	for (u32 i = 0; i < jobs.size(); ++i)
+	{
+		Job& job = jobs[i];
+		job.key = HashCombine(toolHash ^ scanner.HashWithIncludes(job.source), job.arguments);
+
+		const auto* pEntry = previous.Find(job.outputName);
+		std::error_code ec;
+		if (options.bForce || !pEntry || pEntry->key != job.key || !fs::exists(job.output, ec))
+			dirty.push_back(i);
+		else
+			manifest.Add(*pEntry);
+	}
+
+	// **
+	// Compile
+	// **
+	std::error_code ec;
+	if (!jobs.empty())
+		fs::create_directories(jobs.front().output.parent_path(), ec);
+
+	std::mutex          mutex;
+	std::atomic< u32 >  next{ 0 };
+	std::atomic< u32 >  numFailed{ 0 };
+	auto worker = [&]()
+	{
+		for (u32 i = next.fetch_add(1); i < dirty.size(); i = next.fetch_add(1))
+		{
+			const Job& job = jobs[dirty[i]];
+
+			std::string log;
+			const int exitCode = RunCommand(
+				Quote(options.compiler) + " " + job.arguments + " " + job.outputFlag + " " + Quote(job.output) + " " + Quote(job.source), log);
+
+			render::ShaderManifest::Entry entry = {};
+			bool bCompiled = exitCode == 0;
+			if (bCompiled)
+			{
+				std::string binary;
+				bCompiled = ReadText(job.output, binary);
+				entry.name       = job.outputName;
+				entry.key        = job.key;
+				entry.binaryHash = render::HashShaderBinary(binary.data(), binary.size());
+			}
+
+			std::lock_guard< std::mutex > lock(mutex);
+			if (bCompiled)
+			{
+				printf("[ShaderBuilder] %s\n", job.outputName.c_str());
+				manifest.Add(entry);
+			}
+			else
+			{
+				// No manifest entry, so the next run retries it
+				fprintf(stderr, "[ShaderBuilder] FAILED %s\n%s\n", job.source.string().c_str(), log.c_str());
+				numFailed.fetch_add(1);
+			}
+		}
+	};
+
+	const u32 numWorkers = std::min< u32 >(options.numJobs, static_cast< u32 >(dirty.size()));
+	std::vector< std::thread > threads;
+	for (u32 i = 1; i < numWorkers; ++i)
+		threads.emplace_back(worker);
+	worker();
+	for (auto& thread : threads)
+		thread.join();
+
+	if (!manifest.Save(manifestPath))
+		fprintf(stderr, "[ShaderBuilder] failed to write '%s'\n", manifestPath.string().c_str());
+
+	const double elapsedMs = std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - start).count();
+	printf("[ShaderBuilder] %s: %zu shaders, %zu rebuilt, %u failed, %zu up to date in %.0f ms\n",
+		options.api.c_str(), jobs.size(), dirty.size(), numFailed.load(), jobs.size() - dirty.size(), elapsedMs);
+
+	return numFailed.load() == 0 ? 0 : 1;
+}
@@ -69,6 +69,7 @@ DynamicBufferAllocator::Page::Page(VkRenderDevice& rd, VkDeviceSize sizeInBytes)
 	, m_OffsetInBytes(0)
 {
 	m_pBuffer = VulkanUniformBuffer::Create(m_RenderDevice, "AllocatedBuffer_Dynamic", sizeInBytes, VK_BUFFER_USAGE_2_TRANSFER_SRC_BIT);
+	m_pBuffer->SetMemoryTag(render::eMemoryTag::DynamicBuffers);
 }
 
 DynamicBufferAllocator::Page::~Page()
@@ -183,6 +184,9 @@ void StaticBufferAllocator::Resize(VkDeviceSize sizeInBytes)
 			m_pAllocatedBuffer = VulkanUniformBuffer::Create(m_RenderDevice, "AllocatedBuffer_Static", sizeInBytes, m_UsageFlags);
 		else if (m_UsageFlags & VK_BUFFER_USAGE_2_INDEX_BUFFER_BIT)
 			m_pAllocatedBuffer = VulkanIndexBuffer::Create(m_RenderDevice, "AllocatedBuffer_Static", (u32)(sizeInBytes / sizeof(u32)), VK_INDEX_TYPE_UINT32);
+
+		if (m_pAllocatedBuffer)
+			m_pAllocatedBuffer->SetMemoryTag(render::eMemoryTag::StaticBuffers);
 		return;
 	}
 
@@ -17,12 +17,12 @@
 namespace vk
 {
 
-static bool ValidateResourceBinding(const std::string& name, u32 set, u32 binding)
+static bool ValidateResourceBinding(const render::BindingId& id, u32 set, u32 binding)
 {
 	if (set != kInvalidIndex && binding != kInvalidIndex)
 		return true;
 
-	BB_ASSERT(false, "Descriptor '%s' was not found in the current Vulkan pipeline.", name.c_str());
+	BB_ASSERT(false, "Descriptor '%s' was not found in the current Vulkan pipeline.", id.name);
 	return false;
 }
 
@@ -114,20 +114,20 @@ public:
 		VkImageLayout newLayout,
 		u32 baseMip = 0, u32 numMips = 1, u32 baseArray = 0, u32 numArrays = 1);
 
-	void SetComputeDynamicUniformBuffer(const std::string& name, u32 sizeInBytes, const void* pData);
-	void SetGraphicsDynamicUniformBuffer(const std::string& name, u32 sizeInBytes, const void* pData);
+	void SetComputeDynamicUniformBuffer(const render::BindingId& id, u32 sizeInBytes, const void* pData);
+	void SetGraphicsDynamicUniformBuffer(const render::BindingId& id, u32 sizeInBytes, const void* pData);
 
 	void SetPushConstants(u32 sizeInBytes, const void* pData, VkShaderStageFlags stages, u32 offsetInBytes = 0);
 	void SetDynamicUniformBuffer(u32 set, u32 binding, VkDeviceSize sizeInBytes, const void* pData);
 	
-	void SetComputeShaderResource(const std::string& name, Arc< VulkanBuffer > pBuffer);
-	void SetGraphicsShaderResource(const std::string& name, Arc< VulkanBuffer > pBuffer);
-	void SetComputeShaderResource(const std::string& name, Arc< VulkanTexture > pTexture, Arc< VulkanSampler > samplerInCharge);
-	void SetGraphicsShaderResource(const std::string& name, Arc< VulkanTexture > pTexture, Arc< VulkanSampler > samplerInCharge);
+	void SetComputeShaderResource(const render::BindingId& id, Arc< VulkanBuffer > pBuffer);
+	void SetGraphicsShaderResource(const render::BindingId& id, Arc< VulkanBuffer > pBuffer);
+	void SetComputeShaderResource(const render::BindingId& id, Arc< VulkanTexture > pTexture, Arc< VulkanSampler > samplerInCharge);
+	void SetGraphicsShaderResource(const render::BindingId& id, Arc< VulkanTexture > pTexture, Arc< VulkanSampler > samplerInCharge);
 	 
-	void StageDescriptor(const std::string& name, Arc< VulkanBuffer > pBuffer, u32 offset = 0);
-	void StageDescriptor(const std::string& name, Arc< VulkanTexture > pTexture, Arc< VulkanSampler > pSamplerInCharge, u32 offset = 0);
-	void StageDescriptorMip(const std::string& name, Arc< VulkanTexture > pTexture, u32 mipLevel, Arc< VulkanSampler > pSamplerInCharge = nullptr);
+	void StageDescriptor(const render::BindingId& id, Arc< VulkanBuffer > pBuffer, u32 offset = 0);
+	void StageDescriptor(const render::BindingId& id, Arc< VulkanTexture > pTexture, Arc< VulkanSampler > pSamplerInCharge, u32 offset = 0);
+	void StageDescriptorMip(const render::BindingId& id, Arc< VulkanTexture > pTexture, u32 mipLevel, Arc< VulkanSampler > pSamplerInCharge = nullptr);
 
 	void PushDescriptor(u32 set, u32 binding, const VkDescriptorBufferInfo& bufferInfo, VkDescriptorType descriptorType);
 	void PushDescriptor(u32 set, u32 binding, const VkDescriptorImageInfo& imageInfo, VkDescriptorType descriptorType);
@@ -155,6 +155,10 @@ public:
 	void Flush() const;
 	void FlushBarriers();
 
+	VkCommandBuffer SplitCommandBuffer();
+	void AddWaitSemaphore(VkSemaphore vkSemaphore, VkPipelineStageFlags vkStage);
+	void ConsumeWaitSemaphores(std::vector< VkSemaphore >& outSemaphores, std::vector< VkPipelineStageFlags >& outStages);
+
 	eCommandType GetCommandType() const { return m_CommandType; }
 
 	bool IsTransient() const { return m_bTransient; }
@@ -169,6 +173,7 @@ public:
 	VkSemaphore vkRenderCompleteSemaphore() const { return m_vkPresentWaitSemaphore ? m_vkPresentWaitSemaphore : m_vkRenderCompleteSemaphore; }
 	void SetPresentWaitSemaphore(VkSemaphore vkSemaphore) { m_vkPresentWaitSemaphore = vkSemaphore; }
 	VkSemaphore vkPresentCompleteSemaphore() const { return m_vkPresentCompleteSemaphore; }
+	VkSemaphore vkSplitSemaphore() const { return m_vkSplitSemaphore; }
 
 	VkPipelineLayout vkGraphicsPipelineLayout() const { return m_pGraphicsPipeline ? m_pGraphicsPipeline->vkPipelineLayout() : nullptr; }
 	VkPipelineLayout vkComputePipelineLayout() const { return m_pComputePipeline ? m_pComputePipeline->vkPipelineLayout() : nullptr; }
@@ -180,11 +185,15 @@ public:
 
 	double GetElapsedTime() const;
 
-	void BeginGpuMarker(const char* name, bool bWithStats);
+	void BeginGpuMarker(render::ProfileScopeId scopeId, bool bWithStats);
 	void EndGpuMarker();
 	const std::vector< render::GpuProfileEntry >& GetLastFrameProfile() const;
+	u64 GetLastFrameProfileIndex() const { return m_Timer.GetLastFrameIndex(); }
+
+	void ExecuteCommands(VkCommandBuffer vkSecondaryCommandBuffer);
 
 private:
+	void ClampToQueueStages(VkPipelineStageFlags2& stage, VkAccessFlags2& access) const;
 	void AddBarrier(const VkBufferMemoryBarrier2& barrier, bool bFlushImmediate);
 	void AddBarrier(const VkImageMemoryBarrier2& barrier, bool bFlushImmediate);
 
@@ -209,6 +218,11 @@ private:
 	VkCommandPool        m_vkBelongedPool = VK_NULL_HANDLE;
 	VkCommandBufferLevel m_Level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 
+	// one command buffer per part of a frame split around async compute ([0] when unsplit);
+	// m_vkCommandBuffer is the one being recorded
+	std::vector< VkCommandBuffer > m_vkCommandBuffers;
+	u32                            m_NumSplits = 0;
+
 	Box< DynamicBufferAllocator > m_pUniformBufferPool;
 	Box< DynamicBufferAllocator > m_pStagingBufferPool;
 
@@ -216,6 +230,10 @@ private:
 	VkSemaphore m_vkRenderCompleteSemaphore  = VK_NULL_HANDLE;
 	VkSemaphore m_vkPresentCompleteSemaphore = VK_NULL_HANDLE;
 	VkSemaphore m_vkPresentWaitSemaphore     = VK_NULL_HANDLE;
+	VkSemaphore m_vkSplitSemaphore           = VK_NULL_HANDLE;
+
+	std::vector< VkSemaphore >          m_vkWaitSemaphores;
+	std::vector< VkPipelineStageFlags > m_vkWaitStages;
 
 	VulkanGraphicsPipeline* m_pGraphicsPipeline = nullptr;
 	VulkanComputePipeline*  m_pComputePipeline  = nullptr;
@@ -255,6 +273,7 @@ VkCommandContext::Impl::Impl(VkRenderDevice& rd, VkCommandContext& context, VkCo
 	allocInfo.level = m_Level;
 	allocInfo.commandBufferCount = 1;
 	VK_CHECK(vkAllocateCommandBuffers(m_RenderDevice.vkDevice(), &allocInfo, &m_vkCommandBuffer));
+	m_vkCommandBuffers.push_back(m_vkCommandBuffer);
 
 
 	// **
@@ -276,11 +295,16 @@ VkCommandContext::Impl::Impl(VkRenderDevice& rd, VkCommandContext& context, VkCo
 	semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 	VK_CHECK(vkCreateSemaphore(m_RenderDevice.vkDevice(), &semaphoreInfo, nullptr, &m_vkRenderCompleteSemaphore));
 	VK_CHECK(vkCreateSemaphore(m_RenderDevice.vkDevice(), &semaphoreInfo, nullptr, &m_vkPresentCompleteSemaphore));
+	VK_CHECK(vkCreateSemaphore(m_RenderDevice.vkDevice(), &semaphoreInfo, nullptr, &m_vkSplitSemaphore));
 
 
 	// **
 	// Set Gpu Timer
 	// **
+	// secondaries are timed by the primary that executes them
+	if (m_Level == VK_COMMAND_BUFFER_LEVEL_SECONDARY)
+		return;
+
 	const bool bGraphicsPipelineStatistics =
 		m_CommandType == eCommandType::Graphics &&
 		m_RenderDevice.Capabilities().bPipelineStatistics;
@@ -297,11 +321,12 @@ VkCommandContext::Impl::~Impl()
 {
 	m_Timer.Destroy(m_RenderDevice.vkDevice());
 
+	vkDestroySemaphore(m_RenderDevice.vkDevice(), m_vkSplitSemaphore, nullptr);
 	vkDestroySemaphore(m_RenderDevice.vkDevice(), m_vkPresentCompleteSemaphore, nullptr);
 	vkDestroySemaphore(m_RenderDevice.vkDevice(), m_vkRenderCompleteSemaphore, nullptr);
 	vkDestroyFence(m_RenderDevice.vkDevice(), m_vkRenderCompleteFence, nullptr);
 
-	vkFreeCommandBuffers(m_RenderDevice.vkDevice(), m_vkBelongedPool, 1, &m_vkCommandBuffer);
+	vkFreeCommandBuffers(m_RenderDevice.vkDevice(), m_vkBelongedPool, static_cast< u32 >(m_vkCommandBuffers.size()), m_vkCommandBuffers.data());
 }
 
 void VkCommandContext::Impl::Open(VkCommandBufferUsageFlags flags)
@@ -311,12 +336,21 @@ void VkCommandContext::Impl::Open(VkCommandBufferUsageFlags flags)
 	m_CurrentContextIndex = m_RenderDevice.ContextIndex();
 
 	m_vkPresentWaitSemaphore = VK_NULL_HANDLE;
+	m_vkWaitSemaphores.clear();
+	m_vkWaitStages.clear();
 
+	m_NumSplits       = 0;
+	m_vkCommandBuffer = m_vkCommandBuffers[0];
 	VK_CHECK(vkResetCommandBuffer(m_vkCommandBuffer, 0));
 
+	// secondaries begin and end their own rendering, so nothing is inherited
+	VkCommandBufferInheritanceInfo inheritanceInfo = {};
+	inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+
 	VkCommandBufferBeginInfo beginInfo = {};
-	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-	beginInfo.flags = flags;
+	beginInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags            = flags;
+	beginInfo.pInheritanceInfo = m_Level == VK_COMMAND_BUFFER_LEVEL_SECONDARY ? &inheritanceInfo : nullptr;
 	VK_CHECK(vkBeginCommandBuffer(m_vkCommandBuffer, &beginInfo));
 
 	m_pUniformBufferPool->Reset();
@@ -328,17 +362,67 @@ void VkCommandContext::Impl::Open(VkCommandBufferUsageFlags flags)
 
 	// Reads previous frame's timestamp results (fence above guarantees completion),
 	// resets the pool, and opens the implicit "Frame" scope.
-	m_Timer.BeginFrame(m_vkCommandBuffer, m_RenderDevice.vkDevice(), m_RenderDevice.DeviceProps());
+	if (m_Level == VK_COMMAND_BUFFER_LEVEL_PRIMARY)
+		m_Timer.BeginFrame(m_vkCommandBuffer, m_RenderDevice.vkDevice(), m_RenderDevice.DeviceProps(), m_RenderDevice.FrameIndex());
 }
 
 void VkCommandContext::Impl::Close()
 {
-	m_Timer.EndFrame(m_vkCommandBuffer); // closes implicit "Frame"
+	if (m_Level == VK_COMMAND_BUFFER_LEVEL_PRIMARY)
+		m_Timer.EndFrame(m_vkCommandBuffer); // closes implicit "Frame"
 
 	FlushBarriers();
 	VK_CHECK(vkEndCommandBuffer(m_vkCommandBuffer));
 }
 
+VkCommandBuffer VkCommandContext::Impl::SplitCommandBuffer()
+{
+	assert(m_Level == VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+	FlushBarriers();
+	VK_CHECK(vkEndCommandBuffer(m_vkCommandBuffer));
+	VkCommandBuffer vkClosedCommandBuffer = m_vkCommandBuffer;
+
+	if (++m_NumSplits == m_vkCommandBuffers.size())
+	{
+		VkCommandBufferAllocateInfo allocInfo = {};
+		allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.commandPool        = m_vkBelongedPool;
+		allocInfo.level              = m_Level;
+		allocInfo.commandBufferCount = 1;
+		VK_CHECK(vkAllocateCommandBuffers(m_RenderDevice.vkDevice(), &allocInfo, &m_vkCommandBuffers.emplace_back()));
+	}
+	m_vkCommandBuffer = m_vkCommandBuffers[m_NumSplits];
+	VK_CHECK(vkResetCommandBuffer(m_vkCommandBuffer, 0));
+
+	// bound state and push descriptors do not carry over; the timer's open scopes do, as the
+	// query pool is shared by every part of the frame
+	VkCommandBufferBeginInfo beginInfo = {};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	VK_CHECK(vkBeginCommandBuffer(m_vkCommandBuffer, &beginInfo));
+
+	m_pGraphicsPipeline = nullptr;
+	m_pComputePipeline  = nullptr;
+	m_PushAllocations.clear();
+
+	return vkClosedCommandBuffer;
+}
+
+void VkCommandContext::Impl::AddWaitSemaphore(VkSemaphore vkSemaphore, VkPipelineStageFlags vkStage)
+{
+	m_vkWaitSemaphores.push_back(vkSemaphore);
+	m_vkWaitStages.push_back(vkStage);
+}
+
+void VkCommandContext::Impl::ConsumeWaitSemaphores(std::vector< VkSemaphore >& outSemaphores, std::vector< VkPipelineStageFlags >& outStages)
+{
+	outSemaphores.insert(outSemaphores.end(), m_vkWaitSemaphores.begin(), m_vkWaitSemaphores.end());
+	outStages.insert(outStages.end(), m_vkWaitStages.begin(), m_vkWaitStages.end());
+	m_vkWaitSemaphores.clear();
+	m_vkWaitStages.clear();
+}
+
 void VkCommandContext::Impl::UploadData(const Arc< VulkanBuffer >& pDstBuffer, const void* pData, u32 numElements, u64 elemSizeInBytes, u64 dstOffsetInBytes)
 {
 	u64 sizeInBytes = numElements * elemSizeInBytes;
@@ -798,21 +882,21 @@ void VkCommandContext::Impl::ClearTexture(
 	}
 }
 
-void VkCommandContext::Impl::SetComputeDynamicUniformBuffer(const std::string& name, u32 sizeInBytes, const void* pData)
+void VkCommandContext::Impl::SetComputeDynamicUniformBuffer(const render::BindingId& id, u32 sizeInBytes, const void* pData)
 {
 	assert(IsComputeContext());
-	auto [set, binding] = m_pComputePipeline->GetResourceBindingIndex(name);
-	if (!ValidateResourceBinding(name, set, binding))
+	auto [set, binding] = m_pComputePipeline->GetResourceBindingIndex(id);
+	if (!ValidateResourceBinding(id, set, binding))
 		return;
 
 	SetDynamicUniformBuffer(set, binding, sizeInBytes, pData);
 }
 
-void VkCommandContext::Impl::SetGraphicsDynamicUniformBuffer(const std::string& name, u32 sizeInBytes, const void* pData)
+void VkCommandContext::Impl::SetGraphicsDynamicUniformBuffer(const render::BindingId& id, u32 sizeInBytes, const void* pData)
 {
 	assert(IsGraphicsContext());
-	auto [set, binding] = m_pGraphicsPipeline->GetResourceBindingIndex(name);
-	if (!ValidateResourceBinding(name, set, binding))
+	auto [set, binding] = m_pGraphicsPipeline->GetResourceBindingIndex(id);
+	if (!ValidateResourceBinding(id, set, binding))
 		return;
 
 	SetDynamicUniformBuffer(set, binding, sizeInBytes, pData);
@@ -842,11 +926,11 @@ void VkCommandContext::Impl::SetDynamicUniformBuffer(u32 set, u32 binding, VkDev
 	m_PushAllocations[set].push_back({ binding, bufferInfo, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER });
 }
 
-void VkCommandContext::Impl::SetComputeShaderResource(const std::string& name, Arc< VulkanBuffer > pBuffer)
+void VkCommandContext::Impl::SetComputeShaderResource(const render::BindingId& id, Arc< VulkanBuffer > pBuffer)
 {
 	assert(IsComputeContext());
-	auto [set, binding] = m_pComputePipeline->GetResourceBindingIndex(name);
-	if (!ValidateResourceBinding(name, set, binding))
+	auto [set, binding] = m_pComputePipeline->GetResourceBindingIndex(id);
+	if (!ValidateResourceBinding(id, set, binding))
 		return;
 
 	PushDescriptor(
@@ -859,11 +943,11 @@ void VkCommandContext::Impl::SetComputeShaderResource(const std::string& name, A
 		}, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
 }
 
-void VkCommandContext::Impl::SetGraphicsShaderResource(const std::string& name, Arc< VulkanBuffer > pBuffer)
+void VkCommandContext::Impl::SetGraphicsShaderResource(const render::BindingId& id, Arc< VulkanBuffer > pBuffer)
 {
 	assert(IsGraphicsContext());
-	auto [set, binding] = m_pGraphicsPipeline->GetResourceBindingIndex(name);
-	if (!ValidateResourceBinding(name, set, binding))
+	auto [set, binding] = m_pGraphicsPipeline->GetResourceBindingIndex(id);
+	if (!ValidateResourceBinding(id, set, binding))
 		return;
 
 	PushDescriptor(
@@ -876,11 +960,11 @@ void VkCommandContext::Impl::SetGraphicsShaderResource(const std::string& name,
 		}, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
 }
 
-void VkCommandContext::Impl::SetComputeShaderResource(const std::string& name, Arc< VulkanTexture > pTexture, Arc< VulkanSampler > pSamplerInCharge)
+void VkCommandContext::Impl::SetComputeShaderResource(const render::BindingId& id, Arc< VulkanTexture > pTexture, Arc< VulkanSampler > pSamplerInCharge)
 {
 	assert(IsComputeContext());
-	auto [set, binding] = m_pComputePipeline->GetResourceBindingIndex(name);
-	if (!ValidateResourceBinding(name, set, binding))
+	auto [set, binding] = m_pComputePipeline->GetResourceBindingIndex(id);
+	if (!ValidateResourceBinding(id, set, binding))
 		return;
 
 	auto layout = pTexture->GetState().GetSubresourceState().layout;
@@ -897,11 +981,11 @@ void VkCommandContext::Impl::SetComputeShaderResource(const std::string& name, A
 		}, descType);
 }
 
-void VkCommandContext::Impl::SetGraphicsShaderResource(const std::string& name, Arc< VulkanTexture > pTexture, Arc< VulkanSampler > pSamplerInCharge)
+void VkCommandContext::Impl::SetGraphicsShaderResource(const render::BindingId& id, Arc< VulkanTexture > pTexture, Arc< VulkanSampler > pSamplerInCharge)
 {
 	assert(IsGraphicsContext());
-	auto [set, binding] = m_pGraphicsPipeline->GetResourceBindingIndex(name);
-	if (!ValidateResourceBinding(name, set, binding))
+	auto [set, binding] = m_pGraphicsPipeline->GetResourceBindingIndex(id);
+	if (!ValidateResourceBinding(id, set, binding))
 		return;
 
 	auto layout = pTexture->GetState().GetSubresourceState().layout;
@@ -918,12 +1002,12 @@ void VkCommandContext::Impl::SetGraphicsShaderResource(const std::string& name,
 		}, descType);
 }
 
-void VkCommandContext::Impl::StageDescriptor(const std::string& name, Arc< VulkanBuffer > pBuffer, u32 offset)
+void VkCommandContext::Impl::StageDescriptor(const render::BindingId& id, Arc< VulkanBuffer > pBuffer, u32 offset)
 {
 	if (IsGraphicsContext())
 	{
-		auto [set, binding] = m_pGraphicsPipeline->GetResourceBindingIndex(name);
-		if (!ValidateResourceBinding(name, set, binding))
+		auto [set, binding] = m_pGraphicsPipeline->GetResourceBindingIndex(id);
+		if (!ValidateResourceBinding(id, set, binding))
 			return;
 
 		PushDescriptor(
@@ -937,8 +1021,8 @@ void VkCommandContext::Impl::StageDescriptor(const std::string& name, Arc< Vulka
 	}
 	else if (IsComputeContext())
 	{
-		auto [set, binding] = m_pComputePipeline->GetResourceBindingIndex(name);
-		if (!ValidateResourceBinding(name, set, binding))
+		auto [set, binding] = m_pComputePipeline->GetResourceBindingIndex(id);
+		if (!ValidateResourceBinding(id, set, binding))
 			return;
 
 		PushDescriptor(
@@ -956,14 +1040,14 @@ void VkCommandContext::Impl::StageDescriptor(const std::string& name, Arc< Vulka
 	}
 }
 
-void VkCommandContext::Impl::StageDescriptor(const std::string& name, Arc< VulkanTexture > pTexture, Arc< VulkanSampler > pSamplerInCharge, u32 offset)
+void VkCommandContext::Impl::StageDescriptor(const render::BindingId& id, Arc< VulkanTexture > pTexture, Arc< VulkanSampler > pSamplerInCharge, u32 offset)
 {
 	UNUSED(offset);
 
 	if (IsGraphicsContext())
 	{
-		auto [set, binding] = m_pGraphicsPipeline->GetResourceBindingIndex(name);
-		if (!ValidateResourceBinding(name, set, binding))
+		auto [set, binding] = m_pGraphicsPipeline->GetResourceBindingIndex(id);
+		if (!ValidateResourceBinding(id, set, binding))
 			return;
 
 		auto layout = pTexture->GetState().GetSubresourceState().layout;
@@ -981,8 +1065,8 @@ void VkCommandContext::Impl::StageDescriptor(const std::string& name, Arc< Vulka
 	}
 	else if (IsComputeContext())
 	{
-		auto [set, binding] = m_pComputePipeline->GetResourceBindingIndex(name);
-		if (!ValidateResourceBinding(name, set, binding))
+		auto [set, binding] = m_pComputePipeline->GetResourceBindingIndex(id);
+		if (!ValidateResourceBinding(id, set, binding))
 			return;
 
 		auto layout = pTexture->GetState().GetSubresourceState().layout;
@@ -1005,13 +1089,13 @@ void VkCommandContext::Impl::StageDescriptor(const std::string& name, Arc< Vulka
 	}
 }
 
-void VkCommandContext::Impl::StageDescriptorMip(const std::string& name, Arc< VulkanTexture > pTexture, u32 mipLevel, Arc< VulkanSampler > pSamplerInCharge)
+void VkCommandContext::Impl::StageDescriptorMip(const render::BindingId& id, Arc< VulkanTexture > pTexture, u32 mipLevel, Arc< VulkanSampler > pSamplerInCharge)
 {
 	std::pair< u32, u32 > bindingPair;
 	if (IsComputeContext())
-		bindingPair = m_pComputePipeline->GetResourceBindingIndex(name);
+		bindingPair = m_pComputePipeline->GetResourceBindingIndex(id);
 	else if (IsGraphicsContext())
-		bindingPair = m_pGraphicsPipeline->GetResourceBindingIndex(name);
+		bindingPair = m_pGraphicsPipeline->GetResourceBindingIndex(id);
 	else
 	{
 		assert(false && "No pipeline is set!");
@@ -1019,7 +1103,7 @@ void VkCommandContext::Impl::StageDescriptorMip(const std::string& name, Arc< Vu
 	}
 
 	auto [set, binding] = bindingPair;
-	if (!ValidateResourceBinding(name, set, binding))
+	if (!ValidateResourceBinding(id, set, binding))
 		return;
 
 	// With sampler: bind per-mip view as SRV (ShaderReadOnly) — for reading a specific mip
@@ -1172,14 +1256,29 @@ double VkCommandContext::Impl::GetElapsedTime() const
 	return m_Timer.GetLastFrameTotalNs();
 }
 
-void VkCommandContext::Impl::BeginGpuMarker(const char* name, bool bWithStats)
+void VkCommandContext::Impl::BeginGpuMarker(render::ProfileScopeId scopeId, bool bWithStats)
 {
-	m_Timer.BeginMarker(m_vkCommandBuffer, name, bWithStats);
+	if (m_Level == VK_COMMAND_BUFFER_LEVEL_PRIMARY)
+		m_Timer.BeginMarker(m_vkCommandBuffer, scopeId, bWithStats);
 }
 
 void VkCommandContext::Impl::EndGpuMarker()
 {
-	m_Timer.EndMarker(m_vkCommandBuffer);
+	if (m_Level == VK_COMMAND_BUFFER_LEVEL_PRIMARY)
+		m_Timer.EndMarker(m_vkCommandBuffer);
+}
+
+void VkCommandContext::Impl::ExecuteCommands(VkCommandBuffer vkSecondaryCommandBuffer)
+{
+	assert(m_Level == VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+	FlushBarriers();
+	vkCmdExecuteCommands(m_vkCommandBuffer, 1, &vkSecondaryCommandBuffer);
+
+	// bound pipeline state is undefined after vkCmdExecuteCommands; force a rebind on next use
+	m_pGraphicsPipeline = nullptr;
+	m_pComputePipeline  = nullptr;
+	m_PushAllocations.clear();
 }
 
 const std::vector< render::GpuProfileEntry >& VkCommandContext::Impl::GetLastFrameProfile() const
@@ -1207,8 +1306,43 @@ void VkCommandContext::Impl::AddBarrier(const VkImageMemoryBarrier2& barrier, bo
 	}
 }
 
+void VkCommandContext::Impl::ClampToQueueStages(VkPipelineStageFlags2& stage, VkAccessFlags2& access) const
+{
+	if (m_CommandType != eCommandType::Compute)
+		return;
+
+	// A compute queue cannot name graphics stages. Graphics work on the other side of such a barrier
+	// belongs to another submission, already ordered against this one by the semaphores between them.
+	constexpr VkPipelineStageFlags2 kComputeQueueStages =
+		VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT | VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT |
+		VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_HOST_BIT |
+		VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COPY_BIT | VK_PIPELINE_STAGE_2_CLEAR_BIT;
+	constexpr VkAccessFlags2 kComputeQueueAccess =
+		VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_UNIFORM_READ_BIT |
+		VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT |
+		VK_ACCESS_2_SHADER_SAMPLED_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT |
+		VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT |
+		VK_ACCESS_2_HOST_READ_BIT | VK_ACCESS_2_HOST_WRITE_BIT | VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+	stage  &= kComputeQueueStages;
+	access &= kComputeQueueAccess;
+	if (stage == VK_PIPELINE_STAGE_2_NONE)
+		access = VK_ACCESS_2_NONE;
+}
+
 void VkCommandContext::Impl::FlushBarriers()
 {
+	for (u32 i = 0; i < m_NumBufferBarriersToFlush; ++i)
+	{
+		ClampToQueueStages(m_BufferBarriers[i].srcStageMask, m_BufferBarriers[i].srcAccessMask);
+		ClampToQueueStages(m_BufferBarriers[i].dstStageMask, m_BufferBarriers[i].dstAccessMask);
+	}
+	for (u32 i = 0; i < m_NumImageBarriersToFlush; ++i)
+	{
+		ClampToQueueStages(m_ImageBarriers[i].srcStageMask, m_ImageBarriers[i].srcAccessMask);
+		ClampToQueueStages(m_ImageBarriers[i].dstStageMask, m_ImageBarriers[i].dstAccessMask);
+	}
+
 	if (m_NumBufferBarriersToFlush > 0)
 	{
 		VkDependencyInfo dependency = {};
@@ -1467,6 +1601,23 @@ void VkCommandContext::UAVBarrier(const Arc< render::Buffer >& pBuffer, bool bFl
 	m_Impl->UAVBarrier(StaticCast<VulkanBuffer>(pBuffer), bFlushImmediate);
 }
 
+void VkCommandContext::AliasingBarrier(const Arc< render::Texture >& pBefore, const Arc< render::Texture >& pAfter)
+{
+	auto rhiBefore = StaticCast< VulkanTexture >(pBefore);
+	auto rhiAfter  = StaticCast< VulkanTexture >(pAfter);
+	assert(rhiBefore && rhiAfter);
+
+	// the next transition of 'pAfter' then waits on every last use of 'pBefore'
+	// and discards the old contents (UNDEFINED) instead of converting them
+	BarrierState lastUse = rhiBefore->GetState().GetSubresourceState();
+	for (const auto& [_, subresourceState] : rhiBefore->GetState())
+	{
+		lastUse.access |= subresourceState.access;
+		lastUse.stage  |= subresourceState.stage;
+	}
+	rhiAfter->SetState({ lastUse.access, lastUse.stage, VK_IMAGE_LAYOUT_UNDEFINED });
+}
+
 void VkCommandContext::TransitionImageLayout(
 	Arc< VulkanTexture > texture,
 	VkImageLayout newLayout,
@@ -1525,46 +1676,46 @@ void VkCommandContext::SetGraphicsConstants(u32 sizeInBytes, const void* pData,
 	m_Impl->SetPushConstants(sizeInBytes, pData, stages, offsetInBytes);
 }
 
-void VkCommandContext::SetComputeDynamicUniformBuffer(const std::string& name, u32 sizeInBytes, const void* pData)
+void VkCommandContext::SetComputeDynamicUniformBuffer(const render::BindingId& id, u32 sizeInBytes, const void* pData)
 {
-	m_Impl->SetComputeDynamicUniformBuffer(name, sizeInBytes, pData);
+	m_Impl->SetComputeDynamicUniformBuffer(id, sizeInBytes, pData);
 }
 
-void VkCommandContext::SetGraphicsDynamicUniformBuffer(const std::string& name, u32 sizeInBytes, const void* pData)
+void VkCommandContext::SetGraphicsDynamicUniformBuffer(const render::BindingId& id, u32 sizeInBytes, const void* pData)
 {
-	m_Impl->SetGraphicsDynamicUniformBuffer(name, sizeInBytes, pData);
+	m_Impl->SetGraphicsDynamicUniformBuffer(id, sizeInBytes, pData);
 }
 
-void VkCommandContext::SetComputeShaderResource(const std::string& name, Arc< render::Texture > texture, Arc< render::Sampler > samplerInCharge)
+void VkCommandContext::SetComputeShaderResource(const render::BindingId& id, Arc< render::Texture > texture, Arc< render::Sampler > samplerInCharge)
 {
 	auto rhiTexture = StaticCast<VulkanTexture>(texture);
 	assert(rhiTexture);
 
-	m_Impl->SetComputeShaderResource(name, rhiTexture, StaticCast<VulkanSampler>(samplerInCharge));
+	m_Impl->SetComputeShaderResource(id, rhiTexture, StaticCast<VulkanSampler>(samplerInCharge));
 }
 
-void VkCommandContext::SetGraphicsShaderResource(const std::string& name, Arc< render::Texture > texture, Arc< render::Sampler > samplerInCharge)
+void VkCommandContext::SetGraphicsShaderResource(const render::BindingId& id, Arc< render::Texture > texture, Arc< render::Sampler > samplerInCharge)
 {
 	auto rhiTexture = StaticCast<VulkanTexture>(texture);
 	assert(rhiTexture);
 
-	m_Impl->SetGraphicsShaderResource(name, rhiTexture, StaticCast<VulkanSampler>(samplerInCharge));
+	m_Impl->SetGraphicsShaderResource(id, rhiTexture, StaticCast<VulkanSampler>(samplerInCharge));
 }
 
-void VkCommandContext::SetComputeShaderResource(const std::string& name, Arc< render::Buffer > buffer)
+void VkCommandContext::SetComputeShaderResource(const render::BindingId& id, Arc< render::Buffer > buffer)
 {
 	auto rhiBuffer = StaticCast<VulkanBuffer>(buffer);
 	assert(rhiBuffer);
 
-	m_Impl->SetComputeShaderResource(name, rhiBuffer);
+	m_Impl->SetComputeShaderResource(id, rhiBuffer);
 }
 
-void VkCommandContext::SetGraphicsShaderResource(const std::string& name, Arc< render::Buffer > buffer)
+void VkCommandContext::SetGraphicsShaderResource(const render::BindingId& id, Arc< render::Buffer > buffer)
 {
 	auto rhiBuffer = StaticCast<VulkanBuffer>(buffer);
 	assert(rhiBuffer);
 
-	m_Impl->SetGraphicsShaderResource(name, rhiBuffer);
+	m_Impl->SetGraphicsShaderResource(id, rhiBuffer);
 }
 
 void VkCommandContext::SetAccelerationStructure(const std::string& name, render::TopLevelAccelerationStructure& tlas)
@@ -1574,28 +1725,28 @@ void VkCommandContext::SetAccelerationStructure(const std::string& name, render:
 	BB_ASSERT(false, "Vulkan acceleration-structure binding is unsupported.");
 }
 
-void VkCommandContext::StageDescriptor(const std::string& name, Arc< render::Buffer > buffer, u32 offset)
+void VkCommandContext::StageDescriptor(const render::BindingId& id, Arc< render::Buffer > buffer, u32 offset)
 {
 	auto rhiBuffer = StaticCast<VulkanBuffer>(buffer);
 	assert(rhiBuffer);
 
-	m_Impl->StageDescriptor(name, rhiBuffer, offset);
+	m_Impl->StageDescriptor(id, rhiBuffer, offset);
 }
 
-void VkCommandContext::StageDescriptor(const std::string& name, Arc< render::Texture > texture, Arc< render::Sampler > samplerInCharge, u32 offset)
+void VkCommandContext::StageDescriptor(const render::BindingId& id, Arc< render::Texture > texture, Arc< render::Sampler > samplerInCharge, u32 offset)
 {
 	auto rhiTexture = StaticCast<VulkanTexture>(texture);
 	assert(rhiTexture);
 
-	m_Impl->StageDescriptor(name, rhiTexture, StaticCast<VulkanSampler>(samplerInCharge), offset);
+	m_Impl->StageDescriptor(id, rhiTexture, StaticCast<VulkanSampler>(samplerInCharge), offset);
 }
 
-void VkCommandContext::StageDescriptorMip(const std::string& name, Arc< render::Texture > texture, u32 mipLevel, Arc< render::Sampler > samplerInCharge)
+void VkCommandContext::StageDescriptorMip(const render::BindingId& id, Arc< render::Texture > texture, u32 mipLevel, Arc< render::Sampler > samplerInCharge)
 {
 	auto rhiTexture = StaticCast<VulkanTexture>(texture);
 	assert(rhiTexture);
 
-	m_Impl->StageDescriptorMip(name, rhiTexture, mipLevel, StaticCast<VulkanSampler>(samplerInCharge));
+	m_Impl->StageDescriptorMip(id, rhiTexture, mipLevel, StaticCast<VulkanSampler>(samplerInCharge));
 }
 
 void VkCommandContext::PushDescriptor(u32 set, u32 binding, const VkDescriptorImageInfo& imageInfo, VkDescriptorType descriptorType)
@@ -1777,6 +1928,26 @@ VkSemaphore VkCommandContext::vkPresentCompleteSemaphore() const
 	return m_Impl->vkPresentCompleteSemaphore();
 }
 
+void VkCommandContext::AddWaitSemaphore(VkSemaphore vkSemaphore, VkPipelineStageFlags vkStage)
+{
+	m_Impl->AddWaitSemaphore(vkSemaphore, vkStage);
+}
+
+void VkCommandContext::ConsumeWaitSemaphores(std::vector< VkSemaphore >& outSemaphores, std::vector< VkPipelineStageFlags >& outStages)
+{
+	m_Impl->ConsumeWaitSemaphores(outSemaphores, outStages);
+}
+
+VkCommandBuffer VkCommandContext::SplitCommandBuffer()
+{
+	return m_Impl->SplitCommandBuffer();
+}
+
+VkSemaphore VkCommandContext::vkSplitSemaphore() const
+{
+	return m_Impl->vkSplitSemaphore();
+}
+
 VkPipelineLayout VkCommandContext::vkGraphicsPipelineLayout() const
 {
 	return m_Impl->vkGraphicsPipelineLayout();
@@ -1802,9 +1973,9 @@ double VkCommandContext::GetLastFrameElapsedTime() const
 	return m_Impl->GetElapsedTime();
 }
 
-void VkCommandContext::BeginGpuMarker(const char* name, bool bWithStats)
+void VkCommandContext::BeginGpuMarker(render::ProfileScopeId scopeId, bool bWithStats)
 {
-	m_Impl->BeginGpuMarker(name, bWithStats);
+	m_Impl->BeginGpuMarker(scopeId, bWithStats);
 }
 
 void VkCommandContext::EndGpuMarker()
@@ -1812,9 +1983,19 @@ void VkCommandContext::EndGpuMarker()
 	m_Impl->EndGpuMarker();
 }
 
+void VkCommandContext::ExecuteCommands(const VkCommandContext& secondaryContext)
+{
+	m_Impl->ExecuteCommands(secondaryContext.vkCommandBuffer());
+}
+
 const std::vector< render::GpuProfileEntry >& VkCommandContext::GetLastFrameProfile() const
 {
 	return m_Impl->GetLastFrameProfile();
 }
 
+u64 VkCommandContext::GetLastFrameProfileIndex() const
+{
+	return m_Impl->GetLastFrameProfileIndex();
+}
+
 } // namespace vk
@@ -71,6 +71,7 @@ public:
 	virtual void TransitionTextureToWrite(const Arc< render::Texture >& pTexture, render::ePipelineStage dstStage, u32 subresource = ALL_SUBRESOURCES, bool bFlushImmediate = false) override;
 	virtual void TransitionBarrier(const Arc< render::Texture >& texture, render::eTextureLayout newState, u32 subresource = ALL_SUBRESOURCES, bool bFlushImmediate = false) override;
 	virtual void UAVBarrier(const Arc < render::Buffer >& pBuffer, bool bFlushImmediate) override;
+	virtual void AliasingBarrier(const Arc< render::Texture >& pBefore, const Arc< render::Texture >& pAfter) override;
 
 	// todo. unlock other types of barrier
 	void TransitionImageLayout(
@@ -101,19 +102,26 @@ public:
 	virtual void SetComputeConstants(u32 sizeInBytes, const void* pData, u32 offsetInBytes = 0) override;
 	virtual void SetGraphicsConstants(u32 sizeInBytes, const void* pData, u32 offsetInBytes = 0) override;
 
-	virtual void SetComputeDynamicUniformBuffer(const std::string& name, u32 sizeInBytes, const void* pData) override;
-	virtual void SetGraphicsDynamicUniformBuffer(const std::string& name, u32 sizeInBytes, const void* pData) override;
+	using render::CommandContext::SetComputeDynamicUniformBuffer;
+	using render::CommandContext::SetGraphicsDynamicUniformBuffer;
+	using render::CommandContext::SetComputeShaderResource;
+	using render::CommandContext::SetGraphicsShaderResource;
+	using render::CommandContext::StageDescriptor;
+	using render::CommandContext::StageDescriptorMip;
 
-	virtual void SetComputeShaderResource(const std::string& name, Arc< render::Texture > texture, Arc< render::Sampler > samplerInCharge) override;
-	virtual void SetGraphicsShaderResource(const std::string& name, Arc< render::Texture > texture, Arc< render::Sampler > samplerInCharge) override;
-	virtual void SetComputeShaderResource(const std::string& name, Arc< render::Buffer > buffer) override;
-	virtual void SetGraphicsShaderResource(const std::string& name, Arc< render::Buffer > buffer) override;
+	virtual void SetComputeDynamicUniformBuffer(const render::BindingId& id, u32 sizeInBytes, const void* pData) override;
+	virtual void SetGraphicsDynamicUniformBuffer(const render::BindingId& id, u32 sizeInBytes, const void* pData) override;
+
+	virtual void SetComputeShaderResource(const render::BindingId& id, Arc< render::Texture > texture, Arc< render::Sampler > samplerInCharge) override;
+	virtual void SetGraphicsShaderResource(const render::BindingId& id, Arc< render::Texture > texture, Arc< render::Sampler > samplerInCharge) override;
+	virtual void SetComputeShaderResource(const render::BindingId& id, Arc< render::Buffer > buffer) override;
+	virtual void SetGraphicsShaderResource(const render::BindingId& id, Arc< render::Buffer > buffer) override;
 
 	virtual void SetAccelerationStructure(const std::string& name, render::TopLevelAccelerationStructure& tlas) override;
 
-	virtual void StageDescriptor(const std::string& name, Arc< render::Buffer > buffer, u32 offset = 0) override;
-	virtual void StageDescriptor(const std::string& name, Arc< render::Texture > texture, Arc< render::Sampler > samplerInCharge, u32 offset = 0) override;
-	virtual void StageDescriptorMip(const std::string& name, Arc< render::Texture > texture, u32 mipLevel, Arc< render::Sampler > samplerInCharge = nullptr) override;
+	virtual void StageDescriptor(const render::BindingId& id, Arc< render::Buffer > buffer, u32 offset = 0) override;
+	virtual void StageDescriptor(const render::BindingId& id, Arc< render::Texture > texture, Arc< render::Sampler > samplerInCharge, u32 offset = 0) override;
+	virtual void StageDescriptorMip(const render::BindingId& id, Arc< render::Texture > texture, u32 mipLevel, Arc< render::Sampler > samplerInCharge = nullptr) override;
 
 	void PushDescriptor(u32 set, u32 binding, const VkDescriptorImageInfo& imageInfo, VkDescriptorType descriptorType);
 	void PushDescriptor(u32 set, u32 binding, const VkDescriptorBufferInfo& bufferInfo, VkDescriptorType descriptorType);
@@ -157,16 +165,28 @@ public:
 	VkSemaphore vkRenderCompleteSemaphore() const;
 	VkSemaphore vkPresentCompleteSemaphore() const;
 
+	// Cross-queue synchronization. Waits added here go with the next submission of this context.
+	// SplitCommandBuffer ends what was recorded so far, for CommandQueue::SubmitSplit, and keeps
+	// recording into a fresh command buffer; vkSplitSemaphore is what such a submission may signal.
+	void AddWaitSemaphore(VkSemaphore vkSemaphore, VkPipelineStageFlags vkStage);
+	void ConsumeWaitSemaphores(std::vector< VkSemaphore >& outSemaphores, std::vector< VkPipelineStageFlags >& outStages);
+	VkCommandBuffer SplitCommandBuffer();
+	VkSemaphore vkSplitSemaphore() const;
+
 	VkPipelineLayout vkGraphicsPipelineLayout() const;
 	VkPipelineLayout vkComputePipelineLayout() const;
 	VkPipeline vkGraphicsPipeline() const;
 	VkPipeline vkComputePipeline() const;
 
-	virtual void BeginGpuMarker(const char* name, bool bWithStats = false) override;
+	virtual void BeginGpuMarker(render::ProfileScopeId scopeId, bool bWithStats = false) override;
 	virtual void EndGpuMarker() override;
 	virtual const std::vector< render::GpuProfileEntry >& GetLastFrameProfile() const override;
+	virtual u64 GetLastFrameProfileIndex() const override;
 	virtual double GetLastFrameElapsedTime() const override;
 
+	// Replays a closed secondary context (see CommandQueue::AllocateSecondary) into this primary.
+	void ExecuteCommands(const VkCommandContext& secondaryContext);
+
 private:
     class Impl;
     Box< Impl > m_Impl;
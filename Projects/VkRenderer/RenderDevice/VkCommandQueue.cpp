@@ -36,6 +36,14 @@ CommandQueue::~CommandQueue()
 	}
 	m_pContexts.clear();
 
+	for (auto& recorder : m_SecondaryRecorders)
+	{
+		for (auto& pContexts : recorder.pContexts)
+			pContexts.clear();
+		vkDestroyCommandPool(m_RenderDevice.vkDevice(), recorder.vkCommandPool, nullptr);
+	}
+	m_SecondaryRecorders.clear();
+
 	vkDestroyCommandPool(m_RenderDevice.vkDevice(), m_vkCommandPool, nullptr);
 }
 
@@ -86,6 +94,44 @@ void CommandQueue::RecycleUnsubmitted(Arc< VkCommandContext >&& pContext)
 	m_pAvailableContexts.push(std::move(pContext));
 }
 
+Arc< VkCommandContext > CommandQueue::AllocateSecondary(u32 recorderIndex, u32 contextIndex)
+{
+	assert(contextIndex < kMaxFramesInFlight);
+	if (recorderIndex >= m_SecondaryRecorders.size())
+	{
+		const size_t numRecorders = m_SecondaryRecorders.size();
+		m_SecondaryRecorders.resize(recorderIndex + 1);
+
+		for (size_t i = numRecorders; i < m_SecondaryRecorders.size(); ++i)
+		{
+			VkCommandPoolCreateInfo commandPoolInfo = {};
+			commandPoolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+			commandPoolInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+			commandPoolInfo.queueFamilyIndex = m_QueueIndex;
+			VK_CHECK(vkCreateCommandPool(m_RenderDevice.vkDevice(), &commandPoolInfo, nullptr, &m_SecondaryRecorders[i].vkCommandPool));
+		}
+	}
+
+	auto& recorder  = m_SecondaryRecorders[recorderIndex];
+	auto& pContexts = recorder.pContexts[contextIndex];
+	u32&  numUsed   = recorder.numUsed[contextIndex];
+	if (numUsed == pContexts.size())
+	{
+		pContexts.push_back(MakeArc< VkCommandContext >(m_RenderDevice, recorder.vkCommandPool, m_CommandType, VK_COMMAND_BUFFER_LEVEL_SECONDARY));
+	}
+
+	auto pContext = pContexts[numUsed++];
+	pContext->Open(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+	return pContext;
+}
+
+void CommandQueue::ResetSecondaries(u32 contextIndex)
+{
+	// the primary of this frame slot has been waited on, so its secondaries are free again
+	for (auto& recorder : m_SecondaryRecorders)
+		recorder.numUsed[contextIndex] = 0;
+}
+
 void CommandQueue::Flush()
 {
 	for (auto Context : m_pContexts)
@@ -100,18 +146,26 @@ void CommandQueue::ExecuteCommandBuffer(Arc< VkCommandContext > context)
 	// **
 	if (!context->IsTransient())
 	{
-		VkPipelineStageFlags waitStages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		std::vector< VkSemaphore >          waitSemaphores;
+		std::vector< VkPipelineStageFlags > waitStages;
+		context->ConsumeWaitSemaphores(waitSemaphores, waitStages);
+
+		// non-transient graphics contexts are frame contexts; they blit into the acquired swapchain image
+		if (m_CommandType == eCommandType::Graphics)
+		{
+			waitSemaphores.push_back(context->vkPresentCompleteSemaphore());
+			waitStages.push_back(VK_PIPELINE_STAGE_TRANSFER_BIT);
+		}
 
-		auto vkWaitSemaphore   = context->vkPresentCompleteSemaphore();
 		auto vkCommandBuffer   = context->vkCommandBuffer();
 		auto vkSignalSemaphore = context->vkRenderCompleteSemaphore();
 		auto vkRenderCompleteFence = context->vkRenderCompleteFence();
 
 		VkSubmitInfo submitInfo = {};
 		submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-		submitInfo.waitSemaphoreCount   = 1;
-		submitInfo.pWaitSemaphores      = &vkWaitSemaphore;
-		submitInfo.pWaitDstStageMask    = &waitStages;
+		submitInfo.waitSemaphoreCount   = static_cast< u32 >(waitSemaphores.size());
+		submitInfo.pWaitSemaphores      = waitSemaphores.data();
+		submitInfo.pWaitDstStageMask    = waitStages.data();
 		submitInfo.commandBufferCount   = 1;
 		submitInfo.pCommandBuffers      = &vkCommandBuffer;
 		submitInfo.signalSemaphoreCount = 1;
@@ -139,4 +193,27 @@ void CommandQueue::ExecuteCommandBuffer(Arc< VkCommandContext > context)
 	}
 }
 
+void CommandQueue::SubmitSplit(VkCommandContext& context, VkSemaphore vkSignalSemaphore)
+{
+	assert(!context.IsTransient());
+
+	std::vector< VkSemaphore >          waitSemaphores;
+	std::vector< VkPipelineStageFlags > waitStages;
+	context.ConsumeWaitSemaphores(waitSemaphores, waitStages);
+
+	auto vkCommandBuffer = context.SplitCommandBuffer();
+
+	// no fence: the context's final submission signals it after this part in queue order
+	VkSubmitInfo submitInfo = {};
+	submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.waitSemaphoreCount   = static_cast< u32 >(waitSemaphores.size());
+	submitInfo.pWaitSemaphores      = waitSemaphores.data();
+	submitInfo.pWaitDstStageMask    = waitStages.data();
+	submitInfo.commandBufferCount   = 1;
+	submitInfo.pCommandBuffers      = &vkCommandBuffer;
+	submitInfo.signalSemaphoreCount = vkSignalSemaphore ? 1 : 0;
+	submitInfo.pSignalSemaphores    = &vkSignalSemaphore;
+	VK_CHECK(vkQueueSubmit(m_vkQueue, 1, &submitInfo, VK_NULL_HANDLE));
+}
+
 } // namespace vk
\ No newline at end of file
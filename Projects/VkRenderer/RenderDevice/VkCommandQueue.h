@@ -18,8 +18,18 @@ public:
 	void RecycleUnsubmitted(Arc< VkCommandContext >&& pContext);
 	void Flush();
 
+	// Secondary contexts for parallel recording. Each recorder owns a command pool so worker threads
+	// never share one; contexts are reused once the frame slot 'contextIndex' comes around again.
+	[[nodiscard]]
+	Arc< VkCommandContext > AllocateSecondary(u32 recorderIndex, u32 contextIndex);
+	void ResetSecondaries(u32 contextIndex);
+
 	void ExecuteCommandBuffer(Arc< VkCommandContext > context);
 
+	// Submits what 'context' recorded so far, with its pending waits, and leaves it open for the
+	// rest of the frame. 'vkSignalSemaphore' is signalled once that part completes.
+	void SubmitSplit(VkCommandContext& context, VkSemaphore vkSignalSemaphore = VK_NULL_HANDLE);
+
 
 	[[nodiscard]]
 	inline u32 Index() const { return m_QueueIndex; }
@@ -38,6 +48,15 @@ private:
 	std::vector< Arc< VkCommandContext > > m_pContexts;
 	std::queue< Arc< VkCommandContext > >  m_pAvailableContexts;
 
+	struct SecondaryRecorder
+	{
+		VkCommandPool vkCommandPool = VK_NULL_HANDLE;
+
+		std::vector< Arc< VkCommandContext > > pContexts[kMaxFramesInFlight];
+		u32                                    numUsed[kMaxFramesInFlight] = {};
+	};
+	std::vector< SecondaryRecorder > m_SecondaryRecorders;
+
 	u32 m_QueueIndex = UINT_MAX;
 };
 
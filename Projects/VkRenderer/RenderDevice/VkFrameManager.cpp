@@ -41,6 +41,7 @@ void FrameManager::EndFrame(Arc< VkCommandContext >&& pContext)
         m_SwapChain.Present(pContext->vkRenderCompleteSemaphore());
 
     m_ContextIndex = (m_ContextIndex + 1) % kMaxFramesInFlight;
+    m_RenderDevice.AdvanceFrame();
 }
 
 } // namespace vk
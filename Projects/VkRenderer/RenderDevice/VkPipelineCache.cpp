@@ -0,0 +1,275 @@
+#include "RendererPch.h"
+#include "VkPipelineCache.h"
+#include "Utils/FileIO.hpp"
+
+#include <cstring>
+
+namespace vk
+{
+
+namespace
+{
+
+constexpr u32 kArchiveMagic   = 0x43504242; // 'BBPC'
+constexpr u32 kArchiveVersion = 1;
+constexpr const char* kArchiveName = "Pipelines.cache";
+
+struct ArchiveHeader
+{
+	u32 magic    = kArchiveMagic;
+	u32 version  = kArchiveVersion;
+	u32 vendorID = 0;
+	u32 deviceID = 0;
+	u8  pipelineCacheUUID[VK_UUID_SIZE] = {};
+	u64 shaderSetHash = 0;
+	u64 dataSize      = 0;
+};
+
+constexpr u64 kFnvOffset = 14695981039346656037ull;
+constexpr u64 kFnvPrime  = 1099511628211ull;
+
+u64 Fnv1a(u64 hash, const void* pData, size_t size)
+{
+	const u8* pBytes = static_cast< const u8* >(pData);
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= pBytes[i];
+		hash *= kFnvPrime;
+	}
+	return hash;
+}
+
+bool IsCompatiblePipelineCache(const u8* pData, u64 size, const VkPhysicalDeviceProperties& deviceProps)
+{
+	if (!pData || size < sizeof(VkPipelineCacheHeaderVersionOne))
+		return false;
+
+	VkPipelineCacheHeaderVersionOne header = {};
+	std::memcpy(&header, pData, sizeof(header));
+	return header.headerSize == sizeof(VkPipelineCacheHeaderVersionOne) &&
+		header.headerSize <= size &&
+		header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+		header.vendorID == deviceProps.vendorID &&
+		header.deviceID == deviceProps.deviceID &&
+		std::memcmp(header.pipelineCacheUUID, deviceProps.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+} // anonymous namespace
+
+PipelineCache::PipelineCache(VkRenderDevice& rd)
+	: m_RenderDevice(rd)
+{
+}
+
+PipelineCache::~PipelineCache()
+{
+	Save();
+
+	for (auto vkPipelineCache : m_Caches)
+		vkDestroyPipelineCache(m_RenderDevice.vkDevice(), vkPipelineCache, nullptr);
+}
+
+void PipelineCache::LoadArchive()
+{
+	// Reading every SPIR-V binary is what validating the archive costs, so it waits for the
+	// first compile instead of holding up device creation
+	m_bLoaded = true;
+
+	PruneLegacyCaches();
+
+	m_ShaderSetHash = HashShaderSet();
+
+	FileIO::Data archive = FileIO::ReadBinary((PIPELINE_PATH / kArchiveName).string());
+	if (archive.data && archive.size >= sizeof(ArchiveHeader))
+	{
+		ArchiveHeader header = {};
+		std::memcpy(&header, archive.data, sizeof(header));
+
+		const auto& deviceProps = m_RenderDevice.DeviceProps();
+		const u8*   pBlob       = static_cast< const u8* >(archive.data) + sizeof(ArchiveHeader);
+		const bool bValid =
+			header.magic == kArchiveMagic &&
+			header.version == kArchiveVersion &&
+			header.vendorID == deviceProps.vendorID &&
+			header.deviceID == deviceProps.deviceID &&
+			std::memcmp(header.pipelineCacheUUID, deviceProps.pipelineCacheUUID, VK_UUID_SIZE) == 0 &&
+			header.shaderSetHash == m_ShaderSetHash &&
+			header.dataSize == archive.size - sizeof(ArchiveHeader) &&
+			IsCompatiblePipelineCache(pBlob, header.dataSize, deviceProps);
+		if (bValid)
+		{
+			m_SeedData.assign(pBlob, pBlob + header.dataSize);
+		}
+		else
+		{
+			// Driver or shaders changed since it was written; nothing in it can hit again
+			printf("[PipelineCache] dropping stale archive '%s'\n", kArchiveName);
+			std::error_code ec;
+			fs::remove(PIPELINE_PATH / kArchiveName, ec);
+		}
+	}
+	archive.Deallocate();
+}
+
+VkPipelineCache PipelineCache::Acquire()
+{
+	std::lock_guard< std::mutex > lock(m_Mutex);
+	if (!m_bLoaded)
+		LoadArchive();
+
+	if (!m_FreeCaches.empty())
+	{
+		const VkPipelineCache vkPipelineCache = m_FreeCaches.back();
+		m_FreeCaches.pop_back();
+		return vkPipelineCache;
+	}
+
+	// One seeded cache per concurrent compile; the pool only grows to the build queue's worker count
+	VkPipelineCacheCreateInfo cacheInfo = {};
+	cacheInfo.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	cacheInfo.initialDataSize = m_SeedData.size();
+	cacheInfo.pInitialData    = m_SeedData.empty() ? nullptr : m_SeedData.data();
+
+	VkPipelineCache vkPipelineCache = VK_NULL_HANDLE;
+	VK_CHECK(vkCreatePipelineCache(m_RenderDevice.vkDevice(), &cacheInfo, nullptr, &vkPipelineCache));
+	m_Caches.push_back(vkPipelineCache);
+	return vkPipelineCache;
+}
+
+void PipelineCache::Release(VkPipelineCache vkPipelineCache, bool bInserted)
+{
+	std::lock_guard< std::mutex > lock(m_Mutex);
+	m_FreeCaches.push_back(vkPipelineCache);
+	m_bDirty |= bInserted;
+}
+
+VkPipelineCreationFeedbackCreateInfo PipelineCache::FeedbackInfo(VkPipelineCreationFeedback& feedback)
+{
+	feedback = {};
+
+	VkPipelineCreationFeedbackCreateInfo feedbackInfo = {};
+	feedbackInfo.sType                     = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO;
+	feedbackInfo.pPipelineCreationFeedback = &feedback;
+	return feedbackInfo;
+}
+
+bool PipelineCache::InsertedInto(const VkPipelineCreationFeedback& feedback)
+{
+	// without valid feedback, assume the compile added to the cache
+	return (feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT) == 0
+		|| (feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT) == 0;
+}
+
+void PipelineCache::Save()
+{
+	std::lock_guard< std::mutex > lock(m_Mutex);
+	if (!m_bDirty || m_Caches.empty())
+		return;
+
+	BB_ASSERT(m_FreeCaches.size() == m_Caches.size(), "PipelineCache saved while a compile still holds a cache");
+
+	auto vkDevice = m_RenderDevice.vkDevice();
+
+	VkPipelineCacheCreateInfo cacheInfo = {};
+	cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+	VkPipelineCache vkMerged = VK_NULL_HANDLE;
+	VK_CHECK(vkCreatePipelineCache(vkDevice, &cacheInfo, nullptr, &vkMerged));
+	VK_CHECK(vkMergePipelineCaches(vkDevice, vkMerged, static_cast< u32 >(m_Caches.size()), m_Caches.data()));
+
+	size_t dataSize = 0;
+	VK_CHECK(vkGetPipelineCacheData(vkDevice, vkMerged, &dataSize, nullptr));
+
+	std::vector< u8 > archive(sizeof(ArchiveHeader) + dataSize);
+	VkResult result = vkGetPipelineCacheData(vkDevice, vkMerged, &dataSize, archive.data() + sizeof(ArchiveHeader));
+	vkDestroyPipelineCache(vkDevice, vkMerged, nullptr);
+	if (result != VK_SUCCESS || dataSize == 0)
+		return;
+
+	const auto& deviceProps = m_RenderDevice.DeviceProps();
+
+	ArchiveHeader header = {};
+	header.vendorID      = deviceProps.vendorID;
+	header.deviceID      = deviceProps.deviceID;
+	header.shaderSetHash = m_ShaderSetHash;
+	header.dataSize      = static_cast< u64 >(dataSize);
+	std::memcpy(header.pipelineCacheUUID, deviceProps.pipelineCacheUUID, VK_UUID_SIZE);
+	std::memcpy(archive.data(), &header, sizeof(header));
+	archive.resize(sizeof(ArchiveHeader) + dataSize);
+
+	// Written beside the archive and renamed over it, so a crash mid-write never leaves a torn file
+	const fs::path archivePath = PIPELINE_PATH / kArchiveName;
+	const fs::path tempPath    = PIPELINE_PATH / (std::string(kArchiveName) + ".tmp");
+
+	std::error_code ec;
+	fs::create_directories(PIPELINE_PATH, ec);
+	{
+		std::ofstream file(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+			return;
+
+		file.write(reinterpret_cast< const char* >(archive.data()), static_cast< std::streamsize >(archive.size()));
+		if (!file)
+		{
+			file.close();
+			fs::remove(tempPath, ec);
+			return;
+		}
+	}
+	fs::rename(tempPath, archivePath, ec);
+	if (ec)
+	{
+		fs::remove(tempPath, ec);
+		return;
+	}
+
+	m_bDirty = false;
+	printf("[PipelineCache] wrote '%s' (%llu bytes from %zu caches)\n",
+		kArchiveName, static_cast< unsigned long long >(archive.size()), m_Caches.size());
+}
+
+u64 PipelineCache::HashShaderSet() const
+{
+	std::error_code ec;
+	if (!fs::is_directory(SPIRV_PATH, ec))
+		return 0;
+
+	std::vector< fs::path > shaderPaths;
+	for (const auto& entry : fs::directory_iterator(SPIRV_PATH, ec))
+	{
+		if (entry.is_regular_file(ec) && entry.path().extension() == ".spv")
+			shaderPaths.push_back(entry.path());
+	}
+	std::sort(shaderPaths.begin(), shaderPaths.end());
+
+	u64 hash = kFnvOffset;
+	for (const auto& path : shaderPaths)
+	{
+		const std::string filename = path.filename().string();
+		hash = Fnv1a(hash, filename.data(), filename.size());
+
+		FileIO::Data code = FileIO::ReadBinary(path.string());
+		hash = Fnv1a(hash, code.data, static_cast< size_t >(code.size));
+		code.Deallocate();
+	}
+	return hash;
+}
+
+void PipelineCache::PruneLegacyCaches() const
+{
+	// Left over from when every pipeline kept its own '<name>.cache' file
+	std::error_code ec;
+	if (!fs::is_directory(PIPELINE_PATH, ec))
+		return;
+
+	std::vector< fs::path > legacyPaths;
+	for (const auto& entry : fs::directory_iterator(PIPELINE_PATH, ec))
+	{
+		if (entry.is_regular_file(ec) && entry.path().extension() == ".cache" && entry.path().filename() != kArchiveName)
+			legacyPaths.push_back(entry.path());
+	}
+	for (const auto& path : legacyPaths)
+		fs::remove(path, ec);
+}
+
+} // namespace vk
@@ -0,0 +1,53 @@
+#pragma once
+
+namespace vk
+{
+
+//-----------------------------------------------------------------------------
+// PipelineCache
+//     - one archive file for every pipeline the device builds
+//     - loaded on the first lease, seeded into a pool of VkPipelineCaches
+//       that compiles lease one at a time (so parallel builds don't contend)
+//     - merged and written back once at shutdown, through a temp file + rename,
+//       only if a compile missed the cache and added to it
+//     - keyed by the driver's cache UUID and a content hash of the SPIR-V set;
+//       a mismatch drops the old blob instead of letting it accumulate
+//-----------------------------------------------------------------------------
+class PipelineCache
+{
+public:
+	PipelineCache(VkRenderDevice& rd);
+	~PipelineCache();
+
+	[[nodiscard]]
+	VkPipelineCache Acquire();
+	// 'bInserted': the compile missed the cache and added its pipeline to it
+	void Release(VkPipelineCache vkPipelineCache, bool bInserted);
+
+	// Merges every leased-and-returned cache and writes the archive
+	void Save();
+
+	// Fills in 'feedback' for a pipeline create info's pNext; InsertedInto reads it back afterwards
+	static VkPipelineCreationFeedbackCreateInfo FeedbackInfo(VkPipelineCreationFeedback& feedback);
+	static bool InsertedInto(const VkPipelineCreationFeedback& feedback);
+
+private:
+	void LoadArchive();
+	u64 HashShaderSet() const;
+	void PruneLegacyCaches() const;
+
+private:
+	VkRenderDevice& m_RenderDevice;
+
+	std::mutex m_Mutex;
+
+	std::vector< u8 >              m_SeedData; // driver blob from the archive, empty if stale or missing
+	std::vector< VkPipelineCache > m_Caches;
+	std::vector< VkPipelineCache > m_FreeCaches;
+
+	u64  m_ShaderSetHash = 0;
+	bool m_bLoaded       = false;
+	bool m_bDirty        = false;
+};
+
+} // namespace vk
@@ -5,6 +5,7 @@
 #include "VkCommandContext.h"
 #include "VkResourceManager.h"
 #include "VkDescriptorPool.h"
+#include "VkPipelineCache.h"
 #include "RenderResource/VkRenderTarget.h"
 #include "RenderResource/VkSceneResource.h"
 
@@ -97,6 +98,10 @@ VkRenderDevice::VkRenderDevice(const render::DeviceSettings& ds)
 	m_pTransferQueue = new CommandQueue(*this, deviceBuilder.queueFamilyIndices.transferQueueIndex, eCommandType::Transfer);
 	assert(m_pGraphicsQueue && m_pComputeQueue && m_pTransferQueue);
 
+	if (m_Settings.bAsyncCompute && m_pComputeQueue->Index() != m_pGraphicsQueue->Index())
+		m_ConcurrentQueueFamilies = { m_pGraphicsQueue->Index(), m_pComputeQueue->Index() };
+	m_Settings.bAsyncCompute = IsAsyncComputeEnabled();
+
 
 	// **
 	// Resource management
@@ -132,6 +137,12 @@ VkRenderDevice::VkRenderDevice(const render::DeviceSettings& ds)
 	emptyLayoutInfo.bindingCount = 0;
 	emptyLayoutInfo.pBindings    = nullptr;
 	VK_CHECK(vkCreateDescriptorSetLayout(m_vkDevice, &emptyLayoutInfo, nullptr, &m_vkEmptySetLayout));
+
+
+	// **
+	// Pipeline cache
+	// **
+	m_pPipelineCache = new PipelineCache(*this);
 }
 
 VkRenderDevice::~VkRenderDevice()
@@ -142,6 +153,7 @@ VkRenderDevice::~VkRenderDevice()
 
 	RELEASE(m_pResourceManager);
 	RELEASE(m_pGlobalDescriptorPool);
+	RELEASE(m_pPipelineCache);
 	vkDestroyDescriptorSetLayout(m_vkDevice, m_vkEmptySetLayout, nullptr);
 	if (m_vmaAllocator)
 		vmaDestroyAllocator(m_vmaAllocator);
@@ -197,6 +209,56 @@ Arc< render::RenderTarget > VkRenderDevice::CreateEmptyRenderTarget(const char*
 	return MakeArc< VulkanRenderTarget >(*this, name);
 }
 
+void VkRenderDevice::AliasTransientTextures(const std::vector< std::vector< Arc< render::Texture > > >& groups)
+{
+	// images about to be re-created may still be referenced by frames in flight
+	Flush();
+
+	const auto ReleaseGroup = [](const std::vector< Arc< render::Texture > >& group)
+	{
+		for (const auto& pTexture : group)
+			StaticCast< VulkanTexture >(pTexture)->ReleaseAliasedMemory();
+	};
+
+	for (const auto& group : groups)
+	{
+		if (group.size() < 2)
+		{
+			ReleaseGroup(group);
+			continue;
+		}
+
+		VkMemoryRequirements requirements = { .size = 0, .alignment = 1, .memoryTypeBits = ~0u };
+		for (const auto& pTexture : group)
+		{
+			VkMemoryRequirements textureRequirements = {};
+			vkGetImageMemoryRequirements(m_vkDevice, StaticCast< VulkanTexture >(pTexture)->vkImage(), &textureRequirements);
+
+			requirements.size            = std::max(requirements.size, textureRequirements.size);
+			requirements.alignment       = std::max(requirements.alignment, textureRequirements.alignment);
+			requirements.memoryTypeBits &= textureRequirements.memoryTypeBits;
+		}
+
+		// no memory type fits every member; they keep their own allocations
+		if (requirements.memoryTypeBits == 0)
+		{
+			ReleaseGroup(group);
+			continue;
+		}
+
+		VmaAllocationCreateInfo vmaInfo = {};
+		vmaInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		vmaInfo.flags         = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+
+		VmaAllocation vmaAllocation = VK_NULL_HANDLE;
+		VK_CHECK(vmaAllocateMemory(m_vmaAllocator, &requirements, &vmaInfo, &vmaAllocation, nullptr));
+
+		auto pMemory = MakeArc< VulkanAliasedMemory >(*this, vmaAllocation, requirements.size);
+		for (const auto& pTexture : group)
+			StaticCast< VulkanTexture >(pTexture)->BindAliasedMemory(pMemory);
+	}
+}
+
 Arc< render::Sampler > VkRenderDevice::CreateSampler(const char* name, render::Sampler::CreationInfo&& info)
 {
 	return VulkanSampler::Create(*this, name, std::move(info));
@@ -336,6 +398,30 @@ bool VkRenderDevice::SaveTextureToEXR(const Arc< render::Texture >& pTexture, co
 	return false;
 }
 
+void VkRenderDevice::QueryMemoryBudgets(std::vector< render::MemoryHeapBudget >& outBudgets) const
+{
+	outBudgets.clear();
+	if (!m_vmaAllocator)
+		return;
+
+	const VkPhysicalDeviceMemoryProperties* pMemoryProps = nullptr;
+	vmaGetMemoryProperties(m_vmaAllocator, &pMemoryProps);
+
+	// Without VK_EXT_memory_budget VMA estimates these from its own allocations
+	std::array< VmaBudget, VK_MAX_MEMORY_HEAPS > budgets = {};
+	vmaGetHeapBudgets(m_vmaAllocator, budgets.data());
+
+	for (u32 heapIdx = 0; heapIdx < pMemoryProps->memoryHeapCount; ++heapIdx)
+	{
+		outBudgets.push_back(
+			{
+				.bDeviceLocal = (pMemoryProps->memoryHeaps[heapIdx].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0,
+				.usageBytes   = budgets[heapIdx].usage,
+				.budgetBytes  = budgets[heapIdx].budget,
+			});
+	}
+}
+
 DescriptorSet& VkRenderDevice::AllocateDescriptorSet(VkDescriptorSetLayout vkSetLayout) const
 {
 	return m_pGlobalDescriptorPool->AllocateSet(vkSetLayout);
@@ -9,6 +9,7 @@ class VkCommandContext;
 class VkResourceManager;
 class DescriptorSet;
 class DescriptorPool;
+class PipelineCache;
 
 enum class eCommandType;
 
@@ -54,6 +55,8 @@ public:
 
 	virtual Arc< render::RenderTarget > CreateEmptyRenderTarget(const char* name = "") override;
 
+	virtual void AliasTransientTextures(const std::vector< std::vector< Arc< render::Texture > > >& groups) override;
+
 	virtual Arc< render::Sampler > CreateSampler(const char* name, render::Sampler::CreationInfo&& info) override;
 
 	virtual Arc< render::Shader > CreateShader(const char* name, render::Shader::CreationInfo&& info) override;
@@ -85,6 +88,11 @@ public:
 	inline CommandQueue& ComputeQueue() const { return *m_pComputeQueue; }
 	inline CommandQueue& TransferQueue() const { return *m_pTransferQueue; }
 
+	// Async compute needs a compute queue family of its own. While enabled, buffers and textures are
+	// created shared by the graphics and compute families, so no ownership transfers are recorded.
+	inline bool IsAsyncComputeEnabled() const { return !m_ConcurrentQueueFamilies.empty(); }
+	inline const std::vector< u32 >& ConcurrentQueueFamilies() const { return m_ConcurrentQueueFamilies; }
+
 	Arc< VkCommandContext > BeginCommand(eCommandType cmdType, VkCommandBufferUsageFlags usage = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, bool bTransient = false);
 	void ExecuteCommand(Arc< VkCommandContext > pContext);
 
@@ -93,12 +101,16 @@ public:
 
 	virtual bool SaveTextureToEXR(const Arc< render::Texture >& pTexture, const char* path) override;
 
+	virtual void QueryMemoryBudgets(std::vector< render::MemoryHeapBudget >& outBudgets) const override;
+
 	inline VkRenderPass vkMainRenderPass() const { return m_vkMainRenderPass; }
 	void SetMainRenderPass(VkRenderPass vkRenderPass) { m_vkMainRenderPass = vkRenderPass; }
 
 	DescriptorSet& AllocateDescriptorSet(VkDescriptorSetLayout vkSetLayout) const;
 	inline VkDescriptorSetLayout GetEmptyDescriptorSetLayout() const { return m_vkEmptySetLayout; }
 
+	inline PipelineCache& GetPipelineCache() const { return *m_pPipelineCache; }
+
 	void SetVkObjectName(const std::string& name, u64 handle, VkObjectType type);
 
 private:
@@ -118,6 +130,8 @@ private:
 	CommandQueue* m_pComputeQueue  = nullptr;
 	CommandQueue* m_pTransferQueue = nullptr;
 
+	std::vector< u32 > m_ConcurrentQueueFamilies;
+
 	VmaAllocator       m_vmaAllocator     = VK_NULL_HANDLE;
 	VkResourceManager* m_pResourceManager = nullptr;
 
@@ -125,6 +139,8 @@ private:
 
 	VkDescriptorSetLayout m_vkEmptySetLayout      = VK_NULL_HANDLE;
 	DescriptorPool*       m_pGlobalDescriptorPool = nullptr;
+
+	PipelineCache* m_pPipelineCache = nullptr;
 };
 
 } // namespace vk
\ No newline at end of file
@@ -1,14 +1,12 @@
 #include "RendererPch.h"
 #include "VkRenderPipeline.h"
 #include "VkResourceManager.h"
+#include "VkPipelineCache.h"
 #include "RenderResource/VkRenderTarget.h"
 #include "RenderResource/VkSceneResource.h"
-#include "Utils/FileIO.hpp"
+#include "RenderCommon/PipelineBuildQueue.h"
 
 #include <cstddef>
-#include <cstdlib>
-#include <cstring>
-#include <new>
 #include <unordered_set>
 
 namespace vk
@@ -18,88 +16,6 @@ using namespace render;
 
 namespace
 {
-bool IsCompatiblePipelineCache(const FileIO::Data& cacheData, const VkPhysicalDeviceProperties& deviceProps)
-{
-	if (!cacheData.data || cacheData.size < sizeof(VkPipelineCacheHeaderVersionOne))
-		return false;
-
-	VkPipelineCacheHeaderVersionOne header = {};
-	std::memcpy(&header, cacheData.data, sizeof(header));
-	return header.headerSize == sizeof(VkPipelineCacheHeaderVersionOne) &&
-		header.headerSize <= cacheData.size &&
-		header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
-		header.vendorID == deviceProps.vendorID &&
-		header.deviceID == deviceProps.deviceID &&
-		std::memcmp(header.pipelineCacheUUID, deviceProps.pipelineCacheUUID, VK_UUID_SIZE) == 0;
-}
-
-VkPipelineCache CreatePipelineCache(VkRenderDevice& renderDevice, const std::string& filename)
-{
-	FileIO::Data cacheData = FileIO::ReadBinary((PIPELINE_PATH / filename).string());
-
-	VkPipelineCacheCreateInfo cacheInfo = {};
-	cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-	if (IsCompatiblePipelineCache(cacheData, renderDevice.DeviceProps()))
-	{
-		cacheInfo.initialDataSize = static_cast<std::size_t>(cacheData.size);
-		cacheInfo.pInitialData = cacheData.data;
-	}
-
-	VkPipelineCache pipelineCache = VK_NULL_HANDLE;
-	const VkResult result = vkCreatePipelineCache(renderDevice.vkDevice(), &cacheInfo, nullptr, &pipelineCache);
-	cacheData.Deallocate();
-	VK_CHECK(result);
-	return pipelineCache;
-}
-
-void WritePipelineCache(VkRenderDevice& renderDevice, VkPipelineCache pipelineCache, const std::string& filename)
-{
-	for (;;)
-	{
-		std::size_t cacheSize = 0;
-		const VkResult sizeResult =
-			vkGetPipelineCacheData(renderDevice.vkDevice(), pipelineCache, &cacheSize, nullptr);
-		if (sizeResult != VK_SUCCESS)
-		{
-			VK_CHECK(sizeResult);
-			return;
-		}
-		if (cacheSize == 0)
-			return;
-
-		FileIO::Data writeData = {};
-		writeData.data = std::malloc(cacheSize);
-		if (!writeData.data)
-			throw std::bad_alloc();
-		writeData.size = static_cast<u64>(cacheSize);
-
-		const VkResult dataResult =
-			vkGetPipelineCacheData(renderDevice.vkDevice(), pipelineCache, &cacheSize, writeData.data);
-		if (dataResult == VK_SUCCESS)
-		{
-			writeData.size = static_cast<u64>(cacheSize);
-			try
-			{
-				FileIO::WriteBinary(PIPELINE_PATH.string(), filename, writeData);
-			}
-			catch (...)
-			{
-				writeData.Deallocate();
-				throw;
-			}
-			writeData.Deallocate();
-			return;
-		}
-
-		writeData.Deallocate();
-		if (dataResult != VK_INCOMPLETE)
-		{
-			VK_CHECK(dataResult);
-			return;
-		}
-	}
-}
-
 VkPipelineColorBlendAttachmentState MakeDefaultBlendState()
 {
 	VkPipelineColorBlendAttachmentState state = {};
@@ -279,6 +195,9 @@ VulkanGraphicsPipeline::VulkanGraphicsPipeline(VkRenderDevice& rd, const char* n
 
 VulkanGraphicsPipeline::~VulkanGraphicsPipeline()
 {
+	// a queued compile captures this pipeline
+	PipelineBuildQueue::Cancel(this);
+
 	vkDestroyPipeline(m_RenderDevice.vkDevice(), m_vkPipeline, nullptr);
 	vkDestroyPipelineLayout(m_RenderDevice.vkDevice(), m_vkPipelineLayout, nullptr);
 	for (u32 i = 1; i < m_vkSetLayouts.size(); ++i)
@@ -424,26 +343,29 @@ void VulkanGraphicsPipeline::Build()
 		assert(ms && ps);
 
 		VkPipelineShaderStageCreateInfo msStageCreateInfo = {};
-		msStageCreateInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-		msStageCreateInfo.stage  = VK_SHADER_STAGE_MESH_BIT_EXT;
-		msStageCreateInfo.module = ms->vkModule();
-		msStageCreateInfo.pName  = "main";
+		msStageCreateInfo.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		msStageCreateInfo.stage               = VK_SHADER_STAGE_MESH_BIT_EXT;
+		msStageCreateInfo.module              = ms->vkModule();
+		msStageCreateInfo.pName               = "main";
+		msStageCreateInfo.pSpecializationInfo = ms->SpecializationInfo();
 		shaderStages.push_back(msStageCreateInfo);
 
 		VkPipelineShaderStageCreateInfo fsStageCreateInfo = {};
-		fsStageCreateInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-		fsStageCreateInfo.stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
-		fsStageCreateInfo.module = ps->vkModule();
-		fsStageCreateInfo.pName  = "main";
+		fsStageCreateInfo.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		fsStageCreateInfo.stage               = VK_SHADER_STAGE_FRAGMENT_BIT;
+		fsStageCreateInfo.module              = ps->vkModule();
+		fsStageCreateInfo.pName               = "main";
+		fsStageCreateInfo.pSpecializationInfo = ps->SpecializationInfo();
 		shaderStages.push_back(fsStageCreateInfo);
 
 		if (ts)
 		{
 			VkPipelineShaderStageCreateInfo tsStageCreateInfo = {};
-			tsStageCreateInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-			tsStageCreateInfo.stage  = VK_SHADER_STAGE_TASK_BIT_EXT;
-			tsStageCreateInfo.module = ts->vkModule();
-			tsStageCreateInfo.pName  = "main";
+			tsStageCreateInfo.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+			tsStageCreateInfo.stage               = VK_SHADER_STAGE_TASK_BIT_EXT;
+			tsStageCreateInfo.module              = ts->vkModule();
+			tsStageCreateInfo.pName               = "main";
+			tsStageCreateInfo.pSpecializationInfo = ts->SpecializationInfo();
 			shaderStages.push_back(tsStageCreateInfo);
 		}
 
@@ -466,7 +388,7 @@ void VulkanGraphicsPipeline::Build()
 				layoutBinding.stageFlags      = VK_SHADER_STAGE_MESH_BIT_EXT;
 				descriptorSetLayoutBindingMap[set].emplace(info.binding, layoutBinding);
 
-				m_ResourceBindingMap.emplace(info.name, (static_cast<u64>(set) << 32) | info.binding);
+				AddResourceBinding(info.name, (static_cast<u64>(set) << 32) | info.binding);
 			}
 
 			maxSet = maxSet < (i32)set ? (i32)set : maxSet;
@@ -491,7 +413,7 @@ void VulkanGraphicsPipeline::Build()
 					descriptorSetLayoutBindingMap[set].emplace(info.binding, layoutBinding);
 				}
 
-				m_ResourceBindingMap.emplace(info.name, (static_cast<u64>(set) << 32) | info.binding);
+				AddResourceBinding(info.name, (static_cast<u64>(set) << 32) | info.binding);
 			}
 
 			maxSet = maxSet < (i32)set ? (i32)set : maxSet;
@@ -518,7 +440,7 @@ void VulkanGraphicsPipeline::Build()
 						descriptorSetLayoutBindingMap[set].emplace(info.binding, layoutBinding);
 					}
 
-					m_ResourceBindingMap.emplace(info.name, (static_cast<u64>(set) << 32) | info.binding);
+					AddResourceBinding(info.name, (static_cast<u64>(set) << 32) | info.binding);
 				}
 
 				maxSet = maxSet < (i32)set ? (i32)set : maxSet;
@@ -587,44 +509,49 @@ void VulkanGraphicsPipeline::Build()
 		assert(vs && ps);
 
 		VkPipelineShaderStageCreateInfo vsStageCreateInfo = {};
-		vsStageCreateInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-		vsStageCreateInfo.stage  = VK_SHADER_STAGE_VERTEX_BIT;
-		vsStageCreateInfo.module = vs->vkModule();
-		vsStageCreateInfo.pName  = "main";
+		vsStageCreateInfo.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		vsStageCreateInfo.stage               = VK_SHADER_STAGE_VERTEX_BIT;
+		vsStageCreateInfo.module              = vs->vkModule();
+		vsStageCreateInfo.pName               = "main";
+		vsStageCreateInfo.pSpecializationInfo = vs->SpecializationInfo();
 		shaderStages.push_back(vsStageCreateInfo);
 
 		VkPipelineShaderStageCreateInfo fsStageCreateInfo = {};
-		fsStageCreateInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-		fsStageCreateInfo.stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
-		fsStageCreateInfo.module = ps->vkModule();
-		fsStageCreateInfo.pName  = "main";
+		fsStageCreateInfo.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		fsStageCreateInfo.stage               = VK_SHADER_STAGE_FRAGMENT_BIT;
+		fsStageCreateInfo.module              = ps->vkModule();
+		fsStageCreateInfo.pName               = "main";
+		fsStageCreateInfo.pSpecializationInfo = ps->SpecializationInfo();
 		shaderStages.push_back(fsStageCreateInfo);
 
 		if (gs)
 		{
 			VkPipelineShaderStageCreateInfo gsStageCreateInfo = {};
-			gsStageCreateInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-			gsStageCreateInfo.stage  = VK_SHADER_STAGE_GEOMETRY_BIT;
-			gsStageCreateInfo.module = gs->vkModule();
-			gsStageCreateInfo.pName  = "main";
+			gsStageCreateInfo.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+			gsStageCreateInfo.stage               = VK_SHADER_STAGE_GEOMETRY_BIT;
+			gsStageCreateInfo.module              = gs->vkModule();
+			gsStageCreateInfo.pName               = "main";
+			gsStageCreateInfo.pSpecializationInfo = gs->SpecializationInfo();
 			shaderStages.push_back(gsStageCreateInfo);
 		}
 		if (hs)
 		{
 			VkPipelineShaderStageCreateInfo hsStageCreateInfo = {};
-			hsStageCreateInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-			hsStageCreateInfo.stage  = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
-			hsStageCreateInfo.module = hs->vkModule();
-			hsStageCreateInfo.pName  = "main";
+			hsStageCreateInfo.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+			hsStageCreateInfo.stage               = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+			hsStageCreateInfo.module              = hs->vkModule();
+			hsStageCreateInfo.pName               = "main";
+			hsStageCreateInfo.pSpecializationInfo = hs->SpecializationInfo();
 			shaderStages.push_back(hsStageCreateInfo);
 		}
 		if (ds)
 		{
 			VkPipelineShaderStageCreateInfo dsStageCreateInfo = {};
-			dsStageCreateInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-			dsStageCreateInfo.stage  = VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
-			dsStageCreateInfo.module = ds->vkModule();
-			dsStageCreateInfo.pName  = "main";
+			dsStageCreateInfo.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+			dsStageCreateInfo.stage               = VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+			dsStageCreateInfo.module              = ds->vkModule();
+			dsStageCreateInfo.pName               = "main";
+			dsStageCreateInfo.pSpecializationInfo = ds->SpecializationInfo();
 			shaderStages.push_back(dsStageCreateInfo);
 		}
 
@@ -648,7 +575,7 @@ void VulkanGraphicsPipeline::Build()
 				layoutBinding.stageFlags      = VK_SHADER_STAGE_VERTEX_BIT;
 				descriptorSetLayoutBindingMap[set].emplace(info.binding, layoutBinding);
 
-				m_ResourceBindingMap.emplace(info.name, (static_cast<u64>(set) << 32) | info.binding);
+				AddResourceBinding(info.name, (static_cast<u64>(set) << 32) | info.binding);
 			}
 
 			maxSet = maxSet < (i32)set ? (i32)set : maxSet;
@@ -675,7 +602,7 @@ void VulkanGraphicsPipeline::Build()
 						descriptorSetLayoutBindingMap[set].emplace(info.binding, layoutBinding);
 					}
 
-					m_ResourceBindingMap.emplace(info.name, (static_cast<u64>(set) << 32) | info.binding);
+					AddResourceBinding(info.name, (static_cast<u64>(set) << 32) | info.binding);
 				}
 
 				maxSet = maxSet < (i32)set ? (i32)set : maxSet;
@@ -704,7 +631,7 @@ void VulkanGraphicsPipeline::Build()
 						descriptorSetLayoutBindingMap[set].emplace(info.binding, layoutBinding);
 					}
 
-					m_ResourceBindingMap.emplace(info.name, (static_cast<u64>(set) << 32) | info.binding);
+					AddResourceBinding(info.name, (static_cast<u64>(set) << 32) | info.binding);
 				}
 
 				maxSet = maxSet < (i32)set ? (i32)set : maxSet;
@@ -733,7 +660,7 @@ void VulkanGraphicsPipeline::Build()
 						descriptorSetLayoutBindingMap[set].emplace(info.binding, layoutBinding);
 					}
 
-					m_ResourceBindingMap.emplace(info.name, (static_cast<u64>(set) << 32) | info.binding);
+					AddResourceBinding(info.name, (static_cast<u64>(set) << 32) | info.binding);
 				}
 
 				maxSet = maxSet < (i32)set ? (i32)set : maxSet;
@@ -762,7 +689,7 @@ void VulkanGraphicsPipeline::Build()
 						descriptorSetLayoutBindingMap[set].emplace(info.binding, layoutBinding);
 					}
 
-					m_ResourceBindingMap.emplace(info.name, (static_cast<u64>(set) << 32) | info.binding);
+					AddResourceBinding(info.name, (static_cast<u64>(set) << 32) | info.binding);
 				}
 
 				maxSet = maxSet < (i32)set ? (i32)set : maxSet;
@@ -912,27 +839,6 @@ void VulkanGraphicsPipeline::Build()
 	// Pipeline
 	// **
 
-	// Pipeline cache
-	std::string filename   = std::string(m_Name) + ".cache";
-	const VkPipelineCache vkPipelineCache = CreatePipelineCache(m_RenderDevice, filename);
-
-	// dynamic state
-	std::vector< VkDynamicState > dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
-	VkPipelineDynamicStateCreateInfo dynamicStateInfo = {};
-	dynamicStateInfo.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-	dynamicStateInfo.dynamicStateCount = static_cast<u32>(dynamicStates.size());
-	dynamicStateInfo.pDynamicStates    = dynamicStates.data();
-
-	VkPipelineColorBlendStateCreateInfo colorBlendingInfo = 
-	{
-		.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
-		.logicOpEnable   = m_PipelineDesc.bLogicOpEnabled,
-		.logicOp         = m_PipelineDesc.blendLogicOp,
-		.attachmentCount = m_PipelineDesc.colorAttachmentCount,
-		.pAttachments    = m_PipelineDesc.blendStates.data(),
-		.blendConstants  = { 0.f, 0.f, 0.f, 0.f }
-	};
-
 	if (m_PipelineDesc.bLogicOpEnabled)
 	{
 		for (u32 i = 0; i < m_PipelineDesc.colorAttachmentCount; ++i)
@@ -942,37 +848,66 @@ void VulkanGraphicsPipeline::Build()
 		}
 	}
 
-	// Pipeline
-	VkGraphicsPipelineCreateInfo pipelineInfo = {};
-	pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-	pipelineInfo.stageCount          = static_cast<u32>(shaderStages.size());
-	pipelineInfo.pStages             = shaderStages.data();
-	pipelineInfo.pVertexInputState   = &m_PipelineDesc.vertexInputInfo;
-	pipelineInfo.pInputAssemblyState = &m_PipelineDesc.inputAssemblyInfo;
-	pipelineInfo.pViewportState      = &m_PipelineDesc.viewportStateInfo;
-	pipelineInfo.pRasterizationState = &m_PipelineDesc.rasterizerInfo;
-	pipelineInfo.pMultisampleState   = &m_PipelineDesc.multisamplingInfo;
-	pipelineInfo.pDepthStencilState  = &m_PipelineDesc.depthStencilInfo;
-	pipelineInfo.pColorBlendState    = &colorBlendingInfo;
-	pipelineInfo.pDynamicState       = &dynamicStateInfo;
-	pipelineInfo.layout              = m_vkPipelineLayout;
-	pipelineInfo.renderPass          = m_PipelineDesc.renderPass;
-	pipelineInfo.subpass             = 0;
-	pipelineInfo.basePipelineIndex   = -1;
-	// **
-	// Clean up
-	// **
-	try
-	{
-		VK_CHECK(vkCreateGraphicsPipelines(m_RenderDevice.vkDevice(), vkPipelineCache, 1, &pipelineInfo, nullptr, &m_vkPipeline));
-		WritePipelineCache(m_RenderDevice, vkPipelineCache, filename);
-	}
-	catch (...)
+	// Everything above touches shared device state; the compile below only reads
+	// this pipeline's own description, so it may run on a PipelineBuildQueue worker
+	PipelineBuildQueue::Submit(this, m_Name, [this, shaderStages = std::move(shaderStages)]()
 	{
-		vkDestroyPipelineCache(m_RenderDevice.vkDevice(), vkPipelineCache, nullptr);
-		throw;
-	}
-	vkDestroyPipelineCache(m_RenderDevice.vkDevice(), vkPipelineCache, nullptr);
+		// Pipeline cache
+		auto& pipelineCache = m_RenderDevice.GetPipelineCache();
+		const VkPipelineCache vkPipelineCache = pipelineCache.Acquire();
+
+		// dynamic state
+		std::vector< VkDynamicState > dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+		VkPipelineDynamicStateCreateInfo dynamicStateInfo = {};
+		dynamicStateInfo.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+		dynamicStateInfo.dynamicStateCount = static_cast<u32>(dynamicStates.size());
+		dynamicStateInfo.pDynamicStates    = dynamicStates.data();
+
+		VkPipelineColorBlendStateCreateInfo colorBlendingInfo = 
+		{
+			.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+			.logicOpEnable   = m_PipelineDesc.bLogicOpEnabled,
+			.logicOp         = m_PipelineDesc.blendLogicOp,
+			.attachmentCount = m_PipelineDesc.colorAttachmentCount,
+			.pAttachments    = m_PipelineDesc.blendStates.data(),
+			.blendConstants  = { 0.f, 0.f, 0.f, 0.f }
+		};
+
+		// Pipeline
+		VkPipelineCreationFeedback feedback;
+		const auto feedbackInfo = PipelineCache::FeedbackInfo(feedback);
+
+		VkGraphicsPipelineCreateInfo pipelineInfo = {};
+		pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+		pipelineInfo.stageCount          = static_cast<u32>(shaderStages.size());
+		pipelineInfo.pStages             = shaderStages.data();
+		pipelineInfo.pVertexInputState   = &m_PipelineDesc.vertexInputInfo;
+		pipelineInfo.pInputAssemblyState = &m_PipelineDesc.inputAssemblyInfo;
+		pipelineInfo.pViewportState      = &m_PipelineDesc.viewportStateInfo;
+		pipelineInfo.pRasterizationState = &m_PipelineDesc.rasterizerInfo;
+		pipelineInfo.pMultisampleState   = &m_PipelineDesc.multisamplingInfo;
+		pipelineInfo.pDepthStencilState  = &m_PipelineDesc.depthStencilInfo;
+		pipelineInfo.pColorBlendState    = &colorBlendingInfo;
+		pipelineInfo.pDynamicState       = &dynamicStateInfo;
+		pipelineInfo.layout              = m_vkPipelineLayout;
+		pipelineInfo.renderPass          = m_PipelineDesc.renderPass;
+		pipelineInfo.subpass             = 0;
+		pipelineInfo.basePipelineIndex   = -1;
+		pipelineInfo.pNext               = &feedbackInfo;
+		// **
+		// Clean up
+		// **
+		try
+		{
+			VK_CHECK(vkCreateGraphicsPipelines(m_RenderDevice.vkDevice(), vkPipelineCache, 1, &pipelineInfo, nullptr, &m_vkPipeline));
+		}
+		catch (...)
+		{
+			pipelineCache.Release(vkPipelineCache, false);
+			throw;
+		}
+		pipelineCache.Release(vkPipelineCache, PipelineCache::InsertedInto(feedback));
+	});
 }
 
 
@@ -987,6 +922,9 @@ VulkanComputePipeline::VulkanComputePipeline(VkRenderDevice& rd, const char* nam
 
 VulkanComputePipeline::~VulkanComputePipeline()
 {
+	// a queued compile captures this pipeline
+	PipelineBuildQueue::Cancel(this);
+
 	vkDestroyPipeline(m_RenderDevice.vkDevice(), m_vkPipeline, nullptr);
 	vkDestroyPipelineLayout(m_RenderDevice.vkDevice(), m_vkPipelineLayout, nullptr);
 	for (u32 i = 1; i < m_vkSetLayouts.size(); ++i)
@@ -1029,7 +967,7 @@ void VulkanComputePipeline::Build()
 			layoutBinding.stageFlags      = VK_SHADER_STAGE_COMPUTE_BIT;
 			descriptorSetLayoutBindingMap[set].emplace(info.binding, layoutBinding);
 
-			m_ResourceBindingMap.emplace(info.name, (static_cast<u64>(set) << 32) | info.binding);
+			AddResourceBinding(info.name, (static_cast<u64>(set) << 32) | info.binding);
 		}
 
 		maxSet = maxSet < (i32)set ? (i32)set : maxSet;
@@ -1090,33 +1028,41 @@ void VulkanComputePipeline::Build()
 	// Pipeline
 	// **
 
-	// Pipeline cache
-	std::string filename   = std::string(m_Name) + ".cache";
-	const VkPipelineCache vkPipelineCache = CreatePipelineCache(m_RenderDevice, filename);
-
-	VkComputePipelineCreateInfo pipelineInfo = {};
-	pipelineInfo.sType              = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
-	pipelineInfo.stage.sType        = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-	pipelineInfo.stage.stage        = VK_SHADER_STAGE_COMPUTE_BIT;
-	pipelineInfo.stage.module       = vkCS->vkModule();
-	pipelineInfo.stage.pName        = "main";
-	pipelineInfo.layout             = m_vkPipelineLayout;
-	pipelineInfo.basePipelineHandle = nullptr;
-	pipelineInfo.basePipelineIndex  = 0;
-	// **
-	// Clean up
-	// **
-	try
-	{
-		VK_CHECK(vkCreateComputePipelines(m_RenderDevice.vkDevice(), vkPipelineCache, 1, &pipelineInfo, nullptr, &m_vkPipeline));
-		WritePipelineCache(m_RenderDevice, vkPipelineCache, filename);
-	}
-	catch (...)
+	// Layout and module are in place; the compile may run on a PipelineBuildQueue worker
+	PipelineBuildQueue::Submit(this, m_Name, [this, vkModule = vkCS->vkModule(), pSpecializationInfo = vkCS->SpecializationInfo()]()
 	{
-		vkDestroyPipelineCache(m_RenderDevice.vkDevice(), vkPipelineCache, nullptr);
-		throw;
-	}
-	vkDestroyPipelineCache(m_RenderDevice.vkDevice(), vkPipelineCache, nullptr);
+		// Pipeline cache
+		auto& pipelineCache = m_RenderDevice.GetPipelineCache();
+		const VkPipelineCache vkPipelineCache = pipelineCache.Acquire();
+
+		VkPipelineCreationFeedback feedback;
+		const auto feedbackInfo = PipelineCache::FeedbackInfo(feedback);
+
+		VkComputePipelineCreateInfo pipelineInfo = {};
+		pipelineInfo.sType                     = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		pipelineInfo.stage.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		pipelineInfo.stage.stage               = VK_SHADER_STAGE_COMPUTE_BIT;
+		pipelineInfo.stage.module              = vkModule;
+		pipelineInfo.stage.pName               = "main";
+		pipelineInfo.stage.pSpecializationInfo = pSpecializationInfo;
+		pipelineInfo.layout                    = m_vkPipelineLayout;
+		pipelineInfo.basePipelineHandle        = nullptr;
+		pipelineInfo.basePipelineIndex         = 0;
+		pipelineInfo.pNext                     = &feedbackInfo;
+		// **
+		// Clean up
+		// **
+		try
+		{
+			VK_CHECK(vkCreateComputePipelines(m_RenderDevice.vkDevice(), vkPipelineCache, 1, &pipelineInfo, nullptr, &m_vkPipeline));
+		}
+		catch (...)
+		{
+			pipelineCache.Release(vkPipelineCache, false);
+			throw;
+		}
+		pipelineCache.Release(vkPipelineCache, PipelineCache::InsertedInto(feedback));
+	});
 }
 
 } // namespace vk
@@ -85,7 +85,7 @@ void VkTimer::Destroy(VkDevice vkDevice)
 	}
 }
 
-void VkTimer::BeginFrame(VkCommandBuffer vkCmdBuffer, VkDevice vkDevice, const VkPhysicalDeviceProperties& deviceProps)
+void VkTimer::BeginFrame(VkCommandBuffer vkCmdBuffer, VkDevice vkDevice, const VkPhysicalDeviceProperties& deviceProps, u64 frameIndex)
 {
 	if (!m_bEnabled)
 		return;
@@ -112,6 +112,7 @@ void VkTimer::BeginFrame(VkCommandBuffer vkCmdBuffer, VkDevice vkDevice, const V
 			const auto [startIdx, endIdx] = m_QueryIndices[i];
 			const u64  delta = (ticks[endIdx] - ticks[startIdx]) & timestampMask;
 			m_Building[i].elapsedMs       = double(delta) * tickToMs;
+			m_Building[i].beginMs         = double(ticks[startIdx] & timestampMask) * tickToMs;
 		}
 
 		// --- Pipeline statistics ---
@@ -146,7 +147,9 @@ void VkTimer::BeginFrame(VkCommandBuffer vkCmdBuffer, VkDevice vkDevice, const V
 			}
 		}
 
-		m_LastResults = std::move(m_Building);
+		// Swap rather than move so both buffers keep their capacity
+		m_LastResults.swap(m_Building);
+		m_LastFrameIndex = m_BuildingFrameIndex;
 	}
 
 	// 2) Reset bookkeeping for new frame
@@ -157,13 +160,15 @@ void VkTimer::BeginFrame(VkCommandBuffer vkCmdBuffer, VkDevice vkDevice, const V
 	m_NextQueryIdx = 0;
 	m_NextStatsIdx = 0;
 	m_CurrentDepth = 0;
+	m_BuildingFrameIndex = frameIndex;
 
 	// 3) Reset GPU pools and open the implicit "Frame" scope
 	vkCmdResetQueryPool(vkCmdBuffer, m_QueryPool, 0, m_MaxQueries);
 	if (m_bStatsSupported)
 		vkCmdResetQueryPool(vkCmdBuffer, m_StatsPool, 0, m_MaxStatsQueries);
 
-	BeginMarker(vkCmdBuffer, "Frame");
+	static const render::ProfileScopeId s_FrameScope = render::ProfileScopeRegistry::Intern("Frame");
+	BeginMarker(vkCmdBuffer, s_FrameScope);
 
 	m_bHasPreviousFrame = true;
 }
@@ -177,7 +182,7 @@ void VkTimer::EndFrame(VkCommandBuffer vkCmdBuffer)
 	BB_ASSERT(m_OpenStack.empty(), "Unbalanced BeginGpuMarker / EndGpuMarker.");
 }
 
-void VkTimer::BeginMarker(VkCommandBuffer vkCmdBuffer, const char* name, bool bStats)
+void VkTimer::BeginMarker(VkCommandBuffer vkCmdBuffer, render::ProfileScopeId scopeId, bool bStats)
 {
 	if (!m_bEnabled)
 		return;
@@ -187,10 +192,13 @@ void VkTimer::BeginMarker(VkCommandBuffer vkCmdBuffer, const char* name, bool bS
 
 	const u32 startIdx = m_NextQueryIdx++;
 
+	const char* name = render::ProfileScopeRegistry::Name(scopeId);
+
 	render::GpuProfileEntry entry = {
 		.name      = name,
 		.depth     = m_CurrentDepth,
 		.elapsedMs = 0.0,
+		.scopeId   = scopeId,
 	};
 
 	const u32 entryIdx = u32(m_Building.size());
@@ -24,15 +24,16 @@ public:
 	void Destroy(VkDevice vkDevice);
 
 	// Frame lifecycle
-	void BeginFrame(VkCommandBuffer vkCmdBuffer, VkDevice vkDevice, const VkPhysicalDeviceProperties& deviceProps);
+	void BeginFrame(VkCommandBuffer vkCmdBuffer, VkDevice vkDevice, const VkPhysicalDeviceProperties& deviceProps, u64 frameIndex);
 	void EndFrame(VkCommandBuffer vkCmdBuffer);
 
 	// Scoped markers (called between BeginFrame and EndFrame)
-	void BeginMarker(VkCommandBuffer vkCmdBuffer, const char* name, bool bStats = false);
+	void BeginMarker(VkCommandBuffer vkCmdBuffer, render::ProfileScopeId scopeId, bool bStats = false);
 	void EndMarker(VkCommandBuffer vkCmdBuffer);
 
 	// Results from previous completed frame
 	const std::vector< render::GpuProfileEntry >& GetLastFrameProfile() const { return m_LastResults; }
+	u64 GetLastFrameIndex() const { return m_LastFrameIndex; }
 	double GetLastFrameTotalNs() const;
 
 private:
@@ -61,6 +62,9 @@ private:
 	std::vector< u32 >                     m_OpenStack;    // indices into m_Building of currently-open scopes
 	u32                                    m_CurrentDepth = 0;
 
+	u64 m_BuildingFrameIndex = render::kNoProfileFrame;
+	u64 m_LastFrameIndex     = render::kNoProfileFrame;
+
 	bool m_bHasPreviousFrame = false;
 };
 
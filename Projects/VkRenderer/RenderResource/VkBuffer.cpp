@@ -74,6 +74,14 @@ void VulkanBuffer::Resize(u64 sizeInBytes, bool bReset)
 	bufferInfo.size  = sizeInBytes;
 	bufferInfo.usage = VK_BUFFER_USAGE_FLAGS(m_CreationInfo.bufferUsage);
 
+	const auto& concurrentQueueFamilies = m_RenderDevice.ConcurrentQueueFamilies();
+	if (!concurrentQueueFamilies.empty())
+	{
+		bufferInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+		bufferInfo.queueFamilyIndexCount = static_cast< u32 >(concurrentQueueFamilies.size());
+		bufferInfo.pQueueFamilyIndices   = concurrentQueueFamilies.data();
+	}
+
 	VmaAllocationCreateInfo vmaInfo = {};
 	switch (m_CreationInfo.mapDirection)
 	{
@@ -131,6 +139,7 @@ void VulkanBuffer::Resize(u64 sizeInBytes, bool bReset)
 	m_vmaAllocation  = vmaAllocation;
 	m_AllocationInfo = allocationInfo;
 	m_DeviceAddress  = deviceAddress;
+	TrackAllocation(render::eMemoryTag::Buffers);
 
 	m_CreationInfo.count              = 1;
 	m_CreationInfo.elementSizeInBytes = sizeInBytes;
@@ -1,5 +1,6 @@
 #pragma once
 #include "VkBarrierState.h"
+#include "RenderCommon/MemoryTracker.h"
 
 namespace vk
 {
@@ -95,18 +96,38 @@ public:
 	[[nodiscard]]
 	inline const ResourceState& GetState() const { return m_CurrentState; }
 
+	// Reports this resource's memory under 'tag' from now on, instead of the one its usage implies
+	void SetMemoryTag(render::eMemoryTag tag)
+	{
+		m_TrackedMemory.Retag(tag);
+		m_bMemoryTagSet = true;
+	}
+
 protected:
 	void SetDeviceObjectName(u64 handle, VkObjectType type)
 	{
 		m_RenderDevice.SetVkObjectName(m_Name, handle, type);
 	}
 
+	// Reports the current VMA allocation, replacing what was reported before
+	void TrackAllocation(render::eMemoryTag defaultTag)
+	{
+		m_TrackedMemory.Clear();
+		if (!m_bMemoryTagSet)
+			m_TrackedMemory.Retag(defaultTag);
+		if (m_vmaAllocation)
+			m_TrackedMemory.Add(m_AllocationInfo.size);
+	}
+
 	VkRenderDevice& m_RenderDevice;
 	std::string     m_Name;
 
 	VmaAllocation     m_vmaAllocation  = VK_NULL_HANDLE;
 	VmaAllocationInfo m_AllocationInfo = {};
 
+	render::TrackedMemory m_TrackedMemory{ render::eMemoryTag::Buffers };
+	bool                  m_bMemoryTagSet = false;
+
 	ResourceState m_CurrentState = {};
 };
 
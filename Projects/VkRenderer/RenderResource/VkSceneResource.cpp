@@ -308,6 +308,10 @@ void VkSceneResource::UpdateSceneResources(const SceneRenderView& sceneView, ren
 	}
 	else if (m_FrameData[m_ContextIndex].bInitialized)
 	{
+		if (m_FrameData[m_ContextIndex].visibilityRevision != sceneView.visibilityRevision)
+			UpdateInstances(sceneView, ctx);
+		m_NumInstances = m_FrameData[m_ContextIndex].numInstances;
+
 		UpdateCameraAndEnvironment(sceneView, ctx);
 		return;
 	}
@@ -469,15 +473,15 @@ void VkSceneResource::UpdateSceneResources(const SceneRenderView& sceneView, ren
 	UpdateFrameBuffer(ctx, meshes.data(), (u32)meshes.size(), sizeof(MeshData), *m_FrameData[m_ContextIndex].pMeshDataAllocator, VK_PIPELINE_STAGE_2_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_2_MESH_SHADER_BIT_EXT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
 
 	u32 meshletVisibilityCursor = 0;
-	std::vector< InstanceData > instances;
+	m_DrawInstances.clear();
 	for (auto& [id, data] : sceneView.draws)
 	{
-		InstanceData instance = {};
 		if (data.mesh != kInvalidIndex)
 		{
 			BB_ASSERT(data.mesh < sceneView.meshes.size(), "Mesh idx_%d should less than mesh size %d", data.mesh, (u32)sceneView.meshes.size());
 			auto& meshView = sceneView.meshes[data.mesh];
 
+			InstanceData instance = {};
 			{
 				instance.meshID = data.mesh;
 
@@ -491,6 +495,7 @@ void VkSceneResource::UpdateSceneResources(const SceneRenderView& sceneView, ren
 					instance.materialID = data.material;
 				}
 
+				// slots follow the draw, not its packed position, so visibility history survives re-packing
 				instance.visOffset = meshletVisibilityCursor;
 
 				u32 maxLodMeshletCount = 0;
@@ -498,12 +503,27 @@ void VkSceneResource::UpdateSceneResources(const SceneRenderView& sceneView, ren
 					maxLodMeshletCount = std::max(maxLodMeshletCount, meshes[data.mesh].lods[i].mCount);
 				meshletVisibilityCursor += maxLodMeshletCount;
 			}
-			instances.push_back(instance);
-
-			m_NumInstances++;
+			m_DrawInstances.push_back({ id, instance });
 		}
 	}
 	m_NumMeshletVisibilitySlots = meshletVisibilityCursor;
+	UpdateInstances(sceneView, ctx);
+
+	UpdateFrameBuffer(ctx, &sceneView.light, 1, sizeof(LightData), *m_FrameData[m_ContextIndex].pLightAllocator, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+	ctx.FlushBarriers();
+
+	UpdateCameraAndEnvironment(sceneView, ctx);
+	m_FrameData[m_ContextIndex].bInitialized = true;
+	m_LastSceneRevision = sceneView.sceneRevision;
+}
+
+void VkSceneResource::UpdateInstances(const SceneRenderView& sceneView, VkCommandContext& ctx)
+{
+	auto& frameData = m_FrameData[m_ContextIndex];
+	frameData.pInstanceAllocator->Reset();
+
+	std::vector< InstanceData > instances;
+	u32 numVisible = PackDrawInstances(sceneView, instances);
 
 	// Voxel chunk: prepend it at the head of instance buffer
 	if (sceneView.voxelTerrain.bValid)
@@ -515,17 +535,16 @@ void VkSceneResource::UpdateSceneResources(const SceneRenderView& sceneView, ren
 		voxelInstance.visOffset   = 0;                                 // unused: voxel skips per-meshlet cull
 		voxelInstance.isVoxel     = 1;
 		instances.insert(instances.begin() + kVoxelChunkInstanceBase, voxelInstance); // instanceID == chunkID
+		++numVisible;
 	}
-	m_NumInstances = (u32)instances.size();
-	UpdateFrameBuffer(ctx, instances.data(), (u32)instances.size(), sizeof(InstanceData), *m_FrameData[m_ContextIndex].pInstanceAllocator, VK_PIPELINE_STAGE_2_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_2_MESH_SHADER_BIT_EXT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+	UpdateFrameBuffer(ctx, instances.data(), (u32)instances.size(), sizeof(InstanceData), *frameData.pInstanceAllocator, VK_PIPELINE_STAGE_2_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_2_MESH_SHADER_BIT_EXT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
 	//UpdateFrameBuffer(ctx, indirects.data(), (u32)indirects.size(), sizeof(IndirectCommandData), *m_FrameData[m_ContextIndex].pIndirectCommandAllocator, VK_PIPELINE_STAGE_2_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_2_MESH_SHADER_BIT_EXT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
-
-	UpdateFrameBuffer(ctx, &sceneView.light, 1, sizeof(LightData), *m_FrameData[m_ContextIndex].pLightAllocator, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
 	ctx.FlushBarriers();
 
-	UpdateCameraAndEnvironment(sceneView, ctx);
-	m_FrameData[m_ContextIndex].bInitialized = true;
-	m_LastSceneRevision = sceneView.sceneRevision;
+	// culled instances trail the visible ones and fall outside the cull/draw dispatch
+	m_NumInstances               = numVisible;
+	frameData.numInstances       = numVisible;
+	frameData.visibilityRevision = sceneView.visibilityRevision;
 }
 
 void VkSceneResource::BindSceneResources(render::CommandContext& context)
@@ -690,6 +709,8 @@ Arc< VulkanTexture > VkSceneResource::GetOrLoadTexture(const std::string& filepa
 
 	auto tex   = rm.LoadTexture(filepath, false, colorSpace);
 	auto vkTex = StaticCast<VulkanTexture>(tex);
+	if (vkTex)
+		vkTex->SetMemoryTag(render::eMemoryTag::TextureCache);
 
 	m_TextureCache.emplace(cacheKey, vkTex);
 
@@ -62,6 +62,7 @@ private:
     void ResetFrameBuffers();
     void UpdateFrameBuffer(VkCommandContext& context, const void* pData, u32 count, u64 elementSizeInBytes, StaticBufferAllocator& targetBuffer, VkPipelineStageFlags2 dstStageMask);
     void UpdateCameraAndEnvironment(const SceneRenderView& sceneView, VkCommandContext& ctx);
+    void UpdateInstances(const SceneRenderView& sceneView, VkCommandContext& ctx);
 
 private:
     VkRenderDevice& m_RenderDevice;
@@ -96,7 +97,9 @@ private:
         Arc< VulkanUniformBuffer > pSceneEnvironmentBuffer;
         Arc< VulkanUniformBuffer > pFrozenCameraBuffer;
 
-        bool bInitialized = false;
+        u64  visibilityRevision = 0;
+        u32  numInstances       = 0; // NumInstances() while this frame's instance list is bound
+        bool bInitialized       = false;
 
         void Reset();
     };
@@ -1,5 +1,7 @@
 #include "RendererPch.h"
 #include "VkShader.h"
+#include "RenderCommon/ShaderManifest.hpp"
+#include "RenderCommon/ShaderReflectionCache.hpp"
 
 #include <fstream>
 #include <spirv_cross/spirv_cross.hpp>
@@ -222,6 +224,80 @@ VkShaderStageFlagBits ParseSpirv(const u32* code, u64 codeSize, VulkanShader::Sh
 	return stage;
 }
 
+// Bump whenever ShaderReflection or the sidecar layout below changes
+constexpr u32 kReflectionVersion = 1;
+
+// Leaves 'stage' and 'reflection' untouched unless the whole sidecar reads back
+bool LoadReflection(const std::string& spirvPath, u64 binaryHash, VkShaderStageFlagBits& stage, VulkanShader::ShaderReflection& reflection)
+{
+	render::ReflectionReader reader;
+	if (!reader.Load(render::GetReflectionSidecarPath(spirvPath), kReflectionVersion, binaryHash))
+		return false;
+
+	VulkanShader::ShaderReflection loaded = {};
+	const auto loadedStage = reader.Read< VkShaderStageFlagBits >();
+	loaded.localSizeX = reader.Read< u32 >();
+	loaded.localSizeY = reader.Read< u32 >();
+	loaded.localSizeZ = reader.Read< u32 >();
+
+	const u32 numPushConstants = reader.Read< u32 >();
+	for (u32 i = 0; i < numPushConstants && reader.IsValid(); ++i)
+		loaded.pushConstants.push_back(reader.Read< VkPushConstantRange >());
+
+	const u32 numSets = reader.Read< u32 >();
+	for (u32 i = 0; i < numSets && reader.IsValid(); ++i)
+	{
+		const u32 set            = reader.Read< u32 >();
+		const u32 numDescriptors = reader.Read< u32 >();
+
+		auto& descriptors = loaded.descriptors[set];
+		for (u32 j = 0; j < numDescriptors && reader.IsValid(); ++j)
+		{
+			VulkanShader::DescriptorInfo& descriptorInfo = descriptors.emplace_back();
+			descriptorInfo.name           = reader.ReadString();
+			descriptorInfo.binding        = reader.Read< u32 >();
+			descriptorInfo.arraySize      = reader.Read< u32 >();
+			descriptorInfo.descriptorType = reader.Read< VkDescriptorType >();
+		}
+	}
+
+	if (!reader.IsComplete())
+		return false;
+
+	stage      = loadedStage;
+	reflection = std::move(loaded);
+	return true;
+}
+
+void SaveReflection(const std::string& spirvPath, u64 binaryHash, VkShaderStageFlagBits stage, const VulkanShader::ShaderReflection& reflection)
+{
+	render::ReflectionWriter writer;
+	writer.Write(stage);
+	writer.Write(reflection.localSizeX);
+	writer.Write(reflection.localSizeY);
+	writer.Write(reflection.localSizeZ);
+
+	writer.Write(static_cast< u32 >(reflection.pushConstants.size()));
+	for (const auto& pushConstant : reflection.pushConstants)
+		writer.Write(pushConstant);
+
+	writer.Write(static_cast< u32 >(reflection.descriptors.size()));
+	for (const auto& [set, descriptors] : reflection.descriptors)
+	{
+		writer.Write(set);
+		writer.Write(static_cast< u32 >(descriptors.size()));
+		for (const auto& descriptorInfo : descriptors)
+		{
+			writer.WriteString(descriptorInfo.name);
+			writer.Write(descriptorInfo.binding);
+			writer.Write(descriptorInfo.arraySize);
+			writer.Write(descriptorInfo.descriptorType);
+		}
+	}
+
+	writer.Save(render::GetReflectionSidecarPath(spirvPath), kReflectionVersion, binaryHash);
+}
+
 Arc< VulkanShader > VulkanShader::Create(VkRenderDevice& rd, const char* name, CreationInfo&& info)
 {
 	return MakeArc< VulkanShader >(rd, name, std::move(info));
@@ -231,7 +307,8 @@ VulkanShader::VulkanShader(VkRenderDevice& rd, const char* name, CreationInfo&&
 	: render::Shader(name, std::move(info))
 	, VulkanResource(rd, name)
 {
-	auto code = ReadSpirv(VK_SHADER_PATH(info.filename, info.stage));
+	const std::string spirvPath = VK_SHADER_PATH(info.filename, info.stage);
+	auto code = ReadSpirv(spirvPath);
 
 	VkShaderModuleCreateInfo shaderInfo = {};
 	shaderInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
@@ -239,7 +316,28 @@ VulkanShader::VulkanShader(VkRenderDevice& rd, const char* name, CreationInfo&&
 	shaderInfo.pCode    = reinterpret_cast<const u32*>(code.data());
 	VK_CHECK(vkCreateShaderModule(m_RenderDevice.vkDevice(), &shaderInfo, nullptr, &m_vkModule));
 
-	m_Stage = ParseSpirv(reinterpret_cast<const u32*>(code.data()), code.size() / 4, m_Reflection);
+	// The sidecar is keyed by the SPIR-V's hash, so a recompiled shader reflects again
+	const u64 binaryHash = render::HashShaderBinary(code.data(), code.size());
+	render::ValidateShaderBinary(spirvPath, binaryHash);
+	if (!LoadReflection(spirvPath, binaryHash, m_Stage, m_Reflection))
+	{
+		m_Stage = ParseSpirv(reinterpret_cast<const u32*>(code.data()), code.size() / 4, m_Reflection);
+		SaveReflection(spirvPath, binaryHash, m_Stage, m_Reflection);
+	}
+
+	// Every permutation shares the SPIR-V; its features only pick the specialization constants
+	for (const auto& feature : info.features)
+	{
+		VkSpecializationMapEntry& entry = m_SpecializationEntries.emplace_back();
+		entry.constantID = feature.constantId;
+		entry.offset     = static_cast< u32 >(m_SpecializationData.size() * sizeof(u32));
+		entry.size       = sizeof(u32);
+		m_SpecializationData.push_back(feature.value);
+	}
+	m_SpecializationInfo.mapEntryCount = static_cast< u32 >(m_SpecializationEntries.size());
+	m_SpecializationInfo.pMapEntries   = m_SpecializationEntries.data();
+	m_SpecializationInfo.dataSize      = m_SpecializationData.size() * sizeof(u32);
+	m_SpecializationInfo.pData         = m_SpecializationData.data();
 
 	SetDeviceObjectName((u64)m_vkModule, VK_OBJECT_TYPE_SHADER_MODULE);
 }
@@ -36,6 +36,8 @@ public:
 	inline VkShaderStageFlagBits Stage() const { assert(m_Stage != VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM); return m_Stage; }
 	[[nodiscard]]
 	inline const ShaderReflection& Reflection() const { return m_Reflection; }
+	[[nodiscard]]
+	inline const VkSpecializationInfo* SpecializationInfo() const { return m_SpecializationEntries.empty() ? nullptr : &m_SpecializationInfo; }
 
 private:
     VkShaderModule        m_vkModule = VK_NULL_HANDLE;
@@ -43,6 +45,11 @@ private:
 
 	CreationInfo     m_CreationInfo;
 	ShaderReflection m_Reflection;
+
+	// permutation features, one u32 specialization constant each
+	std::vector< VkSpecializationMapEntry > m_SpecializationEntries;
+	std::vector< u32 >                      m_SpecializationData;
+	VkSpecializationInfo                    m_SpecializationInfo = {};
 };
 
 } // namespace vk
\ No newline at end of file
@@ -56,7 +56,14 @@ inline VkSampleCountFlagBits GetSampleCount(u32 sampleCount)
 	}
 }
 
-VkImageCreateInfo GetVkImageCreateInfo(const render::Texture::CreationInfo& info)
+// Images the GPU writes count as render targets, the rest as sampled textures
+inline render::eMemoryTag GetMemoryTag(VkImageUsageFlags usage)
+{
+	constexpr VkImageUsageFlags kWriteUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+	return (usage & kWriteUsage) ? render::eMemoryTag::RenderTargets : render::eMemoryTag::Textures;
+}
+
+VkImageCreateInfo GetVkImageCreateInfo(const render::Texture::CreationInfo& info, const std::vector< u32 >& concurrentQueueFamilies)
 {
 	using namespace render; 
 
@@ -75,6 +82,14 @@ VkImageCreateInfo GetVkImageCreateInfo(const render::Texture::CreationInfo& info
 	desc.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
 	desc.initialLayout = VK_LAYOUT(info.initialLayout);
 
+	// shared with the async compute queue family without ownership transfers
+	if (!concurrentQueueFamilies.empty())
+	{
+		desc.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+		desc.queueFamilyIndexCount = static_cast< u32 >(concurrentQueueFamilies.size());
+		desc.pQueueFamilyIndices   = concurrentQueueFamilies.data();
+	}
+
 	return desc;
 }
 
@@ -83,14 +98,19 @@ void VulkanTexture::CreateImageAndView(const CreationInfo& info)
 	// **
 	// Create image
 	// **
-	m_Desc = GetVkImageCreateInfo(info);
+	m_Desc = GetVkImageCreateInfo(info, m_RenderDevice.ConcurrentQueueFamilies());
 
 	VmaAllocationCreateInfo vmaInfo = {};
 	vmaInfo.usage = VMA_MEMORY_USAGE_AUTO;
 	vmaInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
 	VK_CHECK(vmaCreateImage(m_RenderDevice.vmaAllocator(), &m_Desc, &vmaInfo, &m_vkImage, &m_vmaAllocation, &m_AllocationInfo));
+	TrackAllocation(GetMemoryTag(m_Desc.usage));
 
+	CreateViews();
+}
 
+void VulkanTexture::CreateViews()
+{
 	// **
 	// Create image view
 	// **
@@ -313,6 +333,9 @@ void VulkanTexture::DestroyImageAndViews()
 
 	if (m_vmaAllocation)
 		vmaDestroyImage(m_RenderDevice.vmaAllocator(), m_vkImage, m_vmaAllocation);
+	else if (m_pAliasedMemory)
+		vkDestroyImage(m_RenderDevice.vkDevice(), m_vkImage, nullptr);
+	m_pAliasedMemory.reset();
 
 	m_vkImage        = VK_NULL_HANDLE;
 	m_vkImageView    = VK_NULL_HANDLE;
@@ -320,6 +343,7 @@ void VulkanTexture::DestroyImageAndViews()
 	m_vkImageUAV     = VK_NULL_HANDLE;
 	m_vmaAllocation = VK_NULL_HANDLE;
 	m_AllocationInfo = {};
+	m_TrackedMemory.Clear();
 }
 
 Arc< VulkanTexture > VulkanTexture::Create(VkRenderDevice& rd, const char* name, CreationInfo&& desc)
@@ -348,6 +372,50 @@ void VulkanTexture::Resize(u32 width, u32 height, u32 depth)
 	SetState({ 0, 0, m_Desc.initialLayout });
 }
 
+void VulkanTexture::BindAliasedMemory(Arc< VulkanAliasedMemory > pMemory)
+{
+	assert(pMemory);
+
+	DestroyImageAndViews();
+
+	m_Desc = GetVkImageCreateInfo(m_CreationInfo, m_RenderDevice.ConcurrentQueueFamilies());
+	VK_CHECK(vkCreateImage(m_RenderDevice.vkDevice(), &m_Desc, nullptr, &m_vkImage));
+	VK_CHECK(vmaBindImageMemory(m_RenderDevice.vmaAllocator(), pMemory->vmaAllocation(), m_vkImage));
+	m_pAliasedMemory = std::move(pMemory);
+
+	CreateViews();
+	CreatePerMipViews();
+
+	SetDeviceObjectName((u64)m_vkImage, VK_OBJECT_TYPE_IMAGE);
+	SetState({ 0, 0, m_Desc.initialLayout });
+}
+
+void VulkanTexture::ReleaseAliasedMemory()
+{
+	if (!m_pAliasedMemory)
+		return;
+
+	DestroyImageAndViews();
+	CreateImageAndView(m_CreationInfo);
+	CreatePerMipViews();
+
+	SetDeviceObjectName((u64)m_vkImage, VK_OBJECT_TYPE_IMAGE);
+	SetState({ 0, 0, m_Desc.initialLayout });
+}
+
+VulkanAliasedMemory::VulkanAliasedMemory(VkRenderDevice& rd, VmaAllocation vmaAllocation, u64 sizeInBytes)
+	: m_RenderDevice(rd)
+	, m_vmaAllocation(vmaAllocation)
+{
+	m_TrackedMemory.Add(sizeInBytes);
+}
+
+VulkanAliasedMemory::~VulkanAliasedMemory()
+{
+	if (m_vmaAllocation)
+		vmaFreeMemory(m_RenderDevice.vmaAllocator(), m_vmaAllocation);
+}
+
 void VulkanTexture::SetResource(VkImage vkImage, VkImageView vkImageView, VkImageCreateInfo createInfo, VmaAllocation vmaAllocation, VmaAllocationInfo vmaAllocInfo, VkImageAspectFlags aspectMask)
 {
 	assert(!m_vkImage && !m_vkImageView);
@@ -358,6 +426,7 @@ void VulkanTexture::SetResource(VkImage vkImage, VkImageView vkImageView, VkImag
 	m_vmaAllocation  = vmaAllocation;
 	m_AllocationInfo = vmaAllocInfo;
 	m_AspectFlags    = aspectMask;
+	TrackAllocation(GetMemoryTag(m_Desc.usage));
 
 	m_CreationInfo.resolution = { createInfo.extent.width, createInfo.extent.height, createInfo.extent.depth };
 
@@ -6,6 +6,22 @@ namespace vk
 
 class VulkanSampler;
 
+// One allocation shared by aliased transient textures; freed with the last of them
+class VulkanAliasedMemory : public ArcBase
+{
+public:
+	VulkanAliasedMemory(VkRenderDevice& rd, VmaAllocation vmaAllocation, u64 sizeInBytes);
+	~VulkanAliasedMemory();
+
+	inline VmaAllocation vmaAllocation() const { return m_vmaAllocation; }
+
+private:
+	VkRenderDevice& m_RenderDevice;
+	VmaAllocation   m_vmaAllocation = VK_NULL_HANDLE;
+
+	render::TrackedMemory m_TrackedMemory{ render::eMemoryTag::RenderTargets };
+};
+
 class VulkanTexture : public render::Texture, public VulkanResource< VulkanTexture >
 {
 public:
@@ -18,6 +34,10 @@ public:
 
 	void Resize(u32 width, u32 height, u32 depth);
 	void SetResource(VkImage vkImage, VkImageView vkImageView, VkImageCreateInfo createInfo, VmaAllocation vmaAllocation, VmaAllocationInfo vmaAllocInfo, VkImageAspectFlags aspectMask);
+	// re-creates the image on 'pMemory' (offset 0); contents and layout are lost
+	void BindAliasedMemory(Arc< VulkanAliasedMemory > pMemory);
+	// back to a dedicated allocation if currently aliased
+	void ReleaseAliasedMemory();
 
 	inline CreationInfo Info() const { return m_CreationInfo; }
     inline VkImage vkImage() const { return m_vkImage; }
@@ -26,11 +46,12 @@ public:
     inline const VkImageCreateInfo& Desc() const { return m_Desc; }
 	inline VkImageAspectFlags AspectMask() const { return m_AspectFlags; }
 	VkClearValue ClearValue() const;
-	u64 SizeInBytes() const;
+	u64 SizeInBytes() const override;
 	u32 MipLevels() const override { return m_Desc.mipLevels; }
 
 protected:
     void CreateImageAndView(const CreationInfo& info);
+    void CreateViews();
     void CreatePerMipViews();
     void DestroyImageAndViews();
     VkImageViewCreateInfo GetViewDesc(const VkImageCreateInfo& imageDesc);
@@ -45,6 +66,8 @@ private:
 
     VkImageCreateInfo  m_Desc        = {};
 	VkImageAspectFlags m_AspectFlags = 0;
+
+	Arc< VulkanAliasedMemory > m_pAliasedMemory;
 };
 
 } // namespace vk
\ No newline at end of file
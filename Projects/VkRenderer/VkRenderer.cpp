@@ -2,6 +2,7 @@
 #include "VkRenderer.h"
 #include "RenderDevice/VkSwapChain.h"
 #include "RenderDevice/VkFrameManager.h"
+#include "RenderDevice/VkCommandQueue.h"
 #include "RenderDevice/VkResourceManager.h"
 #include "RenderDevice/VkCommandContext.h"
 #include "RenderDevice/VkDescriptorSet.h"
@@ -59,14 +60,75 @@ Arc< render::CommandContext > VkRenderer::BeginFrame()
 	auto& sr = static_cast<VkSceneResource&>(m_pRenderDevice->GetResourceManager().GetSceneResource());
 	sr.SetCurrentContextIndex(context.contextIndex);
 
+	m_FrameContextIndex = context.contextIndex;
+	m_pRenderDevice->GraphicsQueue().ResetSecondaries(m_FrameContextIndex);
+
 	return context.rhiCommandContext;
 }
 
+Arc< render::CommandContext > VkRenderer::BeginRecordingContext(u32 threadIndex)
+{
+	assert(threadIndex < kMaxRecordingThreads);
+	return m_pRenderDevice->GraphicsQueue().AllocateSecondary(threadIndex, m_FrameContextIndex);
+}
+
+void VkRenderer::ExecuteRecordingContext(render::CommandContext& frameContext, Arc< render::CommandContext >&& pContext)
+{
+	auto rhiContext = StaticCast<VkCommandContext>(pContext);
+	assert(rhiContext);
+
+	rhiContext->Close();
+	static_cast<VkCommandContext&>(frameContext).ExecuteCommands(*rhiContext);
+}
+
+Arc< render::CommandContext > VkRenderer::BeginAsyncCompute()
+{
+	if (!m_pRenderDevice->IsAsyncComputeEnabled())
+		return nullptr;
+
+	return m_pRenderDevice->ComputeQueue().Allocate(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+}
+
+void VkRenderer::SubmitAsyncCompute(render::CommandContext& frameContext, Arc< render::CommandContext >&& pContext)
+{
+	auto& rhiFrameContext = static_cast<VkCommandContext&>(frameContext);
+	auto  rhiContext      = StaticCast<VkCommandContext>(pContext);
+	assert(rhiContext && m_vkPendingAsyncComputeSemaphore == VK_NULL_HANDLE);
+
+	// scene uploads recorded so far go first; the compute queue waits for them
+	m_pRenderDevice->GraphicsQueue().SubmitSplit(rhiFrameContext, rhiFrameContext.vkSplitSemaphore());
+	rhiContext->AddWaitSemaphore(rhiFrameContext.vkSplitSemaphore(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+	rhiContext->Close();
+	m_vkPendingAsyncComputeSemaphore = rhiContext->vkRenderCompleteSemaphore();
+	m_pRenderDevice->ComputeQueue().ExecuteCommandBuffer(std::move(rhiContext));
+}
+
+void VkRenderer::JoinAsyncCompute(render::CommandContext& frameContext)
+{
+	if (m_vkPendingAsyncComputeSemaphore == VK_NULL_HANDLE)
+		return;
+
+	// what was recorded before the join is submitted without the wait, so it overlaps the compute work
+	auto& rhiFrameContext = static_cast<VkCommandContext&>(frameContext);
+	m_pRenderDevice->GraphicsQueue().SubmitSplit(rhiFrameContext);
+	rhiFrameContext.AddWaitSemaphore(m_vkPendingAsyncComputeSemaphore, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+	m_vkPendingAsyncComputeSemaphore = VK_NULL_HANDLE;
+}
+
 void VkRenderer::EndFrame(Arc< render::CommandContext >&& context, Arc< render::Texture > pScene, bool bDrawUI)
 {
 	auto rhiContext = StaticCast<VkCommandContext>(context);
 	assert(rhiContext);
 
+	// no pass waited for the compute work; the frame's fence still has to cover it
+	if (m_vkPendingAsyncComputeSemaphore != VK_NULL_HANDLE)
+	{
+		rhiContext->AddWaitSemaphore(m_vkPendingAsyncComputeSemaphore, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+		m_vkPendingAsyncComputeSemaphore = VK_NULL_HANDLE;
+	}
+
 	auto pColor = StaticCast<VulkanTexture>(pScene);
 	assert(pColor);
 	if (bDrawUI)
@@ -15,6 +15,14 @@ public:
 	virtual Arc< render::CommandContext > BeginFrame() override;
 	virtual void EndFrame(Arc< render::CommandContext >&& context, Arc< render::Texture > scene, bool bDrawUI) override;
 
+	virtual u32 MaxRecordingThreads() const override { return kMaxRecordingThreads; }
+	virtual Arc< render::CommandContext > BeginRecordingContext(u32 threadIndex) override;
+	virtual void ExecuteRecordingContext(render::CommandContext& frameContext, Arc< render::CommandContext >&& pContext) override;
+
+	virtual Arc< render::CommandContext > BeginAsyncCompute() override;
+	virtual void SubmitAsyncCompute(render::CommandContext& frameContext, Arc< render::CommandContext >&& pContext) override;
+	virtual void JoinAsyncCompute(render::CommandContext& frameContext) override;
+
 	virtual void WaitIdle() override;
 	virtual void Resize(i32 width, i32 height) override;
 
@@ -23,10 +31,17 @@ public:
 	eRendererAPI GetAPIType() const override { return eRendererAPI::Vulkan; }
 
 private:
+	static constexpr u32 kMaxRecordingThreads = 8;
+
 	class VkRenderDevice* m_pRenderDevice = nullptr;
 	class SwapChain*      m_pSwapChain    = nullptr;
 	class FrameManager*   m_pFrameManager = nullptr;
 
+	u32 m_FrameContextIndex = 0;
+
+	// signalled by this frame's compute submission, until the frame context waits on it
+	VkSemaphore m_vkPendingAsyncComputeSemaphore = VK_NULL_HANDLE;
+
 	Box< class ImGuiModule > m_ImGuiModule;
 };
 
@@ -60,6 +60,68 @@ project "Application"
 		optimize 'on'
 
 
+-- Tests : headless unit tests and CPU benchmarks ('BaambooTests --bench')
+project "BaambooTests"
+	location "BaambooTests"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++23"
+	staticruntime "off"
+	debugdir (Path.Solution)
+
+	targetdir (Path.Target)
+	objdir (Path.Obj)
+
+	callingconvention ("FastCall")
+	exceptionhandling ("Off")
+	rtti ("Off")
+	floatingpoint ("Fast")
+	flags { "MultiProcessorCompile" }
+	warnings ("High")
+	exceptionhandling ("On")
+
+	files {
+		"%{prj.name}/**.h",
+		"%{prj.name}/**.hpp",
+		"%{prj.name}/**.cpp",
+	}
+
+	includedirs {
+		"%{prj.name}/",
+		"%{Path.Solution}Projects/BaambooCommon",
+		"%{Path.Solution}Projects/BaambooEngine",
+		"%{Path.Solution}Projects/ThirdParties",
+		"%{Path.Solution}Projects/ThirdParties/glm",
+		"%{Path.Solution}Projects/ThirdParties/glfw/include",
+		"%{Path.Solution}Projects/ThirdParties/imgui",
+		"%{Path.Solution}Projects/ThirdParties/entt/single_include",
+		"%{Path.Solution}Projects/ThirdParties/assimp/include",
+		"%{Path.Solution}Projects/ThirdParties/magic_enum/include",
+		"%{Path.Solution}Projects/ThirdParties/meshoptimizer/src",
+	}
+
+	links {
+		"BaambooEngine",
+	}
+
+	debugenvs {
+		"PATH=Projects/ThirdParties/assimp/bin/Release/;Output/Binaries/%{cfg.buildcfg}/%{cfg.system}/BaambooCommon;%PATH%"
+	}
+
+	filter 'system:windows'
+		systemversion 'latest'
+
+	filter 'configurations:Debug'
+		defines '_DEBUG'
+		runtime 'Debug'
+		symbols 'on'
+
+	filter 'configurations:Release'
+		defines 'NDEBUG'
+		runtime 'Release'
+		optimize 'on'
+
+
 -- BaambooEngine
 project "BaambooEngine"
 	location "BaambooEngine"
@@ -195,6 +257,47 @@ project "BaambooCommon"
 		optimize "on"
 
 
+-- ShaderBuilder
+project "ShaderBuilder"
+	location "ShaderBuilder"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++23"
+	staticruntime "off"
+	debugdir (Path.Solution)
+
+	targetdir (Path.Target)
+	objdir (Path.Obj)
+
+	flags { "MultiProcessorCompile" }
+	warnings ("High")
+	exceptionhandling ("On")
+
+	files {
+		"%{prj.name}/**.h",
+		"%{prj.name}/**.cpp",
+	}
+
+	-- header-only pieces of BaambooCommon (hashing, manifest); no link dependency
+	includedirs {
+		"%{prj.name}/",
+		"%{Path.Solution}Projects/BaambooCommon",
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+	filter "configurations:Debug"
+		defines "_DEBUG"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		defines "NDEBUG"
+		runtime "Release"
+		optimize "on"
+
+
 -- Renderers
 project "Dx12Renderer"
 	location "Dx12Renderer"
@@ -258,34 +361,15 @@ project "Dx12Renderer"
 		"BaambooCommon"
 	}
 
-	shadermodel ("6.6")
-	shaderobjectfileoutput (path.join(Path.Cso, "%%(Filename).cso"))
-	filter { "files:**VS.hlsl" }
-		shadertype "Vertex"
-
-	filter { "files:**PS.hlsl" }
-		shadertype "Pixel"
-
-	filter { "files:**GS.hlsl" }
-		shadertype "Geometry"
-
-	filter { "files:**DS.hlsl" }
-		shadertype "Domain"
-
-	filter { "files:**HS.hlsl" }
-		shadertype "Hull"
-
-	filter { "files:**CS.hlsl" }
-		shadertype "Compute"
-
-	filter { "files:**MS.hlsl" }
-		shadertype "Mesh"
-
-	filter { "files:**TS.hlsl" }
-		shadertype "Amplification"
+	-- HLSL is compiled incrementally by ShaderBuilder, not per file by the IDE
+	dependson { "ShaderBuilder" }
+	prebuildmessage "Building HLSL shaders"
+	prebuildcommands {
+		'"%{Path.ShaderBuilder}" --api dx12 --root "%{Path.Solution}" --compiler "%{_WORKING_DIR}/packages/Microsoft.Direct3D.DXC.1.8.2505.32/build/native/bin/x64/dxc.exe"',
+	}
 
-	filter { "files:**LIB.hlsl" }
-		shadertype "Library"
+	filter { "files:**.hlsl" }
+		buildaction "None"
 
 	filter { "files:Dx12Renderer/RenderDevice/D3D12MemoryAllocator/src/**.cpp" }
 		flags "NoPCH"
@@ -331,14 +415,6 @@ project "Dx12Renderer"
 		links {  }
 
 
-rule "VkShaderCompile"
-	location "VkRenderer"
-	display "Compiling Shader to Spv"
-	fileextension { ".vert", ".frag", ".geom", ".hull", ".domain", ".task", ".mesh", ".comp" }
-
-	buildmessage 'Compiling %(Filename)%(Extension) to Spv'
-	buildcommands '$(VULKAN_SDK)/Bin/glslangValidator %(FullPath) -V -gVS --target-env vulkan1.4 -o %{Path.Spv}/%(Filename)%(Extension).spv'
-	buildoutputs '%{Path.Spv}/%(Filename)%(Extension).spv'
 project "VkRenderer"
 	location "VkRenderer"
 	kind "SharedLib"
@@ -360,7 +436,13 @@ project "VkRenderer"
 	flags { "MultiProcessorCompile" }
 	warnings ("High")
 	exceptionhandling ("On")
-	rules { "VkShaderCompile" }
+
+	-- GLSL is compiled incrementally by ShaderBuilder, not per file by the IDE
+	dependson { "ShaderBuilder" }
+	prebuildmessage "Building GLSL shaders"
+	prebuildcommands {
+		'"%{Path.ShaderBuilder}" --api vulkan --root "%{Path.Solution}" --compiler "%{Path.Vulkan}/Bin/glslangValidator.exe"',
+	}
 
 	files {
 		"%{prj.name}/**.h",
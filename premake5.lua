@@ -7,6 +7,7 @@ Path["Vulkan"] = os.getenv("VULKAN_SDK")
 Path["ShaderSrc"] = path.join(Path.Solution, "Assets/Shader/")
 Path["Cso"] = path.join(Path.Solution, "Output/Shader/cso/")
 Path["Spv"] = path.join(Path.Solution, "Output/Shader/spv")
+Path["ShaderBuilder"] = path.join(Path.Solution, "Output/Binaries/%{cfg.buildcfg}/%{cfg.system}/ShaderBuilder/ShaderBuilder.exe")
 
 Package = {}
 